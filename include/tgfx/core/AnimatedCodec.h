@@ -0,0 +1,160 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <mutex>
+#include <vector>
+#include "tgfx/core/Data.h"
+#include "tgfx/core/ImageInfo.h"
+#include "tgfx/core/Rect.h"
+
+namespace tgfx {
+/**
+ * Defines how the area of a frame is treated before the next frame is rendered.
+ */
+enum class FrameDisposal {
+  /**
+   * The frame is left in place, and the next frame is rendered on top of it.
+   */
+  None,
+  /**
+   * The area of the frame is cleared to transparent before rendering the next frame.
+   */
+  Background,
+  /**
+   * The area of the frame is restored to its content before the frame was rendered.
+   */
+  Previous
+};
+
+/**
+ * FrameInfo describes a single frame of an animated image.
+ */
+struct FrameInfo {
+  /**
+   * The area of the canvas covered by the frame.
+   */
+  Rect bounds = Rect::MakeEmpty();
+
+  /**
+   * The duration of the frame in microseconds.
+   */
+  int64_t duration = 0;
+
+  /**
+   * How the area of the frame is treated before rendering the next frame.
+   */
+  FrameDisposal disposal = FrameDisposal::None;
+
+  /**
+   * If true, the frame is alpha-blended onto the canvas. Otherwise, it replaces the pixels in its
+   * area.
+   */
+  bool blend = false;
+};
+
+/**
+ * AnimatedCodec decodes the frames of an animated image, such as an animated WebP or APNG file.
+ * Each decoded frame is composited with the frames before it according to their disposal and blend
+ * modes, so it always covers the whole canvas. Frames are decoded fastest in sequential order, as
+ * seeking backward restarts the decoding from the first frame. AnimatedCodec is safe across
+ * threads, but its decoding calls are serialized. Use an AnimatedImageReader to play the animation
+ * with the frames decoded ahead on background threads.
+ */
+class AnimatedCodec {
+ public:
+  /**
+   * If the file path represents an animated image that we know how to decode, returns an
+   * AnimatedCodec that can decode it. Otherwise, returns nullptr.
+   */
+  static std::shared_ptr<AnimatedCodec> MakeFrom(const std::string& filePath);
+
+  /**
+   * If the bytes represent an animated image that we know how to decode, returns an AnimatedCodec
+   * that can decode it. Otherwise, returns nullptr.
+   */
+  static std::shared_ptr<AnimatedCodec> MakeFrom(std::shared_ptr<Data> imageBytes);
+
+  virtual ~AnimatedCodec() = default;
+
+  /**
+   * Returns the width of the canvas of the animation.
+   */
+  int width() const {
+    return _width;
+  }
+
+  /**
+   * Returns the height of the canvas of the animation.
+   */
+  int height() const {
+    return _height;
+  }
+
+  /**
+   * Returns the number of frames in the animation.
+   */
+  int frameCount() const {
+    return static_cast<int>(frames.size());
+  }
+
+  /**
+   * Returns the information of the frame at the specified index.
+   */
+  const FrameInfo& getFrameInfo(int index) const {
+    return frames[static_cast<size_t>(index)];
+  }
+
+  /**
+   * Returns the number of times the animation plays, or 0 if it repeats forever.
+   */
+  int loopCount() const {
+    return _loopCount;
+  }
+
+  /**
+   * Returns the total duration of one loop of the animation in microseconds.
+   */
+  int64_t duration() const;
+
+  /**
+   * Decodes the frame at the specified index, composited with the frames before it, into the given
+   * pixels. Returns true if the decoding was successful.
+   */
+  bool readFrame(int index, const ImageInfo& dstInfo, void* dstPixels);
+
+ protected:
+  AnimatedCodec(int width, int height, std::vector<FrameInfo> frames, int loopCount);
+
+  /**
+   * Decodes and composites the frame at the specified index, and returns the address of the
+   * canvas, which is in the RGBA_8888 format with premultiplied alpha and has 4 * width() bytes
+   * per row. The returned address remains valid until the next call. Returns nullptr if the
+   * decoding fails.
+   */
+  virtual const void* onDecodeFrame(int index) = 0;
+
+ private:
+  std::mutex locker = {};
+  int _width = 0;
+  int _height = 0;
+  std::vector<FrameInfo> frames = {};
+  int _loopCount = 0;
+};
+}  // namespace tgfx
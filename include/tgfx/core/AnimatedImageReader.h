@@ -0,0 +1,107 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <deque>
+#include <mutex>
+#include "tgfx/core/AnimatedCodec.h"
+#include "tgfx/core/Bitmap.h"
+#include "tgfx/core/ImageBuffer.h"
+
+namespace tgfx {
+class ImageReader;
+class PixelBuffer;
+class Task;
+
+/**
+ * AnimatedImageReader plays an animated image decoded by an AnimatedCodec. The frames following the
+ * displayed one are decoded ahead on background threads into a bounded queue, so acquiring the
+ * next frame usually costs no more than a memory copy. All ImageBuffers acquired from the same
+ * reader share one texture, which is updated in place with only the area that changed between the
+ * frames. AnimatedImageReader is safe across threads.
+ */
+class AnimatedImageReader {
+ public:
+  /**
+   * Creates a new AnimatedImageReader for the given codec. The bufferCount specifies how many
+   * frames are decoded ahead of the displayed one, which bounds the extra memory used by the reader
+   * to bufferCount times the size of the canvas. Returns nullptr if the codec is nullptr.
+   */
+  static std::shared_ptr<AnimatedImageReader> MakeFrom(std::shared_ptr<AnimatedCodec> codec,
+                                                       int bufferCount = 3);
+
+  ~AnimatedImageReader();
+
+  /**
+   * Returns the codec that decodes the frames.
+   */
+  std::shared_ptr<AnimatedCodec> codec() const {
+    return _codec;
+  }
+
+  /**
+   * Returns the index of the frame displayed at the specified time in microseconds since the
+   * animation started. Once all loops of the animation have finished, the last frame stays on
+   * display.
+   */
+  int getFrameIndex(int64_t time) const;
+
+  /**
+   * Acquires an ImageBuffer capturing the frame displayed at the specified time in microseconds
+   * since the animation started. Returns nullptr if the frame is the same as the one returned by
+   * the previous call or if decoding fails. Usually, the previously acquired ImageBuffer expires
+   * after the newly acquired one is drawn.
+   */
+  std::shared_ptr<ImageBuffer> acquireNextBuffer(int64_t time);
+
+ private:
+  struct DecodedFrame {
+    int index = -1;
+    std::shared_ptr<PixelBuffer> pixels = nullptr;
+  };
+
+  std::mutex acquireLocker = {};
+  std::mutex locker = {};
+  std::shared_ptr<AnimatedCodec> _codec = nullptr;
+  std::vector<int64_t> frameEndTimes = {};
+  size_t bufferCount = 0;
+  std::deque<DecodedFrame> decodedFrames = {};
+  std::vector<std::shared_ptr<PixelBuffer>> freeBuffers = {};
+  std::shared_ptr<Task> decodeTask = nullptr;
+  int nextDecodeIndex = 0;
+  bool released = false;
+  Bitmap bitmap = {};
+  std::shared_ptr<ImageReader> reader = nullptr;
+  int displayedIndex = -1;
+
+  AnimatedImageReader(std::shared_ptr<AnimatedCodec> codec, int bufferCount);
+
+  bool findDecodedFrame(int index, DecodedFrame* frame);
+
+  std::shared_ptr<PixelBuffer> obtainBuffer();
+
+  bool decodeFrame(int index, PixelBuffer* pixels);
+
+  void scheduleDecoding();
+
+  void decodeAhead();
+
+  Rect getDirtyBounds(int index) const;
+};
+}  // namespace tgfx
@@ -29,7 +29,9 @@ namespace tgfx {
 class Data {
  public:
   /**
-   * Creates a Data object from the specified file path.
+   * Creates a Data object from the specified file path. Where supported, large local files are
+   * memory-mapped instead of being copied into a heap buffer, so the file should not be truncated
+   * or modified while the returned Data is alive.
    */
   static std::shared_ptr<Data> MakeFromFile(const std::string& filePath);
 
@@ -0,0 +1,87 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace tgfx {
+/**
+ * Statistics of the DecodedImageCache.
+ */
+struct DecodedImageCacheStats {
+  /**
+   * The number of decodes served from the cache.
+   */
+  uint64_t hitCount = 0;
+
+  /**
+   * The number of decodes that were not found in the cache.
+   */
+  uint64_t missCount = 0;
+
+  /**
+   * The number of decoded images purged to stay within the cache limit.
+   */
+  uint64_t evictionCount = 0;
+
+  /**
+   * The number of decoded images currently in the cache.
+   */
+  size_t entryCount = 0;
+
+  /**
+   * The estimated bytes of the decoded images currently in the cache.
+   */
+  size_t memoryUsage = 0;
+};
+
+/**
+ * DecodedImageCache keeps the decoded pixels of images generated from ImageGenerators, such as
+ * images created from encoded data or files, in a global least-recently-used cache. When the GPU
+ * texture of such an image has been purged from the resource cache, drawing it again uploads the
+ * cached pixels instead of decoding the image from scratch. The cache is disabled by default and
+ * all methods are thread-safe.
+ */
+class DecodedImageCache {
+ public:
+  /**
+   * Returns the maximum bytes of decoded pixels the cache can hold. The default value is 0, which
+   * means the cache is disabled.
+   */
+  static size_t GetCacheLimit();
+
+  /**
+   * Sets the maximum bytes of decoded pixels the cache can hold. Least recently used images are
+   * purged immediately if the current usage exceeds the new limit. Setting it to 0 disables the
+   * cache and releases all cached pixels.
+   */
+  static void SetCacheLimit(size_t bytesLimit);
+
+  /**
+   * Returns the current statistics of the cache.
+   */
+  static DecodedImageCacheStats GetStats();
+
+  /**
+   * Releases all cached pixels. The statistics counters are not reset.
+   */
+  static void PurgeAll();
+};
+}  // namespace tgfx
@@ -39,6 +39,7 @@ class ImageFilter;
 class FragmentProcessor;
 class TextureProxy;
 class Paint;
+class ImageCodec;
 
 /**
  * The Image class represents a two-dimensional array of pixels for drawing. These pixels can be
@@ -61,6 +62,29 @@ class Image {
    */
   static std::shared_ptr<Image> MakeFromEncoded(std::shared_ptr<Data> encodedData);
 
+  /**
+   * Creates an Image from the encoded data that is decoded into YUV planes instead of RGBA pixels
+   * if the codec supports it, for example, a JPEG image with 4:2:0 chroma subsampling. The planes
+   * are uploaded as a YUV texture and converted to RGB in the fragment shader, which halves the
+   * decoding time and upload bandwidth and takes much less texture memory. Otherwise, the returned
+   * Image behaves the same as one created by MakeFromEncoded(). Note that YUV images are not
+   * mipmapped and are always decoded at full resolution.
+   */
+  static std::shared_ptr<Image> MakeYUVFromEncoded(std::shared_ptr<Data> encodedData);
+
+  /**
+   * Creates a tiled Image from the specified ImageCodec, which is meant for very large images such
+   * as maps or scanned documents. When drawn directly, only the tiles visible in the current
+   * viewport are decoded from their own regions of the encoded image, at a resolution that matches
+   * the drawing scale, and cached as independent GPU textures. Images that cannot be decoded by
+   * region natively, such as interlaced PNG or CMYK JPEG images, still decode the entire image into
+   * a temporary buffer for each tile. When sampled as a whole, for example by image shaders or
+   * filters, the image is decoded at a reduced resolution of at most 4096 pixels on its longest
+   * side. The tileSize is the size of each tile texture in pixels and is at least 64. Note that the
+   * orientation of the codec is not applied. Returns nullptr if the codec is nullptr.
+   */
+  static std::shared_ptr<Image> MakeTiled(std::shared_ptr<ImageCodec> codec, int tileSize = 512);
+
   /**
    * Creates an Image from the platform-specific NativeImage. For example, the NativeImage could be
    * a jobject that represents a java Bitmap on the android platform or a CGImageRef on the apple
@@ -301,7 +325,8 @@ class Image {
     Rasterized,
     RGBAAA,
     Texture,
-    Subset
+    Subset,
+    Tiled
   };
 
   virtual Type type() const = 0;
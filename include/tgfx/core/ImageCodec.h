@@ -18,12 +18,17 @@
 
 #pragma once
 
+#include <vector>
 #include "tgfx/core/Data.h"
 #include "tgfx/core/EncodedFormat.h"
 #include "tgfx/core/ImageGenerator.h"
 #include "tgfx/core/ImageInfo.h"
 #include "tgfx/core/Orientation.h"
 #include "tgfx/core/Pixmap.h"
+#include "tgfx/core/Size.h"
+#include "tgfx/core/WriteStream.h"
+#include "tgfx/core/YUVColorSpace.h"
+#include "tgfx/core/YUVData.h"
 #include "tgfx/platform/NativeImage.h"
 
 namespace tgfx {
@@ -61,6 +66,23 @@ class ImageCodec : public ImageGenerator {
    */
   static std::shared_ptr<Data> Encode(const Pixmap& pixmap, EncodedFormat format, int quality);
 
+  /**
+   * Encodes the specified Pixmap into a binary image format and writes the encoded bytes to the
+   * stream as soon as the encoder produces them, instead of buffering the whole output in memory.
+   * Large images are encoded on multiple threads where the format allows it. Returns false if
+   * encoding fails, in which case part of the output may already have been written to the stream.
+   */
+  static bool Encode(const Pixmap& pixmap, EncodedFormat format, int quality,
+                     WriteStream* stream);
+
+  /**
+   * Encodes the specified Pixmaps concurrently on the task pool. Returns the encoded data of each
+   * Pixmap in the same order, with nullptr for the ones that fail to encode. The Pixmaps must stay
+   * valid until this method returns.
+   */
+  static std::vector<std::shared_ptr<Data>> Encode(const std::vector<const Pixmap*>& pixmaps,
+                                                   EncodedFormat format, int quality);
+
   /**
    * Returns the orientation of the target image.
    */
@@ -80,11 +102,57 @@ class ImageCodec : public ImageGenerator {
    */
   virtual bool readPixels(const ImageInfo& dstInfo, void* dstPixels) const = 0;
 
+  /**
+   * Returns the smallest dimensions the codec can decode the image to natively that are no smaller
+   * than the image dimensions multiplied by the given scale. The scale is clamped to (0, 1]. Codecs
+   * that do not support scaled decoding always return the full dimensions of the image.
+   */
+  virtual ISize getScaledDimensions(float scale) const;
+
+  /**
+   * Decodes the image at a reduced resolution into the given pixels. The dimensions of dstInfo must
+   * match the dimensions returned by getScaledDimensions() for some scale, otherwise false is
+   * returned. Decoding at a reduced size skips most of the decoding work, which is much cheaper
+   * than decoding at full resolution and downsampling afterward.
+   */
+  virtual bool readScaledPixels(const ImageInfo& dstInfo, void* dstPixels) const;
+
+  /**
+   * Decodes the image into Y, U, and V planes in the I420 format without converting them to RGB.
+   * The planes can be uploaded as a YUV texture and converted in the fragment shader, which is
+   * faster to decode and upload and takes less memory than RGBA pixels. If colorSpace is not
+   * nullptr, it is set to the YUVColorSpace of the returned planes. Returns nullptr if the codec
+   * cannot decode the image into I420 planes, for example, if it is not a JPEG image with 4:2:0
+   * chroma subsampling.
+   */
+  virtual std::shared_ptr<YUVData> readYUVData(YUVColorSpace* colorSpace = nullptr) const;
+
+  /**
+   * Decodes the specified region of the image into the given pixels. The region is rounded to
+   * integer coordinates and must lie within the bounds of the image, which are not affected by the
+   * orientation. The dimensions of dstInfo can be smaller than the region, in which case the region
+   * is downscaled to fit them, using the native scaled decoding of the codec where possible. Only
+   * the parts of the encoded image required by the region are decoded if the codec supports it,
+   * which keeps the memory usage low for very large images. Returns true if the decoding was
+   * successful.
+   */
+  bool readRegion(const Rect& region, const ImageInfo& dstInfo, void* dstPixels) const;
+
  protected:
   ImageCodec(int width, int height, Orientation orientation)
       : ImageGenerator(width, height), _orientation(orientation) {
   }
 
+  /**
+   * Decodes the image at the scaledSize, which is either the full size of the image or a size
+   * returned by getScaledDimensions(), and copies the given region of the scaled image into the
+   * pixels. The region has integer coordinates in the scaled image and the same dimensions as
+   * dstInfo. Returns false if the codec cannot decode the region at the scaledSize. The default
+   * implementation decodes the entire image and then copies the region out of it.
+   */
+  virtual bool onReadRegion(const ISize& scaledSize, const Rect& region, const ImageInfo& dstInfo,
+                            void* dstPixels) const;
+
   std::shared_ptr<ImageBuffer> onMakeBuffer(bool tryHardware) const override;
 
   virtual std::shared_ptr<Data> getEncodedData() const {
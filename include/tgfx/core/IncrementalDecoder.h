@@ -0,0 +1,151 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <mutex>
+#include "tgfx/core/Bitmap.h"
+#include "tgfx/core/Buffer.h"
+#include "tgfx/core/Data.h"
+#include "tgfx/core/ImageBuffer.h"
+#include "tgfx/core/Orientation.h"
+
+namespace tgfx {
+class ImageReader;
+
+/**
+ * IncrementalDecoder decodes an encoded image whose bytes arrive in chunks, such as an image being
+ * downloaded or read from slow storage. Each appended chunk is decoded as far as possible, so the
+ * image can be displayed before all of its bytes are available: baseline images fill in from the
+ * top, while progressive JPEGs, interlaced PNGs, and incremental WebPs are refined pass by pass.
+ * Call acquireNextBuffer() after appending data to read the latest decoded pixels. All buffers
+ * acquired from the same decoder share one texture, which is only updated with the rows decoded
+ * since the last upload. Supports PNG, JPEG, and WebP if their embedded decoders are enabled.
+ * IncrementalDecoder is safe across threads. Appended chunks are decoded one at a time, while other
+ * threads keep acquiring the pixels decoded so far.
+ */
+class IncrementalDecoder {
+ public:
+  /**
+   * Creates a new IncrementalDecoder for the image whose encoded bytes begin with the given chunk.
+   * The format of the image is detected from the chunk, which must contain at least the first 14
+   * bytes of the image. Returns nullptr if the format is not recognized or not supported.
+   */
+  static std::shared_ptr<IncrementalDecoder> MakeFrom(std::shared_ptr<Data> firstChunk);
+
+  virtual ~IncrementalDecoder() = default;
+
+  /**
+   * Returns the width of the image, or 0 if the header of the image has not been received yet.
+   */
+  int width() const;
+
+  /**
+   * Returns the height of the image, or 0 if the header of the image has not been received yet.
+   */
+  int height() const;
+
+  /**
+   * Returns the orientation stored in the metadata of the image, or Orientation::TopLeft if there
+   * is none or the header of the image has not been received yet. The width, height, and acquired
+   * buffers all describe the pixels as they are encoded, so draw the buffers through
+   * Image::makeOriented() with this orientation to display the image upright.
+   */
+  Orientation orientation() const;
+
+  /**
+   * Returns true if all the pixels of the image have been decoded.
+   */
+  bool isComplete() const;
+
+  /**
+   * Appends the next chunk of encoded bytes and decodes as much of the image as possible. Returns
+   * false if the encoded data is malformed, in which case all subsequent calls also fail, but the
+   * pixels decoded so far remain accessible.
+   */
+  bool append(std::shared_ptr<Data> chunk);
+
+  /**
+   * Acquires an ImageBuffer capturing the pixels decoded so far. Pixels that have not been decoded
+   * yet are transparent. Returns nullptr if the header of the image has not been received yet or if
+   * no new pixels have been decoded since the last call. Pass the returned buffer to
+   * Image::MakeFrom() to draw it. Usually, the previously acquired ImageBuffer expires after the
+   * newly acquired one is drawn.
+   */
+  std::shared_ptr<ImageBuffer> acquireNextBuffer();
+
+ protected:
+  IncrementalDecoder() = default;
+
+  /**
+   * Decodes the given bytes, which follow all the bytes passed to previous calls. Returns false if
+   * the encoded data is malformed.
+   */
+  virtual bool onAppend(const uint8_t* bytes, size_t length) = 0;
+
+  /**
+   * Allocates the pixels of the image once its header has been decoded. The pixels are stored in
+   * RGBA_8888 format with unpremultiplied alpha. Returns false if the dimensions are invalid or the
+   * allocation fails.
+   */
+  bool setDimensions(int width, int height);
+
+  /**
+   * Sets the orientation read from the metadata of the image.
+   */
+  void setOrientation(Orientation orientation);
+
+  /**
+   * Returns the address of the specified row of the image, or nullptr if the dimensions have not
+   * been set yet.
+   */
+  uint8_t* getRow(int row) const;
+
+  /**
+   * Returns the number of bytes per row of the image.
+   */
+  size_t rowBytes() const;
+
+  /**
+   * Marks the rows in [top, bottom) as changed. They will be copied to the acquired buffers after
+   * onAppend() returns.
+   */
+  void markRowsDecoded(int top, int bottom);
+
+  /**
+   * Marks all the pixels of the image as decoded.
+   */
+  void markComplete();
+
+ private:
+  mutable std::mutex locker = {};
+  std::mutex decodeLocker = {};
+  Buffer pixels = {};
+  ImageInfo info = {};
+  Orientation _orientation = Orientation::TopLeft;
+  Bitmap bitmap = {};
+  std::shared_ptr<ImageReader> reader = nullptr;
+  int dirtyTop = 0;
+  int dirtyBottom = 0;
+  bool hasNewPixels = false;
+  bool complete = false;
+  bool failed = false;
+
+  void flushDecodedRows();
+};
+}  // namespace tgfx
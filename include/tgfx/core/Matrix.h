@@ -676,6 +676,23 @@ class Matrix {
     return dst;
   }
 
+  /**
+   * Sets each Rect in dst to the bounds of the corners of the corresponding Rect in src mapped by
+   * Matrix. This is faster than calling mapRect() for each Rect. src and dst may point to the same
+   * storage.
+   * @param dst    storage for mapped Rect array
+   * @param src    Rect array to transform
+   * @param count  number of Rects to transform
+   */
+  void mapRects(Rect dst[], const Rect src[], int count) const;
+
+  /**
+   * Sets each Rect in rects to the bounds of its corners mapped by Matrix.
+   */
+  void mapRects(Rect rects[], int count) const {
+    mapRects(rects, rects, count);
+  }
+
   /** Compares a and b; returns true if a and b are numerically equal. Returns true even if sign
    * of zero values are different. Returns false if either Matrix contains NaN, even if the other
    * Matrix also contains NaN.
@@ -176,6 +176,9 @@ class Shape {
   friend class StrokeShape;
   friend class MatrixShape;
   friend class ShapeDrawOp;
+  friend class ConvexPathDrawOp;
+  friend class StrokeDrawOp;
+  friend class TessellatedPathDrawOp;
   friend class ProxyProvider;
   friend class Canvas;
 };
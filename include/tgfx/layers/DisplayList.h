@@ -18,10 +18,33 @@
 
 #pragma once
 
+#include "tgfx/core/Clock.h"
 #include "tgfx/core/Surface.h"
 #include "tgfx/layers/Layer.h"
 
 namespace tgfx {
+class TileCache;
+
+/**
+ * Defines the ways a DisplayList renders its layers onto a surface.
+ */
+enum class RenderMode {
+  /**
+   * Renders the whole layer tree directly onto the target surface.
+   */
+  Direct,
+  /**
+   * Renders the layer tree into a grid of fixed-size tiles that are cached between frames and then
+   * composited onto the target surface. Only the visible tiles that are missing from the cache are
+   * rendered, so scrolling a large display list reuses the tiles drawn in previous frames. A change
+   * to the layer tree only invalidates the tiles under the changed layers, while a change to the
+   * zoom scale invalidates all tiles. Offscreen passes without filters are clipped to the tile
+   * being rendered, but layers with filters and rasterized layers still allocate render targets
+   * that cover their full bounds.
+   */
+  Tiled
+};
+
 /**
  * DisplayList represents a collection of layers can be drawn to a Surface. Note: All layers in the
  * display list are not thread-safe and should only be accessed from a single thread.
@@ -30,7 +53,7 @@ class DisplayList {
  public:
   DisplayList();
 
-  virtual ~DisplayList() = default;
+  virtual ~DisplayList();
 
   /**
    * Returns the root layer of the display list. Note: The root layer cannot be added to another
@@ -48,9 +71,101 @@ class DisplayList {
    */
   bool render(Surface* surface, bool replaceAll = true);
 
+  /**
+   * Returns true if any layer in the display list has running animations. While this is true, the
+   * display list should be rendered on every frame to advance the animations.
+   */
+  bool hasAnimations() const;
+
+  /**
+   * Returns the time in microseconds at which layer animations are evaluated during render(). If
+   * the value is negative, the elapsed time of the internal clock of the display list is used. The
+   * default value is -1.
+   */
+  int64_t animationTime() const {
+    return _animationTime;
+  }
+
+  /**
+   * Sets the time in microseconds at which layer animations are evaluated during render(). This is
+   * useful to synchronize animations with an external timeline, such as the vsync timestamp.
+   */
+  void setAnimationTime(int64_t time);
+
+  /**
+   * Returns the render mode of the display list. The default value is RenderMode::Direct.
+   */
+  RenderMode renderMode() const {
+    return _renderMode;
+  }
+
+  /**
+   * Sets the render mode of the display list.
+   */
+  void setRenderMode(RenderMode value);
+
+  /**
+   * Returns the width and height in pixels of the tiles used in RenderMode::Tiled. The default
+   * value is 256.
+   */
+  int tileSize() const {
+    return _tileSize;
+  }
+
+  /**
+   * Sets the width and height in pixels of the tiles used in RenderMode::Tiled. Values less than 16
+   * are clamped to 16.
+   */
+  void setTileSize(int value);
+
+  /**
+   * Returns the scale factor applied to the layer tree when rendering it onto the surface. The
+   * default value is 1.0.
+   */
+  float zoomScale() const {
+    return _zoomScale;
+  }
+
+  /**
+   * Sets the scale factor applied to the layer tree when rendering it onto the surface.
+   */
+  void setZoomScale(float value);
+
+  /**
+   * Returns the offset in pixels applied to the layer tree after the zoom scale when rendering it
+   * onto the surface. The default value is (0, 0).
+   */
+  const Point& contentOffset() const {
+    return _contentOffset;
+  }
+
+  /**
+   * Sets the offset in pixels applied to the layer tree after the zoom scale when rendering it onto
+   * the surface. In RenderMode::Tiled, the offset is rounded to whole pixels so that the tiles are
+   * composited without resampling.
+   */
+  void setContentOffset(const Point& value);
+
  private:
   std::shared_ptr<Layer> _root = nullptr;
+  Clock clock = {};
+  int64_t _animationTime = -1;
+  RenderMode _renderMode = RenderMode::Direct;
+  int _tileSize = 256;
+  float _zoomScale = 1.0f;
+  Point _contentOffset = Point::Zero();
+  bool viewportChanged = false;
+  std::unique_ptr<TileCache> tileCache = nullptr;
+  uint32_t tileContextID = 0u;
+  uint64_t frameIndex = 0u;
   uint32_t surfaceContentVersion = 0u;
   uint32_t surfaceID = 0u;
+
+  void renderTiles(Surface* surface);
+
+  void collectDirtyRects(Layer* layer, const Matrix& matrix, bool parentDirty,
+                         std::vector<Rect>* dirtyRects);
+
+  std::shared_ptr<Image> renderTile(Context* context, uint32_t renderFlags, int tileX, int tileY);
 };
 }  // namespace tgfx
@@ -24,6 +24,7 @@
 #include "tgfx/core/Matrix.h"
 #include "tgfx/layers/LayerContent.h"
 #include "tgfx/layers/LayerType.h"
+#include "tgfx/layers/animations/Animation.h"
 #include "tgfx/layers/filters/LayerFilter.h"
 #include "tgfx/layers/layerstyles/LayerStyle.h"
 
@@ -31,6 +32,7 @@ namespace tgfx {
 
 class DisplayList;
 class DrawArgs;
+class LayerAnimator;
 struct LayerStyleSource;
 
 /**
@@ -304,6 +306,32 @@ class Layer {
    */
   void setScrollRect(const Rect& rect);
 
+  /**
+   * Returns the list of animations currently attached to the layer. Finished animations are removed
+   * from the list automatically.
+   */
+  std::vector<std::shared_ptr<Animation>> animations() const;
+
+  /**
+   * Adds an animation to the layer. The animation starts the next time the display list containing
+   * the layer is rendered, and it is evaluated at render time from the clock of the display list.
+   * If the layer already has an animation for the same property, the existing animation is
+   * replaced. An animation instance can be attached to multiple layers, each of which keeps its own
+   * timing.
+   */
+  void addAnimation(std::shared_ptr<Animation> animation);
+
+  /**
+   * Removes the given animation from the layer. The layer property reverts to the value set by the
+   * caller.
+   */
+  void removeAnimation(std::shared_ptr<Animation> animation);
+
+  /**
+   * Removes all animations from the layer.
+   */
+  void removeAllAnimations();
+
   /**
    * Returns the root layer of the calling layer. A DisplayList has only one root layer. If a layer
    * is not added to a display list, its root property is set to nullptr.
@@ -546,6 +574,14 @@ class Layer {
 
   Matrix getMatrixWithScrollRect() const;
 
+  float getPresentationAlpha() const;
+
+  Matrix getPresentationMatrix() const;
+
+  void invalidateAnimations();
+
+  bool updateAnimations(int64_t time);
+
   LayerContent* getContent();
 
   Paint getLayerPaint(float alpha, BlendMode blendMode = BlendMode::SrcOver) const;
@@ -559,6 +595,16 @@ class Layer {
 
   void drawLayer(const DrawArgs& args, Canvas* canvas, float alpha, BlendMode blendMode);
 
+  bool requiresOffscreen(const DrawArgs& args, float alpha, BlendMode blendMode);
+
+  bool drawsAsSingleImage(const DrawArgs& args) const;
+
+  bool hasChildrenToDraw() const;
+
+  bool canDrawWithoutOverlap(const DrawArgs& args);
+
+  void invalidateOverlapAnalysis();
+
   void drawOffscreen(const DrawArgs& args, Canvas* canvas, float alpha, BlendMode blendMode);
 
   void drawDirectly(const DrawArgs& args, Canvas* canvas, float alpha);
@@ -586,6 +632,10 @@ class Layer {
     bool allowsEdgeAntialiasing : 1;
     bool allowsGroupOpacity : 1;
     bool excludeChildEffectsInLayerStyle : 1;
+    bool hasAnimations : 1;        // the layer or any of its descendants has animations
+    bool overlapAnalyzed : 1;      // whether drawsWithoutOverlap holds an up-to-date result
+    bool drawsWithoutOverlap : 1;  // the content and children can be drawn with a folded alpha
+    bool selfDirty : 1;            // the whole area of the layer needs to be redrawn
   } bitFields = {};
   std::string _name;
   float _alpha = 1.0f;
@@ -602,6 +652,11 @@ class Layer {
   std::unique_ptr<LayerContent> rasterizedContent = nullptr;
   std::vector<std::shared_ptr<Layer>> _children = {};
   std::vector<std::shared_ptr<LayerStyle>> _layerStyles = {};
+  std::shared_ptr<LayerAnimator> animator = nullptr;
+  // The bounds of the layer in the display list coordinates when it was last rendered in tiles.
+  Rect renderBounds = Rect::MakeEmpty();
+  // The union of the render bounds of the children removed since the last tiled render.
+  Rect removedChildBounds = Rect::MakeEmpty();
 
   friend class DisplayList;
   friend class LayerProperty;
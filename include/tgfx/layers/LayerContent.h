@@ -44,6 +44,15 @@ class LayerContent {
    */
   virtual void draw(Canvas* canvas, const Paint& paint) const = 0;
 
+  /**
+   * Returns true if the content is drawn by a single draw call that uses the alpha and blend mode
+   * of the given paint. Layers use it to apply group opacity and blend modes directly to the
+   * content instead of compositing it through an offscreen image. The default value is false.
+   */
+  virtual bool isSingleDraw() const {
+    return false;
+  }
+
   /**
     * Checks if the layer content overlaps or intersects with the specified point (localX, localY).
     * The localX and localY coordinates are in the layer's local coordinate space. If the
@@ -0,0 +1,158 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+namespace tgfx {
+/**
+ * Defines the layer properties that can be driven by an Animation.
+ */
+enum class AnimationProperty {
+  /**
+   * The alpha transparency of the layer.
+   */
+  Alpha,
+  /**
+   * The x coordinate of the layer's position.
+   */
+  PositionX,
+  /**
+   * The y coordinate of the layer's position.
+   */
+  PositionY,
+  /**
+   * An additional horizontal scale factor applied in the layer's local coordinate space, on top of
+   * the layer's matrix. The unanimated value is 1.
+   */
+  ScaleX,
+  /**
+   * An additional vertical scale factor applied in the layer's local coordinate space, on top of
+   * the layer's matrix. The unanimated value is 1.
+   */
+  ScaleY,
+  /**
+   * An additional rotation in degrees applied in the layer's local coordinate space, on top of the
+   * layer's matrix. The unanimated value is 0.
+   */
+  Rotation,
+  /**
+   * The strokeStart property of a ShapeLayer. Ignored by other layer types.
+   */
+  StrokeStart,
+  /**
+   * The strokeEnd property of a ShapeLayer. Ignored by other layer types.
+   */
+  StrokeEnd
+};
+
+/**
+ * Animation is the base class for animations that can be added to a Layer. Animations are
+ * evaluated by the DisplayList at render time, so no per-frame work is required from the caller.
+ * Animations of alpha and transform properties (Alpha, PositionX, PositionY, ScaleX, ScaleY and
+ * Rotation) only change how the layer is composited: they do not invalidate the layer content, and
+ * the rasterized caches of the layer are reused on every frame. Their animated values only affect
+ * rendering, the getters of the layer and methods like getBounds() and hitTestPoint() keep using
+ * the values set by the caller. Other properties are applied to the layer directly on each frame.
+ * When an animation finishes, its final value is assigned to the layer property, and the animation
+ * is removed from the layer. All times are measured in microseconds.
+ */
+class Animation {
+ public:
+  virtual ~Animation() = default;
+
+  /**
+   * Returns the layer property driven by the animation.
+   */
+  AnimationProperty property() const {
+    return _property;
+  }
+
+  /**
+   * Returns the duration of a single iteration of the animation in microseconds.
+   */
+  virtual int64_t duration() const {
+    return _duration;
+  }
+
+  /**
+   * Sets the duration of a single iteration of the animation in microseconds.
+   */
+  void setDuration(int64_t value);
+
+  /**
+   * Returns the time in microseconds to wait before the animation starts, measured from the first
+   * time the animation is evaluated after being added to a layer. The default value is 0.
+   */
+  int64_t delay() const {
+    return _delay;
+  }
+
+  /**
+   * Sets the time in microseconds to wait before the animation starts.
+   */
+  void setDelay(int64_t value);
+
+  /**
+   * Returns the number of times the animation repeats. It may be fractional, and a value of
+   * INFINITY makes the animation repeat forever. The default value is 1.
+   */
+  float repeatCount() const {
+    return _repeatCount;
+  }
+
+  /**
+   * Sets the number of times the animation repeats.
+   */
+  void setRepeatCount(float value);
+
+  /**
+   * Returns true if the animation plays backward after playing forward. Each backward pass counts
+   * as a separate iteration. The default value is false.
+   */
+  bool autoreverses() const {
+    return _autoreverses;
+  }
+
+  /**
+   * Sets whether the animation plays backward after playing forward.
+   */
+  void setAutoreverses(bool value);
+
+ protected:
+  explicit Animation(AnimationProperty property) : _property(property) {
+  }
+
+  /**
+   * Returns the animated value at the given fraction of a single iteration. The fraction is in the
+   * range [0, 1].
+   */
+  virtual float getValue(float fraction) const = 0;
+
+ private:
+  AnimationProperty _property = AnimationProperty::Alpha;
+  int64_t _duration = 250000;
+  int64_t _delay = 0;
+  float _repeatCount = 1.0f;
+  bool _autoreverses = false;
+
+  friend class LayerAnimator;
+};
+}  // namespace tgfx
@@ -0,0 +1,96 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <vector>
+#include "tgfx/layers/animations/Animation.h"
+#include "tgfx/layers/animations/TimingFunction.h"
+
+namespace tgfx {
+/**
+ * KeyframeAnimation interpolates a layer property through a list of keyframe values. Each pair of
+ * adjacent keyframes forms a segment, and the pacing of each segment is defined by a
+ * TimingFunction.
+ */
+class KeyframeAnimation : public Animation {
+ public:
+  /**
+   * Creates a KeyframeAnimation that animates the property from one value to another.
+   */
+  static std::shared_ptr<KeyframeAnimation> Make(AnimationProperty property, float fromValue,
+                                                 float toValue);
+
+  /**
+   * Creates a KeyframeAnimation that animates the property through the given values. Returns
+   * nullptr if the values are empty.
+   * @param property The layer property to animate.
+   * @param values The keyframe values.
+   * @param keyTimes The normalized times of the keyframes in the range [0, 1], in ascending order.
+   * If empty or its size does not match the size of the values, the keyframes are distributed
+   * evenly over the duration.
+   */
+  static std::shared_ptr<KeyframeAnimation> Make(AnimationProperty property,
+                                                 std::vector<float> values,
+                                                 std::vector<float> keyTimes = {});
+
+  /**
+   * Returns the keyframe values of the animation.
+   */
+  const std::vector<float>& values() const {
+    return _values;
+  }
+
+  /**
+   * Returns the normalized times of the keyframes.
+   */
+  const std::vector<float>& keyTimes() const {
+    return _keyTimes;
+  }
+
+  /**
+   * Returns the timing functions applied to the segments between keyframes. If the list has fewer
+   * entries than segments, the last entry is used for the remaining segments. The default value is
+   * an empty list, which paces every segment linearly.
+   */
+  const std::vector<std::shared_ptr<TimingFunction>>& timingFunctions() const {
+    return _timingFunctions;
+  }
+
+  /**
+   * Sets the timing functions applied to the segments between keyframes.
+   */
+  void setTimingFunctions(std::vector<std::shared_ptr<TimingFunction>> value);
+
+  /**
+   * Replaces the timing functions with a single one that is applied to every segment.
+   */
+  void setTimingFunction(std::shared_ptr<TimingFunction> value);
+
+ protected:
+  float getValue(float fraction) const override;
+
+ private:
+  std::vector<float> _values = {};
+  std::vector<float> _keyTimes = {};
+  std::vector<std::shared_ptr<TimingFunction>> _timingFunctions = {};
+
+  KeyframeAnimation(AnimationProperty property, std::vector<float> values,
+                    std::vector<float> keyTimes);
+};
+}  // namespace tgfx
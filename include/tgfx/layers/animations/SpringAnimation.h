@@ -0,0 +1,120 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "tgfx/layers/animations/Animation.h"
+
+namespace tgfx {
+/**
+ * SpringAnimation animates a layer property from one value to another using the motion of a damped
+ * spring attached to the target value. The duration of the animation is derived from the spring
+ * parameters as the time needed for the motion to settle, so setDuration() has no effect.
+ */
+class SpringAnimation : public Animation {
+ public:
+  /**
+   * Creates a SpringAnimation that animates the property from one value to another.
+   */
+  static std::shared_ptr<SpringAnimation> Make(AnimationProperty property, float fromValue,
+                                               float toValue);
+
+  /**
+   * Returns the value the spring starts from.
+   */
+  float fromValue() const {
+    return _fromValue;
+  }
+
+  /**
+   * Returns the value the spring settles at.
+   */
+  float toValue() const {
+    return _toValue;
+  }
+
+  /**
+   * Returns the mass of the object attached to the spring. The default value is 1.
+   */
+  float mass() const {
+    return _mass;
+  }
+
+  /**
+   * Sets the mass of the object attached to the spring. Non-positive values are ignored.
+   */
+  void setMass(float value);
+
+  /**
+   * Returns the stiffness coefficient of the spring. The default value is 100.
+   */
+  float stiffness() const {
+    return _stiffness;
+  }
+
+  /**
+   * Sets the stiffness coefficient of the spring. Non-positive values are ignored.
+   */
+  void setStiffness(float value);
+
+  /**
+   * Returns the damping coefficient of the spring. The default value is 10.
+   */
+  float damping() const {
+    return _damping;
+  }
+
+  /**
+   * Sets the damping coefficient of the spring. Negative values are ignored.
+   */
+  void setDamping(float value);
+
+  /**
+   * Returns the initial velocity of the object attached to the spring, in property units per
+   * second. The default value is 0.
+   */
+  float initialVelocity() const {
+    return _initialVelocity;
+  }
+
+  /**
+   * Sets the initial velocity of the object attached to the spring.
+   */
+  void setInitialVelocity(float value);
+
+  /**
+   * Returns the estimated time in microseconds for the spring to settle at the target value.
+   */
+  int64_t duration() const override;
+
+ protected:
+  float getValue(float fraction) const override;
+
+ private:
+  float _fromValue = 0.0f;
+  float _toValue = 0.0f;
+  float _mass = 1.0f;
+  float _stiffness = 100.0f;
+  float _damping = 10.0f;
+  float _initialVelocity = 0.0f;
+
+  SpringAnimation(AnimationProperty property, float fromValue, float toValue);
+
+  float getDisplacement(float seconds) const;
+};
+}  // namespace tgfx
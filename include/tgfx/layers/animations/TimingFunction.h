@@ -0,0 +1,68 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <memory>
+
+namespace tgfx {
+/**
+ * TimingFunction defines the pacing of an animation as a curve that maps the linear progress of an
+ * animation to the eased progress used to interpolate the animated values. Both the input and the
+ * output progress are normalized to the range [0, 1].
+ */
+class TimingFunction {
+ public:
+  /**
+   * Returns a TimingFunction that paces the animation evenly over its duration.
+   */
+  static std::shared_ptr<TimingFunction> Linear();
+
+  /**
+   * Returns a TimingFunction that starts slowly and then speeds up.
+   */
+  static std::shared_ptr<TimingFunction> EaseIn();
+
+  /**
+   * Returns a TimingFunction that starts quickly and then slows down.
+   */
+  static std::shared_ptr<TimingFunction> EaseOut();
+
+  /**
+   * Returns a TimingFunction that starts slowly, speeds up in the middle, and then slows down.
+   */
+  static std::shared_ptr<TimingFunction> EaseInOut();
+
+  /**
+   * Creates a TimingFunction defined by a cubic Bézier curve, whose end points are fixed at (0, 0)
+   * and (1, 1). The x coordinates of the control points are clamped to the range [0, 1].
+   * @param x1 The x coordinate of the first control point.
+   * @param y1 The y coordinate of the first control point.
+   * @param x2 The x coordinate of the second control point.
+   * @param y2 The y coordinate of the second control point.
+   */
+  static std::shared_ptr<TimingFunction> MakeCubicBezier(float x1, float y1, float x2, float y2);
+
+  virtual ~TimingFunction() = default;
+
+  /**
+   * Returns the eased progress for the given linear progress in the range [0, 1].
+   */
+  virtual float getValue(float progress) const = 0;
+};
+}  // namespace tgfx
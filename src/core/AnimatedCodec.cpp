@@ -0,0 +1,81 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "tgfx/core/AnimatedCodec.h"
+#include "tgfx/core/Pixmap.h"
+
+#ifdef TGFX_USE_WEBP_DECODE
+#include "core/codecs/webp/AnimatedWebpCodec.h"
+#endif
+
+#ifdef TGFX_USE_PNG_DECODE
+#include "core/codecs/png/ApngCodec.h"
+#endif
+
+namespace tgfx {
+std::shared_ptr<AnimatedCodec> AnimatedCodec::MakeFrom(const std::string& filePath) {
+  return MakeFrom(Data::MakeFromFile(filePath));
+}
+
+std::shared_ptr<AnimatedCodec> AnimatedCodec::MakeFrom(std::shared_ptr<Data> imageBytes) {
+  if (imageBytes == nullptr || imageBytes->size() < 14) {
+    return nullptr;
+  }
+  std::shared_ptr<AnimatedCodec> codec = nullptr;
+#ifdef TGFX_USE_WEBP_DECODE
+  if (WebpCodec::IsWebp(imageBytes)) {
+    codec = AnimatedWebpCodec::MakeFrom(imageBytes);
+  }
+#endif
+
+#ifdef TGFX_USE_PNG_DECODE
+  if (codec == nullptr && PngCodec::IsPng(imageBytes)) {
+    codec = ApngCodec::MakeFrom(imageBytes);
+  }
+#endif
+  if (codec && !ImageInfo::IsValidSize(codec->width(), codec->height())) {
+    codec = nullptr;
+  }
+  return codec;
+}
+
+AnimatedCodec::AnimatedCodec(int width, int height, std::vector<FrameInfo> frames, int loopCount)
+    : _width(width), _height(height), frames(std::move(frames)), _loopCount(loopCount) {
+}
+
+int64_t AnimatedCodec::duration() const {
+  int64_t total = 0;
+  for (auto& frame : frames) {
+    total += frame.duration;
+  }
+  return total;
+}
+
+bool AnimatedCodec::readFrame(int index, const ImageInfo& dstInfo, void* dstPixels) {
+  if (index < 0 || index >= frameCount() || dstPixels == nullptr || dstInfo.isEmpty()) {
+    return false;
+  }
+  std::lock_guard<std::mutex> autoLock(locker);
+  auto pixels = onDecodeFrame(index);
+  if (pixels == nullptr) {
+    return false;
+  }
+  auto info = ImageInfo::Make(_width, _height, ColorType::RGBA_8888, AlphaType::Premultiplied);
+  return Pixmap(info, pixels).readPixels(dstInfo, dstPixels);
+}
+}  // namespace tgfx
@@ -0,0 +1,231 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "tgfx/core/AnimatedImageReader.h"
+#include <algorithm>
+#include "core/PixelBuffer.h"
+#include "tgfx/core/ImageReader.h"
+#include "tgfx/core/Task.h"
+
+namespace tgfx {
+std::shared_ptr<AnimatedImageReader> AnimatedImageReader::MakeFrom(
+    std::shared_ptr<AnimatedCodec> codec, int bufferCount) {
+  if (codec == nullptr || codec->frameCount() == 0) {
+    return nullptr;
+  }
+  auto reader = std::shared_ptr<AnimatedImageReader>(
+      new AnimatedImageReader(std::move(codec), std::max(bufferCount, 1)));
+  if (reader->reader == nullptr) {
+    return nullptr;
+  }
+  return reader;
+}
+
+AnimatedImageReader::AnimatedImageReader(std::shared_ptr<AnimatedCodec> codec, int bufferCount)
+    : _codec(std::move(codec)), bufferCount(static_cast<size_t>(bufferCount)) {
+  int64_t endTime = 0;
+  for (int i = 0; i < _codec->frameCount(); i++) {
+    endTime += _codec->getFrameInfo(i).duration;
+    frameEndTimes.push_back(endTime);
+  }
+  // Frames are copied into the bitmap one dirty area at a time, which suits raster memory better
+  // than hardware buffers.
+  if (bitmap.allocPixels(_codec->width(), _codec->height(), false, false)) {
+    reader = ImageReader::MakeFrom(bitmap);
+  }
+}
+
+AnimatedImageReader::~AnimatedImageReader() {
+  std::shared_ptr<Task> task = nullptr;
+  {
+    std::lock_guard<std::mutex> autoLock(locker);
+    released = true;
+    task = decodeTask;
+  }
+  if (task != nullptr) {
+    task->cancel();
+    task->wait();
+  }
+}
+
+int AnimatedImageReader::getFrameIndex(int64_t time) const {
+  auto totalDuration = frameEndTimes.back();
+  auto lastIndex = static_cast<int>(frameEndTimes.size()) - 1;
+  if (time <= 0 || totalDuration <= 0) {
+    return 0;
+  }
+  auto loopCount = _codec->loopCount();
+  if (loopCount > 0 && time / totalDuration >= loopCount) {
+    return lastIndex;
+  }
+  auto loopTime = time % totalDuration;
+  auto index = std::upper_bound(frameEndTimes.begin(), frameEndTimes.end(), loopTime) -
+               frameEndTimes.begin();
+  return std::min(static_cast<int>(index), lastIndex);
+}
+
+std::shared_ptr<ImageBuffer> AnimatedImageReader::acquireNextBuffer(int64_t time) {
+  std::lock_guard<std::mutex> acquireLock(acquireLocker);
+  auto index = getFrameIndex(time);
+  if (index == displayedIndex) {
+    return nullptr;
+  }
+  DecodedFrame frame = {};
+  if (!findDecodedFrame(index, &frame)) {
+    // The frame may be the one being decoded ahead right now.
+    std::shared_ptr<Task> task = nullptr;
+    {
+      std::lock_guard<std::mutex> autoLock(locker);
+      task = decodeTask;
+    }
+    if (task != nullptr) {
+      task->wait();
+    }
+    if (!findDecodedFrame(index, &frame)) {
+      // The animation has jumped to a frame that is not queued, so the queue is dropped and the
+      // frame is decoded directly.
+      {
+        std::lock_guard<std::mutex> autoLock(locker);
+        for (auto& decodedFrame : decodedFrames) {
+          freeBuffers.push_back(std::move(decodedFrame.pixels));
+        }
+        decodedFrames.clear();
+        nextDecodeIndex = (index + 1) % _codec->frameCount();
+      }
+      frame.pixels = obtainBuffer();
+      if (frame.pixels == nullptr || !decodeFrame(index, frame.pixels.get())) {
+        return nullptr;
+      }
+      frame.index = index;
+    }
+  }
+  auto dirtyBounds = getDirtyBounds(index);
+  auto left = static_cast<int>(dirtyBounds.left);
+  auto top = static_cast<int>(dirtyBounds.top);
+  auto& info = frame.pixels->info();
+  auto dirtyInfo = info.makeWH(static_cast<int>(dirtyBounds.width()),
+                               static_cast<int>(dirtyBounds.height()));
+  // Only the area that differs from the displayed frame is copied and uploaded to the texture.
+  auto pixels = frame.pixels->lockPixels();
+  auto success = pixels != nullptr &&
+                 bitmap.writePixels(dirtyInfo, info.computeOffset(pixels, left, top), left, top);
+  frame.pixels->unlockPixels();
+  {
+    std::lock_guard<std::mutex> autoLock(locker);
+    freeBuffers.push_back(std::move(frame.pixels));
+  }
+  if (!success) {
+    displayedIndex = -1;
+    return nullptr;
+  }
+  displayedIndex = index;
+  scheduleDecoding();
+  return reader->acquireNextBuffer();
+}
+
+bool AnimatedImageReader::findDecodedFrame(int index, DecodedFrame* frame) {
+  std::lock_guard<std::mutex> autoLock(locker);
+  auto result = std::find_if(decodedFrames.begin(), decodedFrames.end(),
+                             [index](const DecodedFrame& item) { return item.index == index; });
+  if (result == decodedFrames.end()) {
+    return false;
+  }
+  // The frames queued before the requested one have been skipped.
+  while (decodedFrames.front().index != index) {
+    freeBuffers.push_back(std::move(decodedFrames.front().pixels));
+    decodedFrames.pop_front();
+  }
+  *frame = std::move(decodedFrames.front());
+  decodedFrames.pop_front();
+  return true;
+}
+
+void AnimatedImageReader::scheduleDecoding() {
+  {
+    std::lock_guard<std::mutex> autoLock(locker);
+    if (released || decodedFrames.size() >= bufferCount ||
+        (decodeTask != nullptr && decodeTask->executing())) {
+      return;
+    }
+  }
+  // The task may run on the calling thread if no worker thread is available, so it must be
+  // started without holding the lock.
+  auto task = Task::Run([this]() { decodeAhead(); });
+  std::lock_guard<std::mutex> autoLock(locker);
+  decodeTask = task;
+}
+
+void AnimatedImageReader::decodeAhead() {
+  while (true) {
+    int index = 0;
+    {
+      std::lock_guard<std::mutex> autoLock(locker);
+      if (released || decodedFrames.size() >= bufferCount) {
+        return;
+      }
+      index = nextDecodeIndex;
+    }
+    auto pixels = obtainBuffer();
+    if (pixels == nullptr || !decodeFrame(index, pixels.get())) {
+      return;
+    }
+    std::lock_guard<std::mutex> autoLock(locker);
+    if (nextDecodeIndex != index) {
+      // The queue was dropped by a seek while this frame was being decoded.
+      freeBuffers.push_back(std::move(pixels));
+      continue;
+    }
+    decodedFrames.push_back({index, std::move(pixels)});
+    nextDecodeIndex = (index + 1) % _codec->frameCount();
+  }
+}
+
+std::shared_ptr<PixelBuffer> AnimatedImageReader::obtainBuffer() {
+  {
+    std::lock_guard<std::mutex> autoLock(locker);
+    if (!freeBuffers.empty()) {
+      auto pixels = std::move(freeBuffers.back());
+      freeBuffers.pop_back();
+      return pixels;
+    }
+  }
+  return PixelBuffer::Make(bitmap.width(), bitmap.height(), false, false);
+}
+
+bool AnimatedImageReader::decodeFrame(int index, PixelBuffer* pixels) {
+  auto dstPixels = pixels->lockPixels();
+  if (dstPixels == nullptr) {
+    return false;
+  }
+  auto success = _codec->readFrame(index, pixels->info(), dstPixels);
+  pixels->unlockPixels();
+  return success;
+}
+
+Rect AnimatedImageReader::getDirtyBounds(int index) const {
+  if (displayedIndex < 0 || index != displayedIndex + 1) {
+    return Rect::MakeWH(bitmap.width(), bitmap.height());
+  }
+  auto& previous = _codec->getFrameInfo(displayedIndex);
+  auto bounds = _codec->getFrameInfo(index).bounds;
+  if (previous.disposal != FrameDisposal::None) {
+    bounds.join(previous.bounds);
+  }
+  return bounds;
+}
+}  // namespace tgfx
@@ -0,0 +1,102 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "ContourMeasures.h"
+
+namespace tgfx {
+using namespace pk;
+
+ContourMeasures::ContourMeasures(const SkPath& path) {
+  SkPath::Iter iter(path, false);
+  SkPoint points[4];
+  SkPath::Verb verb;
+  while ((verb = iter.next(points)) != SkPath::kDone_Verb) {
+    if (verb == SkPath::kMove_Verb || contours.empty()) {
+      contours.emplace_back();
+      contours.back().setFillType(path.getFillType());
+    }
+    auto& contour = contours.back();
+    switch (verb) {
+      case SkPath::kMove_Verb:
+        contour.moveTo(points[0]);
+        break;
+      case SkPath::kLine_Verb:
+        contour.lineTo(points[1]);
+        break;
+      case SkPath::kQuad_Verb:
+        contour.quadTo(points[1], points[2]);
+        break;
+      case SkPath::kConic_Verb:
+        contour.conicTo(points[1], points[2], iter.conicWeight());
+        break;
+      case SkPath::kCubic_Verb:
+        contour.cubicTo(points[1], points[2], points[3]);
+        break;
+      case SkPath::kClose_Verb:
+        contour.close();
+        break;
+      default:
+        break;
+    }
+  }
+  measures.resize(contours.size());
+}
+
+SkPathMeasure* ContourMeasures::getMeasure(size_t index) {
+  auto& measure = measures[index];
+  if (measure == nullptr) {
+    measure = std::make_unique<SkPathMeasure>(contours[index], false);
+  }
+  return measure.get();
+}
+
+float ContourMeasures::getLength(size_t index) {
+  if (index >= contours.size()) {
+    return 0;
+  }
+  std::lock_guard<std::mutex> autoLock(locker);
+  return getMeasure(index)->getLength();
+}
+
+bool ContourMeasures::isClosed(size_t index) {
+  if (index >= contours.size()) {
+    return false;
+  }
+  std::lock_guard<std::mutex> autoLock(locker);
+  return getMeasure(index)->isClosed();
+}
+
+bool ContourMeasures::getSegment(size_t index, float startD, float stopD, SkPath* result,
+                                 bool startWithMoveTo) {
+  if (index >= contours.size()) {
+    return false;
+  }
+  std::lock_guard<std::mutex> autoLock(locker);
+  return getMeasure(index)->getSegment(startD, stopD, result, startWithMoveTo);
+}
+
+size_t ContourMeasures::firstContour() {
+  std::lock_guard<std::mutex> autoLock(locker);
+  for (size_t i = 0; i < contours.size(); i++) {
+    if (getMeasure(i)->getLength() > 0) {
+      return i;
+    }
+  }
+  return contours.size();
+}
+}  // namespace tgfx
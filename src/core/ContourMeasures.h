@@ -0,0 +1,75 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "pathkit.h"
+
+namespace tgfx {
+/**
+ * ContourMeasures holds the measured segment tables of every contour in a path, so that trimming
+ * and dashing the same path repeatedly with different parameters only needs to look up the
+ * affected segments instead of measuring the whole path again. The tables of each contour are
+ * built lazily on first use. ContourMeasures is thread-safe.
+ */
+class ContourMeasures {
+ public:
+  explicit ContourMeasures(const pk::SkPath& path);
+
+  /**
+   * Returns the number of contours in the path, including the zero-length ones.
+   */
+  size_t contourCount() const {
+    return contours.size();
+  }
+
+  /**
+   * Returns the length of the contour at the given index.
+   */
+  float getLength(size_t index);
+
+  /**
+   * Returns true if the contour at the given index is closed.
+   */
+  bool isClosed(size_t index);
+
+  /**
+   * Appends the segment between the start and stop distances of the contour at the given index to
+   * the result. Returns false if the segment is zero-length.
+   */
+  bool getSegment(size_t index, float startD, float stopD, pk::SkPath* result,
+                  bool startWithMoveTo);
+
+  /**
+   * Returns the index of the first contour that has a non-zero length, which is the contour
+   * measured by PathMeasure. Returns contourCount() if there is no such contour.
+   */
+  size_t firstContour();
+
+ private:
+  std::mutex locker = {};
+  // The measures keep references to the contours, which never move after construction.
+  std::vector<pk::SkPath> contours = {};
+  std::vector<std::unique_ptr<pk::SkPathMeasure>> measures = {};
+
+  pk::SkPathMeasure* getMeasure(size_t index);
+};
+}  // namespace tgfx
@@ -0,0 +1,128 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "DashPathEffect.h"
+#include <cmath>
+#include "core/ContourMeasures.h"
+#include "core/PathRef.h"
+
+namespace tgfx {
+using namespace pk;
+
+// Guards against dash patterns that would generate an unreasonable number of segments.
+static constexpr double MaxDashCount = 1000000;
+
+std::shared_ptr<PathEffect> PathEffect::MakeDash(const float* intervals, int count, float phase) {
+  if (intervals == nullptr || count < 2 || count % 2 != 0) {
+    return nullptr;
+  }
+  float length = 0;
+  for (int i = 0; i < count; i++) {
+    if (intervals[i] < 0) {
+      return nullptr;
+    }
+    length += intervals[i];
+  }
+  if (!(length > 0) || !std::isfinite(length) || !std::isfinite(phase)) {
+    return nullptr;
+  }
+  return std::shared_ptr<PathEffect>(new DashPathEffect(intervals, count, phase));
+}
+
+DashPathEffect::DashPathEffect(const float intervals[], int count, float phase)
+    : intervals(intervals, intervals + count) {
+  for (auto interval : this->intervals) {
+    intervalLength += interval;
+  }
+  // Moves the phase into [0, intervalLength), flipping it if negative.
+  if (phase < 0) {
+    phase = -phase;
+    if (phase > intervalLength) {
+      phase = fmodf(phase, intervalLength);
+    }
+    phase = intervalLength - phase;
+    if (phase == intervalLength) {
+      phase = 0;
+    }
+  } else if (phase >= intervalLength) {
+    phase = fmodf(phase, intervalLength);
+  }
+  initialDashIndex = 0;
+  initialDashLength = this->intervals[0];
+  for (size_t i = 0; i < this->intervals.size(); i++) {
+    auto gap = this->intervals[i];
+    if (phase > gap || (phase == gap && gap != 0)) {
+      phase -= gap;
+    } else {
+      initialDashIndex = i;
+      initialDashLength = gap - phase;
+      break;
+    }
+  }
+}
+
+bool DashPathEffect::filterPath(Path* path) const {
+  if (path == nullptr) {
+    return false;
+  }
+  // The measures are cached on the source path, so dashing the same path again with a different
+  // phase only looks up the segments instead of measuring the whole path again.
+  auto measures = PathRef::GetContourMeasures(*path);
+  auto contourCount = measures->contourCount();
+  double totalLength = 0;
+  for (size_t i = 0; i < contourCount; i++) {
+    totalLength += measures->getLength(i);
+  }
+  if (totalLength / intervalLength * static_cast<double>(intervals.size()) > MaxDashCount) {
+    return false;
+  }
+  Path result = {};
+  auto& dst = PathRef::WriteAccess(result);
+  for (size_t contour = 0; contour < contourCount; contour++) {
+    auto length = static_cast<double>(measures->getLength(contour));
+    if (length <= 0) {
+      continue;
+    }
+    auto closed = measures->isClosed(contour);
+    // A closed contour skips its first dash here and appends it at the end instead, so that it
+    // connects with the last dash across the starting point.
+    auto skipFirstSegment = closed;
+    auto addedSegment = false;
+    auto index = initialDashIndex;
+    double distance = 0;
+    double dashLength = initialDashLength;
+    while (distance < length) {
+      addedSegment = false;
+      if (index % 2 == 0 && !skipFirstSegment) {
+        addedSegment = true;
+        measures->getSegment(contour, static_cast<float>(distance),
+                             static_cast<float>(distance + dashLength), &dst, true);
+      }
+      distance += dashLength;
+      skipFirstSegment = false;
+      index = (index + 1) % intervals.size();
+      dashLength = intervals[index];
+    }
+    if (closed && initialDashIndex % 2 == 0 && initialDashLength >= 0) {
+      measures->getSegment(contour, 0, initialDashLength, &dst, !addedSegment);
+    }
+  }
+  *path = std::move(result);
+  return true;
+}
+}  // namespace tgfx
@@ -0,0 +1,38 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <vector>
+#include "tgfx/core/PathEffect.h"
+
+namespace tgfx {
+class DashPathEffect : public PathEffect {
+ public:
+  DashPathEffect(const float intervals[], int count, float phase);
+
+  bool filterPath(Path* path) const override;
+
+ private:
+  std::vector<float> intervals = {};
+  float intervalLength = 0.0f;
+  // The length of the first dash and its index in the intervals, after applying the phase.
+  float initialDashLength = 0.0f;
+  size_t initialDashIndex = 0;
+};
+}  // namespace tgfx
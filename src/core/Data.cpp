@@ -18,10 +18,15 @@
 
 #include "tgfx/core/Data.h"
 #include <cstring>
+#include "core/utils/MappedFile.h"
 #include "tgfx/core/Stream.h"
 
 namespace tgfx {
 std::shared_ptr<Data> Data::MakeFromFile(const std::string& filePath) {
+  auto mappedData = MapFile(filePath, FileAccess::Normal);
+  if (mappedData != nullptr) {
+    return mappedData;
+  }
   auto stream = Stream::MakeFromFile(filePath);
   if (stream == nullptr) {
     return nullptr;
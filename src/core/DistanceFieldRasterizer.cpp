@@ -0,0 +1,218 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "DistanceFieldRasterizer.h"
+#include <algorithm>
+#include <cmath>
+#include "core/PixelBuffer.h"
+
+namespace tgfx {
+// The maximum distance in pixels between a curve and the line segments approximating it.
+static constexpr float FlattenTolerance = 0.1f;
+static constexpr float MaxCurveSegments = 64.0f;
+
+struct Segment {
+  Point start = {};
+  Point end = {};
+};
+
+struct Crossing {
+  float x = 0.0f;
+  int winding = 0;
+};
+
+struct FlattenContext {
+  std::vector<Segment> segments = {};
+  Point startPoint = {};
+  Point lastPoint = {};
+};
+
+static void AddLine(FlattenContext* context, const Point& end) {
+  if (context->lastPoint != end) {
+    context->segments.push_back({context->lastPoint, end});
+    context->lastPoint = end;
+  }
+}
+
+static size_t GetCurveSegmentCount(float deviation) {
+  auto count = ceilf(sqrtf(deviation / FlattenTolerance));
+  return static_cast<size_t>(std::clamp(count, 1.0f, MaxCurveSegments));
+}
+
+static void FlattenPath(PathVerb verb, const Point points[4], void* info) {
+  auto context = static_cast<FlattenContext*>(info);
+  switch (verb) {
+    case PathVerb::Move:
+      // Contours are implicitly closed when filled.
+      AddLine(context, context->startPoint);
+      context->startPoint = points[0];
+      context->lastPoint = points[0];
+      break;
+    case PathVerb::Line:
+      AddLine(context, points[1]);
+      break;
+    case PathVerb::Quad: {
+      auto deviation = (points[0] - points[1] * 2.0f + points[2]).length() * 0.25f;
+      auto count = GetCurveSegmentCount(deviation);
+      for (size_t i = 1; i <= count; i++) {
+        auto t = static_cast<float>(i) / static_cast<float>(count);
+        auto u = 1.0f - t;
+        AddLine(context, points[0] * (u * u) + points[1] * (2.0f * u * t) + points[2] * (t * t));
+      }
+    } break;
+    case PathVerb::Cubic: {
+      auto deviation = std::max((points[0] - points[1] * 2.0f + points[2]).length(),
+                                (points[1] - points[2] * 2.0f + points[3]).length()) *
+                       0.75f;
+      auto count = GetCurveSegmentCount(deviation);
+      for (size_t i = 1; i <= count; i++) {
+        auto t = static_cast<float>(i) / static_cast<float>(count);
+        auto u = 1.0f - t;
+        AddLine(context, points[0] * (u * u * u) + points[1] * (3.0f * u * u * t) +
+                             points[2] * (3.0f * u * t * t) + points[3] * (t * t * t));
+      }
+    } break;
+    case PathVerb::Close:
+      AddLine(context, context->startPoint);
+      break;
+  }
+}
+
+static float DistanceToSegment(const Point& point, const Segment& segment) {
+  auto direction = segment.end - segment.start;
+  auto offset = point - segment.start;
+  auto lengthSquared = direction.x * direction.x + direction.y * direction.y;
+  auto t = 0.0f;
+  if (lengthSquared > 0.0f) {
+    t = (offset.x * direction.x + offset.y * direction.y) / lengthSquared;
+    t = std::clamp(t, 0.0f, 1.0f);
+  }
+  return (offset - direction * t).length();
+}
+
+/**
+ * Updates the unsigned distances of the pixels within Radius of the segment. Each row only visits
+ * the pixels around the part of the segment within Radius vertically, so the cost scales with the
+ * length of the segment times Radius rather than with the area of its bounding box.
+ */
+static void UpdateDistances(const Segment& segment, int width, int height, float* distances) {
+  auto radius = DistanceFieldRasterizer::Radius;
+  auto& start = segment.start;
+  auto& end = segment.end;
+  auto top = std::max(static_cast<int>(floorf(std::min(start.y, end.y) - radius)), 0);
+  auto bottom = std::min(static_cast<int>(ceilf(std::max(start.y, end.y) + radius)), height);
+  auto deltaY = end.y - start.y;
+  for (int y = top; y < bottom; y++) {
+    auto centerY = static_cast<float>(y) + 0.5f;
+    auto minX = std::min(start.x, end.x);
+    auto maxX = std::max(start.x, end.x);
+    if (deltaY != 0.0f) {
+      auto t0 = std::clamp((centerY - radius - start.y) / deltaY, 0.0f, 1.0f);
+      auto t1 = std::clamp((centerY + radius - start.y) / deltaY, 0.0f, 1.0f);
+      auto x0 = start.x + (end.x - start.x) * t0;
+      auto x1 = start.x + (end.x - start.x) * t1;
+      minX = std::min(x0, x1);
+      maxX = std::max(x0, x1);
+    }
+    auto left = std::max(static_cast<int>(floorf(minX - radius)), 0);
+    auto right = std::min(static_cast<int>(ceilf(maxX + radius)), width);
+    auto row = distances + static_cast<size_t>(y) * static_cast<size_t>(width);
+    for (int x = left; x < right; x++) {
+      auto center = Point::Make(static_cast<float>(x) + 0.5f, centerY);
+      row[x] = std::min(row[x], DistanceToSegment(center, segment));
+    }
+  }
+}
+
+/**
+ * Adds the crossings of the segment with the horizontal lines through the pixel centers.
+ */
+static void AddCrossings(const Segment& segment, int height,
+                         std::vector<std::vector<Crossing>>* rows) {
+  if (segment.start.y == segment.end.y) {
+    return;
+  }
+  auto winding = segment.end.y > segment.start.y ? 1 : -1;
+  auto top = std::min(segment.start.y, segment.end.y);
+  auto bottom = std::max(segment.start.y, segment.end.y);
+  auto firstRow = std::max(static_cast<int>(ceilf(top - 0.5f)), 0);
+  auto lastRow = std::min(static_cast<int>(ceilf(bottom - 0.5f)), height);
+  auto slope = (segment.end.x - segment.start.x) / (segment.end.y - segment.start.y);
+  for (int row = firstRow; row < lastRow; row++) {
+    auto y = static_cast<float>(row) + 0.5f;
+    auto x = segment.start.x + (y - segment.start.y) * slope;
+    (*rows)[static_cast<size_t>(row)].push_back({x, winding});
+  }
+}
+
+DistanceFieldRasterizer::DistanceFieldRasterizer(int width, int height,
+                                                 std::shared_ptr<GlyphRunList> glyphRunList,
+                                                 const Matrix& matrix)
+    : Rasterizer(width, height), glyphRunList(std::move(glyphRunList)), matrix(matrix) {
+}
+
+std::shared_ptr<ImageBuffer> DistanceFieldRasterizer::onMakeBuffer(bool tryHardware) const {
+  Path path = {};
+  if (!glyphRunList->getPath(&path, matrix.getMaxScale())) {
+    return nullptr;
+  }
+  path.transform(matrix);
+  auto pixelBuffer = PixelBuffer::Make(width(), height(), true, tryHardware);
+  if (pixelBuffer == nullptr) {
+    return nullptr;
+  }
+  FlattenContext context = {};
+  path.decompose(FlattenPath, &context);
+  AddLine(&context, context.startPoint);
+  auto pixelCount = static_cast<size_t>(width()) * static_cast<size_t>(height());
+  std::vector<float> distances(pixelCount, Radius);
+  std::vector<std::vector<Crossing>> rows(static_cast<size_t>(height()));
+  for (auto& segment : context.segments) {
+    UpdateDistances(segment, width(), height(), distances.data());
+    AddCrossings(segment, height(), &rows);
+  }
+  auto evenOdd = path.getFillType() == PathFillType::EvenOdd;
+  auto pixels = static_cast<uint8_t*>(pixelBuffer->lockPixels());
+  if (pixels == nullptr) {
+    return nullptr;
+  }
+  auto rowBytes = pixelBuffer->info().rowBytes();
+  for (int y = 0; y < height(); y++) {
+    auto& crossings = rows[static_cast<size_t>(y)];
+    std::sort(crossings.begin(), crossings.end(),
+              [](const Crossing& a, const Crossing& b) { return a.x < b.x; });
+    auto distanceRow = distances.data() + static_cast<size_t>(y) * static_cast<size_t>(width());
+    auto pixelRow = pixels + static_cast<size_t>(y) * rowBytes;
+    size_t crossingIndex = 0;
+    int winding = 0;
+    for (int x = 0; x < width(); x++) {
+      auto centerX = static_cast<float>(x) + 0.5f;
+      while (crossingIndex < crossings.size() && crossings[crossingIndex].x <= centerX) {
+        winding += evenOdd ? 1 : crossings[crossingIndex].winding;
+        crossingIndex++;
+      }
+      auto inside = evenOdd ? (winding & 1) != 0 : winding != 0;
+      auto distance = inside ? distanceRow[x] : -distanceRow[x];
+      auto value = std::clamp(0.5f + distance / (2.0f * Radius), 0.0f, 1.0f);
+      pixelRow[x] = static_cast<uint8_t>(value * 255.0f + 0.5f);
+    }
+  }
+  pixelBuffer->unlockPixels();
+  return pixelBuffer;
+}
+}  // namespace tgfx
@@ -0,0 +1,48 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "core/Rasterizer.h"
+
+namespace tgfx {
+/**
+ * DistanceFieldRasterizer generates a signed distance field from the outlines of a set of glyphs.
+ * Each pixel stores the distance from its center to the nearest outline edge, mapped from
+ * [-Radius, Radius] to [0, 1], where values above 0.5 are inside the glyphs. Unlike a coverage
+ * mask, the distance field can be drawn at a different scale than it was generated at while
+ * keeping the edges sharp.
+ */
+class DistanceFieldRasterizer : public Rasterizer {
+ public:
+  /**
+   * The maximum distance in pixels encoded in the distance field.
+   */
+  static constexpr float Radius = 4.0f;
+
+  DistanceFieldRasterizer(int width, int height, std::shared_ptr<GlyphRunList> glyphRunList,
+                          const Matrix& matrix);
+
+ protected:
+  std::shared_ptr<ImageBuffer> onMakeBuffer(bool tryHardware) const override;
+
+ private:
+  std::shared_ptr<GlyphRunList> glyphRunList = nullptr;
+  Matrix matrix = Matrix::I();
+};
+}  // namespace tgfx
@@ -0,0 +1,146 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "GlyphCache.h"
+#include "core/ScalerContext.h"
+
+namespace tgfx {
+static constexpr uint32_t BoundsShift = 0;
+static constexpr uint32_t AdvanceShift = 4;
+static constexpr uint32_t PathShift = 6;
+
+static size_t GetFauxIndex(bool fauxBold, bool fauxItalic) {
+  return (fauxBold ? 1u : 0u) | (fauxItalic ? 2u : 0u);
+}
+
+GlyphCache::GlyphRecord::~GlyphRecord() {
+  for (auto& path : paths) {
+    delete path;
+  }
+}
+
+GlyphCache::GlyphCache(const ScalerContext* context) : context(context) {
+}
+
+GlyphCache::~GlyphCache() {
+  for (auto& pageSlot : pages) {
+    auto page = pageSlot.load(std::memory_order_relaxed);
+    if (page == nullptr) {
+      continue;
+    }
+    for (auto& recordSlot : page->records) {
+      delete recordSlot.load(std::memory_order_relaxed);
+    }
+    delete page;
+  }
+}
+
+Rect GlyphCache::getBounds(GlyphID glyphID, bool fauxBold, bool fauxItalic) {
+  auto index = GetFauxIndex(fauxBold, fauxItalic);
+  auto bit = 1u << (BoundsShift + index);
+  auto record = findRecord(glyphID);
+  if (record && (record->validFlags.load(std::memory_order_acquire) & bit)) {
+    return record->bounds[index];
+  }
+  auto bounds = context->onGetBounds(glyphID, fauxBold, fauxItalic);
+  std::lock_guard<std::mutex> autoLock(locker);
+  record = findOrCreateRecord(glyphID);
+  if (record && (record->validFlags.load(std::memory_order_relaxed) & bit) == 0) {
+    record->bounds[index] = bounds;
+    record->validFlags.fetch_or(bit, std::memory_order_release);
+  }
+  return bounds;
+}
+
+float GlyphCache::getAdvance(GlyphID glyphID, bool verticalText) {
+  auto index = verticalText ? 1u : 0u;
+  auto bit = 1u << (AdvanceShift + index);
+  auto record = findRecord(glyphID);
+  if (record && (record->validFlags.load(std::memory_order_acquire) & bit)) {
+    return record->advances[index];
+  }
+  auto advance = context->onGetAdvance(glyphID, verticalText);
+  std::lock_guard<std::mutex> autoLock(locker);
+  record = findOrCreateRecord(glyphID);
+  if (record && (record->validFlags.load(std::memory_order_relaxed) & bit) == 0) {
+    record->advances[index] = advance;
+    record->validFlags.fetch_or(bit, std::memory_order_release);
+  }
+  return advance;
+}
+
+bool GlyphCache::getPath(GlyphID glyphID, bool fauxBold, bool fauxItalic, Path* path) {
+  auto index = GetFauxIndex(fauxBold, fauxItalic);
+  auto bit = 1u << (PathShift + index);
+  auto record = findRecord(glyphID);
+  if (record && (record->validFlags.load(std::memory_order_acquire) & bit)) {
+    // A null path records that the glyph has no outline.
+    auto glyphPath = record->paths[index];
+    if (glyphPath == nullptr) {
+      path->reset();
+      return false;
+    }
+    *path = *glyphPath;
+    return true;
+  }
+  Path glyphPath = {};
+  auto result = context->onGeneratePath(glyphID, fauxBold, fauxItalic, &glyphPath);
+  {
+    std::lock_guard<std::mutex> autoLock(locker);
+    record = findOrCreateRecord(glyphID);
+    if (record && (record->validFlags.load(std::memory_order_relaxed) & bit) == 0) {
+      if (result) {
+        record->paths[index] = new Path(glyphPath);
+      }
+      record->validFlags.fetch_or(bit, std::memory_order_release);
+    }
+  }
+  *path = std::move(glyphPath);
+  return result;
+}
+
+GlyphCache::GlyphRecord* GlyphCache::findRecord(GlyphID glyphID) const {
+  auto page = pages[glyphID / PageSize].load(std::memory_order_acquire);
+  if (page == nullptr) {
+    return nullptr;
+  }
+  return page->records[glyphID % PageSize].load(std::memory_order_acquire);
+}
+
+GlyphCache::GlyphRecord* GlyphCache::findOrCreateRecord(GlyphID glyphID) {
+  auto& pageSlot = pages[glyphID / PageSize];
+  auto page = pageSlot.load(std::memory_order_relaxed);
+  if (page != nullptr) {
+    auto record = page->records[glyphID % PageSize].load(std::memory_order_relaxed);
+    if (record != nullptr) {
+      return record;
+    }
+  }
+  if (glyphCount >= MaxGlyphCount) {
+    return nullptr;
+  }
+  if (page == nullptr) {
+    page = new GlyphPage();
+    pageSlot.store(page, std::memory_order_release);
+  }
+  auto record = new GlyphRecord();
+  page->records[glyphID % PageSize].store(record, std::memory_order_release);
+  glyphCount++;
+  return record;
+}
+}  // namespace tgfx
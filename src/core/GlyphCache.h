@@ -0,0 +1,78 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include "tgfx/core/Path.h"
+#include "tgfx/core/Rect.h"
+#include "tgfx/core/Typeface.h"
+
+namespace tgfx {
+class ScalerContext;
+
+/**
+ * GlyphCache memoizes the bounds, advances, and outline paths generated by a ScalerContext. Values
+ * are generated outside the mutex, so threads missing different glyphs don't wait for each other,
+ * and the first result is published under the mutex with a release store. Subsequent reads are
+ * lock-free. The number of cached glyphs is bounded by MaxGlyphCount; glyphs beyond that limit are
+ * generated on every request.
+ */
+class GlyphCache {
+ public:
+  static constexpr size_t MaxGlyphCount = 4096;
+
+  explicit GlyphCache(const ScalerContext* context);
+
+  ~GlyphCache();
+
+  Rect getBounds(GlyphID glyphID, bool fauxBold, bool fauxItalic);
+
+  float getAdvance(GlyphID glyphID, bool verticalText);
+
+  bool getPath(GlyphID glyphID, bool fauxBold, bool fauxItalic, Path* path);
+
+ private:
+  static constexpr size_t PageSize = 256;
+  static constexpr size_t PageCount = 256;
+
+  struct GlyphRecord {
+    // Bits 0-3: bounds, bits 4-5: advances, bits 6-9: paths.
+    std::atomic<uint32_t> validFlags = {0};
+    Rect bounds[4] = {};
+    float advances[2] = {};
+    Path* paths[4] = {};
+
+    ~GlyphRecord();
+  };
+
+  struct GlyphPage {
+    std::atomic<GlyphRecord*> records[PageSize] = {};
+  };
+
+  const ScalerContext* context = nullptr;
+  std::mutex locker = {};
+  std::atomic<GlyphPage*> pages[PageCount] = {};
+  size_t glyphCount = 0;
+
+  GlyphRecord* findRecord(GlyphID glyphID) const;
+
+  GlyphRecord* findOrCreateRecord(GlyphID glyphID);
+};
+}  // namespace tgfx
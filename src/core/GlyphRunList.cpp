@@ -47,6 +47,27 @@ GlyphRunList::GlyphRunList(std::vector<GlyphRun> glyphRuns) : _glyphRuns(std::mo
       }));
 }
 
+bool GlyphRunList::computeContentKey(BytesKey* contentKey) const {
+  for (auto& run : _glyphRuns) {
+    Font font = {};
+    if (!run.glyphFace->asFont(&font)) {
+      return false;
+    }
+    auto typeface = font.getTypeface();
+    contentKey->write(typeface ? typeface->uniqueID() : 0);
+    contentKey->write(font.getSize());
+    contentKey->write(static_cast<uint32_t>(font.isFauxBold()) |
+                      static_cast<uint32_t>(font.isFauxItalic()) << 1);
+    contentKey->write(static_cast<uint32_t>(run.glyphs.size()));
+    for (size_t i = 0; i < run.glyphs.size(); i++) {
+      contentKey->write(static_cast<uint32_t>(run.glyphs[i]));
+      contentKey->write(run.positions[i].x);
+      contentKey->write(run.positions[i].y);
+    }
+  }
+  return true;
+}
+
 Rect GlyphRunList::getBounds(float resolutionScale) const {
   if (resolutionScale <= 0.0f) {
     return Rect::MakeEmpty();
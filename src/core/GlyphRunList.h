@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include "tgfx/core/BytesKey.h"
 #include "tgfx/core/GlyphRun.h"
 #include "tgfx/core/Stroke.h"
 
@@ -84,6 +85,13 @@ class GlyphRunList {
    */
   bool getPath(Path* path, float resolutionScale = 1.0f) const;
 
+  /**
+   * Writes the typefaces, sizes, glyph IDs, and positions of the glyphs into the given BytesKey,
+   * so that GlyphRunLists recreated with the same glyphs on every draw share the same key. Returns
+   * false if any glyph run is not drawn with a Font, whose content can not be identified.
+   */
+  bool computeContentKey(BytesKey* contentKey) const;
+
  private:
   std::vector<GlyphRun> _glyphRuns = {};
 };
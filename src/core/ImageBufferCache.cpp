@@ -0,0 +1,130 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "core/ImageBufferCache.h"
+
+namespace tgfx {
+static size_t EstimateMemorySize(const ImageBuffer* imageBuffer) {
+  auto bytesPerPixel = imageBuffer->isAlphaOnly() ? 1 : 4;
+  return static_cast<size_t>(imageBuffer->width()) * static_cast<size_t>(imageBuffer->height()) *
+         static_cast<size_t>(bytesPerPixel);
+}
+
+size_t DecodedImageCache::GetCacheLimit() {
+  return ImageBufferCache::Get()->cacheLimit();
+}
+
+void DecodedImageCache::SetCacheLimit(size_t bytesLimit) {
+  ImageBufferCache::Get()->setCacheLimit(bytesLimit);
+}
+
+DecodedImageCacheStats DecodedImageCache::GetStats() {
+  return ImageBufferCache::Get()->stats();
+}
+
+void DecodedImageCache::PurgeAll() {
+  ImageBufferCache::Get()->purgeAll();
+}
+
+ImageBufferCache* ImageBufferCache::Get() {
+  static auto& cache = *new ImageBufferCache();
+  return &cache;
+}
+
+bool ImageBufferCache::enabled() const {
+  std::lock_guard<std::mutex> autoLock(locker);
+  return limit > 0;
+}
+
+std::shared_ptr<ImageBuffer> ImageBufferCache::find(const BytesKey& key) {
+  std::lock_guard<std::mutex> autoLock(locker);
+  auto result = entryMap.find(key);
+  if (result == entryMap.end()) {
+    _stats.missCount++;
+    return nullptr;
+  }
+  auto position = result->second;
+  if (position->imageBuffer->expired()) {
+    removeEntry(position);
+    _stats.missCount++;
+    return nullptr;
+  }
+  entries.splice(entries.begin(), entries, position);
+  _stats.hitCount++;
+  return position->imageBuffer;
+}
+
+void ImageBufferCache::add(const BytesKey& key, std::shared_ptr<ImageBuffer> imageBuffer) {
+  if (imageBuffer == nullptr) {
+    return;
+  }
+  auto memorySize = EstimateMemorySize(imageBuffer.get());
+  std::lock_guard<std::mutex> autoLock(locker);
+  if (memorySize > limit) {
+    return;
+  }
+  auto result = entryMap.find(key);
+  if (result != entryMap.end()) {
+    // Another thread decoded the same image concurrently, keep the newer one.
+    removeEntry(result->second);
+  }
+  purgeToLimit(limit - memorySize);
+  entries.push_front({key, std::move(imageBuffer), memorySize});
+  entryMap[key] = entries.begin();
+  _stats.entryCount++;
+  _stats.memoryUsage += memorySize;
+}
+
+size_t ImageBufferCache::cacheLimit() const {
+  std::lock_guard<std::mutex> autoLock(locker);
+  return limit;
+}
+
+void ImageBufferCache::setCacheLimit(size_t bytesLimit) {
+  std::lock_guard<std::mutex> autoLock(locker);
+  limit = bytesLimit;
+  purgeToLimit(limit);
+}
+
+DecodedImageCacheStats ImageBufferCache::stats() const {
+  std::lock_guard<std::mutex> autoLock(locker);
+  return _stats;
+}
+
+void ImageBufferCache::purgeAll() {
+  std::lock_guard<std::mutex> autoLock(locker);
+  entryMap.clear();
+  entries.clear();
+  _stats.entryCount = 0;
+  _stats.memoryUsage = 0;
+}
+
+void ImageBufferCache::removeEntry(std::list<Entry>::iterator position) {
+  _stats.entryCount--;
+  _stats.memoryUsage -= position->memorySize;
+  entryMap.erase(position->key);
+  entries.erase(position);
+}
+
+void ImageBufferCache::purgeToLimit(size_t bytesLimit) {
+  while (!entries.empty() && _stats.memoryUsage > bytesLimit) {
+    removeEntry(std::prev(entries.end()));
+    _stats.evictionCount++;
+  }
+}
+}  // namespace tgfx
@@ -0,0 +1,82 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <list>
+#include <mutex>
+#include "tgfx/core/BytesKey.h"
+#include "tgfx/core/DecodedImageCache.h"
+#include "tgfx/core/ImageBuffer.h"
+
+namespace tgfx {
+/**
+ * ImageBufferCache is the process-wide LRU cache of decoded ImageBuffers behind
+ * DecodedImageCache. The keys are built from the UniqueKey of the image and the decoding options.
+ */
+class ImageBufferCache {
+ public:
+  /**
+   * Returns the global ImageBufferCache instance.
+   */
+  static ImageBufferCache* Get();
+
+  /**
+   * Returns true if the cache limit is greater than zero.
+   */
+  bool enabled() const;
+
+  /**
+   * Returns the ImageBuffer cached for the given key and marks it as the most recently used one.
+   * Returns nullptr if no valid ImageBuffer is found.
+   */
+  std::shared_ptr<ImageBuffer> find(const BytesKey& key);
+
+  /**
+   * Adds the ImageBuffer to the cache, purging the least recently used ones if the cache exceeds
+   * its limit. ImageBuffers larger than the entire cache limit are not cached.
+   */
+  void add(const BytesKey& key, std::shared_ptr<ImageBuffer> imageBuffer);
+
+  size_t cacheLimit() const;
+
+  void setCacheLimit(size_t bytesLimit);
+
+  DecodedImageCacheStats stats() const;
+
+  void purgeAll();
+
+ private:
+  struct Entry {
+    BytesKey key = {};
+    std::shared_ptr<ImageBuffer> imageBuffer = nullptr;
+    size_t memorySize = 0;
+  };
+
+  mutable std::mutex locker = {};
+  size_t limit = 0;
+  // The most recently used entry is at the front of the list.
+  std::list<Entry> entries = {};
+  BytesKeyMap<std::list<Entry>::iterator> entryMap = {};
+  DecodedImageCacheStats _stats = {};
+
+  void removeEntry(std::list<Entry>::iterator position);
+
+  void purgeToLimit(size_t bytesLimit);
+};
+}  // namespace tgfx
@@ -17,12 +17,15 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "tgfx/core/ImageCodec.h"
+#include <algorithm>
 #include "core/PixelBuffer.h"
+#include "core/utils/MappedFile.h"
 #include "core/utils/USE.h"
 #include "tgfx/core/Buffer.h"
 #include "tgfx/core/ImageInfo.h"
 #include "tgfx/core/Pixmap.h"
 #include "tgfx/core/Stream.h"
+#include "tgfx/core/Task.h"
 
 #if defined(TGFX_USE_WEBP_DECODE) || defined(TGFX_USE_WEBP_ENCODE)
 #include "core/codecs/webp/WebpCodec.h"
@@ -40,6 +43,14 @@
 
 namespace tgfx {
 std::shared_ptr<ImageCodec> ImageCodec::MakeFrom(const std::string& filePath) {
+  // Sniffing the header and decoding from one mapping of the file avoids opening it repeatedly.
+  auto fileData = MapFile(filePath, FileAccess::Sequential);
+  if (fileData != nullptr) {
+    auto codec = MakeFrom(std::move(fileData));
+    if (codec != nullptr) {
+      return codec;
+    }
+  }
   std::shared_ptr<ImageCodec> codec = nullptr;
   auto stream = Stream::MakeFromFile(filePath);
   if (stream && stream->size() > 14) {
@@ -105,9 +116,18 @@ std::shared_ptr<ImageCodec> ImageCodec::MakeFrom(std::shared_ptr<Data> imageByte
 }
 
 std::shared_ptr<Data> ImageCodec::Encode(const Pixmap& pixmap, EncodedFormat format, int quality) {
-  if (pixmap.isEmpty()) {
+  auto stream = MemoryWriteStream::Make();
+  if (!Encode(pixmap, format, quality, stream.get())) {
     return nullptr;
   }
+  return stream->readData();
+}
+
+bool ImageCodec::Encode(const Pixmap& pixmap, EncodedFormat format, int quality,
+                        WriteStream* stream) {
+  if (pixmap.isEmpty() || stream == nullptr) {
+    return false;
+  }
   USE(format);
   if (quality > 100) {
     quality = 100;
@@ -117,22 +137,189 @@ std::shared_ptr<Data> ImageCodec::Encode(const Pixmap& pixmap, EncodedFormat for
   }
 #ifdef TGFX_USE_JPEG_ENCODE
   if (format == EncodedFormat::JPEG) {
-    return JpegCodec::Encode(pixmap, quality);
+    return JpegCodec::Encode(pixmap, quality, stream);
   }
 #endif
 #ifdef TGFX_USE_WEBP_ENCODE
   if (format == EncodedFormat::WEBP) {
-    return WebpCodec::Encode(pixmap, quality);
+    return WebpCodec::Encode(pixmap, quality, stream);
   }
 #endif
 #ifdef TGFX_USE_PNG_ENCODE
   if (format == EncodedFormat::PNG) {
-    return PngCodec::Encode(pixmap, quality);
+    return PngCodec::Encode(pixmap, quality, stream);
   }
 #endif
+  return false;
+}
+
+std::vector<std::shared_ptr<Data>> ImageCodec::Encode(const std::vector<const Pixmap*>& pixmaps,
+                                                      EncodedFormat format, int quality) {
+  std::vector<std::shared_ptr<Data>> results(pixmaps.size());
+  std::vector<std::shared_ptr<Task>> tasks = {};
+  tasks.reserve(pixmaps.size());
+  for (size_t i = 0; i < pixmaps.size(); i++) {
+    if (pixmaps[i] == nullptr) {
+      continue;
+    }
+    auto pixmap = pixmaps[i];
+    auto result = &results[i];
+    auto task = Task::Run([pixmap, result, format, quality]() {
+      *result = Encode(*pixmap, format, quality);
+    });
+    tasks.push_back(std::move(task));
+  }
+  // Tasks that have not been picked up by a worker yet run on the calling thread.
+  for (auto& task : tasks) {
+    task->wait();
+  }
+  return results;
+}
+
+ISize ImageCodec::getScaledDimensions(float) const {
+  return ISize::Make(width(), height());
+}
+
+bool ImageCodec::readScaledPixels(const ImageInfo& dstInfo, void* dstPixels) const {
+  if (dstInfo.width() != width() || dstInfo.height() != height()) {
+    return false;
+  }
+  return readPixels(dstInfo, dstPixels);
+}
+
+std::shared_ptr<YUVData> ImageCodec::readYUVData(YUVColorSpace*) const {
   return nullptr;
 }
 
+/**
+ * Downsamples the premultiplied RGBA pixels into the destination by averaging all source pixels
+ * covered by each destination pixel.
+ */
+static bool DownsamplePixels(const Pixmap& source, const ImageInfo& dstInfo, void* dstPixels) {
+  auto info = ImageInfo::Make(dstInfo.width(), dstInfo.height(), ColorType::RGBA_8888,
+                              AlphaType::Premultiplied);
+  Buffer buffer = {};
+  auto outPixels = static_cast<uint8_t*>(dstPixels);
+  auto outRowBytes = dstInfo.rowBytes();
+  if (dstInfo.colorType() != ColorType::RGBA_8888 ||
+      dstInfo.alphaType() == AlphaType::Unpremultiplied) {
+    if (!buffer.alloc(info.byteSize())) {
+      return false;
+    }
+    outPixels = buffer.bytes();
+    outRowBytes = info.rowBytes();
+  }
+  auto srcPixels = static_cast<const uint8_t*>(source.pixels());
+  auto srcWidth = static_cast<int64_t>(source.width());
+  auto srcHeight = static_cast<int64_t>(source.height());
+  auto dstWidth = static_cast<int64_t>(info.width());
+  auto dstHeight = static_cast<int64_t>(info.height());
+  for (int64_t y = 0; y < dstHeight; y++) {
+    auto top = y * srcHeight / dstHeight;
+    auto bottom = std::max((y + 1) * srcHeight / dstHeight, top + 1);
+    auto dstRow = outPixels + static_cast<size_t>(y) * outRowBytes;
+    for (int64_t x = 0; x < dstWidth; x++) {
+      auto left = x * srcWidth / dstWidth;
+      auto right = std::max((x + 1) * srcWidth / dstWidth, left + 1);
+      uint32_t sum[4] = {0, 0, 0, 0};
+      for (auto row = top; row < bottom; row++) {
+        auto srcRow = srcPixels + static_cast<size_t>(row) * source.rowBytes();
+        for (auto column = left; column < right; column++) {
+          auto pixel = srcRow + column * 4;
+          for (int i = 0; i < 4; i++) {
+            sum[i] += pixel[i];
+          }
+        }
+      }
+      auto count = static_cast<uint32_t>((bottom - top) * (right - left));
+      auto dstPixel = dstRow + x * 4;
+      for (int i = 0; i < 4; i++) {
+        dstPixel[i] = static_cast<uint8_t>((sum[i] + count / 2) / count);
+      }
+    }
+  }
+  if (buffer.isEmpty()) {
+    return true;
+  }
+  return Pixmap(info, buffer.data()).readPixels(dstInfo, dstPixels);
+}
+
+static Rect ScaleRegion(const Rect& region, int width, int height, const ISize& scaledSize) {
+  auto scaleX = static_cast<float>(scaledSize.width) / static_cast<float>(width);
+  auto scaleY = static_cast<float>(scaledSize.height) / static_cast<float>(height);
+  auto result = Rect::MakeLTRB(region.left * scaleX, region.top * scaleY, region.right * scaleX,
+                               region.bottom * scaleY);
+  result.roundOut();
+  if (!result.intersect(Rect::MakeWH(scaledSize.width, scaledSize.height))) {
+    return Rect::MakeEmpty();
+  }
+  return result;
+}
+
+bool ImageCodec::readRegion(const Rect& region, const ImageInfo& dstInfo, void* dstPixels) const {
+  auto bounds = region;
+  bounds.round();
+  if (dstPixels == nullptr || dstInfo.isEmpty() || bounds.isEmpty() ||
+      !Rect::MakeWH(width(), height()).contains(bounds)) {
+    return false;
+  }
+  auto regionWidth = static_cast<int>(bounds.width());
+  auto regionHeight = static_cast<int>(bounds.height());
+  if (dstInfo.width() > regionWidth || dstInfo.height() > regionHeight) {
+    return false;
+  }
+  auto fullSize = ISize::Make(width(), height());
+  if (dstInfo.width() == regionWidth && dstInfo.height() == regionHeight) {
+    return onReadRegion(fullSize, bounds, dstInfo, dstPixels);
+  }
+  auto scale = std::max(static_cast<float>(dstInfo.width()) / static_cast<float>(regionWidth),
+                        static_cast<float>(dstInfo.height()) / static_cast<float>(regionHeight));
+  auto scaledSize = getScaledDimensions(scale);
+  auto scaledRegion = ScaleRegion(bounds, width(), height(), scaledSize);
+  if (scaledRegion.isEmpty()) {
+    scaledSize = fullSize;
+    scaledRegion = bounds;
+  }
+  if (static_cast<int>(scaledRegion.width()) == dstInfo.width() &&
+      static_cast<int>(scaledRegion.height()) == dstInfo.height() &&
+      onReadRegion(scaledSize, scaledRegion, dstInfo, dstPixels)) {
+    return true;
+  }
+  // Decodes the region at the smallest size the codec supports and downsamples it the rest of the
+  // way, falling back to the full resolution if the codec cannot decode the region scaled.
+  auto info = ImageInfo::Make(static_cast<int>(scaledRegion.width()),
+                              static_cast<int>(scaledRegion.height()), ColorType::RGBA_8888,
+                              AlphaType::Premultiplied);
+  Buffer buffer(info.byteSize());
+  if (buffer.isEmpty()) {
+    return false;
+  }
+  if (!onReadRegion(scaledSize, scaledRegion, info, buffer.data())) {
+    if (scaledSize.width == width() && scaledSize.height == height()) {
+      return false;
+    }
+    info = ImageInfo::Make(regionWidth, regionHeight, ColorType::RGBA_8888,
+                           AlphaType::Premultiplied);
+    if (!buffer.alloc(info.byteSize()) || !onReadRegion(fullSize, bounds, info, buffer.data())) {
+      return false;
+    }
+  }
+  return DownsamplePixels(Pixmap(info, buffer.data()), dstInfo, dstPixels);
+}
+
+bool ImageCodec::onReadRegion(const ISize& scaledSize, const Rect& region,
+                              const ImageInfo& dstInfo, void* dstPixels) const {
+  auto info = ImageInfo::Make(scaledSize.width, scaledSize.height, ColorType::RGBA_8888,
+                              AlphaType::Premultiplied);
+  Buffer buffer(info.byteSize());
+  if (buffer.isEmpty() || !readScaledPixels(info, buffer.data())) {
+    return false;
+  }
+  Pixmap pixmap(info, buffer.data());
+  return pixmap.readPixels(dstInfo, dstPixels, static_cast<int>(region.left),
+                           static_cast<int>(region.top));
+}
+
 std::shared_ptr<ImageBuffer> ImageCodec::onMakeBuffer(bool tryHardware) const {
   auto pixelBuffer = PixelBuffer::Make(width(), height(), isAlphaOnly(), tryHardware);
   if (pixelBuffer == nullptr) {
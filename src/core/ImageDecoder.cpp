@@ -17,9 +17,28 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "ImageDecoder.h"
+#include "core/ImageBufferCache.h"
 #include "core/utils/DataTask.h"
 
 namespace tgfx {
+static BytesKey MakeCacheKey(const UniqueKey& uniqueKey, const ImageGenerator* generator,
+                             bool tryHardware) {
+  BytesKey cacheKey = {};
+  uniqueKey.writeTo(&cacheKey);
+  cacheKey.write(generator->width());
+  cacheKey.write(generator->height());
+  cacheKey.write(static_cast<uint32_t>(tryHardware));
+  return cacheKey;
+}
+
+static std::shared_ptr<ImageBuffer> MakeImageBuffer(const ImageGenerator* generator,
+                                                    bool tryHardware, const BytesKey& cacheKey) {
+  auto imageBuffer = generator->makeBuffer(tryHardware);
+  if (cacheKey.isValid()) {
+    ImageBufferCache::Get()->add(cacheKey, imageBuffer);
+  }
+  return imageBuffer;
+}
 
 class ImageBufferWrapper : public ImageDecoder {
  public:
@@ -49,8 +68,10 @@ class ImageBufferWrapper : public ImageDecoder {
 
 class ImageGeneratorWrapper : public ImageDecoder {
  public:
-  explicit ImageGeneratorWrapper(std::shared_ptr<ImageGenerator> generator, bool tryHardware)
-      : imageGenerator(std::move(generator)), tryHardware(tryHardware) {
+  ImageGeneratorWrapper(std::shared_ptr<ImageGenerator> generator, bool tryHardware,
+                        BytesKey cacheKey)
+      : imageGenerator(std::move(generator)), tryHardware(tryHardware),
+        cacheKey(std::move(cacheKey)) {
   }
 
   int width() const override {
@@ -66,20 +87,24 @@ class ImageGeneratorWrapper : public ImageDecoder {
   }
 
   std::shared_ptr<ImageBuffer> decode() const override {
-    return imageGenerator->makeBuffer(tryHardware);
+    return MakeImageBuffer(imageGenerator.get(), tryHardware, cacheKey);
   }
 
  private:
   std::shared_ptr<ImageGenerator> imageGenerator = nullptr;
   bool tryHardware = true;
+  BytesKey cacheKey = {};
 };
 
 class AsyncImageDecoder : public ImageDecoder {
  public:
-  AsyncImageDecoder(std::shared_ptr<ImageGenerator> generator, bool tryHardware)
+  AsyncImageDecoder(std::shared_ptr<ImageGenerator> generator, bool tryHardware,
+                    BytesKey cacheKey)
       : imageGenerator(std::move(generator)) {
     task = DataTask<ImageBuffer>::Run(
-        [generator = imageGenerator, tryHardware]() { return generator->makeBuffer(tryHardware); });
+        [generator = imageGenerator, tryHardware, cacheKey = std::move(cacheKey)]() {
+          return MakeImageBuffer(generator.get(), tryHardware, cacheKey);
+        });
   }
 
   int width() const override {
@@ -111,13 +136,24 @@ std::shared_ptr<ImageDecoder> ImageDecoder::Wrap(std::shared_ptr<ImageBuffer> im
 }
 
 std::shared_ptr<ImageDecoder> ImageDecoder::MakeFrom(std::shared_ptr<ImageGenerator> generator,
-                                                     bool tryHardware, bool asyncDecoding) {
+                                                     bool tryHardware, bool asyncDecoding,
+                                                     const UniqueKey& uniqueKey) {
   if (generator == nullptr) {
     return nullptr;
   }
+  BytesKey cacheKey = {};
+  if (!uniqueKey.empty() && ImageBufferCache::Get()->enabled()) {
+    cacheKey = MakeCacheKey(uniqueKey, generator.get(), tryHardware);
+    auto imageBuffer = ImageBufferCache::Get()->find(cacheKey);
+    if (imageBuffer != nullptr) {
+      return Wrap(std::move(imageBuffer));
+    }
+  }
   if (asyncDecoding && generator->asyncSupport()) {
-    return std::make_shared<AsyncImageDecoder>(std::move(generator), tryHardware);
+    return std::make_shared<AsyncImageDecoder>(std::move(generator), tryHardware,
+                                               std::move(cacheKey));
   }
-  return std::make_shared<ImageGeneratorWrapper>(std::move(generator), tryHardware);
+  return std::make_shared<ImageGeneratorWrapper>(std::move(generator), tryHardware,
+                                                 std::move(cacheKey));
 }
 }  // namespace tgfx
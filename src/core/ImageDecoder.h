@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include "gpu/ResourceKey.h"
 #include "tgfx/core/ImageGenerator.h"
 
 namespace tgfx {
@@ -34,10 +35,13 @@ class ImageDecoder {
   /**
    * Create an ImageDecoder from the specified ImageGenerator. If asyncDecoding is true, the
    * returned ImageDecoder schedules an asynchronous image-decoding task immediately. Otherwise, the
-   * image will be decoded synchronously when the decode() method is called.
+   * image will be decoded synchronously when the decode() method is called. If the uniqueKey of the
+   * image is not empty and the DecodedImageCache is enabled, the decoded ImageBuffer is looked up
+   * in and added to the DecodedImageCache.
    */
   static std::shared_ptr<ImageDecoder> MakeFrom(std::shared_ptr<ImageGenerator> generator,
-                                                bool tryHardware = true, bool asyncDecoding = true);
+                                                bool tryHardware = true, bool asyncDecoding = true,
+                                                const UniqueKey& uniqueKey = {});
 
   virtual ~ImageDecoder() = default;
 
@@ -0,0 +1,185 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "tgfx/core/IncrementalDecoder.h"
+#include <algorithm>
+#include "tgfx/core/ImageReader.h"
+
+#ifdef TGFX_USE_WEBP_DECODE
+#include "core/codecs/webp/WebpCodec.h"
+#endif
+
+#ifdef TGFX_USE_PNG_DECODE
+#include "core/codecs/png/PngCodec.h"
+#endif
+
+#ifdef TGFX_USE_JPEG_DECODE
+#include "core/codecs/jpeg/JpegCodec.h"
+#endif
+
+namespace tgfx {
+std::shared_ptr<IncrementalDecoder> IncrementalDecoder::MakeFrom(std::shared_ptr<Data> firstChunk) {
+  if (firstChunk == nullptr || firstChunk->size() < 14) {
+    return nullptr;
+  }
+  std::shared_ptr<IncrementalDecoder> decoder = nullptr;
+#ifdef TGFX_USE_WEBP_DECODE
+  if (WebpCodec::IsWebp(firstChunk)) {
+    decoder = WebpCodec::MakeIncrementalDecoder();
+  }
+#endif
+
+#ifdef TGFX_USE_PNG_DECODE
+  if (decoder == nullptr && PngCodec::IsPng(firstChunk)) {
+    decoder = PngCodec::MakeIncrementalDecoder();
+  }
+#endif
+
+#ifdef TGFX_USE_JPEG_DECODE
+  if (decoder == nullptr && JpegCodec::IsJpeg(firstChunk)) {
+    decoder = JpegCodec::MakeIncrementalDecoder();
+  }
+#endif
+  if (decoder == nullptr) {
+    return nullptr;
+  }
+  decoder->append(std::move(firstChunk));
+  return decoder;
+}
+
+int IncrementalDecoder::width() const {
+  std::lock_guard<std::mutex> autoLock(locker);
+  return info.width();
+}
+
+int IncrementalDecoder::height() const {
+  std::lock_guard<std::mutex> autoLock(locker);
+  return info.height();
+}
+
+Orientation IncrementalDecoder::orientation() const {
+  std::lock_guard<std::mutex> autoLock(locker);
+  return _orientation;
+}
+
+bool IncrementalDecoder::isComplete() const {
+  std::lock_guard<std::mutex> autoLock(locker);
+  return complete;
+}
+
+bool IncrementalDecoder::append(std::shared_ptr<Data> chunk) {
+  // The decoding state is only touched by the thread holding decodeLocker. The fields read by other
+  // threads are published under locker, which is not held while decoding.
+  std::lock_guard<std::mutex> decodeLock(decodeLocker);
+  if (failed) {
+    return false;
+  }
+  if (chunk == nullptr || chunk->empty() || complete) {
+    return true;
+  }
+  if (!onAppend(chunk->bytes(), chunk->size())) {
+    failed = true;
+  }
+  std::lock_guard<std::mutex> autoLock(locker);
+  flushDecodedRows();
+  return !failed;
+}
+
+std::shared_ptr<ImageBuffer> IncrementalDecoder::acquireNextBuffer() {
+  std::lock_guard<std::mutex> autoLock(locker);
+  if (reader == nullptr || !hasNewPixels) {
+    return nullptr;
+  }
+  hasNewPixels = false;
+  return reader->acquireNextBuffer();
+}
+
+bool IncrementalDecoder::setDimensions(int width, int height) {
+  if (!info.isEmpty()) {
+    return info.width() == width && info.height() == height;
+  }
+  auto newInfo = ImageInfo::Make(width, height, ColorType::RGBA_8888, AlphaType::Unpremultiplied);
+  if (newInfo.isEmpty() || !pixels.alloc(newInfo.byteSize())) {
+    return false;
+  }
+  // The texture is updated row by row as the image decodes, which is not what hardware buffers
+  // are good at.
+  if (!bitmap.allocPixels(width, height, false, false)) {
+    pixels.reset();
+    return false;
+  }
+  pixels.clear();
+  bitmap.clear();
+  auto newReader = ImageReader::MakeFrom(bitmap);
+  std::lock_guard<std::mutex> autoLock(locker);
+  info = newInfo;
+  reader = std::move(newReader);
+  // The first acquired buffer shows the transparent image, even if no rows have been decoded yet.
+  hasNewPixels = true;
+  return true;
+}
+
+void IncrementalDecoder::setOrientation(Orientation orientation) {
+  std::lock_guard<std::mutex> autoLock(locker);
+  _orientation = orientation;
+}
+
+uint8_t* IncrementalDecoder::getRow(int row) const {
+  if (pixels.isEmpty() || row < 0 || row >= info.height()) {
+    return nullptr;
+  }
+  return pixels.bytes() + info.rowBytes() * static_cast<size_t>(row);
+}
+
+size_t IncrementalDecoder::rowBytes() const {
+  return info.rowBytes();
+}
+
+void IncrementalDecoder::markRowsDecoded(int top, int bottom) {
+  top = std::max(top, 0);
+  bottom = std::min(bottom, info.height());
+  if (top >= bottom) {
+    return;
+  }
+  if (dirtyTop >= dirtyBottom) {
+    dirtyTop = top;
+    dirtyBottom = bottom;
+  } else {
+    dirtyTop = std::min(dirtyTop, top);
+    dirtyBottom = std::max(dirtyBottom, bottom);
+  }
+}
+
+void IncrementalDecoder::markComplete() {
+  std::lock_guard<std::mutex> autoLock(locker);
+  complete = true;
+}
+
+void IncrementalDecoder::flushDecodedRows() {
+  if (dirtyTop >= dirtyBottom) {
+    return;
+  }
+  auto rowsInfo = info.makeWH(info.width(), dirtyBottom - dirtyTop);
+  // Bitmap::writePixels() converts the rows to the premultiplied native format and marks them
+  // dirty, so the next acquired buffer only uploads these rows to the texture.
+  if (bitmap.writePixels(rowsInfo, getRow(dirtyTop), 0, dirtyTop)) {
+    hasNewPixels = true;
+  }
+  dirtyTop = dirtyBottom = 0;
+}
+}  // namespace tgfx
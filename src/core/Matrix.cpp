@@ -17,9 +17,18 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "tgfx/core/Matrix.h"
+#include <algorithm>
 #include <cfloat>
 #include "core/utils/MathExtra.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TGFX_MATRIX_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define TGFX_MATRIX_NEON
+#include <arm_neon.h>
+#endif
+
 namespace tgfx {
 
 void Matrix::reset() {
@@ -299,17 +308,111 @@ bool Matrix::invertNonIdentity(Matrix* inverse) const {
   return true;
 }
 
+/**
+ * The points are processed in pairs, with each pair loaded as one vector of (x0, y0, x1, y1). The
+ * remaining point, if any, is mapped by the scalar code.
+ */
+static void MapTranslatePoints(const float values[6], Point dst[], const Point src[], int count) {
+  int index = 0;
+#if defined(TGFX_MATRIX_SSE2)
+  auto trans = _mm_setr_ps(values[2], values[5], values[2], values[5]);
+  for (; index + 2 <= count; index += 2) {
+    auto points = _mm_loadu_ps(&src[index].x);
+    _mm_storeu_ps(&dst[index].x, _mm_add_ps(points, trans));
+  }
+#elif defined(TGFX_MATRIX_NEON)
+  float transValues[4] = {values[2], values[5], values[2], values[5]};
+  auto trans = vld1q_f32(transValues);
+  for (; index + 2 <= count; index += 2) {
+    auto points = vld1q_f32(&src[index].x);
+    vst1q_f32(&dst[index].x, vaddq_f32(points, trans));
+  }
+#endif
+  for (; index < count; index++) {
+    dst[index].set(src[index].x + values[2], src[index].y + values[5]);
+  }
+}
+
+static void MapScaleTranslatePoints(const float values[6], Point dst[], const Point src[],
+                                    int count) {
+  int index = 0;
+#if defined(TGFX_MATRIX_SSE2)
+  auto scale = _mm_setr_ps(values[0], values[4], values[0], values[4]);
+  auto trans = _mm_setr_ps(values[2], values[5], values[2], values[5]);
+  for (; index + 2 <= count; index += 2) {
+    auto points = _mm_loadu_ps(&src[index].x);
+    _mm_storeu_ps(&dst[index].x, _mm_add_ps(_mm_mul_ps(points, scale), trans));
+  }
+#elif defined(TGFX_MATRIX_NEON)
+  float scaleValues[4] = {values[0], values[4], values[0], values[4]};
+  float transValues[4] = {values[2], values[5], values[2], values[5]};
+  auto scale = vld1q_f32(scaleValues);
+  auto trans = vld1q_f32(transValues);
+  for (; index + 2 <= count; index += 2) {
+    auto points = vld1q_f32(&src[index].x);
+    vst1q_f32(&dst[index].x, vaddq_f32(vmulq_f32(points, scale), trans));
+  }
+#endif
+  for (; index < count; index++) {
+    dst[index].set(src[index].x * values[0] + values[2], src[index].y * values[4] + values[5]);
+  }
+}
+
+static void MapAffinePoints(const float values[6], Point dst[], const Point src[], int count) {
+  auto sx = values[0];
+  auto kx = values[1];
+  auto tx = values[2];
+  auto ky = values[3];
+  auto sy = values[4];
+  auto ty = values[5];
+  int index = 0;
+#if defined(TGFX_MATRIX_SSE2)
+  auto scale = _mm_setr_ps(sx, sy, sx, sy);
+  auto skew = _mm_setr_ps(kx, ky, kx, ky);
+  auto trans = _mm_setr_ps(tx, ty, tx, ty);
+  for (; index + 2 <= count; index += 2) {
+    auto points = _mm_loadu_ps(&src[index].x);
+    // Swaps x and y of each point to (y0, x0, y1, x1).
+    auto swapped = _mm_shuffle_ps(points, points, _MM_SHUFFLE(2, 3, 0, 1));
+    auto result = _mm_add_ps(_mm_add_ps(_mm_mul_ps(points, scale), _mm_mul_ps(swapped, skew)),
+                             trans);
+    _mm_storeu_ps(&dst[index].x, result);
+  }
+#elif defined(TGFX_MATRIX_NEON)
+  float scaleValues[4] = {sx, sy, sx, sy};
+  float skewValues[4] = {kx, ky, kx, ky};
+  float transValues[4] = {tx, ty, tx, ty};
+  auto scale = vld1q_f32(scaleValues);
+  auto skew = vld1q_f32(skewValues);
+  auto trans = vld1q_f32(transValues);
+  for (; index + 2 <= count; index += 2) {
+    auto points = vld1q_f32(&src[index].x);
+    auto swapped = vrev64q_f32(points);
+    auto result = vaddq_f32(vaddq_f32(vmulq_f32(points, scale), vmulq_f32(swapped, skew)), trans);
+    vst1q_f32(&dst[index].x, result);
+  }
+#endif
+  for (; index < count; index++) {
+    auto x = src[index].x * sx + src[index].y * kx + tx;
+    auto y = src[index].x * ky + src[index].y * sy + ty;
+    dst[index].set(x, y);
+  }
+}
+
+static bool IsScaleTranslate(const float values[6]) {
+  return values[1] == 0 && values[3] == 0;
+}
+
 void Matrix::mapPoints(Point dst[], const Point src[], int count) const {
-  auto tx = values[TRANS_X];
-  auto ty = values[TRANS_Y];
-  auto sx = values[SCALE_X];
-  auto sy = values[SCALE_Y];
-  auto kx = values[SKEW_X];
-  auto ky = values[SKEW_Y];
-  for (int i = 0; i < count; i++) {
-    auto x = src[i].x * sx + src[i].y * kx + tx;
-    auto y = src[i].x * ky + src[i].y * sy + ty;
-    dst[i].set(x, y);
+  if (count <= 0) {
+    return;
+  }
+  if (!IsScaleTranslate(values)) {
+    MapAffinePoints(values, dst, src, count);
+  } else if (values[SCALE_X] == 1 && values[SCALE_Y] == 1) {
+    MapTranslatePoints(values, dst, src, count);
+  } else {
+    MapScaleTranslatePoints(values, dst, src, count);
   }
 }
 
@@ -335,6 +438,10 @@ bool Matrix::rectStaysRect() const {
 }
 
 void Matrix::mapRect(Rect* dst, const Rect& src) const {
+  if (IsScaleTranslate(values)) {
+    mapRects(dst, &src, 1);
+    return;
+  }
   Point quad[4];
   quad[0].set(src.left, src.top);
   quad[1].set(src.right, src.top);
@@ -344,6 +451,64 @@ void Matrix::mapRect(Rect* dst, const Rect& src) const {
   dst->setBounds(quad, 4);
 }
 
+void Matrix::mapRects(Rect dst[], const Rect src[], int count) const {
+  if (count <= 0) {
+    return;
+  }
+  if (!IsScaleTranslate(values)) {
+    for (int i = 0; i < count; i++) {
+      mapRect(&dst[i], src[i]);
+    }
+    return;
+  }
+  auto sx = values[SCALE_X];
+  auto sy = values[SCALE_Y];
+  auto tx = values[TRANS_X];
+  auto ty = values[TRANS_Y];
+  int index = 0;
+  // Each rect is loaded as one vector of (left, top, right, bottom), mapped as two points, and then
+  // sorted by taking the min and max of the two mapped corners.
+#if defined(TGFX_MATRIX_SSE2)
+  auto scale = _mm_setr_ps(sx, sy, sx, sy);
+  auto trans = _mm_setr_ps(tx, ty, tx, ty);
+  for (; index < count; index++) {
+    auto corners = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&src[index].left), scale), trans);
+    auto swapped = _mm_shuffle_ps(corners, corners, _MM_SHUFFLE(1, 0, 3, 2));
+    auto minValues = _mm_min_ps(corners, swapped);
+    auto maxValues = _mm_max_ps(corners, swapped);
+    _mm_storeu_ps(&dst[index].left,
+                  _mm_shuffle_ps(minValues, maxValues, _MM_SHUFFLE(3, 2, 1, 0)));
+  }
+#elif defined(TGFX_MATRIX_NEON)
+  float scaleValues[4] = {sx, sy, sx, sy};
+  float transValues[4] = {tx, ty, tx, ty};
+  auto scale = vld1q_f32(scaleValues);
+  auto trans = vld1q_f32(transValues);
+  for (; index < count; index++) {
+    auto corners = vaddq_f32(vmulq_f32(vld1q_f32(&src[index].left), scale), trans);
+    auto swapped = vextq_f32(corners, corners, 2);
+    auto minValues = vminq_f32(corners, swapped);
+    auto maxValues = vmaxq_f32(corners, swapped);
+    vst1q_f32(&dst[index].left, vcombine_f32(vget_low_f32(minValues), vget_high_f32(maxValues)));
+  }
+#endif
+  for (; index < count; index++) {
+    auto left = src[index].left * sx + tx;
+    auto top = src[index].top * sy + ty;
+    auto right = src[index].right * sx + tx;
+    auto bottom = src[index].bottom * sy + ty;
+    dst[index].setLTRB(std::min(left, right), std::min(top, bottom), std::max(left, right),
+                       std::max(top, bottom));
+  }
+  for (index = 0; index < count; index++) {
+    auto& rect = dst[index];
+    // Matches Rect::setBounds(), which returns an empty rect if any corner is not finite.
+    if ((rect.left + rect.top + rect.right + rect.bottom) * 0 != 0) {
+      rect.setEmpty();
+    }
+  }
+}
+
 float Matrix::getMinScale() const {
   float results[2];
   if (getMinMaxScaleFactors(results)) {
@@ -17,6 +17,7 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "tgfx/core/Path.h"
+#include "core/PathOpCache.h"
 #include "core/PathRef.h"
 #include "core/utils/MathExtra.h"
 
@@ -464,10 +465,85 @@ void Path::addRRect(const RRect& rRect, bool reversed, unsigned int startIndex)
   writableRef()->path.addRRect(skRRect, ToSkDirection(reversed), startIndex);
 }
 
+/**
+ * Returns true if the rRect covers the whole rect. The box inset by (1 - cos(45°)) of the radii
+ * touches each corner arc at its middle point, and is therefore fully inside the rRect.
+ */
+static bool RRectContainsRect(const RRect& rRect, const Rect& rect) {
+  constexpr float InsetFactor = 1.0f - static_cast<float>(M_SQRT1_2);
+  auto innerRect = rRect.rect;
+  innerRect.inset(rRect.radii.x * InsetFactor, rRect.radii.y * InsetFactor);
+  return innerRect.contains(rect);
+}
+
+/**
+ * Computes the result of the boolean operation without the general path op algorithm if one of the
+ * operands is a rect that covers the other, or if the two paths do not overlap at all. Returns
+ * false if none of the fast paths apply.
+ */
+static bool MergeWithoutPathOp(const Path& first, const Path& second, PathOp op, Path* result) {
+  if (first.isInverseFillType() || second.isInverseFillType()) {
+    return false;
+  }
+  auto firstBounds = first.getBounds();
+  auto secondBounds = second.getBounds();
+  if (!firstBounds.intersects(secondBounds)) {
+    // The winding number of a contour is zero everywhere outside its bounds, so the contours of
+    // the two paths never affect each other.
+    switch (op) {
+      case PathOp::Intersect:
+        *result = {};
+        return true;
+      case PathOp::Difference:
+        *result = first;
+        return true;
+      default:
+        if (first.getFillType() != second.getFillType()) {
+          return false;
+        }
+        *result = first;
+        result->addPath(second);
+        return true;
+    }
+  }
+  if (op != PathOp::Intersect) {
+    return false;
+  }
+  Rect rect = {};
+  if (first.isRect(&rect)) {
+    RRect rRect = {};
+    if (rect.contains(secondBounds)) {
+      *result = second;
+      return true;
+    }
+    if (second.isRect(&rRect.rect) || (second.isRRect(&rRect) && RRectContainsRect(rRect, rect))) {
+      if (!rect.intersect(rRect.rect)) {
+        *result = {};
+        return true;
+      }
+      result->reset();
+      result->addRect(rect);
+      return true;
+    }
+  }
+  if (second.isRect(&rect)) {
+    RRect rRect = {};
+    if (rect.contains(firstBounds)) {
+      *result = first;
+      return true;
+    }
+    if (first.isRRect(&rRect) && RRectContainsRect(rRect, rect)) {
+      *result = second;
+      return true;
+    }
+  }
+  return false;
+}
+
 void Path::addPath(const Path& src, PathOp op) {
-  auto& path = writableRef()->path;
-  const auto& newPath = src.pathRef->path;
   if (op == PathOp::Append) {
+    auto& path = writableRef()->path;
+    const auto& newPath = src.pathRef->path;
     if (path.isEmpty()) {
       path = newPath;
     } else {
@@ -475,6 +551,16 @@ void Path::addPath(const Path& src, PathOp op) {
     }
     return;
   }
+  Path result = {};
+  if (MergeWithoutPathOp(*this, src, op, &result)) {
+    pathRef = result.pathRef;
+    return;
+  }
+  auto cache = PathOpCache::Get();
+  if (cache->find(*this, src, op, &result)) {
+    pathRef = result.pathRef;
+    return;
+  }
   SkPathOp pathOp;
   switch (op) {
     case PathOp::Intersect:
@@ -490,7 +576,12 @@ void Path::addPath(const Path& src, PathOp op) {
       pathOp = SkPathOp::kUnion_SkPathOp;
       break;
   }
-  Op(path, newPath, pathOp, &path);
+  if (!Op(pathRef->path, src.pathRef->path, pathOp, &result.pathRef->path)) {
+    // Keeps the original path if the operation fails, and doesn't cache the failure.
+    return;
+  }
+  cache->add(*this, src, op, result);
+  pathRef = result.pathRef;
 }
 
 void Path::reset() {
@@ -559,6 +650,7 @@ PathRef* Path::writableRef() {
   } else {
     pathRef->uniqueKey.reset();
     pathRef->resetBounds();
+    pathRef->resetContourMeasures();
   }
   return pathRef.get();
 }
@@ -0,0 +1,66 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "PathOpCache.h"
+#include "core/PathRef.h"
+
+namespace tgfx {
+static constexpr size_t MaxCacheEntries = 64;
+
+PathOpCache* PathOpCache::Get() {
+  static auto cache = new PathOpCache();
+  return cache;
+}
+
+BytesKey PathOpCache::MakeKey(const Path& first, const Path& second, PathOp op) {
+  // The domain IDs are never reused, so the key identifies the operands without keeping their
+  // unique keys alive.
+  BytesKey key(3);
+  key.write(static_cast<uint32_t>(op));
+  key.write(PathRef::GetUniqueKey(first).domainID());
+  key.write(PathRef::GetUniqueKey(second).domainID());
+  return key;
+}
+
+bool PathOpCache::find(const Path& first, const Path& second, PathOp op, Path* result) {
+  auto key = MakeKey(first, second, op);
+  std::lock_guard<std::mutex> autoLock(locker);
+  auto item = entryMap.find(key);
+  if (item == entryMap.end()) {
+    return false;
+  }
+  // Moves the entry to the front, which holds the most recently used one.
+  entries.splice(entries.begin(), entries, item->second);
+  *result = item->second->result;
+  return true;
+}
+
+void PathOpCache::add(const Path& first, const Path& second, PathOp op, const Path& result) {
+  auto key = MakeKey(first, second, op);
+  std::lock_guard<std::mutex> autoLock(locker);
+  if (entryMap.find(key) != entryMap.end()) {
+    return;
+  }
+  if (entries.size() >= MaxCacheEntries) {
+    entryMap.erase(entries.back().key);
+    entries.pop_back();
+  }
+  entries.push_front({key, result});
+  entryMap[key] = entries.begin();
+}
+}  // namespace tgfx
@@ -0,0 +1,62 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <list>
+#include <mutex>
+#include "tgfx/core/BytesKey.h"
+#include "tgfx/core/Path.h"
+
+namespace tgfx {
+/**
+ * PathOpCache keeps the results of the most recent boolean operations between paths, keyed by the
+ * unique keys of the two operands and the operation. Since a path gets a new unique key whenever it
+ * is modified, a cached result never goes stale. PathOpCache is thread-safe.
+ */
+class PathOpCache {
+ public:
+  /**
+   * Returns the shared cache instance.
+   */
+  static PathOpCache* Get();
+
+  /**
+   * Returns true and sets the result if the operation between the two paths is cached.
+   */
+  bool find(const Path& first, const Path& second, PathOp op, Path* result);
+
+  /**
+   * Caches the result of the operation between the two paths, evicting the least recently used
+   * entry if the cache is full.
+   */
+  void add(const Path& first, const Path& second, PathOp op, const Path& result);
+
+ private:
+  struct Entry {
+    BytesKey key = {};
+    Path result = {};
+  };
+
+  std::mutex locker = {};
+  std::list<Entry> entries = {};
+  BytesKeyMap<std::list<Entry>::iterator> entryMap = {};
+
+  static BytesKey MakeKey(const Path& first, const Path& second, PathOp op);
+};
+}  // namespace tgfx
@@ -17,6 +17,7 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "PathRef.h"
+#include "core/ContourMeasures.h"
 #include "tgfx/core/Path.h"
 
 namespace tgfx {
@@ -34,8 +35,24 @@ UniqueKey PathRef::GetUniqueKey(const Path& path) {
   return path.pathRef->uniqueKey.get();
 }
 
+ContourMeasures* PathRef::GetContourMeasures(const Path& path) {
+  auto pathRef = path.pathRef.get();
+  auto measures = pathRef->contourMeasures.load(std::memory_order_acquire);
+  if (measures == nullptr) {
+    auto newMeasures = new ContourMeasures(pathRef->path);
+    if (pathRef->contourMeasures.compare_exchange_strong(measures, newMeasures,
+                                                         std::memory_order_acq_rel)) {
+      measures = newMeasures;
+    } else {
+      delete newMeasures;
+    }
+  }
+  return measures;
+}
+
 PathRef::~PathRef() {
   resetBounds();
+  resetContourMeasures();
 }
 
 Rect PathRef::getBounds() {
@@ -63,4 +80,9 @@ void PathRef::resetBounds() {
   auto oldBounds = bounds.exchange(nullptr, std::memory_order_acq_rel);
   delete oldBounds;
 }
-}  // namespace tgfx
\ No newline at end of file
+
+void PathRef::resetContourMeasures() {
+  auto oldMeasures = contourMeasures.exchange(nullptr, std::memory_order_acq_rel);
+  delete oldMeasures;
+}
+}  // namespace tgfx
@@ -23,6 +23,7 @@
 
 namespace tgfx {
 class Path;
+class ContourMeasures;
 struct Rect;
 
 class PathRef {
@@ -33,6 +34,12 @@ class PathRef {
 
   static UniqueKey GetUniqueKey(const Path& path);
 
+  /**
+   * Returns the contour measures of the path, which are created on first use and kept until the
+   * path is modified. The returned object is owned by the path.
+   */
+  static ContourMeasures* GetContourMeasures(const Path& path);
+
   PathRef() = default;
 
   explicit PathRef(const pk::SkPath& path) : path(path) {
@@ -45,10 +52,13 @@ class PathRef {
  private:
   LazyUniqueKey uniqueKey = {};
   std::atomic<Rect*> bounds = {nullptr};
+  std::atomic<ContourMeasures*> contourMeasures = {nullptr};
   pk::SkPath path = {};
 
   void resetBounds();
 
+  void resetContourMeasures();
+
   friend bool operator==(const Path& a, const Path& b);
   friend bool operator!=(const Path& a, const Path& b);
   friend class Path;
@@ -17,6 +17,7 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "Rasterizer.h"
+#include "core/DistanceFieldRasterizer.h"
 #include "core/GlyphRasterizer.h"
 #include "core/ShapeRasterizer.h"
 
@@ -32,6 +33,15 @@ std::shared_ptr<Rasterizer> Rasterizer::MakeFrom(int width, int height,
                                            matrix, stroke);
 }
 
+std::shared_ptr<Rasterizer> Rasterizer::MakeDistanceField(
+    int width, int height, std::shared_ptr<GlyphRunList> glyphRunList, const Matrix& matrix) {
+  if (glyphRunList == nullptr || !glyphRunList->hasOutlines() || width <= 0 || height <= 0) {
+    return nullptr;
+  }
+  return std::make_shared<DistanceFieldRasterizer>(width, height, std::move(glyphRunList),
+                                                   matrix);
+}
+
 std::shared_ptr<Rasterizer> Rasterizer::MakeFrom(int width, int height, Path path, bool antiAlias,
                                                  const Matrix& matrix, const Stroke* stroke) {
   if (width <= 0 || height <= 0) {
@@ -36,6 +36,14 @@ class Rasterizer : public ImageGenerator {
                                               std::shared_ptr<GlyphRunList> glyphRunList,
                                               bool antiAlias, const Matrix& matrix,
                                               const Stroke* stroke = nullptr);
+  /**
+   * Creates a Rasterizer that generates a signed distance field from the outlines of a
+   * GlyphRunList instead of a coverage mask. Returns nullptr if the glyphs have no outlines.
+   */
+  static std::shared_ptr<Rasterizer> MakeDistanceField(int width, int height,
+                                                       std::shared_ptr<GlyphRunList> glyphRunList,
+                                                       const Matrix& matrix);
+
   /**
    * Creates a Rasterizer from a Path.
    */
@@ -28,22 +28,10 @@ class EmptyScalerContext : public ScalerContext {
     return {};
   }
 
-  Rect getBounds(GlyphID, bool, bool) const override {
-    return Rect::MakeEmpty();
-  }
-
-  float getAdvance(GlyphID, bool) const override {
-    return 0.0f;
-  }
-
   Point getVerticalOffset(GlyphID) const override {
     return Point::Zero();
   }
 
-  bool generatePath(GlyphID, bool, bool, Path*) const override {
-    return false;
-  }
-
   Rect getImageTransform(GlyphID, Matrix*) const override {
     return Rect::MakeEmpty();
   }
@@ -51,6 +39,19 @@ class EmptyScalerContext : public ScalerContext {
   std::shared_ptr<ImageBuffer> generateImage(GlyphID, bool) const override {
     return nullptr;
   }
+
+ protected:
+  Rect onGetBounds(GlyphID, bool, bool) const override {
+    return Rect::MakeEmpty();
+  }
+
+  float onGetAdvance(GlyphID, bool) const override {
+    return 0.0f;
+  }
+
+  bool onGeneratePath(GlyphID, bool, bool, Path*) const override {
+    return false;
+  }
 };
 
 std::shared_ptr<ScalerContext> ScalerContext::MakeEmpty(float size) {
@@ -86,6 +87,6 @@ std::shared_ptr<ScalerContext> ScalerContext::Make(std::shared_ptr<Typeface> typ
 }
 
 ScalerContext::ScalerContext(std::shared_ptr<Typeface> typeface, float size)
-    : typeface(std::move(typeface)), textSize(size) {
+    : typeface(std::move(typeface)), textSize(size), glyphCache(this) {
 }
 }  // namespace tgfx
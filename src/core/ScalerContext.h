@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include "core/GlyphCache.h"
 #include "tgfx/core/FontMetrics.h"
 #include "tgfx/core/Image.h"
 #include "tgfx/core/Path.h"
@@ -52,13 +53,28 @@ class ScalerContext {
 
   virtual FontMetrics getFontMetrics() const = 0;
 
-  virtual Rect getBounds(GlyphID glyphID, bool fauxBold, bool fauxItalic) const = 0;
+  /**
+   * Returns the bounds of the glyph. The result is cached after the first request.
+   */
+  Rect getBounds(GlyphID glyphID, bool fauxBold, bool fauxItalic) const {
+    return glyphCache.getBounds(glyphID, fauxBold, fauxItalic);
+  }
 
-  virtual float getAdvance(GlyphID glyphID, bool verticalText) const = 0;
+  /**
+   * Returns the advance of the glyph. The result is cached after the first request.
+   */
+  float getAdvance(GlyphID glyphID, bool verticalText) const {
+    return glyphCache.getAdvance(glyphID, verticalText);
+  }
 
   virtual Point getVerticalOffset(GlyphID glyphID) const = 0;
 
-  virtual bool generatePath(GlyphID glyphID, bool fauxBold, bool fauxItalic, Path* path) const = 0;
+  /**
+   * Generates the outline path of the glyph. The result is cached after the first request.
+   */
+  bool generatePath(GlyphID glyphID, bool fauxBold, bool fauxItalic, Path* path) const {
+    return glyphCache.getPath(glyphID, fauxBold, fauxItalic, path);
+  }
 
   virtual Rect getImageTransform(GlyphID glyphID, Matrix* matrix) const = 0;
 
@@ -71,9 +87,19 @@ class ScalerContext {
 
   ScalerContext(std::shared_ptr<Typeface> typeface, float size);
 
+  virtual Rect onGetBounds(GlyphID glyphID, bool fauxBold, bool fauxItalic) const = 0;
+
+  virtual float onGetAdvance(GlyphID glyphID, bool verticalText) const = 0;
+
+  virtual bool onGeneratePath(GlyphID glyphID, bool fauxBold, bool fauxItalic,
+                              Path* path) const = 0;
+
  private:
+  mutable GlyphCache glyphCache;
+
   static std::shared_ptr<ScalerContext> CreateNew(std::shared_ptr<Typeface> typeface, float size);
 
   friend class Font;
+  friend class GlyphCache;
 };
 }  // namespace tgfx
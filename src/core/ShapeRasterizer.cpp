@@ -17,11 +17,138 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "ShapeRasterizer.h"
+#include <algorithm>
 #include "core/PathTriangulator.h"
+#include "core/utils/TaskGroup.h"
+#include "tgfx/core/Buffer.h"
 #include "tgfx/core/Mask.h"
 #include "utils/Log.h"
 
 namespace tgfx {
+// Paths below this size tessellate in a fraction of a millisecond, where the cost of splitting
+// them and scheduling the groups on other threads outweighs the gain.
+static constexpr int MinParallelVerbs = 2000;
+static constexpr int MinGroupVerbs = 500;
+static constexpr int MaxGroupCount = 16;
+
+struct Contour {
+  Path path = {};
+  Rect bounds = {};
+  int verbs = 0;
+};
+
+static std::vector<Contour> SplitContours(const Path& path) {
+  std::vector<Contour> contours = {};
+  auto iterator = [&](PathVerb verb, const Point points[4], void*) {
+    if (verb == PathVerb::Move || contours.empty()) {
+      contours.emplace_back();
+      contours.back().path.setFillType(path.getFillType());
+    }
+    auto& contour = contours.back();
+    contour.verbs++;
+    switch (verb) {
+      case PathVerb::Move:
+        contour.path.moveTo(points[0]);
+        break;
+      case PathVerb::Line:
+        contour.path.lineTo(points[1]);
+        break;
+      case PathVerb::Quad:
+        contour.path.quadTo(points[1], points[2]);
+        break;
+      case PathVerb::Cubic:
+        contour.path.cubicTo(points[1], points[2], points[3]);
+        break;
+      case PathVerb::Close:
+        contour.path.close();
+        break;
+    }
+  };
+  path.decompose(iterator);
+  for (auto& contour : contours) {
+    contour.bounds = contour.path.getBounds();
+    // Leave room for the antialiasing ramps so that neighboring groups never touch each other.
+    contour.bounds.outset(1.0f, 1.0f);
+  }
+  return contours;
+}
+
+/**
+ * Sorts the contours along one axis and returns the index ranges of the runs whose bounds do not
+ * overlap any other run on that axis. Contours in different runs can be tessellated independently
+ * without changing the winding of any pixel.
+ */
+static std::vector<std::pair<size_t, size_t>> SortIntoDisjointRuns(std::vector<Contour>* contours,
+                                                                   bool vertical) {
+  auto start = [vertical](const Contour& contour) {
+    return vertical ? contour.bounds.top : contour.bounds.left;
+  };
+  auto end = [vertical](const Contour& contour) {
+    return vertical ? contour.bounds.bottom : contour.bounds.right;
+  };
+  std::sort(contours->begin(), contours->end(),
+            [&](const Contour& a, const Contour& b) { return start(a) < start(b); });
+  std::vector<std::pair<size_t, size_t>> runs = {};
+  float runEnd = 0;
+  for (size_t i = 0; i < contours->size(); i++) {
+    auto& contour = (*contours)[i];
+    if (runs.empty() || start(contour) >= runEnd) {
+      runs.emplace_back(i, i + 1);
+      runEnd = end(contour);
+    } else {
+      runs.back().second = i + 1;
+      runEnd = std::max(runEnd, end(contour));
+    }
+  }
+  return runs;
+}
+
+std::vector<Path> ShapeRasterizer::SplitIntoGroups(const Path& path, int threadCount) {
+  if (path.isInverseFillType() || path.countVerbs() < MinParallelVerbs) {
+    return {};
+  }
+  auto maxGroupCount = std::min({threadCount, MaxGroupCount, path.countVerbs() / MinGroupVerbs});
+  if (maxGroupCount <= 1) {
+    return {};
+  }
+  auto contours = SplitContours(path);
+  if (contours.size() <= 1) {
+    return {};
+  }
+  auto runs = SortIntoDisjointRuns(&contours, false);
+  if (runs.size() <= 1) {
+    runs = SortIntoDisjointRuns(&contours, true);
+    if (runs.size() <= 1) {
+      return {};
+    }
+  }
+  // Merge adjacent runs until each group carries its share of the verbs.
+  auto groupVerbs = path.countVerbs() / maxGroupCount;
+  std::vector<Path> groups = {};
+  Path group = {};
+  group.setFillType(path.getFillType());
+  int verbs = 0;
+  for (auto& run : runs) {
+    for (auto i = run.first; i < run.second; i++) {
+      group.addPath(contours[i].path);
+      verbs += contours[i].verbs;
+    }
+    if (verbs >= groupVerbs) {
+      groups.push_back(std::move(group));
+      group = {};
+      group.setFillType(path.getFillType());
+      verbs = 0;
+    }
+  }
+  if (verbs > 0) {
+    groups.push_back(std::move(group));
+  }
+  if (groups.size() <= 1) {
+    return {};
+  }
+  return groups;
+}
+
 ShapeRasterizer::ShapeRasterizer(int width, int height, std::shared_ptr<Shape> shape,
                                  bool antiAlias)
     : Rasterizer(width, height), shape(std::move(shape)), antiAlias(antiAlias) {
@@ -34,7 +161,8 @@ std::shared_ptr<ShapeBuffer> ShapeRasterizer::makeRasterized(bool tryHardware) c
     finalPath.addRect(Rect::MakeWH(width(), height()));
   }
   if (PathTriangulator::ShouldTriangulatePath(finalPath)) {
-    return ShapeBuffer::MakeFrom(makeTriangles(finalPath));
+    static const int CPUCores = GetCPUCores();
+    return ShapeBuffer::MakeFrom(makeTriangles(finalPath, CPUCores));
   }
   return ShapeBuffer::MakeFrom(makeImageBuffer(finalPath, tryHardware));
 }
@@ -44,20 +172,52 @@ std::shared_ptr<ImageBuffer> ShapeRasterizer::onMakeBuffer(bool tryHardware) con
   return makeImageBuffer(finalPath, tryHardware);
 }
 
-std::shared_ptr<Data> ShapeRasterizer::makeTriangles(const Path& finalPath) const {
-  std::vector<float> vertices = {};
-  size_t count = 0;
+size_t ShapeRasterizer::triangulate(const Path& path, std::vector<float>* vertices) const {
   auto bounds = Rect::MakeWH(width(), height());
   if (antiAlias) {
-    count = PathTriangulator::ToAATriangles(finalPath, bounds, &vertices);
-  } else {
-    count = PathTriangulator::ToTriangles(finalPath, bounds, &vertices);
+    return PathTriangulator::ToAATriangles(path, bounds, vertices);
   }
-  if (count == 0) {
-    // The path is not a filled path, or it is invisible.
+  return PathTriangulator::ToTriangles(path, bounds, vertices);
+}
+
+std::shared_ptr<Data> ShapeRasterizer::makeTriangles(const Path& finalPath,
+                                                     int threadCount) const {
+  auto groups = SplitIntoGroups(finalPath, threadCount);
+  if (groups.empty()) {
+    std::vector<float> vertices = {};
+    if (triangulate(finalPath, &vertices) == 0) {
+      // The path is not a filled path, or it is invisible.
+      return nullptr;
+    }
+    return Data::MakeWithCopy(vertices.data(), vertices.size() * sizeof(float));
+  }
+  // The groups do not overlap each other, so their meshes can be generated independently and
+  // simply concatenated. The first group runs on the calling thread.
+  std::vector<std::vector<float>> groupVertices(groups.size());
+  std::vector<std::shared_ptr<Task>> tasks = {};
+  for (size_t i = 1; i < groups.size(); i++) {
+    tasks.push_back(Task::Run([this, &groups, &groupVertices, i]() {
+      triangulate(groups[i], &groupVertices[i]);
+    }));
+  }
+  triangulate(groups[0], &groupVertices[0]);
+  size_t totalSize = groupVertices[0].size();
+  for (size_t i = 1; i < groups.size(); i++) {
+    // A group that has not been picked up by a worker yet runs on the calling thread.
+    tasks[i - 1]->wait();
+    totalSize += groupVertices[i].size();
+  }
+  if (totalSize == 0) {
     return nullptr;
   }
-  return Data::MakeWithCopy(vertices.data(), vertices.size() * sizeof(float));
+  Buffer buffer(totalSize * sizeof(float));
+  size_t offset = 0;
+  for (auto& vertices : groupVertices) {
+    auto size = vertices.size() * sizeof(float);
+    buffer.writeRange(offset, size, vertices.data());
+    offset += size;
+  }
+  return buffer.release();
 }
 
 std::shared_ptr<ImageBuffer> ShapeRasterizer::makeImageBuffer(const Path& finalPath,
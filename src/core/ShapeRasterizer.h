@@ -49,7 +49,18 @@ class ShapeRasterizer : public Rasterizer {
   std::shared_ptr<Shape> shape = nullptr;
   bool antiAlias = true;
 
-  std::shared_ptr<Data> makeTriangles(const Path& finalPath) const;
+  /**
+   * Splits the path into at most threadCount paths whose bounds do not overlap each other, with
+   * roughly the same number of verbs in each. Returns an empty list if the path cannot be split.
+   */
+  static std::vector<Path> SplitIntoGroups(const Path& path, int threadCount);
+
+  size_t triangulate(const Path& path, std::vector<float>* vertices) const;
+
+  /**
+   * Triangulates the path, splitting it across up to threadCount threads if it is large enough.
+   */
+  std::shared_ptr<Data> makeTriangles(const Path& finalPath, int threadCount) const;
 
   std::shared_ptr<ImageBuffer> makeImageBuffer(const Path& finalPath, bool tryHardware) const;
 };
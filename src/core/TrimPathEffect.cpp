@@ -17,8 +17,8 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "TrimPathEffect.h"
+#include "core/ContourMeasures.h"
 #include "core/PathRef.h"
-#include "tgfx/core/PathMeasure.h"
 
 namespace tgfx {
 using namespace pk;
@@ -43,12 +43,15 @@ bool TrimPathEffect::filterPath(Path* path) const {
     path->reset();
     return true;
   }
-  auto pathMeasure = PathMeasure::MakeFrom(*path);
-  auto length = pathMeasure->getLength();
+  // The measures are cached on the path, so trimming the same path again with different values
+  // only walks the segments within the trimmed range.
+  auto measures = PathRef::GetContourMeasures(*path);
+  auto contour = measures->firstContour();
+  auto length = measures->getLength(contour);
   auto start = startT * length;
   auto end = stopT * length;
   Path tempPath = {};
-  if (!pathMeasure->getSegment(start, end, &tempPath)) {
+  if (!measures->getSegment(contour, start, end, &PathRef::WriteAccess(tempPath), true)) {
     return false;
   }
   *path = std::move(tempPath);
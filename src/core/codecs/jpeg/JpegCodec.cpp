@@ -17,8 +17,12 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "core/codecs/jpeg/JpegCodec.h"
+#include <algorithm>
 #include <csetjmp>
+#include <vector>
+#include "core/utils/MappedFile.h"
 #include "core/utils/OrientationHelper.h"
+#include "core/utils/ParallelRows.h"
 #include "tgfx/core/Buffer.h"
 #include "tgfx/core/Data.h"
 #include "tgfx/core/Pixmap.h"
@@ -69,6 +73,11 @@ struct my_error_mgr {
 };
 
 std::shared_ptr<ImageCodec> JpegCodec::MakeFrom(const std::string& filePath) {
+  // Decoding from the mapped bytes avoids reopening and rereading the file on every decode.
+  auto fileData = MapFile(filePath, FileAccess::Sequential);
+  if (fileData != nullptr) {
+    return MakeFromData("", std::move(fileData));
+  }
   return MakeFromData(filePath, nullptr);
 }
 
@@ -86,6 +95,7 @@ std::shared_ptr<ImageCodec> JpegCodec::MakeFromData(const std::string& filePath,
   my_error_mgr jerr = {};
   cinfo.err = jpeg_std_error(&jerr.pub);
   Orientation orientation = Orientation::TopLeft;
+  bool progressive = false;
   do {
     if (setjmp(jerr.setjmp_buffer)) break;
     jpeg_create_decompress(&cinfo);
@@ -97,6 +107,7 @@ std::shared_ptr<ImageCodec> JpegCodec::MakeFromData(const std::string& filePath,
     jpeg_save_markers(&cinfo, kExifMarker, 0xFFFF);
     if (jpeg_read_header(&cinfo, TRUE) != JPEG_HEADER_OK) break;
     orientation = get_exif_orientation(&cinfo);
+    progressive = jpeg_has_multiple_scans(&cinfo);
   } while (false);
   jpeg_destroy_decompress(&cinfo);
   if (infile) fclose(infile);
@@ -105,15 +116,49 @@ std::shared_ptr<ImageCodec> JpegCodec::MakeFromData(const std::string& filePath,
   }
   return std::shared_ptr<ImageCodec>(new JpegCodec(static_cast<int>(cinfo.image_width),
                                                    static_cast<int>(cinfo.image_height),
-                                                   orientation, filePath, std::move(byteData)));
+                                                   orientation, filePath, std::move(byteData),
+                                                   progressive));
+}
+
+/**
+ * libjpeg can scale the image by 1/2, 1/4, and 1/8 during the inverse DCT at almost no extra cost,
+ * which is the fastest way to get a downscaled image out of a JPEG file.
+ */
+static constexpr int MaxScaleDenom = 8;
+
+static int GetScaledSize(int size, int scaleDenom) {
+  // Matches the jdiv_round_up() used by libjpeg to compute the output dimensions.
+  return (size + scaleDenom - 1) / scaleDenom;
+}
+
+ISize JpegCodec::getScaledDimensions(float scale) const {
+  int scaleDenom = 1;
+  while (scaleDenom < MaxScaleDenom && scale * static_cast<float>(scaleDenom * 2) <= 1.0f) {
+    scaleDenom *= 2;
+  }
+  return ISize::Make(GetScaledSize(width(), scaleDenom), GetScaledSize(height(), scaleDenom));
 }
 
 bool JpegCodec::readPixels(const ImageInfo& dstInfo, void* dstPixels) const {
+  return decodePixels(dstInfo, dstPixels, 1);
+}
+
+bool JpegCodec::readScaledPixels(const ImageInfo& dstInfo, void* dstPixels) const {
+  for (int scaleDenom = 1; scaleDenom <= MaxScaleDenom; scaleDenom *= 2) {
+    if (dstInfo.width() == GetScaledSize(width(), scaleDenom) &&
+        dstInfo.height() == GetScaledSize(height(), scaleDenom)) {
+      return decodePixels(dstInfo, dstPixels, scaleDenom);
+    }
+  }
+  return false;
+}
+
+bool JpegCodec::decodePixels(const ImageInfo& dstInfo, void* dstPixels, int scaleDenom) const {
   if (dstPixels == nullptr || dstInfo.isEmpty()) {
     return false;
   }
   if (dstInfo.colorType() == ColorType::ALPHA_8) {
-    memset(dstPixels, 255, dstInfo.rowBytes() * static_cast<size_t>(height()));
+    memset(dstPixels, 255, dstInfo.rowBytes() * static_cast<size_t>(dstInfo.height()));
     return true;
   }
   Bitmap bitmap = {};
@@ -146,6 +191,31 @@ bool JpegCodec::readPixels(const ImageInfo& dstInfo, void* dstPixels) const {
     outPixels = pixmap.writablePixels();
     outRowBytes = pixmap.rowBytes();
   }
+  // Large images are split into row bands decoded by separate decompressors on the task pool.
+  // libjpeg cannot start decoding at a restart marker, so every band still entropy-decodes the rows
+  // above it, but the inverse DCT, upsampling, and color conversion of each band run in parallel.
+  // Progressive images are excluded, as skipping their rows requires decoding all scans first.
+  auto bandCount = progressive ? 1 : GetParallelBandCount(dstInfo.width(), dstInfo.height());
+  return ParallelForRows(dstInfo.height(), bandCount, [&](int top, int bottom) {
+    if (!decodeRows(out_color_space, scaleDenom, top, bottom, outPixels, outRowBytes)) {
+      return false;
+    }
+    if (pixmap.isEmpty()) {
+      return true;
+    }
+    auto rowCount = bottom - top;
+    auto srcInfo = pixmap.info().makeWH(pixmap.width(), rowCount);
+    auto srcPixels = static_cast<const uint8_t*>(pixmap.pixels()) +
+                     pixmap.rowBytes() * static_cast<size_t>(top);
+    auto dstPixmapPixels = static_cast<uint8_t*>(dstPixels) +
+                           dstInfo.rowBytes() * static_cast<size_t>(top);
+    return Pixmap(srcInfo, srcPixels)
+        .readPixels(dstInfo.makeWH(dstInfo.width(), rowCount), dstPixmapPixels);
+  });
+}
+
+bool JpegCodec::decodeRows(int colorSpace, int scaleDenom, int top, int bottom, void* outPixels,
+                           size_t rowBytes) const {
   FILE* infile = nullptr;
   if (fileData == nullptr && (infile = fopen(filePath.c_str(), "rb")) == nullptr) {
     return false;
@@ -165,31 +235,416 @@ bool JpegCodec::readPixels(const ImageInfo& dstInfo, void* dstPixels) const {
     if (jpeg_read_header(&cinfo, TRUE) != JPEG_HEADER_OK) {
       break;
     }
-    cinfo.out_color_space = out_color_space;
+    cinfo.out_color_space = static_cast<J_COLOR_SPACE>(colorSpace);
+    cinfo.scale_num = 1;
+    cinfo.scale_denom = static_cast<unsigned int>(scaleDenom);
     if (!jpeg_start_decompress(&cinfo)) {
       break;
     }
+    auto startLine = static_cast<JDIMENSION>(top);
+    auto endLine = std::min(static_cast<JDIMENSION>(bottom), cinfo.output_height);
+    if (startLine > 0 && jpeg_skip_scanlines(&cinfo, startLine) != startLine) {
+      break;
+    }
     JSAMPROW pRow[1];
-    int line = 0;
-    JDIMENSION h = static_cast<JDIMENSION>(height());
-    while (cinfo.output_scanline < h) {
+    while (cinfo.output_scanline < endLine) {
       pRow[0] = (JSAMPROW)(static_cast<unsigned char*>(outPixels) +
-                           outRowBytes * static_cast<size_t>(line));
-      jpeg_read_scanlines(&cinfo, pRow, 1);
+                           rowBytes * static_cast<size_t>(cinfo.output_scanline));
+      if (jpeg_read_scanlines(&cinfo, pRow, 1) != 1) {
+        break;
+      }
+    }
+    if (cinfo.output_scanline < endLine) {
+      break;
+    }
+    if (endLine == cinfo.output_height) {
+      result = jpeg_finish_decompress(&cinfo);
+    } else {
+      jpeg_abort_decompress(&cinfo);
+      result = true;
+    }
+  } while (false);
+  jpeg_destroy_decompress(&cinfo);
+  if (infile) {
+    fclose(infile);
+  }
+  return result;
+}
+
+bool JpegCodec::onReadRegion(const ISize& scaledSize, const Rect& region,
+                             const ImageInfo& dstInfo, void* dstPixels) const {
+  int scaleDenom = 1;
+  while (scaleDenom <= MaxScaleDenom &&
+         (GetScaledSize(width(), scaleDenom) != scaledSize.width ||
+          GetScaledSize(height(), scaleDenom) != scaledSize.height)) {
+    scaleDenom *= 2;
+  }
+  if (scaleDenom > MaxScaleDenom) {
+    return false;
+  }
+  auto left = static_cast<JDIMENSION>(region.left);
+  auto top = static_cast<JDIMENSION>(region.top);
+  auto regionWidth = static_cast<JDIMENSION>(region.width());
+  auto regionHeight = static_cast<JDIMENSION>(region.height());
+  FILE* infile = nullptr;
+  if (fileData == nullptr && (infile = fopen(filePath.c_str(), "rb")) == nullptr) {
+    return false;
+  }
+  jpeg_decompress_struct cinfo = {};
+  my_error_mgr jerr = {};
+  cinfo.err = jpeg_std_error(&jerr.pub);
+  Buffer buffer = {};
+  bool result = false;
+  bool rgbaSupported = true;
+  do {
+    if (setjmp(jerr.setjmp_buffer)) break;
+    jpeg_create_decompress(&cinfo);
+    if (infile) {
+      jpeg_stdio_src(&cinfo, infile);
+    } else {
+      jpeg_mem_src(&cinfo, fileData->bytes(), fileData->size());
+    }
+    if (jpeg_read_header(&cinfo, TRUE) != JPEG_HEADER_OK) {
+      break;
+    }
+    // libjpeg cannot convert CMYK and YCCK images to RGBA, so they are left to the full decode.
+    if (cinfo.jpeg_color_space == JCS_CMYK || cinfo.jpeg_color_space == JCS_YCCK) {
+      rgbaSupported = false;
+      break;
+    }
+    cinfo.out_color_space = JCS_EXT_RGBA;
+    cinfo.scale_num = 1;
+    cinfo.scale_denom = static_cast<unsigned int>(scaleDenom);
+    if (!jpeg_start_decompress(&cinfo)) {
+      break;
+    }
+    // Only the iMCU columns covering the region are decoded. The crop offset is moved to the left
+    // iMCU boundary, so the region starts somewhere in the middle of each output row.
+    auto cropLeft = left;
+    auto cropWidth = regionWidth;
+    jpeg_crop_scanline(&cinfo, &cropLeft, &cropWidth);
+    auto rowBytes = static_cast<size_t>(cinfo.output_width) * 4;
+    auto info = ImageInfo::Make(static_cast<int>(regionWidth), static_cast<int>(regionHeight),
+                                ColorType::RGBA_8888, AlphaType::Opaque, rowBytes);
+    if (!buffer.alloc(rowBytes * regionHeight)) {
+      break;
+    }
+    // The rows above the region are skipped without running the inverse DCT.
+    if (top > 0 && jpeg_skip_scanlines(&cinfo, top) != top) {
+      break;
+    }
+    auto columnOffset = static_cast<size_t>(left - cropLeft) * 4;
+    JSAMPROW pRow[1];
+    JDIMENSION line = 0;
+    while (line < regionHeight) {
+      pRow[0] = buffer.bytes() + rowBytes * line;
+      if (jpeg_read_scanlines(&cinfo, pRow, 1) != 1) {
+        break;
+      }
       line++;
     }
-    result = jpeg_finish_decompress(&cinfo);
+    if (line < regionHeight) {
+      break;
+    }
+    Pixmap pixmap(info, buffer.bytes() + columnOffset);
+    result = pixmap.readPixels(dstInfo, dstPixels);
+    // The rows below the region are never read, so the decompression is aborted instead of being
+    // finished.
+    jpeg_abort_decompress(&cinfo);
   } while (false);
   jpeg_destroy_decompress(&cinfo);
   if (infile) {
     fclose(infile);
   }
-  if (result && !pixmap.isEmpty()) {
-    pixmap.readPixels(dstInfo, dstPixels);
+  if (!rgbaSupported) {
+    return ImageCodec::onReadRegion(scaledSize, region, dstInfo, dstPixels);
   }
   return result;
 }
 
+/**
+ * Returns true if the image is encoded in YCbCr with 4:2:0 chroma subsampling, which maps directly
+ * to the I420 format.
+ */
+static bool IsI420Compatible(const jpeg_decompress_struct& cinfo) {
+  if (cinfo.jpeg_color_space != JCS_YCbCr || cinfo.num_components != 3) {
+    return false;
+  }
+  auto component = cinfo.comp_info;
+  return component[0].h_samp_factor == 2 && component[0].v_samp_factor == 2 &&
+         component[1].h_samp_factor == 1 && component[1].v_samp_factor == 1 &&
+         component[2].h_samp_factor == 1 && component[2].v_samp_factor == 1;
+}
+
+static void ReleaseYUVPlanes(void*, const void** data, size_t) {
+  free(const_cast<void*>(data[0]));
+}
+
+std::shared_ptr<YUVData> JpegCodec::readYUVData(YUVColorSpace* colorSpace) const {
+  FILE* infile = nullptr;
+  if (fileData == nullptr && (infile = fopen(filePath.c_str(), "rb")) == nullptr) {
+    return nullptr;
+  }
+  jpeg_decompress_struct cinfo = {};
+  my_error_mgr jerr = {};
+  cinfo.err = jpeg_std_error(&jerr.pub);
+  // The planes are allocated after setjmp() and freed after a longjmp(), so the pointer must be
+  // volatile to keep its value from being cached in a register that longjmp() restores.
+  uint8_t* volatile planes = nullptr;
+  std::shared_ptr<YUVData> yuvData = nullptr;
+  do {
+    if (setjmp(jerr.setjmp_buffer)) break;
+    jpeg_create_decompress(&cinfo);
+    if (infile) {
+      jpeg_stdio_src(&cinfo, infile);
+    } else {
+      jpeg_mem_src(&cinfo, fileData->bytes(), fileData->size());
+    }
+    if (jpeg_read_header(&cinfo, TRUE) != JPEG_HEADER_OK || !IsI420Compatible(cinfo)) {
+      break;
+    }
+    // Skips the color conversion and chroma upsampling, the samples are returned as stored in the
+    // file, one plane per component.
+    cinfo.raw_data_out = TRUE;
+    if (!jpeg_start_decompress(&cinfo)) {
+      break;
+    }
+    // jpeg_read_raw_data() always outputs whole iMCU rows of 16 luma lines and 8 chroma lines,
+    // padded to whole DCT blocks horizontally, so the planes are allocated with the same padding.
+    auto yRowBytes = static_cast<size_t>(cinfo.comp_info[0].width_in_blocks) * DCTSIZE;
+    auto uvRowBytes = static_cast<size_t>(cinfo.comp_info[1].width_in_blocks) * DCTSIZE;
+    auto mcuRows = (cinfo.output_height + 2 * DCTSIZE - 1) / (2 * DCTSIZE);
+    auto yRows = static_cast<size_t>(mcuRows) * 2 * DCTSIZE;
+    auto uvRows = static_cast<size_t>(mcuRows) * DCTSIZE;
+    auto ySize = yRowBytes * yRows;
+    auto uvSize = uvRowBytes * uvRows;
+    planes = static_cast<uint8_t*>(malloc(ySize + uvSize * 2));
+    if (planes == nullptr) {
+      break;
+    }
+    uint8_t* planeAddresses[3] = {planes, planes + ySize, planes + ySize + uvSize};
+    JSAMPROW yRowPointers[2 * DCTSIZE];
+    JSAMPROW uRowPointers[DCTSIZE];
+    JSAMPROW vRowPointers[DCTSIZE];
+    JSAMPARRAY rowPointers[3] = {yRowPointers, uRowPointers, vRowPointers};
+    while (cinfo.output_scanline < cinfo.output_height) {
+      auto yRow = static_cast<size_t>(cinfo.output_scanline);
+      for (size_t i = 0; i < 2 * DCTSIZE; i++) {
+        yRowPointers[i] = planeAddresses[0] + (yRow + i) * yRowBytes;
+      }
+      for (size_t i = 0; i < DCTSIZE; i++) {
+        uRowPointers[i] = planeAddresses[1] + (yRow / 2 + i) * uvRowBytes;
+        vRowPointers[i] = planeAddresses[2] + (yRow / 2 + i) * uvRowBytes;
+      }
+      if (jpeg_read_raw_data(&cinfo, rowPointers, 2 * DCTSIZE) == 0) {
+        break;
+      }
+    }
+    if (cinfo.output_scanline < cinfo.output_height || !jpeg_finish_decompress(&cinfo)) {
+      break;
+    }
+    const void* data[3] = {planeAddresses[0], planeAddresses[1], planeAddresses[2]};
+    size_t rowBytes[3] = {yRowBytes, uvRowBytes, uvRowBytes};
+    yuvData = YUVData::MakeFrom(static_cast<int>(cinfo.output_width),
+                                static_cast<int>(cinfo.output_height), data, rowBytes,
+                                YUVData::I420_PLANE_COUNT, ReleaseYUVPlanes);
+  } while (false);
+  jpeg_destroy_decompress(&cinfo);
+  if (infile) {
+    fclose(infile);
+  }
+  if (yuvData == nullptr) {
+    free(planes);
+    return nullptr;
+  }
+  if (colorSpace != nullptr) {
+    *colorSpace = YUVColorSpace::JPEG_FULL;
+  }
+  return yuvData;
+}
+
+static void JpegErrorExit(j_common_ptr cinfo) {
+  auto error = reinterpret_cast<my_error_mgr*>(cinfo->err);
+  longjmp(error->setjmp_buffer, 1);
+}
+
+/**
+ * A data source that suspends the decompressor whenever it runs out of bytes, instead of treating
+ * the end of the data as the end of the image. The decompressor then backs up to the last complete
+ * unit and resumes from there once more bytes are appended.
+ */
+struct SuspendingSource {
+  jpeg_source_mgr pub = {};
+  std::vector<uint8_t> bytes = {};
+  size_t bytesToSkip = 0;
+
+  SuspendingSource() {
+    pub.init_source = [](j_decompress_ptr) {};
+    pub.fill_input_buffer = [](j_decompress_ptr) -> boolean { return FALSE; };
+    pub.skip_input_data = [](j_decompress_ptr cinfo, long numBytes) {
+      auto source = reinterpret_cast<SuspendingSource*>(cinfo->src);
+      if (numBytes <= 0) {
+        return;
+      }
+      auto count = static_cast<size_t>(numBytes);
+      if (count <= source->pub.bytes_in_buffer) {
+        source->pub.next_input_byte += count;
+        source->pub.bytes_in_buffer -= count;
+      } else {
+        source->bytesToSkip += count - source->pub.bytes_in_buffer;
+        source->pub.next_input_byte += source->pub.bytes_in_buffer;
+        source->pub.bytes_in_buffer = 0;
+      }
+    };
+    pub.resync_to_restart = jpeg_resync_to_restart;
+    pub.term_source = [](j_decompress_ptr) {};
+  }
+
+  void append(const uint8_t* data, size_t length) {
+    // Bytes before the read position have been consumed and are never revisited.
+    if (pub.next_input_byte != nullptr) {
+      auto consumed = static_cast<size_t>(pub.next_input_byte - bytes.data());
+      bytes.erase(bytes.begin(), bytes.begin() + static_cast<std::ptrdiff_t>(consumed));
+    }
+    auto skipped = std::min(bytesToSkip, length);
+    bytesToSkip -= skipped;
+    bytes.insert(bytes.end(), data + skipped, data + length);
+    pub.next_input_byte = bytes.data();
+    pub.bytes_in_buffer = bytes.size();
+  }
+};
+
+class JpegIncrementalDecoder : public IncrementalDecoder {
+ public:
+  JpegIncrementalDecoder() {
+    cinfo.err = jpeg_std_error(&jerr.pub);
+    jerr.pub.error_exit = JpegErrorExit;
+    jpeg_create_decompress(&cinfo);
+    cinfo.src = &source.pub;
+    jpeg_save_markers(&cinfo, kExifMarker, 0xFFFF);
+  }
+
+  ~JpegIncrementalDecoder() override {
+    jpeg_destroy_decompress(&cinfo);
+  }
+
+ protected:
+  bool onAppend(const uint8_t* bytes, size_t length) override {
+    source.append(bytes, length);
+    if (setjmp(jerr.setjmp_buffer)) {
+      return false;
+    }
+    // Every libjpeg call below returns early with a suspension when it needs more bytes, and is
+    // called again with the same state on the next append.
+    if (state == State::Header) {
+      if (jpeg_read_header(&cinfo, TRUE) == JPEG_SUSPENDED) {
+        return true;
+      }
+      if (!setDimensions(static_cast<int>(cinfo.image_width),
+                         static_cast<int>(cinfo.image_height))) {
+        return false;
+      }
+      setOrientation(get_exif_orientation(&cinfo));
+      cinfo.out_color_space = JCS_EXT_RGBA;
+      // Buffered-image mode keeps the coefficients of all scans received so far, so every scan of
+      // a progressive image can be displayed as soon as it arrives.
+      cinfo.buffered_image = jpeg_has_multiple_scans(&cinfo);
+      state = State::Start;
+    }
+    if (state == State::Start) {
+      if (!jpeg_start_decompress(&cinfo)) {
+        return true;
+      }
+      state = cinfo.buffered_image ? State::Progressive : State::Baseline;
+    }
+    if (state == State::Baseline) {
+      if (!readScanlines()) {
+        return true;
+      }
+      state = State::Finish;
+    }
+    if (state == State::Progressive) {
+      if (!readScans()) {
+        return true;
+      }
+      state = State::Finish;
+    }
+    if (state == State::Finish) {
+      if (!jpeg_finish_decompress(&cinfo)) {
+        return true;
+      }
+      markComplete();
+      state = State::Done;
+    }
+    return true;
+  }
+
+ private:
+  enum class State { Header, Start, Baseline, Progressive, Finish, Done };
+
+  jpeg_decompress_struct cinfo = {};
+  my_error_mgr jerr = {};
+  SuspendingSource source = {};
+  State state = State::Header;
+  bool outputStarted = false;
+
+  /**
+   * Reads the remaining scanlines of the current output pass. Returns false if the decompressor is
+   * suspended before the end of the pass.
+   */
+  bool readScanlines() {
+    auto top = static_cast<int>(cinfo.output_scanline);
+    while (cinfo.output_scanline < cinfo.output_height) {
+      JSAMPROW row = getRow(static_cast<int>(cinfo.output_scanline));
+      if (jpeg_read_scanlines(&cinfo, &row, 1) != 1) {
+        break;
+      }
+    }
+    markRowsDecoded(top, static_cast<int>(cinfo.output_scanline));
+    return cinfo.output_scanline == cinfo.output_height;
+  }
+
+  /**
+   * Outputs the most recent scan of a progressive image, then repeats with newer scans until the
+   * last one has been output. Returns false if it has to wait for more bytes.
+   */
+  bool readScans() {
+    while (true) {
+      if (!outputStarted) {
+        // Absorbs all available bytes first, so the output skips any scans that are already
+        // superseded.
+        int status = 0;
+        do {
+          status = jpeg_consume_input(&cinfo);
+        } while (status != JPEG_SUSPENDED && status != JPEG_REACHED_EOI);
+        if (cinfo.output_scan_number > 0 && cinfo.input_scan_number == cinfo.output_scan_number &&
+            !jpeg_input_complete(&cinfo)) {
+          // The latest scan has been output, wait for the next one.
+          return false;
+        }
+        if (!jpeg_start_output(&cinfo, cinfo.input_scan_number)) {
+          return false;
+        }
+        outputStarted = true;
+      }
+      if (!readScanlines()) {
+        return false;
+      }
+      if (!jpeg_finish_output(&cinfo)) {
+        return false;
+      }
+      outputStarted = false;
+      if (jpeg_input_complete(&cinfo) && cinfo.input_scan_number == cinfo.output_scan_number) {
+        return true;
+      }
+    }
+  }
+};
+
+std::shared_ptr<IncrementalDecoder> JpegCodec::MakeIncrementalDecoder() {
+  return std::make_shared<JpegIncrementalDecoder>();
+}
+
 std::shared_ptr<Data> JpegCodec::getEncodedData() const {
   if (fileData) {
     return fileData;
@@ -201,59 +656,105 @@ std::shared_ptr<Data> JpegCodec::getEncodedData() const {
 }
 
 #ifdef TGFX_USE_JPEG_ENCODE
-std::shared_ptr<Data> JpegCodec::Encode(const Pixmap& pixmap, int quality) {
+static constexpr size_t DestinationBufferSize = 16 * 1024;
+
+/**
+ * A destination manager that hands the compressed bytes to a WriteStream whenever its buffer fills
+ * up, so the encoded image never has to be held in memory as a whole.
+ */
+struct StreamDestination {
+  jpeg_destination_mgr pub = {};
+  WriteStream* stream = nullptr;
+  JOCTET buffer[DestinationBufferSize] = {};
+};
+
+static void InitDestination(j_compress_ptr cinfo) {
+  auto destination = reinterpret_cast<StreamDestination*>(cinfo->dest);
+  destination->pub.next_output_byte = destination->buffer;
+  destination->pub.free_in_buffer = DestinationBufferSize;
+}
+
+static boolean EmptyOutputBuffer(j_compress_ptr cinfo) {
+  auto destination = reinterpret_cast<StreamDestination*>(cinfo->dest);
+  // libjpeg ignores free_in_buffer here and always expects the whole buffer to be written.
+  if (!destination->stream->write(destination->buffer, DestinationBufferSize)) {
+    ERREXIT(cinfo, JERR_FILE_WRITE);
+  }
+  destination->pub.next_output_byte = destination->buffer;
+  destination->pub.free_in_buffer = DestinationBufferSize;
+  return TRUE;
+}
+
+static void TermDestination(j_compress_ptr cinfo) {
+  auto destination = reinterpret_cast<StreamDestination*>(cinfo->dest);
+  auto size = DestinationBufferSize - destination->pub.free_in_buffer;
+  if (size > 0 && !destination->stream->write(destination->buffer, size)) {
+    ERREXIT(cinfo, JERR_FILE_WRITE);
+  }
+  destination->stream->flush();
+}
+
+bool JpegCodec::Encode(const Pixmap& pixmap, int quality, WriteStream* stream) {
   auto srcPixels = static_cast<uint8_t*>(const_cast<void*>(pixmap.pixels()));
-  int srcRowBytes = static_cast<int>(pixmap.rowBytes());
-  jpeg_compress_struct cinfo = {};
-  jpeg_error_mgr jerr = {};
-  JSAMPROW row_pointer[1];
-  cinfo.err = jpeg_std_error(&jerr);
-  jpeg_create_compress(&cinfo);
-  uint8_t* dstBuffer = nullptr;
-  unsigned long dstBufferSize = 0;  // NOLINT
-  jpeg_mem_dest(&cinfo, &dstBuffer, &dstBufferSize);
-  cinfo.image_width = static_cast<JDIMENSION>(pixmap.width());
-  cinfo.image_height = static_cast<JDIMENSION>(pixmap.height());
+  auto srcRowBytes = pixmap.rowBytes();
   Buffer buffer = {};
+  J_COLOR_SPACE colorSpace = JCS_EXT_RGBA;
+  int components = 4;
   switch (pixmap.colorType()) {
     case ColorType::RGBA_8888:
-      cinfo.in_color_space = JCS_EXT_RGBA;
-      cinfo.input_components = 4;
       break;
     case ColorType::BGRA_8888:
-      cinfo.in_color_space = JCS_EXT_BGRA;
-      cinfo.input_components = 4;
+      colorSpace = JCS_EXT_BGRA;
       break;
     case ColorType::Gray_8:
-      cinfo.in_color_space = JCS_GRAYSCALE;
-      cinfo.input_components = 1;
+      colorSpace = JCS_GRAYSCALE;
+      components = 1;
       break;
     default:
       auto info = ImageInfo::Make(pixmap.width(), pixmap.height(), ColorType::RGBA_8888);
       buffer.alloc(info.byteSize());
       if (buffer.isEmpty()) {
-        return nullptr;
+        return false;
       }
       srcPixels = buffer.bytes();
-      srcRowBytes = static_cast<int>(info.rowBytes());
+      srcRowBytes = info.rowBytes();
       Pixmap(info, srcPixels).writePixels(pixmap.info(), pixmap.pixels());
-      cinfo.in_color_space = JCS_EXT_RGBA;
-      cinfo.input_components = 4;
       break;
   }
-  jpeg_set_defaults(&cinfo);
-  cinfo.optimize_coding = TRUE;
-  jpeg_set_quality(&cinfo, quality, TRUE);
-  jpeg_start_compress(&cinfo, TRUE);
-  while (cinfo.next_scanline < cinfo.image_height) {
-    row_pointer[0] = &(srcPixels)[cinfo.next_scanline * static_cast<JDIMENSION>(srcRowBytes)];
-    (void)jpeg_write_scanlines(&cinfo, row_pointer, 1);
-  }
-
-  /* similar to read file, clean up after we're done compressing */
-  jpeg_finish_compress(&cinfo);
+  jpeg_compress_struct cinfo = {};
+  my_error_mgr jerr = {};
+  cinfo.err = jpeg_std_error(&jerr.pub);
+  jerr.pub.error_exit = JpegErrorExit;
+  auto destination = std::make_unique<StreamDestination>();
+  destination->stream = stream;
+  destination->pub.init_destination = InitDestination;
+  destination->pub.empty_output_buffer = EmptyOutputBuffer;
+  destination->pub.term_destination = TermDestination;
+  bool success = false;
+  do {
+    if (setjmp(jerr.setjmp_buffer)) {
+      break;
+    }
+    jpeg_create_compress(&cinfo);
+    cinfo.dest = &destination->pub;
+    cinfo.image_width = static_cast<JDIMENSION>(pixmap.width());
+    cinfo.image_height = static_cast<JDIMENSION>(pixmap.height());
+    cinfo.in_color_space = colorSpace;
+    cinfo.input_components = components;
+    jpeg_set_defaults(&cinfo);
+    cinfo.optimize_coding = TRUE;
+    jpeg_set_quality(&cinfo, quality, TRUE);
+    jpeg_start_compress(&cinfo, TRUE);
+    JSAMPROW rowPointer[1];
+    while (cinfo.next_scanline < cinfo.image_height) {
+      rowPointer[0] = srcPixels + cinfo.next_scanline * srcRowBytes;
+      jpeg_write_scanlines(&cinfo, rowPointer, 1);
+    }
+    jpeg_finish_compress(&cinfo);
+    success = true;
+  } while (false);
   jpeg_destroy_compress(&cinfo);
-  return Data::MakeAdopted(dstBuffer, dstBufferSize, Data::FreeProc);
+  return success;
 }
 #endif
 
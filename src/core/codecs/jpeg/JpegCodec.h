@@ -19,6 +19,8 @@
 #pragma once
 
 #include "tgfx/core/ImageCodec.h"
+#include "tgfx/core/IncrementalDecoder.h"
+#include "tgfx/core/WriteStream.h"
 
 namespace tgfx {
 class JpegCodec : public ImageCodec {
@@ -26,26 +28,42 @@ class JpegCodec : public ImageCodec {
   static std::shared_ptr<ImageCodec> MakeFrom(const std::string& filePath);
   static std::shared_ptr<ImageCodec> MakeFrom(std::shared_ptr<Data> imageBytes);
   static bool IsJpeg(const std::shared_ptr<Data>& data);
+  static std::shared_ptr<IncrementalDecoder> MakeIncrementalDecoder();
 
 #ifdef TGFX_USE_JPEG_ENCODE
-  static std::shared_ptr<Data> Encode(const Pixmap& pixmap, int quality);
+  static bool Encode(const Pixmap& pixmap, int quality, WriteStream* stream);
 #endif
 
  protected:
   bool readPixels(const ImageInfo& dstInfo, void* dstPixels) const override;
 
+  ISize getScaledDimensions(float scale) const override;
+
+  bool readScaledPixels(const ImageInfo& dstInfo, void* dstPixels) const override;
+
+  std::shared_ptr<YUVData> readYUVData(YUVColorSpace* colorSpace) const override;
+
+  bool onReadRegion(const ISize& scaledSize, const Rect& region, const ImageInfo& dstInfo,
+                    void* dstPixels) const override;
+
   std::shared_ptr<Data> getEncodedData() const override;
 
  private:
   std::shared_ptr<Data> fileData;
   const std::string filePath;
+  bool progressive = false;
+
+  bool decodePixels(const ImageInfo& dstInfo, void* dstPixels, int scaleDenom) const;
+
+  bool decodeRows(int colorSpace, int scaleDenom, int top, int bottom, void* outPixels,
+                  size_t rowBytes) const;
 
   static std::shared_ptr<ImageCodec> MakeFromData(const std::string& filePath,
                                                   std::shared_ptr<Data> byteData);
   explicit JpegCodec(int width, int height, Orientation orientation, std::string filePath,
-                     std::shared_ptr<Data> fileData)
+                     std::shared_ptr<Data> fileData, bool progressive)
       : ImageCodec(width, height, orientation), fileData(std::move(fileData)),
-        filePath(std::move(filePath)) {
+        filePath(std::move(filePath)), progressive(progressive) {
   }
 };
 
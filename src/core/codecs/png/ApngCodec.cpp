@@ -0,0 +1,294 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "core/codecs/png/ApngCodec.h"
+#include <cstring>
+#include "zlib.h"
+
+namespace tgfx {
+static constexpr size_t SignatureSize = 8;
+static constexpr size_t ChunkOverhead = 12;
+static constexpr size_t IHDRSize = 13;
+static constexpr size_t FCTLSize = 26;
+
+static uint32_t ReadUInt32(const uint8_t* bytes) {
+  return (static_cast<uint32_t>(bytes[0]) << 24) | (static_cast<uint32_t>(bytes[1]) << 16) |
+         (static_cast<uint32_t>(bytes[2]) << 8) | static_cast<uint32_t>(bytes[3]);
+}
+
+static uint16_t ReadUInt16(const uint8_t* bytes) {
+  return static_cast<uint16_t>((bytes[0] << 8) | bytes[1]);
+}
+
+static uint8_t* WriteUInt32(uint8_t* bytes, uint32_t value) {
+  bytes[0] = static_cast<uint8_t>(value >> 24);
+  bytes[1] = static_cast<uint8_t>(value >> 16);
+  bytes[2] = static_cast<uint8_t>(value >> 8);
+  bytes[3] = static_cast<uint8_t>(value);
+  return bytes + 4;
+}
+
+static bool IsChunk(const uint8_t* type, const char* name) {
+  return memcmp(type, name, 4) == 0;
+}
+
+/**
+ * Writes a chunk with the given type and payload, and returns the address right after it.
+ */
+static uint8_t* WriteChunk(uint8_t* bytes, const char* type, const uint8_t* data, size_t length) {
+  auto typeStart = WriteUInt32(bytes, static_cast<uint32_t>(length));
+  memcpy(typeStart, type, 4);
+  if (length > 0) {
+    memcpy(typeStart + 4, data, length);
+  }
+  auto crc = crc32(0, typeStart, static_cast<uInt>(length + 4));
+  return WriteUInt32(typeStart + 4 + length, static_cast<uint32_t>(crc));
+}
+
+static FrameDisposal ToFrameDisposal(uint8_t disposeOp) {
+  switch (disposeOp) {
+    case 1:
+      return FrameDisposal::Background;
+    case 2:
+      return FrameDisposal::Previous;
+    default:
+      return FrameDisposal::None;
+  }
+}
+
+std::shared_ptr<AnimatedCodec> ApngCodec::MakeFrom(std::shared_ptr<Data> imageBytes) {
+  auto bytes = imageBytes->bytes();
+  auto size = imageBytes->size();
+  ChunkRange header = {};
+  std::vector<ChunkRange> headerChunks = {};
+  std::vector<FrameInfo> frames = {};
+  std::vector<std::vector<ChunkRange>> frameData = {};
+  int width = 0;
+  int height = 0;
+  int loopCount = 0;
+  bool animated = false;
+  bool seenImageData = false;
+  size_t offset = SignatureSize;
+  while (offset + ChunkOverhead <= size) {
+    auto length = static_cast<size_t>(ReadUInt32(bytes + offset));
+    auto type = bytes + offset + 4;
+    auto data = offset + 8;
+    if (length > size - offset - ChunkOverhead) {
+      break;
+    }
+    if (IsChunk(type, "IHDR") && length == IHDRSize) {
+      header = {data, length};
+      width = static_cast<int>(ReadUInt32(bytes + data));
+      height = static_cast<int>(ReadUInt32(bytes + data + 4));
+    } else if (IsChunk(type, "acTL") && length >= 8 && !seenImageData) {
+      animated = true;
+      loopCount = static_cast<int>(ReadUInt32(bytes + data + 4));
+    } else if (IsChunk(type, "fcTL") && length >= FCTLSize) {
+      auto frameWidth = static_cast<int>(ReadUInt32(bytes + data + 4));
+      auto frameHeight = static_cast<int>(ReadUInt32(bytes + data + 8));
+      auto x = static_cast<int>(ReadUInt32(bytes + data + 12));
+      auto y = static_cast<int>(ReadUInt32(bytes + data + 16));
+      if (frameWidth <= 0 || frameHeight <= 0 || x < 0 || y < 0 || x > width - frameWidth ||
+          y > height - frameHeight) {
+        return nullptr;
+      }
+      int64_t delayNumerator = ReadUInt16(bytes + data + 20);
+      int64_t delayDenominator = ReadUInt16(bytes + data + 22);
+      if (delayDenominator == 0) {
+        // A zero denominator means the delay is in hundredths of a second.
+        delayDenominator = 100;
+      }
+      FrameInfo frame = {};
+      frame.bounds = Rect::MakeXYWH(x, y, frameWidth, frameHeight);
+      frame.duration = delayNumerator * 1000000 / delayDenominator;
+      frame.disposal = ToFrameDisposal(bytes[data + 24]);
+      frame.blend = bytes[data + 25] == 1;
+      frames.push_back(frame);
+      frameData.emplace_back();
+    } else if (IsChunk(type, "IDAT")) {
+      // The default image is only part of the animation if a fcTL chunk precedes it.
+      if (frames.size() == 1 && (!seenImageData || !frameData[0].empty())) {
+        frameData[0].push_back({data, length});
+      }
+      seenImageData = true;
+    } else if (IsChunk(type, "fdAT")) {
+      if (!frames.empty() && length > 4) {
+        frameData.back().push_back({data + 4, length - 4});
+      }
+    } else if (IsChunk(type, "IEND")) {
+      break;
+    } else if (!seenImageData) {
+      // Ancillary chunks such as PLTE, tRNS, and gAMA apply to every frame.
+      headerChunks.push_back({offset, length + ChunkOverhead});
+    }
+    offset = data + length + 4;
+  }
+  if (!animated || header.length == 0) {
+    return nullptr;
+  }
+  // Frames without any image data, such as those at the end of a truncated file, are dropped.
+  while (!frames.empty() && frameData.back().empty()) {
+    frames.pop_back();
+    frameData.pop_back();
+  }
+  for (auto& chunks : frameData) {
+    if (chunks.empty()) {
+      return nullptr;
+    }
+  }
+  if (frames.empty()) {
+    return nullptr;
+  }
+  auto codec =
+      std::shared_ptr<ApngCodec>(new ApngCodec(width, height, std::move(frames), loopCount));
+  codec->fileData = std::move(imageBytes);
+  codec->header = header;
+  codec->headerChunks = std::move(headerChunks);
+  codec->frameData = std::move(frameData);
+  return codec;
+}
+
+ApngCodec::ApngCodec(int width, int height, std::vector<FrameInfo> frames, int loopCount)
+    : AnimatedCodec(width, height, std::move(frames), loopCount) {
+}
+
+std::shared_ptr<Data> ApngCodec::makeFrameStream(int index) const {
+  auto& chunks = frameData[static_cast<size_t>(index)];
+  auto bytes = fileData->bytes();
+  size_t size = SignatureSize + ChunkOverhead + IHDRSize + ChunkOverhead;
+  for (auto& chunk : headerChunks) {
+    size += chunk.length;
+  }
+  for (auto& chunk : chunks) {
+    size += ChunkOverhead + chunk.length;
+  }
+  Buffer buffer(size);
+  if (buffer.isEmpty()) {
+    return nullptr;
+  }
+  auto& bounds = getFrameInfo(index).bounds;
+  auto writer = buffer.bytes();
+  memcpy(writer, bytes, SignatureSize);
+  writer += SignatureSize;
+  uint8_t ihdr[IHDRSize] = {};
+  memcpy(ihdr, bytes + header.offset, IHDRSize);
+  WriteUInt32(ihdr, static_cast<uint32_t>(bounds.width()));
+  WriteUInt32(ihdr + 4, static_cast<uint32_t>(bounds.height()));
+  writer = WriteChunk(writer, "IHDR", ihdr, IHDRSize);
+  for (auto& chunk : headerChunks) {
+    memcpy(writer, bytes + chunk.offset, chunk.length);
+    writer += chunk.length;
+  }
+  for (auto& chunk : chunks) {
+    writer = WriteChunk(writer, "IDAT", bytes + chunk.offset, chunk.length);
+  }
+  WriteChunk(writer, "IEND", nullptr, 0);
+  return buffer.release();
+}
+
+static void CopyRect(const uint8_t* src, uint8_t* dst, size_t rowBytes, const Rect& rect) {
+  auto left = static_cast<size_t>(rect.left) * 4;
+  auto length = static_cast<size_t>(rect.width()) * 4;
+  for (auto y = static_cast<size_t>(rect.top); y < static_cast<size_t>(rect.bottom); y++) {
+    memcpy(dst + y * rowBytes + left, src + y * rowBytes + left, length);
+  }
+}
+
+bool ApngCodec::renderFrame(int index) {
+  auto rowBytes = static_cast<size_t>(width()) * 4;
+  if (canvas.isEmpty()) {
+    if (!canvas.alloc(rowBytes * static_cast<size_t>(height()))) {
+      return false;
+    }
+  }
+  if (index == 0) {
+    canvas.clear();
+  } else {
+    auto& previous = getFrameInfo(index - 1);
+    auto disposal = previous.disposal;
+    if (disposal == FrameDisposal::Previous && index == 1) {
+      // The first frame has nothing to restore to, which is treated as clearing its area.
+      disposal = FrameDisposal::Background;
+    }
+    if (disposal == FrameDisposal::Background) {
+      auto left = static_cast<size_t>(previous.bounds.left) * 4;
+      auto length = static_cast<size_t>(previous.bounds.width()) * 4;
+      for (auto y = static_cast<size_t>(previous.bounds.top);
+           y < static_cast<size_t>(previous.bounds.bottom); y++) {
+        memset(canvas.bytes() + y * rowBytes + left, 0, length);
+      }
+    } else if (disposal == FrameDisposal::Previous) {
+      CopyRect(savedCanvas.bytes(), canvas.bytes(), rowBytes, previous.bounds);
+    }
+  }
+  auto& frame = getFrameInfo(index);
+  if (frame.disposal == FrameDisposal::Previous && index > 0) {
+    if (savedCanvas.isEmpty() && !savedCanvas.alloc(canvas.size())) {
+      return false;
+    }
+    CopyRect(canvas.bytes(), savedCanvas.bytes(), rowBytes, frame.bounds);
+  }
+  auto codec = PngCodec::MakeFrom(makeFrameStream(index));
+  if (codec == nullptr) {
+    return false;
+  }
+  auto frameWidth = static_cast<int>(frame.bounds.width());
+  auto frameHeight = static_cast<int>(frame.bounds.height());
+  auto info =
+      ImageInfo::Make(frameWidth, frameHeight, ColorType::RGBA_8888, AlphaType::Premultiplied);
+  Buffer pixels(info.byteSize());
+  if (pixels.isEmpty() || !codec->readPixels(info, pixels.data())) {
+    return false;
+  }
+  auto left = static_cast<size_t>(frame.bounds.left);
+  auto top = static_cast<size_t>(frame.bounds.top);
+  for (size_t y = 0; y < static_cast<size_t>(frameHeight); y++) {
+    auto src = pixels.bytes() + y * info.rowBytes();
+    auto dst = canvas.bytes() + (top + y) * rowBytes + left * 4;
+    if (!frame.blend) {
+      memcpy(dst, src, static_cast<size_t>(frameWidth) * 4);
+      continue;
+    }
+    for (int x = 0; x < frameWidth; x++, src += 4, dst += 4) {
+      // Source-over blending of premultiplied colors.
+      auto inverseAlpha = 255 - src[3];
+      for (int i = 0; i < 4; i++) {
+        dst[i] = static_cast<uint8_t>(src[i] + (dst[i] * inverseAlpha + 127) / 255);
+      }
+    }
+  }
+  return true;
+}
+
+const void* ApngCodec::onDecodeFrame(int index) {
+  if (index < nextIndex - 1) {
+    nextIndex = 0;
+  }
+  if (index == nextIndex - 1) {
+    return canvas.bytes();
+  }
+  while (nextIndex <= index) {
+    if (!renderFrame(nextIndex)) {
+      nextIndex = 0;
+      return nullptr;
+    }
+    nextIndex++;
+  }
+  return canvas.bytes();
+}
+}  // namespace tgfx
@@ -0,0 +1,63 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "core/codecs/png/PngCodec.h"
+#include "tgfx/core/AnimatedCodec.h"
+#include "tgfx/core/Buffer.h"
+
+namespace tgfx {
+/**
+ * ApngCodec decodes the frames of an animated PNG image. libpng does not understand the APNG
+ * chunks, so each frame is repackaged as a standalone PNG stream that is decoded by PngCodec, and
+ * then composited onto the canvas.
+ */
+class ApngCodec : public AnimatedCodec {
+ public:
+  /**
+   * Returns nullptr if the bytes are not an animated PNG image.
+   */
+  static std::shared_ptr<AnimatedCodec> MakeFrom(std::shared_ptr<Data> imageBytes);
+
+ protected:
+  const void* onDecodeFrame(int index) override;
+
+ private:
+  struct ChunkRange {
+    size_t offset = 0;
+    size_t length = 0;
+  };
+
+  std::shared_ptr<Data> fileData = nullptr;
+  // The IHDR payload and the ancillary chunks before the first image data, shared by all frames.
+  ChunkRange header = {};
+  std::vector<ChunkRange> headerChunks = {};
+  // The compressed image data of each frame, with the sequence numbers of fdAT chunks stripped.
+  std::vector<std::vector<ChunkRange>> frameData = {};
+  Buffer canvas = {};
+  Buffer savedCanvas = {};
+  int nextIndex = 0;
+
+  ApngCodec(int width, int height, std::vector<FrameInfo> frames, int loopCount);
+
+  std::shared_ptr<Data> makeFrameStream(int index) const;
+
+  bool renderFrame(int index);
+};
+}  // namespace tgfx
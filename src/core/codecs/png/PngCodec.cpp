@@ -17,12 +17,25 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "core/codecs/png/PngCodec.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <vector>
+#include "core/utils/MappedFile.h"
+#include "core/utils/ParallelRows.h"
 #include "png.h"
 #include "tgfx/core/Buffer.h"
 #include "tgfx/core/Pixmap.h"
+#include "tgfx/core/Task.h"
+#include "zlib.h"
 
 namespace tgfx {
 std::shared_ptr<ImageCodec> PngCodec::MakeFrom(const std::string& filePath) {
+  // Decoding from the mapped bytes avoids reopening and rereading the file on every decode.
+  auto fileData = MapFile(filePath, FileAccess::Sequential);
+  if (fileData != nullptr) {
+    return MakeFromData("", std::move(fileData));
+  }
   return MakeFromData(filePath, nullptr);
 }
 
@@ -164,6 +177,18 @@ static void UpdateReadInfo(png_structp p, png_infop pi) {
   png_read_update_info(p, pi);
 }
 
+/**
+ * Reads the next rowCount rows of a non-interlaced image. Errors are caught here rather than in the
+ * caller, since conversion tasks may still be using the decoded rows when libpng fails.
+ */
+static bool ReadRows(png_structp p, png_bytepp rows, int rowCount) {
+  if (setjmp(png_jmpbuf(p))) {
+    return false;
+  }
+  png_read_rows(p, rows, nullptr, static_cast<png_uint_32>(rowCount));
+  return true;
+}
+
 bool PngCodec::readPixels(const ImageInfo& dstInfo, void* dstPixels) const {
   auto readInfo = ReadInfo::Make(filePath, fileData);
   if (readInfo == nullptr) {
@@ -198,9 +223,155 @@ bool PngCodec::readPixels(const ImageInfo& dstInfo, void* dstPixels) const {
   for (size_t i = 0; i < static_cast<size_t>(h); i++) {
     readInfo->rowPtrs[i] = readInfo->data + (info.rowBytes() * i);
   }
-  png_read_image(readInfo->p, readInfo->rowPtrs);
-  Pixmap pixmap(info, readInfo->data);
-  return pixmap.readPixels(dstInfo, dstPixels);
+  auto convertRows = [&](int top, int bottom) {
+    auto rowCount = bottom - top;
+    auto srcPixels = readInfo->data + info.rowBytes() * static_cast<size_t>(top);
+    auto dstRows = static_cast<uint8_t*>(dstPixels) + dstInfo.rowBytes() * static_cast<size_t>(top);
+    return Pixmap(info.makeWH(w, rowCount), srcPixels)
+        .readPixels(dstInfo.makeWH(dstInfo.width(), rowCount), dstRows);
+  };
+  auto bandCount = GetParallelBandCount(w, h);
+  if (bandCount == 1 || png_get_interlace_type(readInfo->p, readInfo->pi) != PNG_INTERLACE_NONE) {
+    png_read_image(readInfo->p, readInfo->rowPtrs);
+    return ParallelForRows(h, bandCount, convertRows);
+  }
+  // Inflating is inherently sequential, so the rows are read band by band on this thread while the
+  // pixel conversion of the bands already read runs on the task pool.
+  auto bandHeight = (h + bandCount - 1) / bandCount;
+  std::atomic_bool success = {true};
+  std::vector<std::shared_ptr<Task>> tasks = {};
+  for (int top = 0; top < h; top += bandHeight) {
+    auto bottom = std::min(top + bandHeight, h);
+    if (!ReadRows(readInfo->p, readInfo->rowPtrs + top, bottom - top)) {
+      success = false;
+      break;
+    }
+    tasks.push_back(Task::Run([&convertRows, &success, top, bottom]() {
+      if (!convertRows(top, bottom)) {
+        success = false;
+      }
+    }));
+  }
+  for (auto& task : tasks) {
+    task->wait();
+  }
+  return success;
+}
+
+bool PngCodec::onReadRegion(const ISize& scaledSize, const Rect& region,
+                            const ImageInfo& dstInfo, void* dstPixels) const {
+  if (scaledSize.width != width() || scaledSize.height != height()) {
+    return false;
+  }
+  auto readInfo = ReadInfo::Make(filePath, fileData);
+  if (readInfo == nullptr) {
+    return false;
+  }
+  if (png_get_interlace_type(readInfo->p, readInfo->pi) != PNG_INTERLACE_NONE) {
+    // Interlaced images spread every row across all passes, so they must be decoded entirely.
+    return ImageCodec::onReadRegion(scaledSize, region, dstInfo, dstPixels);
+  }
+  UpdateReadInfo(readInfo->p, readInfo->pi);
+  auto top = static_cast<int>(region.top);
+  auto bottom = static_cast<int>(region.bottom);
+  auto rowInfo = ImageInfo::Make(width(), 1, ColorType::RGBA_8888, AlphaType::Unpremultiplied);
+  readInfo->data = (unsigned char*)malloc(rowInfo.byteSize());
+  if (readInfo->data == nullptr) {
+    return false;
+  }
+  if (setjmp(png_jmpbuf(readInfo->p))) {
+    return false;
+  }
+  // The compressed stream can't be sought, so the rows above the region are still inflated,
+  // unfiltered, and expanded by the libpng transformations. Only the copy to the destination is
+  // skipped for them, and the rows below the region are never read.
+  for (int row = 0; row < top; row++) {
+    png_read_row(readInfo->p, readInfo->data, nullptr);
+  }
+  auto rowPixmap = Pixmap(rowInfo, readInfo->data);
+  auto dstRowInfo = dstInfo.makeWH(dstInfo.width(), 1);
+  for (int row = top; row < bottom; row++) {
+    png_read_row(readInfo->p, readInfo->data, nullptr);
+    auto dstRow = static_cast<uint8_t*>(dstPixels) +
+                  dstInfo.rowBytes() * static_cast<size_t>(row - top);
+    if (!rowPixmap.readPixels(dstRowInfo, dstRow, static_cast<int>(region.left), 0)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+class PngIncrementalDecoder : public IncrementalDecoder {
+ public:
+  PngIncrementalDecoder() {
+    p = png_create_read_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
+    if (p == nullptr) {
+      return;
+    }
+    pi = png_create_info_struct(p);
+    if (pi == nullptr) {
+      return;
+    }
+#ifdef PNG_SET_OPTION_SUPPORTED
+    png_set_option(p, PNG_MAXIMUM_INFLATE_WINDOW, PNG_OPTION_ON);
+#endif
+    png_set_progressive_read_fn(p, this, OnInfo, OnRow, OnEnd);
+  }
+
+  ~PngIncrementalDecoder() override {
+    png_destroy_read_struct(&p, pi ? &pi : nullptr, nullptr);
+  }
+
+ protected:
+  bool onAppend(const uint8_t* bytes, size_t length) override {
+    if (pi == nullptr) {
+      return false;
+    }
+    if (setjmp(png_jmpbuf(p))) {
+      return false;
+    }
+    png_process_data(p, pi, const_cast<png_bytep>(bytes), length);
+    return !headerFailed;
+  }
+
+ private:
+  png_structp p = nullptr;
+  png_infop pi = nullptr;
+  bool headerFailed = false;
+
+  static void OnInfo(png_structp p, png_infop pi) {
+    auto decoder = static_cast<PngIncrementalDecoder*>(png_get_progressive_ptr(p));
+    png_uint_32 width = 0;
+    png_uint_32 height = 0;
+    png_get_IHDR(p, pi, &width, &height, nullptr, nullptr, nullptr, nullptr, nullptr);
+    png_set_interlace_handling(p);
+    UpdateReadInfo(p, pi);
+    if (!decoder->setDimensions(static_cast<int>(width), static_cast<int>(height))) {
+      decoder->headerFailed = true;
+      png_process_data_pause(p, 0);
+    }
+  }
+
+  static void OnRow(png_structp p, png_bytep newRow, png_uint_32 rowNumber, int) {
+    auto decoder = static_cast<PngIncrementalDecoder*>(png_get_progressive_ptr(p));
+    auto row = decoder->getRow(static_cast<int>(rowNumber));
+    if (newRow == nullptr || row == nullptr) {
+      return;
+    }
+    // For interlaced images, each pass only fills some of the pixels in the row, and the pixels
+    // from previous passes are kept.
+    png_progressive_combine_row(p, row, newRow);
+    decoder->markRowsDecoded(static_cast<int>(rowNumber), static_cast<int>(rowNumber) + 1);
+  }
+
+  static void OnEnd(png_structp p, png_infop) {
+    auto decoder = static_cast<PngIncrementalDecoder*>(png_get_progressive_ptr(p));
+    decoder->markComplete();
+  }
+};
+
+std::shared_ptr<IncrementalDecoder> PngCodec::MakeIncrementalDecoder() {
+  return std::make_shared<PngIncrementalDecoder>();
 }
 
 bool PngCodec::isAlphaOnly() const {
@@ -218,102 +389,298 @@ std::shared_ptr<Data> PngCodec::getEncodedData() const {
 }
 
 #ifdef TGFX_USE_PNG_ENCODE
-struct PngWriter {
-  unsigned char* data = nullptr;
-  size_t length = 0;
+/**
+ * The rows handed to the PNG encoder, either pointing at the source pixels directly or at a
+ * converted copy of them. ALPHA_8 pixels are stored as gray-alpha with the gray channel zeroed.
+ */
+struct PngEncodeSource {
+  const uint8_t* pixels = nullptr;
+  size_t rowBytes = 0;
+  int channels = 4;
+  Buffer buffer = {};
 };
 
-static void png_reader_write_data(png_structp png_ptr, png_bytep data, png_size_t length) {
-  auto writer = static_cast<PngWriter*>(png_get_io_ptr(png_ptr));
-  size_t nsize = writer->length + length;
-  if (writer->data) {
-    writer->data = static_cast<unsigned char*>(realloc(writer->data, nsize));
-  } else {
-    writer->data = static_cast<unsigned char*>(malloc(nsize));
-  }
-  memcpy(writer->data + writer->length, data, length);
-  writer->length += length;
-}
-
-std::shared_ptr<Data> PngCodec::Encode(const Pixmap& pixmap, int) {
-  auto srcPixels = static_cast<png_bytep>(const_cast<void*>((pixmap.pixels())));
-  auto srcRowBytes = static_cast<int>(pixmap.rowBytes());
-  uint8_t* alphaPixels = nullptr;
-  Buffer tempBuffer;
+static bool PrepareEncodeSource(const Pixmap& pixmap, PngEncodeSource* source) {
+  source->pixels = static_cast<const uint8_t*>(pixmap.pixels());
+  source->rowBytes = pixmap.rowBytes();
+  auto width = static_cast<size_t>(pixmap.width());
+  auto height = static_cast<size_t>(pixmap.height());
   if (pixmap.colorType() == ColorType::ALPHA_8) {
-    tempBuffer.alloc(static_cast<size_t>(pixmap.width()) * 2);
-    alphaPixels = tempBuffer.bytes();
-    srcRowBytes = static_cast<int>(tempBuffer.size());
+    source->channels = 2;
+    if (!source->buffer.alloc(width * height * 2)) {
+      return false;
+    }
+    source->buffer.clear();
+    auto dstPixels = source->buffer.bytes();
+    for (size_t y = 0; y < height; y++) {
+      auto alphas = source->pixels + y * source->rowBytes;
+      for (size_t x = 0; x < width; x++) {
+        dstPixels[x * 2 + 1] = alphas[x];
+      }
+      dstPixels += width * 2;
+    }
+    source->pixels = source->buffer.bytes();
+    source->rowBytes = width * 2;
   } else if (pixmap.colorType() != ColorType::RGBA_8888 ||
              pixmap.alphaType() == AlphaType::Premultiplied) {
     auto dstInfo = ImageInfo::Make(pixmap.width(), pixmap.height(), ColorType::RGBA_8888,
                                    AlphaType::Unpremultiplied);
-    tempBuffer.alloc(dstInfo.byteSize());
-    if (!pixmap.readPixels(dstInfo, tempBuffer.data())) {
-      return nullptr;
-    }
-    srcPixels = tempBuffer.bytes();
-    srcRowBytes = static_cast<int>(dstInfo.rowBytes());
-  }
-  PngWriter pngWriter;
-  png_structp png_ptr = nullptr;
-  png_infop info_ptr = nullptr;
-  png_ptr = png_create_write_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
-  bool encodeSuccess = false;
-  do {
-    if (png_ptr == nullptr) {
-      break;
+    if (!source->buffer.alloc(dstInfo.byteSize()) ||
+        !pixmap.readPixels(dstInfo, source->buffer.data())) {
+      return false;
     }
-    info_ptr = png_create_info_struct(png_ptr);
-    if (info_ptr == nullptr) {
-      break;
-    }
-    if (setjmp(png_jmpbuf(png_ptr))) {
-      break;
+    source->pixels = source->buffer.bytes();
+    source->rowBytes = dstInfo.rowBytes();
+  }
+  return true;
+}
+
+static void WriteToStream(png_structp p, png_bytep data, png_size_t length) {
+  auto stream = static_cast<WriteStream*>(png_get_io_ptr(p));
+  if (!stream->write(data, length)) {
+    png_error(p, "Failed to write to the stream.");
+  }
+}
+
+static void FlushStream(png_structp p) {
+  static_cast<WriteStream*>(png_get_io_ptr(p))->flush();
+}
+
+static bool EncodeWithLibpng(const PngEncodeSource& source, int width, int height,
+                             WriteStream* stream) {
+  auto p = png_create_write_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
+  if (p == nullptr) {
+    return false;
+  }
+  auto pi = png_create_info_struct(p);
+  if (pi == nullptr) {
+    png_destroy_write_struct(&p, nullptr);
+    return false;
+  }
+  if (setjmp(png_jmpbuf(p))) {
+    png_destroy_write_struct(&p, &pi);
+    return false;
+  }
+  png_color_8 sigBit = {8, 8, 8, 0, 8};
+  int colorType = PNG_COLOR_TYPE_RGB_ALPHA;
+  if (source.channels == 2) {
+    // We store ALPHA_8 images as GrayAlpha in png. If the gray channel is set to 1, we assume the
+    // gray channel can be ignored, and we output just alpha. We tried 0 at first, but png doesn't
+    // like a 0 sigBit for a channel it expects, hence we chose 1.
+    sigBit = {0, 0, 0, 1, 8};
+    colorType = PNG_COLOR_TYPE_GRAY_ALPHA;
+  }
+  png_set_IHDR(p, pi, static_cast<png_uint_32>(width), static_cast<png_uint_32>(height), 8,
+               colorType, PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_BASE, PNG_FILTER_TYPE_BASE);
+  png_set_sBIT(p, pi, &sigBit);
+  png_set_write_fn(p, stream, WriteToStream, FlushStream);
+  png_write_info(p, pi);
+  for (int i = 0; i < height; ++i) {
+    png_write_row(p, source.pixels + static_cast<size_t>(i) * source.rowBytes);
+  }
+  png_write_end(p, pi);
+  png_destroy_write_struct(&p, &pi);
+  return true;
+}
+
+/**
+ * The compressed output of a band of rows. Every band is an independent raw deflate stream that
+ * ends on a byte boundary, so the bands can be concatenated into a single zlib stream.
+ */
+struct PngBand {
+  std::vector<uint8_t> output = {};
+  uLong adler = 1;
+  size_t inputLength = 0;
+};
+
+static uint8_t PaethPredictor(int a, int b, int c) {
+  auto p = a + b - c;
+  auto pa = abs(p - a);
+  auto pb = abs(p - b);
+  auto pc = abs(p - c);
+  if (pa <= pb && pa <= pc) {
+    return static_cast<uint8_t>(a);
+  }
+  return static_cast<uint8_t>(pb <= pc ? b : c);
+}
+
+static void FilterRow(int filter, const uint8_t* row, const uint8_t* prevRow, size_t length,
+                      size_t bpp, uint8_t* output) {
+  output[0] = static_cast<uint8_t>(filter);
+  output++;
+  for (size_t i = 0; i < length; i++) {
+    int a = i >= bpp ? row[i - bpp] : 0;
+    int b = prevRow[i];
+    int c = i >= bpp ? prevRow[i - bpp] : 0;
+    int predictor = 0;
+    switch (filter) {
+      case PNG_FILTER_VALUE_SUB:
+        predictor = a;
+        break;
+      case PNG_FILTER_VALUE_UP:
+        predictor = b;
+        break;
+      case PNG_FILTER_VALUE_AVG:
+        predictor = (a + b) / 2;
+        break;
+      case PNG_FILTER_VALUE_PAETH:
+        predictor = PaethPredictor(a, b, c);
+        break;
+      default:
+        break;
     }
-    png_color_8 sigBit = {8, 8, 8, 0, 8};
-    int colorType = PNG_COLOR_TYPE_RGB_ALPHA;
-    if (pixmap.colorType() == ColorType::ALPHA_8) {
-      // We store ALPHA_8 images as GrayAlpha in png. If the gray channel is set to 1, we assume the
-      // gray channel can be ignored, and we output just alpha. We tried 0 at first, but png doesn't
-      // like a 0 sigBit for a channel it expects, hence we chose 1.
-      sigBit = {0, 0, 0, 1, 8};
-      colorType = PNG_COLOR_TYPE_GRAY_ALPHA;
+    output[i] = static_cast<uint8_t>(row[i] - predictor);
+  }
+}
+
+/**
+ * Picks the filter with the minimum sum of absolute differences, the same heuristic libpng uses by
+ * default.
+ */
+static size_t FilterCost(const uint8_t* data, size_t length) {
+  size_t cost = 0;
+  for (size_t i = 1; i < length; i++) {
+    cost += data[i] < 128 ? data[i] : 256 - data[i];
+  }
+  return cost;
+}
+
+static bool DeflateData(z_stream* zs, const uint8_t* data, size_t length, int flush,
+                        std::vector<uint8_t>* output) {
+  static constexpr size_t ChunkSize = 16 * 1024;
+  uint8_t chunk[ChunkSize];
+  zs->next_in = const_cast<uint8_t*>(data);
+  zs->avail_in = static_cast<uInt>(length);
+  do {
+    zs->next_out = chunk;
+    zs->avail_out = ChunkSize;
+    if (deflate(zs, flush) == Z_STREAM_ERROR) {
+      return false;
     }
-    png_set_IHDR(png_ptr, info_ptr, static_cast<png_uint_32>(pixmap.width()),
-                 static_cast<png_uint_32>(pixmap.height()), 8, colorType, PNG_INTERLACE_NONE,
-                 PNG_COMPRESSION_TYPE_BASE, PNG_FILTER_TYPE_BASE);
-    png_set_sBIT(png_ptr, info_ptr, &sigBit);
-    png_set_write_fn(png_ptr, &pngWriter, png_reader_write_data, nullptr);
-    png_write_info(png_ptr, info_ptr);
-    for (int i = 0; i < pixmap.height(); ++i) {
-      if (pixmap.colorType() == ColorType::ALPHA_8) {
-        // convert alpha8 to gray
-        for (int j = 0; j < pixmap.width(); j++) {
-          *(alphaPixels++) = 0;
-          *(alphaPixels++) = *(srcPixels++);
-        }
-        alphaPixels -= srcRowBytes;
-        srcPixels += (pixmap.rowBytes() - static_cast<size_t>(pixmap.width()));
-        png_write_row(png_ptr, reinterpret_cast<png_const_bytep>(alphaPixels));
-      } else {
-        png_write_row(png_ptr, reinterpret_cast<png_const_bytep>(srcPixels));
-        srcPixels += srcRowBytes;
+    output->insert(output->end(), chunk, chunk + (ChunkSize - zs->avail_out));
+  } while (zs->avail_out == 0);
+  return true;
+}
+
+static bool CompressBand(const PngEncodeSource& source, int width, int top, int bottom,
+                         bool lastBand, PngBand* band) {
+  z_stream zs = {};
+  if (deflateInit2(&zs, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8, Z_FILTERED) != Z_OK) {
+    return false;
+  }
+  auto bpp = static_cast<size_t>(source.channels);
+  auto length = static_cast<size_t>(width) * bpp;
+  std::vector<uint8_t> zeroRow(length, 0);
+  std::vector<uint8_t> candidates((length + 1) * 5);
+  bool success = true;
+  for (int y = top; y < bottom && success; y++) {
+    auto row = source.pixels + static_cast<size_t>(y) * source.rowBytes;
+    auto prevRow = y > 0 ? row - source.rowBytes : zeroRow.data();
+    const uint8_t* filtered = nullptr;
+    size_t minCost = SIZE_MAX;
+    for (int filter = PNG_FILTER_VALUE_NONE; filter < PNG_FILTER_VALUE_LAST; filter++) {
+      auto candidate = candidates.data() + static_cast<size_t>(filter) * (length + 1);
+      FilterRow(filter, row, prevRow, length, bpp, candidate);
+      auto cost = FilterCost(candidate, length + 1);
+      if (cost < minCost) {
+        minCost = cost;
+        filtered = candidate;
       }
     }
-    png_write_end(png_ptr, info_ptr);
-    encodeSuccess = true;
-  } while (false);
-  if (png_ptr) {
-    png_destroy_write_struct(&png_ptr, &info_ptr);
-  }
-  if (!encodeSuccess) {
-    if (pngWriter.data) {
-      free(pngWriter.data);
+    band->adler = adler32(band->adler, filtered, static_cast<uInt>(length + 1));
+    band->inputLength += length + 1;
+    success = DeflateData(&zs, filtered, length + 1, Z_NO_FLUSH, &band->output);
+  }
+  if (success) {
+    success = DeflateData(&zs, nullptr, 0, lastBand ? Z_FINISH : Z_SYNC_FLUSH, &band->output);
+  }
+  deflateEnd(&zs);
+  return success;
+}
+
+static void AppendUInt32(std::vector<uint8_t>* data, uint32_t value) {
+  data->push_back(static_cast<uint8_t>(value >> 24));
+  data->push_back(static_cast<uint8_t>(value >> 16));
+  data->push_back(static_cast<uint8_t>(value >> 8));
+  data->push_back(static_cast<uint8_t>(value));
+}
+
+static bool WriteChunk(WriteStream* stream, const char* type, const uint8_t* data, size_t length) {
+  std::vector<uint8_t> header = {};
+  AppendUInt32(&header, static_cast<uint32_t>(length));
+  header.insert(header.end(), type, type + 4);
+  auto crc = crc32(0, header.data() + 4, 4);
+  if (length > 0) {
+    crc = crc32(crc, data, static_cast<uInt>(length));
+  }
+  std::vector<uint8_t> footer = {};
+  AppendUInt32(&footer, static_cast<uint32_t>(crc));
+  return stream->write(header.data(), header.size()) &&
+         (length == 0 || stream->write(data, length)) &&
+         stream->write(footer.data(), footer.size());
+}
+
+/**
+ * Filters and compresses bands of rows concurrently, then writes them as consecutive IDAT chunks
+ * of a single zlib stream.
+ */
+static bool EncodeInParallel(const PngEncodeSource& source, int width, int height, int bandCount,
+                             WriteStream* stream) {
+  auto bandHeight = (height + bandCount - 1) / bandCount;
+  std::vector<PngBand> bands(static_cast<size_t>((height + bandHeight - 1) / bandHeight));
+  auto success = ParallelForRows(height, bandCount, [&](int top, int bottom) {
+    return CompressBand(source, width, top, bottom, bottom == height,
+                        &bands[static_cast<size_t>(top / bandHeight)]);
+  });
+  if (!success) {
+    return false;
+  }
+  static constexpr uint8_t Signature[8] = {137, 80, 78, 71, 13, 10, 26, 10};
+  std::vector<uint8_t> header = {};
+  AppendUInt32(&header, static_cast<uint32_t>(width));
+  AppendUInt32(&header, static_cast<uint32_t>(height));
+  auto colorType = source.channels == 2 ? PNG_COLOR_TYPE_GRAY_ALPHA : PNG_COLOR_TYPE_RGB_ALPHA;
+  header.insert(header.end(), {8, static_cast<uint8_t>(colorType), 0, 0, 0});
+  // Matches the sBIT chunk written by libpng, see EncodeWithLibpng().
+  std::vector<uint8_t> sigBit = {8, 8, 8, 8};
+  if (source.channels == 2) {
+    sigBit = {1, 8};
+  }
+  if (!stream->write(Signature, sizeof(Signature)) ||
+      !WriteChunk(stream, "IHDR", header.data(), header.size()) ||
+      !WriteChunk(stream, "sBIT", sigBit.data(), sigBit.size())) {
+    return false;
+  }
+  // The zlib header for the default compression level, followed by the deflate streams of the
+  // bands and the combined Adler-32 checksum of the filtered rows.
+  bands.front().output.insert(bands.front().output.begin(), {0x78, 0x9C});
+  uLong adler = 1;
+  for (auto& band : bands) {
+    adler = adler32_combine(adler, band.adler, static_cast<z_off_t>(band.inputLength));
+  }
+  AppendUInt32(&bands.back().output, static_cast<uint32_t>(adler));
+  for (auto& band : bands) {
+    if (!WriteChunk(stream, "IDAT", band.output.data(), band.output.size())) {
+      return false;
     }
-    return nullptr;
   }
-  return Data::MakeAdopted(pngWriter.data, pngWriter.length, Data::FreeProc);
+  if (!WriteChunk(stream, "IEND", nullptr, 0)) {
+    return false;
+  }
+  stream->flush();
+  return true;
+}
+
+bool PngCodec::Encode(const Pixmap& pixmap, int, WriteStream* stream) {
+  PngEncodeSource source = {};
+  if (!PrepareEncodeSource(pixmap, &source)) {
+    return false;
+  }
+  auto bandCount = GetParallelBandCount(pixmap.width(), pixmap.height());
+  if (bandCount > 1) {
+    return EncodeInParallel(source, pixmap.width(), pixmap.height(), bandCount, stream);
+  }
+  return EncodeWithLibpng(source, pixmap.width(), pixmap.height(), stream);
 }
 #endif
 
@@ -19,6 +19,8 @@
 #pragma once
 
 #include "tgfx/core/ImageCodec.h"
+#include "tgfx/core/IncrementalDecoder.h"
+#include "tgfx/core/WriteStream.h"
 
 namespace tgfx {
 class PngCodec : public ImageCodec {
@@ -26,16 +28,20 @@ class PngCodec : public ImageCodec {
   static std::shared_ptr<ImageCodec> MakeFrom(const std::string& filePath);
   static std::shared_ptr<ImageCodec> MakeFrom(std::shared_ptr<Data> imageBytes);
   static bool IsPng(const std::shared_ptr<Data>& data);
+  static std::shared_ptr<IncrementalDecoder> MakeIncrementalDecoder();
 
   bool isAlphaOnly() const override;
 
 #ifdef TGFX_USE_PNG_ENCODE
-  static std::shared_ptr<Data> Encode(const Pixmap& pixmap, int quality);
+  static bool Encode(const Pixmap& pixmap, int quality, WriteStream* stream);
 #endif
 
  protected:
   bool readPixels(const ImageInfo& dstInfo, void* dstPixels) const override;
 
+  bool onReadRegion(const ISize& scaledSize, const Rect& region, const ImageInfo& dstInfo,
+                    void* dstPixels) const override;
+
   std::shared_ptr<Data> getEncodedData() const override;
 
  private:
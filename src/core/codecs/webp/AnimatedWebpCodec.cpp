@@ -0,0 +1,105 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "core/codecs/webp/AnimatedWebpCodec.h"
+
+namespace tgfx {
+std::shared_ptr<AnimatedCodec> AnimatedWebpCodec::MakeFrom(std::shared_ptr<Data> imageBytes) {
+  WebPData webpData = {imageBytes->bytes(), imageBytes->size()};
+  auto demux = WebPDemux(&webpData);
+  if (demux == nullptr) {
+    return nullptr;
+  }
+  auto flags = WebPDemuxGetI(demux, WEBP_FF_FORMAT_FLAGS);
+  auto frameCount = static_cast<int>(WebPDemuxGetI(demux, WEBP_FF_FRAME_COUNT));
+  if ((flags & ANIMATION_FLAG) == 0 || frameCount <= 0) {
+    WebPDemuxDelete(demux);
+    return nullptr;
+  }
+  std::vector<FrameInfo> frames = {};
+  WebPIterator iterator = {};
+  for (int i = 1; i <= frameCount; i++) {
+    if (!WebPDemuxGetFrame(demux, i, &iterator)) {
+      break;
+    }
+    FrameInfo frame = {};
+    frame.bounds = Rect::MakeXYWH(iterator.x_offset, iterator.y_offset, iterator.width,
+                                  iterator.height);
+    frame.duration = static_cast<int64_t>(iterator.duration) * 1000;
+    frame.disposal = iterator.dispose_method == WEBP_MUX_DISPOSE_BACKGROUND
+                         ? FrameDisposal::Background
+                         : FrameDisposal::None;
+    frame.blend = iterator.blend_method == WEBP_MUX_BLEND;
+    frames.push_back(frame);
+    WebPDemuxReleaseIterator(&iterator);
+  }
+  auto width = static_cast<int>(WebPDemuxGetI(demux, WEBP_FF_CANVAS_WIDTH));
+  auto height = static_cast<int>(WebPDemuxGetI(demux, WEBP_FF_CANVAS_HEIGHT));
+  auto loopCount = static_cast<int>(WebPDemuxGetI(demux, WEBP_FF_LOOP_COUNT));
+  WebPDemuxDelete(demux);
+  if (static_cast<int>(frames.size()) != frameCount) {
+    return nullptr;
+  }
+  WebPAnimDecoderOptions options = {};
+  if (!WebPAnimDecoderOptionsInit(&options)) {
+    return nullptr;
+  }
+  options.color_mode = MODE_rgbA;
+  options.use_threads = 0;
+  auto decoder = WebPAnimDecoderNew(&webpData, &options);
+  if (decoder == nullptr) {
+    return nullptr;
+  }
+  return std::shared_ptr<AnimatedCodec>(new AnimatedWebpCodec(
+      width, height, std::move(frames), loopCount, std::move(imageBytes), decoder));
+}
+
+AnimatedWebpCodec::AnimatedWebpCodec(int width, int height, std::vector<FrameInfo> frames,
+                                     int loopCount, std::shared_ptr<Data> fileData,
+                                     WebPAnimDecoder* decoder)
+    : AnimatedCodec(width, height, std::move(frames), loopCount), fileData(std::move(fileData)),
+      decoder(decoder) {
+}
+
+AnimatedWebpCodec::~AnimatedWebpCodec() {
+  WebPAnimDecoderDelete(decoder);
+}
+
+const void* AnimatedWebpCodec::onDecodeFrame(int index) {
+  if (index == nextIndex - 1 && canvas != nullptr) {
+    return canvas;
+  }
+  if (index < nextIndex) {
+    WebPAnimDecoderReset(decoder);
+    nextIndex = 0;
+  }
+  while (nextIndex <= index) {
+    uint8_t* buffer = nullptr;
+    int timestamp = 0;
+    if (!WebPAnimDecoderGetNext(decoder, &buffer, &timestamp)) {
+      canvas = nullptr;
+      nextIndex = 0;
+      WebPAnimDecoderReset(decoder);
+      return nullptr;
+    }
+    canvas = buffer;
+    nextIndex++;
+  }
+  return canvas;
+}
+}  // namespace tgfx
@@ -0,0 +1,50 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "core/codecs/webp/WebpCodec.h"
+#include "tgfx/core/AnimatedCodec.h"
+
+namespace tgfx {
+/**
+ * AnimatedWebpCodec decodes the frames of an animated WebP image with the WebPAnimDecoder of
+ * libwebp, which also takes care of compositing them.
+ */
+class AnimatedWebpCodec : public AnimatedCodec {
+ public:
+  /**
+   * Returns nullptr if the bytes are not an animated WebP image.
+   */
+  static std::shared_ptr<AnimatedCodec> MakeFrom(std::shared_ptr<Data> imageBytes);
+
+  ~AnimatedWebpCodec() override;
+
+ protected:
+  const void* onDecodeFrame(int index) override;
+
+ private:
+  std::shared_ptr<Data> fileData = nullptr;
+  WebPAnimDecoder* decoder = nullptr;
+  const uint8_t* canvas = nullptr;
+  int nextIndex = 0;
+
+  AnimatedWebpCodec(int width, int height, std::vector<FrameInfo> frames, int loopCount,
+                    std::shared_ptr<Data> fileData, WebPAnimDecoder* decoder);
+};
+}  // namespace tgfx
@@ -17,7 +17,11 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "core/codecs/webp/WebpCodec.h"
+#include <algorithm>
+#include <cmath>
 #include "core/codecs/webp/WebpUtility.h"
+#include "core/utils/MappedFile.h"
+#include "core/utils/ParallelRows.h"
 #include "tgfx/core/Buffer.h"
 #include "tgfx/core/Pixmap.h"
 
@@ -29,6 +33,11 @@ bool WebpCodec::IsWebp(const std::shared_ptr<Data>& data) {
 }
 
 std::shared_ptr<ImageCodec> WebpCodec::MakeFrom(const std::string& filePath) {
+  // Decoding from the mapped bytes avoids reopening and rereading the file on every decode.
+  auto fileData = MapFile(filePath, FileAccess::Sequential);
+  if (fileData != nullptr) {
+    return MakeFrom(std::move(fileData));
+  }
   auto info = WebpUtility::getDecodeInfo(filePath);
   if (info.width == 0 || info.height == 0) {
     auto data = Data::MakeFromFile(filePath);
@@ -53,6 +62,66 @@ std::shared_ptr<ImageCodec> WebpCodec::MakeFrom(std::shared_ptr<Data> imageBytes
       new WebpCodec(info.width, info.height, info.orientation, "", std::move(imageBytes)));
 }
 
+class WebpIncrementalDecoder : public IncrementalDecoder {
+ public:
+  WebpIncrementalDecoder() {
+    WebPInitDecBuffer(&output);
+    output.colorspace = MODE_RGBA;
+    decoder = WebPINewDecoder(&output);
+  }
+
+  ~WebpIncrementalDecoder() override {
+    if (decoder != nullptr) {
+      WebPIDelete(decoder);
+    }
+    WebPFreeDecBuffer(&output);
+  }
+
+ protected:
+  bool onAppend(const uint8_t* bytes, size_t length) override {
+    if (decoder == nullptr) {
+      return false;
+    }
+    auto status = WebPIAppend(decoder, bytes, length);
+    if (status != VP8_STATUS_OK && status != VP8_STATUS_SUSPENDED) {
+      return false;
+    }
+    int lastRow = 0;
+    int width = 0;
+    int height = 0;
+    int stride = 0;
+    // Returns nullptr until the header of the image has been decoded.
+    auto pixels = WebPIDecGetRGB(decoder, &lastRow, &width, &height, &stride);
+    if (pixels == nullptr) {
+      return true;
+    }
+    if (!setDimensions(width, height)) {
+      return false;
+    }
+    // libwebp decodes into its own buffer, the newly decoded rows are copied from there.
+    auto rowLength = static_cast<size_t>(width) * 4;
+    for (int row = decodedRows; row < lastRow; row++) {
+      memcpy(getRow(row), pixels + static_cast<size_t>(stride) * static_cast<size_t>(row),
+             rowLength);
+    }
+    markRowsDecoded(decodedRows, lastRow);
+    decodedRows = std::max(decodedRows, lastRow);
+    if (status == VP8_STATUS_OK) {
+      markComplete();
+    }
+    return true;
+  }
+
+ private:
+  WebPDecBuffer output = {};
+  WebPIDecoder* decoder = nullptr;
+  int decodedRows = 0;
+};
+
+std::shared_ptr<IncrementalDecoder> WebpCodec::MakeIncrementalDecoder() {
+  return std::make_shared<WebpIncrementalDecoder>();
+}
+
 static WEBP_CSP_MODE webp_decode_mode(ColorType dstCT, bool premultiply) {
   switch (dstCT) {
     case ColorType::BGRA_8888:
@@ -64,7 +133,29 @@ static WEBP_CSP_MODE webp_decode_mode(ColorType dstCT, bool premultiply) {
   }
 }
 
+ISize WebpCodec::getScaledDimensions(float scale) const {
+  if (scale >= 1.0f || scale <= 0.0f) {
+    return ISize::Make(width(), height());
+  }
+  // libwebp rescales the output rows on the fly, so any size smaller than the image is supported.
+  auto scaledWidth = std::max(static_cast<int>(ceilf(static_cast<float>(width()) * scale)), 1);
+  auto scaledHeight = std::max(static_cast<int>(ceilf(static_cast<float>(height()) * scale)), 1);
+  return ISize::Make(scaledWidth, scaledHeight);
+}
+
 bool WebpCodec::readPixels(const ImageInfo& dstInfo, void* dstPixels) const {
+  return decodePixels(dstInfo, dstPixels, false);
+}
+
+bool WebpCodec::readScaledPixels(const ImageInfo& dstInfo, void* dstPixels) const {
+  if (dstInfo.width() > width() || dstInfo.height() > height()) {
+    return false;
+  }
+  auto scaled = dstInfo.width() != width() || dstInfo.height() != height();
+  return decodePixels(dstInfo, dstPixels, scaled);
+}
+
+bool WebpCodec::decodePixels(const ImageInfo& dstInfo, void* dstPixels, bool scaled) const {
   if (dstPixels == nullptr || dstInfo.isEmpty()) {
     return false;
   }
@@ -80,6 +171,11 @@ bool WebpCodec::readPixels(const ImageInfo& dstInfo, void* dstPixels) const {
   if (WebPGetFeatures(byteData->bytes(), byteData->size(), &config.input) != VP8_STATUS_OK) {
     return false;
   }
+  if (scaled) {
+    config.options.use_scaling = 1;
+    config.options.scaled_width = dstInfo.width();
+    config.options.scaled_height = dstInfo.height();
+  }
   config.output.is_external_memory = 1;
   config.output.colorspace =
       webp_decode_mode(dstInfo.colorType(), dstInfo.alphaType() == AlphaType::Premultiplied);
@@ -112,6 +208,58 @@ bool WebpCodec::readPixels(const ImageInfo& dstInfo, void* dstPixels) const {
   return decodeSuccess;
 }
 
+bool WebpCodec::onReadRegion(const ISize& scaledSize, const Rect& region,
+                             const ImageInfo& dstInfo, void* dstPixels) const {
+  // Cropping is applied before scaling in libwebp, so a scaled region can't be mapped exactly to
+  // the output. ImageCodec falls back to a full resolution region in that case.
+  if (scaledSize.width != width() || scaledSize.height != height()) {
+    return false;
+  }
+  auto byteData = fileData;
+  if (byteData == nullptr) {
+    byteData = Data::MakeFromFile(filePath);
+  }
+  if (byteData == nullptr) {
+    return false;
+  }
+  WebPDecoderConfig config;
+  if (!WebPInitDecoderConfig(&config)) return false;
+  if (WebPGetFeatures(byteData->bytes(), byteData->size(), &config.input) != VP8_STATUS_OK) {
+    return false;
+  }
+  // libwebp rounds the crop origin down to even coordinates for the chroma planes, so the crop is
+  // aligned here and the extra column or row is skipped when copying.
+  auto left = static_cast<int>(region.left);
+  auto top = static_cast<int>(region.top);
+  auto cropLeft = left & ~1;
+  auto cropTop = top & ~1;
+  config.options.use_cropping = 1;
+  config.options.crop_left = cropLeft;
+  config.options.crop_top = cropTop;
+  config.options.crop_width = static_cast<int>(region.right) - cropLeft;
+  config.options.crop_height = static_cast<int>(region.bottom) - cropTop;
+  auto premultiplied = dstInfo.alphaType() == AlphaType::Premultiplied;
+  auto alphaType = premultiplied ? AlphaType::Premultiplied : AlphaType::Unpremultiplied;
+  auto info = ImageInfo::Make(config.options.crop_width, config.options.crop_height,
+                              ColorType::RGBA_8888, alphaType);
+  Buffer buffer(info.byteSize());
+  if (buffer.isEmpty()) {
+    return false;
+  }
+  config.output.is_external_memory = 1;
+  config.output.colorspace = webp_decode_mode(info.colorType(), premultiplied);
+  config.output.u.RGBA.rgba = buffer.bytes();
+  config.output.u.RGBA.stride = static_cast<int>(info.rowBytes());
+  config.output.u.RGBA.size = info.byteSize();
+  auto decodeSuccess = WebPDecode(byteData->bytes(), byteData->size(), &config) == VP8_STATUS_OK;
+  WebPFreeDecBuffer(&config.output);
+  if (!decodeSuccess) {
+    return false;
+  }
+  Pixmap pixmap(info, buffer.data());
+  return pixmap.readPixels(dstInfo, dstPixels, left - cropLeft, top - cropTop);
+}
+
 std::shared_ptr<Data> WebpCodec::getEncodedData() const {
   if (fileData) {
     return fileData;
@@ -123,26 +271,12 @@ std::shared_ptr<Data> WebpCodec::getEncodedData() const {
 }
 
 #ifdef TGFX_USE_WEBP_ENCODE
-struct WebpWriter {
-  unsigned char* data = nullptr;
-  size_t length = 0;
-};
-
-static int webp_reader_write_data(const uint8_t* data, size_t data_size,
-                                  const WebPPicture* picture) {
-  auto writer = static_cast<WebpWriter*>(picture->custom_ptr);
-  size_t nsize = writer->length + data_size;
-  if (writer->data) {
-    writer->data = static_cast<unsigned char*>(realloc(writer->data, nsize));
-  } else {
-    writer->data = static_cast<unsigned char*>(malloc(nsize));
-  }
-  memcpy(writer->data + writer->length, data, data_size);
-  writer->length += data_size;
-  return 1;
+static int WriteToStream(const uint8_t* data, size_t dataSize, const WebPPicture* picture) {
+  auto stream = static_cast<WriteStream*>(picture->custom_ptr);
+  return stream->write(data, dataSize) ? 1 : 0;
 }
 
-std::shared_ptr<Data> WebpCodec::Encode(const Pixmap& pixmap, int quality) {
+bool WebpCodec::Encode(const Pixmap& pixmap, int quality, WriteStream* stream) {
   const uint8_t* srcPixels = static_cast<uint8_t*>(const_cast<void*>(pixmap.pixels()));
   auto srcInfo = pixmap.info();
   Buffer tempBuffer = {};
@@ -154,7 +288,7 @@ std::shared_ptr<Data> WebpCodec::Encode(const Pixmap& pixmap, int quality) {
     tempBuffer.alloc(srcInfo.byteSize());
     srcPixels = tempBuffer.bytes();
     if (!pixmap.readPixels(srcInfo, tempBuffer.data())) {
-      return nullptr;
+      return false;
     }
   }
   WebPConfig webp_config;
@@ -164,13 +298,18 @@ std::shared_ptr<Data> WebpCodec::Encode(const Pixmap& pixmap, int quality) {
     isLossless = true;
   }
   if (!WebPConfigPreset(&webp_config, WEBP_PRESET_DEFAULT, static_cast<float>(quality))) {
-    return nullptr;
+    return false;
+  }
+  // Lets libwebp run the analysis and the alpha plane compression on extra threads for large
+  // images.
+  if (GetParallelBandCount(srcInfo.width(), srcInfo.height()) > 1) {
+    webp_config.thread_level = 1;
   }
   WebPPicture pic;
   WebPPictureInit(&pic);
   pic.width = srcInfo.width();
   pic.height = srcInfo.height();
-  pic.writer = webp_reader_write_data;
+  pic.writer = WriteToStream;
   if (isLossless) {
     webp_config.lossless = 1;
     webp_config.method = 0;
@@ -181,8 +320,7 @@ std::shared_ptr<Data> WebpCodec::Encode(const Pixmap& pixmap, int quality) {
     pic.use_argb = 0;
   }
 
-  WebpWriter webpWriter;
-  pic.custom_ptr = &webpWriter;
+  pic.custom_ptr = stream;
   auto importProc = WebPPictureImportRGBX;
   if (ColorType::RGBA_8888 == srcInfo.colorType()) {
     if (AlphaType::Opaque == srcInfo.alphaType()) {
@@ -200,13 +338,11 @@ std::shared_ptr<Data> WebpCodec::Encode(const Pixmap& pixmap, int quality) {
   auto rowBytes = static_cast<int>(srcInfo.rowBytes());
   if (!importProc(&pic, srcPixels, rowBytes) || !WebPEncode(&webp_config, &pic)) {
     WebPPictureFree(&pic);
-    if (webpWriter.data) {
-      free(webpWriter.data);
-    }
-    return nullptr;
+    return false;
   }
   WebPPictureFree(&pic);
-  return Data::MakeAdopted(webpWriter.data, webpWriter.length, Data::FreeProc);
+  stream->flush();
+  return true;
 }
 #endif
 
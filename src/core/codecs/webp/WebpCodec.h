@@ -19,6 +19,8 @@
 #pragma once
 
 #include "tgfx/core/ImageCodec.h"
+#include "tgfx/core/IncrementalDecoder.h"
+#include "tgfx/core/WriteStream.h"
 #include "webp/decode.h"
 #include "webp/demux.h"
 #include "webp/encode.h"
@@ -29,20 +31,30 @@ class WebpCodec : public ImageCodec {
   static std::shared_ptr<ImageCodec> MakeFrom(const std::string& filePath);
   static std::shared_ptr<ImageCodec> MakeFrom(std::shared_ptr<Data> imageBytes);
   static bool IsWebp(const std::shared_ptr<Data>& data);
+  static std::shared_ptr<IncrementalDecoder> MakeIncrementalDecoder();
 
 #ifdef TGFX_USE_WEBP_ENCODE
-  static std::shared_ptr<Data> Encode(const Pixmap& pixmap, int quality);
+  static bool Encode(const Pixmap& pixmap, int quality, WriteStream* stream);
 #endif
 
  protected:
   bool readPixels(const ImageInfo& dstInfo, void* dstPixels) const override;
 
+  ISize getScaledDimensions(float scale) const override;
+
+  bool readScaledPixels(const ImageInfo& dstInfo, void* dstPixels) const override;
+
+  bool onReadRegion(const ISize& scaledSize, const Rect& region, const ImageInfo& dstInfo,
+                    void* dstPixels) const override;
+
   std::shared_ptr<Data> getEncodedData() const override;
 
  private:
   std::shared_ptr<Data> fileData;
   std::string filePath;
 
+  bool decodePixels(const ImageInfo& dstInfo, void* dstPixels, bool scaled) const;
+
   explicit WebpCodec(int width, int height, Orientation orientation, std::string filePath,
                      std::shared_ptr<Data> fileData)
       : ImageCodec(width, height, orientation), fileData(std::move(fileData)),
@@ -17,9 +17,54 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "CodecImage.h"
+#include <algorithm>
+#include <cmath>
 #include <memory>
+#include "core/PixelBuffer.h"
+#include "gpu/ProxyProvider.h"
+#include "gpu/processors/TiledTextureEffect.h"
 
 namespace tgfx {
+/**
+ * The smallest scale a codec image is decoded at. Requested scales are rounded up to a power of
+ * two, which keeps the number of cached textures per image small while the zoom level changes.
+ */
+static constexpr float MinDecodeScale = 0.125f;
+
+/**
+ * ScaledCodecGenerator decodes an ImageCodec at a reduced size using the codec's native scaled
+ * decoding.
+ */
+class ScaledCodecGenerator : public ImageGenerator {
+ public:
+  ScaledCodecGenerator(std::shared_ptr<ImageCodec> codec, const ISize& size)
+      : ImageGenerator(size.width, size.height), codec(std::move(codec)) {
+  }
+
+  bool isAlphaOnly() const override {
+    return codec->isAlphaOnly();
+  }
+
+  bool asyncSupport() const override {
+    return codec->asyncSupport();
+  }
+
+ protected:
+  std::shared_ptr<ImageBuffer> onMakeBuffer(bool tryHardware) const override {
+    auto pixelBuffer = PixelBuffer::Make(width(), height(), isAlphaOnly(), tryHardware);
+    if (pixelBuffer == nullptr) {
+      return nullptr;
+    }
+    auto pixels = pixelBuffer->lockPixels();
+    auto result = codec->readScaledPixels(pixelBuffer->info(), pixels);
+    pixelBuffer->unlockPixels();
+    return result ? pixelBuffer : nullptr;
+  }
+
+ private:
+  std::shared_ptr<ImageCodec> codec = nullptr;
+};
+
 std::shared_ptr<Image> CodecImage::MakeFrom(const std::shared_ptr<ImageCodec>& codec) {
   if (!codec) {
     return nullptr;
@@ -37,4 +82,57 @@ std::shared_ptr<ImageCodec> CodecImage::codec() const {
   return std::static_pointer_cast<ImageCodec>(generator);
 }
 
+std::unique_ptr<FragmentProcessor> CodecImage::asFragmentProcessor(
+    const FPArgs& args, TileMode tileModeX, TileMode tileModeY, const SamplingOptions& sampling,
+    const Matrix* uvMatrix) const {
+  auto decodeSize = getDecodeSize(args, uvMatrix);
+  if (decodeSize.width == width() && decodeSize.height == height()) {
+    return ResourceImage::asFragmentProcessor(args, tileModeX, tileModeY, sampling, uvMatrix);
+  }
+  auto proxyProvider = args.context->proxyProvider();
+  // Prefer the full resolution texture if it already exists, instead of decoding the image again.
+  auto proxy = proxyProvider->findOrWrapTextureProxy(uniqueKey);
+  if (proxy != nullptr) {
+    return TiledTextureEffect::Make(std::move(proxy), tileModeX, tileModeY, sampling, uvMatrix,
+                                    isAlphaOnly());
+  }
+  uint32_t sizeKey[2] = {static_cast<uint32_t>(decodeSize.width),
+                         static_cast<uint32_t>(decodeSize.height)};
+  auto scaledKey = UniqueKey::Append(uniqueKey, sizeKey, 2);
+  auto scaledGenerator = std::make_shared<ScaledCodecGenerator>(codec(), decodeSize);
+  proxy = proxyProvider->createTextureProxy(scaledKey, std::move(scaledGenerator), false,
+                                            args.renderFlags);
+  auto scaleX = static_cast<float>(decodeSize.width) / static_cast<float>(width());
+  auto scaleY = static_cast<float>(decodeSize.height) / static_cast<float>(height());
+  auto matrix = Matrix::MakeScale(scaleX, scaleY);
+  if (uvMatrix != nullptr) {
+    matrix.preConcat(*uvMatrix);
+  }
+  return TiledTextureEffect::Make(std::move(proxy), tileModeX, tileModeY, sampling, &matrix,
+                                  isAlphaOnly());
+}
+
+ISize CodecImage::getDecodeSize(const FPArgs& args, const Matrix* uvMatrix) const {
+  auto fullSize = ISize::Make(width(), height());
+  if (args.context == nullptr) {
+    return fullSize;
+  }
+  // The uvMatrix maps the local coordinates of the draw to the image, so the image-to-device
+  // transformation is the view matrix concatenated with its inverse.
+  auto imageMatrix = args.viewMatrix;
+  if (uvMatrix != nullptr) {
+    Matrix invertMatrix = {};
+    if (!uvMatrix->invert(&invertMatrix)) {
+      return fullSize;
+    }
+    imageMatrix.preConcat(invertMatrix);
+  }
+  auto scale = imageMatrix.getMaxScale();
+  if (scale <= 0.0f || scale >= 0.5f) {
+    return fullSize;
+  }
+  scale = std::max(powf(2.0f, ceilf(log2f(scale))), MinDecodeScale);
+  return codec()->getScaledDimensions(scale);
+}
+
 }  // namespace tgfx
\ No newline at end of file
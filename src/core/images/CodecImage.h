@@ -38,8 +38,20 @@ class CodecImage : public GeneratorImage {
     return Type::Codec;
   }
 
+  std::unique_ptr<FragmentProcessor> asFragmentProcessor(const FPArgs& args, TileMode tileModeX,
+                                                         TileMode tileModeY,
+                                                         const SamplingOptions& sampling,
+                                                         const Matrix* uvMatrix) const override;
+
  private:
   explicit CodecImage(const std::shared_ptr<ImageCodec>& codec);
+
+  /**
+   * Returns the smallest size the codec can decode to that still provides at least one texel per
+   * device pixel for the given draw. Returns the full size of the image if scaled decoding is not
+   * supported or not beneficial.
+   */
+  ISize getDecodeSize(const FPArgs& args, const Matrix* uvMatrix) const;
 };
 
 }  // namespace tgfx
\ No newline at end of file
@@ -25,7 +25,15 @@ std::shared_ptr<Image> Image::MakeFrom(std::shared_ptr<ImageGenerator> generator
   if (generator == nullptr) {
     return nullptr;
   }
-  auto image = std::make_shared<GeneratorImage>(UniqueKey::Make(), std::move(generator));
+  return GeneratorImage::MakeFrom(UniqueKey::Make(), std::move(generator));
+}
+
+std::shared_ptr<Image> GeneratorImage::MakeFrom(UniqueKey uniqueKey,
+                                                std::shared_ptr<ImageGenerator> generator) {
+  if (generator == nullptr) {
+    return nullptr;
+  }
+  auto image = std::make_shared<GeneratorImage>(std::move(uniqueKey), std::move(generator));
   image->weakThis = image;
   return image;
 }
@@ -44,7 +52,7 @@ std::shared_ptr<Image> GeneratorImage::onMakeDecoded(Context* context, bool tryH
       return nullptr;
     }
   }
-  auto decoder = ImageDecoder::MakeFrom(generator, tryHardware, true);
+  auto decoder = ImageDecoder::MakeFrom(generator, tryHardware, true, uniqueKey);
   return DecoderImage::MakeFrom(uniqueKey, std::move(decoder));
 }
 
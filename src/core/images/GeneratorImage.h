@@ -26,6 +26,13 @@ namespace tgfx {
  */
 class GeneratorImage : public ResourceImage {
  public:
+  /**
+   * Creates a GeneratorImage with the specified UniqueKey, which allows images recreated for the
+   * same content to share the same GPU cache.
+   */
+  static std::shared_ptr<Image> MakeFrom(UniqueKey uniqueKey,
+                                         std::shared_ptr<ImageGenerator> generator);
+
   GeneratorImage(UniqueKey uniqueKey, std::shared_ptr<ImageGenerator> generator);
 
   int width() const override {
@@ -25,6 +25,7 @@
 #include "core/images/RasterizedImage.h"
 #include "core/images/SubsetImage.h"
 #include "core/images/TextureImage.h"
+#include "core/images/TiledImage.h"
 #include "gpu/OpContext.h"
 #include "gpu/ProxyProvider.h"
 #include "gpu/TPArgs.h"
@@ -60,6 +61,38 @@ class PixelDataConverter : public ImageGenerator {
   std::shared_ptr<Data> pixels = nullptr;
 };
 
+/**
+ * YUVCodecGenerator decodes an ImageCodec into YUV planes if possible, and falls back to RGBA
+ * pixels otherwise.
+ */
+class YUVCodecGenerator : public ImageGenerator {
+ public:
+  explicit YUVCodecGenerator(std::shared_ptr<ImageCodec> codec)
+      : ImageGenerator(codec->width(), codec->height()), codec(std::move(codec)) {
+  }
+
+  bool isAlphaOnly() const override {
+    return codec->isAlphaOnly();
+  }
+
+  bool asyncSupport() const override {
+    return codec->asyncSupport();
+  }
+
+ protected:
+  std::shared_ptr<ImageBuffer> onMakeBuffer(bool tryHardware) const override {
+    auto colorSpace = YUVColorSpace::JPEG_FULL;
+    auto yuvData = codec->readYUVData(&colorSpace);
+    if (yuvData != nullptr) {
+      return ImageBuffer::MakeI420(std::move(yuvData), colorSpace);
+    }
+    return codec->makeBuffer(tryHardware);
+  }
+
+ private:
+  std::shared_ptr<ImageCodec> codec = nullptr;
+};
+
 std::shared_ptr<Image> Image::MakeFromFile(const std::string& filePath) {
   auto codec = ImageCodec::MakeFrom(filePath);
   auto image = CodecImage::MakeFrom(codec);
@@ -78,6 +111,23 @@ std::shared_ptr<Image> Image::MakeFromEncoded(std::shared_ptr<Data> encodedData)
   return image->makeOriented(codec->orientation());
 }
 
+std::shared_ptr<Image> Image::MakeYUVFromEncoded(std::shared_ptr<Data> encodedData) {
+  auto codec = ImageCodec::MakeFrom(std::move(encodedData));
+  if (codec == nullptr) {
+    return nullptr;
+  }
+  auto orientation = codec->orientation();
+  auto image = MakeFrom(std::make_shared<YUVCodecGenerator>(std::move(codec)));
+  if (image == nullptr) {
+    return nullptr;
+  }
+  return image->makeOriented(orientation);
+}
+
+std::shared_ptr<Image> Image::MakeTiled(std::shared_ptr<ImageCodec> codec, int tileSize) {
+  return TiledImage::MakeFrom(std::move(codec), tileSize);
+}
+
 std::shared_ptr<Image> Image::MakeFrom(NativeImageRef nativeImage) {
   auto codec = ImageCodec::MakeFrom(nativeImage);
   auto image = CodecImage::MakeFrom(codec);
@@ -0,0 +1,184 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "TiledImage.h"
+#include <cmath>
+#include "core/PixelBuffer.h"
+#include "core/images/GeneratorImage.h"
+#include "gpu/ProxyProvider.h"
+#include "gpu/processors/TiledTextureEffect.h"
+
+namespace tgfx {
+static constexpr int MinTileSize = 64;
+
+/**
+ * The maximum width or height of the whole image decoded for sampling it outside the tiles.
+ */
+static constexpr int MaxFallbackSize = 4096;
+
+/**
+ * RegionGenerator decodes a region of an ImageCodec at the specified size.
+ */
+class RegionGenerator : public ImageGenerator {
+ public:
+  RegionGenerator(std::shared_ptr<ImageCodec> codec, const Rect& region, int width, int height)
+      : ImageGenerator(width, height), codec(std::move(codec)), region(region) {
+  }
+
+  bool isAlphaOnly() const override {
+    return codec->isAlphaOnly();
+  }
+
+  bool asyncSupport() const override {
+    return codec->asyncSupport();
+  }
+
+ protected:
+  std::shared_ptr<ImageBuffer> onMakeBuffer(bool tryHardware) const override {
+    auto pixelBuffer = PixelBuffer::Make(width(), height(), isAlphaOnly(), tryHardware);
+    if (pixelBuffer == nullptr) {
+      return nullptr;
+    }
+    auto pixels = pixelBuffer->lockPixels();
+    auto result = codec->readRegion(region, pixelBuffer->info(), pixels);
+    pixelBuffer->unlockPixels();
+    return result ? pixelBuffer : nullptr;
+  }
+
+ private:
+  std::shared_ptr<ImageCodec> codec = nullptr;
+  Rect region = Rect::MakeEmpty();
+};
+
+std::shared_ptr<Image> TiledImage::MakeFrom(std::shared_ptr<ImageCodec> codec, int tileSize) {
+  if (codec == nullptr) {
+    return nullptr;
+  }
+  tileSize = std::max(tileSize, MinTileSize);
+  auto image = std::shared_ptr<TiledImage>(new TiledImage(std::move(codec), tileSize));
+  image->weakThis = image;
+  return image;
+}
+
+TiledImage::TiledImage(std::shared_ptr<ImageCodec> codec, int tileSize)
+    : codec(std::move(codec)), tileSize(tileSize), uniqueKey(UniqueKey::Make()),
+      fallbackKey(UniqueKey::Make()) {
+  // The highest level fits the entire image into a single tile.
+  auto longestSide = std::max(this->codec->width(), this->codec->height());
+  while ((tileSize << maxLevel) < longestSide) {
+    maxLevel++;
+  }
+  while (fallbackLevel < maxLevel && (longestSide >> fallbackLevel) > MaxFallbackSize) {
+    fallbackLevel++;
+  }
+}
+
+int TiledImage::getLevel(float scale) const {
+  if (scale <= 0.0f || scale >= 1.0f) {
+    return 0;
+  }
+  auto level = static_cast<int>(floorf(-log2f(scale)));
+  return std::clamp(level, 0, maxLevel);
+}
+
+std::vector<TiledImage::Tile> TiledImage::getTiles(const Rect& area, int level) const {
+  std::vector<Tile> tiles = {};
+  auto bounds = area;
+  if (!bounds.intersect(Rect::MakeWH(width(), height()))) {
+    return tiles;
+  }
+  level = std::clamp(level, 0, maxLevel);
+  auto size = static_cast<float>(tileSize << level);
+  auto startColumn = static_cast<int>(floorf(bounds.left / size));
+  auto endColumn = static_cast<int>(ceilf(bounds.right / size));
+  auto startRow = static_cast<int>(floorf(bounds.top / size));
+  auto endRow = static_cast<int>(ceilf(bounds.bottom / size));
+  for (int row = startRow; row < endRow; row++) {
+    for (int column = startColumn; column < endColumn; column++) {
+      tiles.push_back(makeTile(level, column, row));
+    }
+  }
+  return tiles;
+}
+
+TiledImage::Tile TiledImage::makeTile(int level, int column, int row) const {
+  auto size = tileSize << level;
+  auto imageBounds = Rect::MakeWH(width(), height());
+  auto bounds = Rect::MakeXYWH(column * size, row * size, size, size);
+  bounds.intersect(imageBounds);
+  // Each tile also decodes one texel of its neighbors, so linear sampling at the tile edges
+  // matches the untiled image and no seams appear between the tiles.
+  auto border = static_cast<float>(1 << level);
+  auto region = bounds.makeOutset(border, border);
+  region.intersect(imageBounds);
+  auto scale = 1.0f / static_cast<float>(1 << level);
+  auto tileWidth = std::max(static_cast<int>(ceilf(region.width() * scale)), 1);
+  auto tileHeight = std::max(static_cast<int>(ceilf(region.height() * scale)), 1);
+  auto generator = std::make_shared<RegionGenerator>(codec, region, tileWidth, tileHeight);
+  uint32_t tileKey[3] = {static_cast<uint32_t>(level), static_cast<uint32_t>(column),
+                         static_cast<uint32_t>(row)};
+  Tile tile = {};
+  tile.image = GeneratorImage::MakeFrom(UniqueKey::Append(uniqueKey, tileKey, 3),
+                                        std::move(generator));
+  tile.bounds = bounds;
+  tile.matrix = Matrix::MakeTrans(-region.left, -region.top);
+  tile.matrix.postScale(static_cast<float>(tileWidth) / region.width(),
+                        static_cast<float>(tileHeight) / region.height());
+  return tile;
+}
+
+std::shared_ptr<Image> TiledImage::onMakeMipmapped(bool) const {
+  // Every level of tiles is decoded natively at its own resolution, so there is no need for
+  // mipmaps.
+  return weakThis.lock();
+}
+
+std::unique_ptr<FragmentProcessor> TiledImage::asFragmentProcessor(
+    const FPArgs& args, TileMode tileModeX, TileMode tileModeY, const SamplingOptions& sampling,
+    const Matrix* uvMatrix) const {
+  // Tiles can only be drawn separately by the RenderContext. Other uses, like image shaders and
+  // filters, sample the image as a whole, which is decoded at the level matching the drawing scale
+  // but never larger than MaxFallbackSize.
+  auto scale = 1.0f;
+  if (uvMatrix != nullptr) {
+    Matrix invertMatrix = {};
+    if (uvMatrix->invert(&invertMatrix)) {
+      scale = args.viewMatrix.getMaxScale() * invertMatrix.getMaxScale();
+    }
+  } else {
+    scale = args.viewMatrix.getMaxScale();
+  }
+  auto level = std::max(getLevel(scale), fallbackLevel);
+  auto levelScale = 1.0f / static_cast<float>(1 << level);
+  auto decodeWidth = std::max(static_cast<int>(ceilf(static_cast<float>(width()) * levelScale)), 1);
+  auto decodeHeight =
+      std::max(static_cast<int>(ceilf(static_cast<float>(height()) * levelScale)), 1);
+  auto generator = std::make_shared<RegionGenerator>(codec, Rect::MakeWH(width(), height()),
+                                                     decodeWidth, decodeHeight);
+  auto levelKey = static_cast<uint32_t>(level);
+  auto proxy = args.context->proxyProvider()->createTextureProxy(
+      UniqueKey::Append(fallbackKey, &levelKey, 1), std::move(generator), false, args.renderFlags);
+  auto matrix = Matrix::MakeScale(static_cast<float>(decodeWidth) / static_cast<float>(width()),
+                                  static_cast<float>(decodeHeight) / static_cast<float>(height()));
+  if (uvMatrix != nullptr) {
+    matrix.preConcat(*uvMatrix);
+  }
+  return TiledTextureEffect::Make(std::move(proxy), tileModeX, tileModeY, sampling, &matrix,
+                                  isAlphaOnly());
+}
+}  // namespace tgfx
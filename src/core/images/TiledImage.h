@@ -0,0 +1,106 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "gpu/ResourceKey.h"
+#include "tgfx/core/Image.h"
+#include "tgfx/core/ImageCodec.h"
+
+namespace tgfx {
+/**
+ * TiledImage splits a large encoded image into tiles that are decoded lazily, only when they
+ * become visible. Each tile is decoded from its own region of the encoded image at a power-of-two
+ * fraction of the full resolution that matches the drawing scale, and is cached as an independent
+ * GPU texture in the ResourceCache. Tiles that are no longer drawn are purged like any other
+ * resource, so the memory usage depends on the viewport instead of the size of the image.
+ */
+class TiledImage : public Image {
+ public:
+  static std::shared_ptr<Image> MakeFrom(std::shared_ptr<ImageCodec> codec, int tileSize);
+
+  /**
+   * A tile of the image at a specific level.
+   */
+  struct Tile {
+    /**
+     * The image that decodes the tile, including a one-pixel border of its neighbors.
+     */
+    std::shared_ptr<Image> image = nullptr;
+    /**
+     * The area of the full resolution image covered by the tile, excluding the border.
+     */
+    Rect bounds = Rect::MakeEmpty();
+    /**
+     * Maps the coordinates of the full resolution image to the coordinates of the tile image.
+     */
+    Matrix matrix = Matrix::I();
+  };
+
+  int width() const override {
+    return codec->width();
+  }
+
+  int height() const override {
+    return codec->height();
+  }
+
+  bool isAlphaOnly() const override {
+    return codec->isAlphaOnly();
+  }
+
+  bool isFullyDecoded() const override {
+    return false;
+  }
+
+  /**
+   * Returns the level of tiles to draw for the given drawing scale. Tiles at level N are decoded at
+   * 1 / 2^N of the full resolution.
+   */
+  int getLevel(float scale) const;
+
+  /**
+   * Returns the tiles at the given level that intersect the specified area of the image.
+   */
+  std::vector<Tile> getTiles(const Rect& area, int level) const;
+
+ protected:
+  Type type() const override {
+    return Type::Tiled;
+  }
+
+  std::shared_ptr<Image> onMakeMipmapped(bool enabled) const override;
+
+  std::unique_ptr<FragmentProcessor> asFragmentProcessor(const FPArgs& args, TileMode tileModeX,
+                                                         TileMode tileModeY,
+                                                         const SamplingOptions& sampling,
+                                                         const Matrix* uvMatrix) const override;
+
+ private:
+  std::shared_ptr<ImageCodec> codec = nullptr;
+  int tileSize = 0;
+  int maxLevel = 0;
+  int fallbackLevel = 0;
+  UniqueKey uniqueKey = {};
+  UniqueKey fallbackKey = {};
+
+  TiledImage(std::shared_ptr<ImageCodec> codec, int tileSize);
+
+  Tile makeTile(int level, int column, int row) const;
+};
+}  // namespace tgfx
@@ -32,14 +32,18 @@ std::shared_ptr<Shape> Shape::ApplyEffect(std::shared_ptr<Shape> shape,
 }
 
 Rect EffectShape::getBounds(float resolutionScale) const {
-  auto bounds = shape->getBounds(resolutionScale);
-  return effect->filterBounds(bounds);
+  return cache.getBounds(resolutionScale, [this](float scale) {
+    auto bounds = shape->getBounds(scale);
+    return effect->filterBounds(bounds);
+  });
 }
 
 Path EffectShape::getPath(float resolutionScale) const {
-  auto path = shape->getPath(resolutionScale);
-  effect->filterPath(&path);
-  return path;
+  return cache.getPath(resolutionScale, [this](float scale) {
+    auto path = shape->getPath(scale);
+    effect->filterPath(&path);
+    return path;
+  });
 }
 
 }  // namespace tgfx
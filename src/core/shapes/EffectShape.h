@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include "core/shapes/ShapeCache.h"
 #include "gpu/ResourceKey.h"
 #include "tgfx/core/Shape.h"
 
@@ -46,6 +47,7 @@ class EffectShape : public Shape {
 
  private:
   LazyUniqueKey uniqueKey = {};
+  ShapeCache cache = {};
   std::shared_ptr<Shape> shape = nullptr;
   std::shared_ptr<PathEffect> effect = nullptr;
 };
@@ -34,15 +34,18 @@ std::shared_ptr<Shape> Shape::MakeFrom(std::shared_ptr<TextBlob> textBlob) {
 }
 
 Rect GlyphShape::getBounds(float resolutionScale) const {
-  return glyphRunList->getBounds(resolutionScale);
+  return cache.getBounds(resolutionScale,
+                         [this](float scale) { return glyphRunList->getBounds(scale); });
 }
 
 Path GlyphShape::getPath(float resolutionScale) const {
-  Path path = {};
-  if (!glyphRunList->getPath(&path, resolutionScale)) {
-    LOGE("TextShape::getPath() Failed to get path from GlyphRunList!");
-    return {};
-  }
-  return path;
+  return cache.getPath(resolutionScale, [this](float scale) {
+    Path path = {};
+    if (!glyphRunList->getPath(&path, scale)) {
+      LOGE("TextShape::getPath() Failed to get path from GlyphRunList!");
+      return Path();
+    }
+    return path;
+  });
 }
 }  // namespace tgfx
@@ -19,6 +19,7 @@
 #pragma once
 
 #include "core/GlyphRunList.h"
+#include "core/shapes/ShapeCache.h"
 #include "gpu/ResourceKey.h"
 #include "tgfx/core/Shape.h"
 
@@ -47,6 +48,7 @@ class GlyphShape : public Shape {
 
  private:
   LazyUniqueKey uniqueKey = {};
+  ShapeCache cache = {};
   std::shared_ptr<GlyphRunList> glyphRunList = nullptr;
 };
 }  // namespace tgfx
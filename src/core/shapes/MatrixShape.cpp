@@ -50,10 +50,11 @@ Rect MatrixShape::getBounds(float resolutionScale) const {
 }
 
 Path MatrixShape::getPath(float resolutionScale) const {
-  resolutionScale *= matrix.getMaxScale();
-  auto path = shape->getPath(resolutionScale);
-  path.transform(matrix);
-  return path;
+  return cache.getPath(resolutionScale, [this](float scale) {
+    auto path = shape->getPath(scale * matrix.getMaxScale());
+    path.transform(matrix);
+    return path;
+  });
 }
 
 bool MatrixShape::isLine(Point line[2]) const {
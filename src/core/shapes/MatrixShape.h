@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include "core/shapes/ShapeCache.h"
 #include "gpu/ResourceKey.h"
 #include "tgfx/core/Shape.h"
 
@@ -56,5 +57,8 @@ class MatrixShape : public Shape {
   }
 
   UniqueKey getUniqueKey() const override;
+
+ private:
+  ShapeCache cache = {};
 };
 }  // namespace tgfx
@@ -91,10 +91,12 @@ Rect MergeShape::getBounds(float resolutionScale) const {
 }
 
 Path MergeShape::getPath(float resolutionScale) const {
-  auto path = first->getPath(resolutionScale);
-  auto secondPath = second->getPath(resolutionScale);
-  path.addPath(secondPath, pathOp);
-  return path;
+  return cache.getPath(resolutionScale, [this](float scale) {
+    auto path = first->getPath(scale);
+    auto secondPath = second->getPath(scale);
+    path.addPath(secondPath, pathOp);
+    return path;
+  });
 }
 
 }  // namespace tgfx
@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include "core/shapes/ShapeCache.h"
 #include "gpu/ResourceKey.h"
 #include "tgfx/core/Shape.h"
 
@@ -50,6 +51,7 @@ class MergeShape : public Shape {
 
  private:
   LazyUniqueKey uniqueKey = {};
+  ShapeCache cache = {};
   std::shared_ptr<Shape> first = nullptr;
   std::shared_ptr<Shape> second = nullptr;
   PathOp pathOp = PathOp::Append;
@@ -0,0 +1,109 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "ShapeCache.h"
+#include <algorithm>
+#include <cmath>
+
+namespace tgfx {
+static constexpr size_t MaxCacheEntries = 2;
+static constexpr float BucketsPerOctave = 4.0f;
+
+/**
+ * Rounds the resolution scale up to the nearest quarter-octave bucket. Returns 0 if the scale
+ * can't be cached.
+ */
+static float QuantizeScale(float resolutionScale) {
+  if (!(resolutionScale > 0.0f) || std::isinf(resolutionScale)) {
+    return 0.0f;
+  }
+  auto bucket = std::ceil(std::log2(resolutionScale) * BucketsPerOctave);
+  return std::exp2(bucket / BucketsPerOctave);
+}
+
+Path ShapeCache::getPath(float resolutionScale, const std::function<Path(float)>& compute) const {
+  auto scale = QuantizeScale(resolutionScale);
+  if (scale == 0.0f) {
+    return compute(resolutionScale);
+  }
+  {
+    std::lock_guard<std::mutex> autoLock(locker);
+    auto entry = findEntry(scale);
+    if (entry != nullptr && entry->hasPath) {
+      return entry->path;
+    }
+  }
+  // Computes outside the lock, so that a slow path doesn't block the readers of other scales.
+  auto path = compute(scale);
+  std::lock_guard<std::mutex> autoLock(locker);
+  auto entry = findEntry(scale);
+  if (entry == nullptr) {
+    entry = addEntry(scale);
+  }
+  entry->path = path;
+  entry->hasPath = true;
+  return path;
+}
+
+Rect ShapeCache::getBounds(float resolutionScale,
+                           const std::function<Rect(float)>& compute) const {
+  auto scale = QuantizeScale(resolutionScale);
+  if (scale == 0.0f) {
+    return compute(resolutionScale);
+  }
+  {
+    std::lock_guard<std::mutex> autoLock(locker);
+    auto entry = findEntry(scale);
+    if (entry != nullptr && entry->hasBounds) {
+      return entry->bounds;
+    }
+  }
+  auto bounds = compute(scale);
+  std::lock_guard<std::mutex> autoLock(locker);
+  auto entry = findEntry(scale);
+  if (entry == nullptr) {
+    entry = addEntry(scale);
+  }
+  entry->bounds = bounds;
+  entry->hasBounds = true;
+  return bounds;
+}
+
+ShapeCache::Entry* ShapeCache::findEntry(float scale) const {
+  for (size_t i = 0; i < entries.size(); i++) {
+    if (entries[i].scale == scale) {
+      // Moves the entry to the back, which holds the most recently used one.
+      if (i + 1 < entries.size()) {
+        std::rotate(entries.begin() + static_cast<long>(i),
+                    entries.begin() + static_cast<long>(i) + 1, entries.end());
+      }
+      return &entries.back();
+    }
+  }
+  return nullptr;
+}
+
+ShapeCache::Entry* ShapeCache::addEntry(float scale) const {
+  if (entries.size() >= MaxCacheEntries) {
+    entries.erase(entries.begin());
+  }
+  entries.push_back({});
+  entries.back().scale = scale;
+  return &entries.back();
+}
+}  // namespace tgfx
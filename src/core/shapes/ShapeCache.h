@@ -0,0 +1,64 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <functional>
+#include <mutex>
+#include <vector>
+#include "tgfx/core/Path.h"
+
+namespace tgfx {
+/**
+ * ShapeCache memoizes the paths and bounds a Shape computes for different resolution scales, so
+ * that the async rasterization tasks and the render thread don't recompute the same geometry.
+ * Resolution scales are rounded up to quarter-octave buckets, and the cached results are computed
+ * with the rounded scale, which is always at least as precise as the requested one. Only a few of
+ * the most recently used buckets are kept. ShapeCache is thread-safe.
+ */
+class ShapeCache {
+ public:
+  /**
+   * Returns the path for the given resolution scale, calling the compute block with the rounded
+   * scale if it is not cached yet.
+   */
+  Path getPath(float resolutionScale, const std::function<Path(float)>& compute) const;
+
+  /**
+   * Returns the bounds for the given resolution scale, calling the compute block with the rounded
+   * scale if it is not cached yet.
+   */
+  Rect getBounds(float resolutionScale, const std::function<Rect(float)>& compute) const;
+
+ private:
+  struct Entry {
+    float scale = 1.0f;
+    bool hasPath = false;
+    bool hasBounds = false;
+    Path path = {};
+    Rect bounds = {};
+  };
+
+  mutable std::mutex locker = {};
+  mutable std::vector<Entry> entries = {};
+
+  Entry* findEntry(float scale) const;
+
+  Entry* addEntry(float scale) const;
+};
+}  // namespace tgfx
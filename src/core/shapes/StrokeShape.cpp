@@ -54,9 +54,11 @@ Rect StrokeShape::getBounds(float resolutionScale) const {
 }
 
 Path StrokeShape::getPath(float resolutionScale) const {
-  auto path = shape->getPath(resolutionScale);
-  stroke.applyToPath(&path, resolutionScale);
-  return path;
+  return cache.getPath(resolutionScale, [this](float scale) {
+    auto path = shape->getPath(scale);
+    stroke.applyToPath(&path, scale);
+    return path;
+  });
 }
 
 bool StrokeShape::isRect(Rect* rect) const {
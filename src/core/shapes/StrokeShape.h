@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include "core/shapes/ShapeCache.h"
 #include "gpu/ResourceKey.h"
 #include "tgfx/core/Shape.h"
 #include "tgfx/core/Stroke.h"
@@ -51,5 +52,8 @@ class StrokeShape : public Shape {
   }
 
   UniqueKey getUniqueKey() const override;
+
+ private:
+  ShapeCache cache = {};
 };
 }  // namespace tgfx
@@ -97,6 +97,13 @@ const SubsetImage* Caster::AsSubsetImage(const Image* image) {
   return nullptr;
 }
 
+const TiledImage* Caster::AsTiledImage(const Image* image) {
+  if (image->type() == Image::Type::Tiled) {
+    return static_cast<const TiledImage*>(image);
+  }
+  return nullptr;
+}
+
 const ShaderMaskFilter* Caster::AsShaderMaskFilter(const MaskFilter* maskFilter) {
   if (maskFilter->type() == MaskFilter::Type::Shader) {
     return static_cast<const ShaderMaskFilter*>(maskFilter);
@@ -27,6 +27,7 @@
 #include "core/images/GeneratorImage.h"
 #include "core/images/PictureImage.h"
 #include "core/images/SubsetImage.h"
+#include "core/images/TiledImage.h"
 #include "core/shaders/ColorShader.h"
 #include "core/shaders/GradientShader.h"
 #include "core/shaders/ImageShader.h"
@@ -63,6 +64,8 @@ class Caster {
 
   static const SubsetImage* AsSubsetImage(const Image* image);
 
+  static const TiledImage* AsTiledImage(const Image* image);
+
   static const ShaderMaskFilter* AsShaderMaskFilter(const MaskFilter* maskFilter);
 };
 
@@ -53,6 +53,14 @@ class DataTask {
     return holder->data;
   }
 
+  /**
+   * Returns true if the generator function has finished executing, in which case wait() returns
+   * immediately.
+   */
+  bool finished() const {
+    return task->finished();
+  }
+
  private:
   std::shared_ptr<Holder> holder = std::make_shared<Holder>();
   std::shared_ptr<Task> task = nullptr;
@@ -0,0 +1,83 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "core/utils/MappedFile.h"
+#if !defined(_WIN32) && !defined(__EMSCRIPTEN__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace tgfx {
+#if !defined(_WIN32) && !defined(__EMSCRIPTEN__)
+/**
+ * Mapping a file costs a few system calls and page faults, which is slower than a single read()
+ * for small files.
+ */
+static constexpr size_t MinMappedFileSize = 16 * 1024;
+
+static int GetAdvice(FileAccess access) {
+  switch (access) {
+    case FileAccess::Sequential:
+      return MADV_SEQUENTIAL;
+    case FileAccess::Random:
+      return MADV_RANDOM;
+    default:
+      return MADV_NORMAL;
+  }
+}
+
+static void UnmapProc(const void* data, void* context) {
+  munmap(const_cast<void*>(data), reinterpret_cast<size_t>(context));
+}
+
+std::shared_ptr<Data> MapFile(const std::string& filePath, FileAccess access) {
+  if (filePath.empty() || filePath.find("://") != std::string::npos) {
+    return nullptr;
+  }
+  auto fd = open(filePath.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    return nullptr;
+  }
+  struct stat fileStat = {};
+  if (fstat(fd, &fileStat) != 0 || !S_ISREG(fileStat.st_mode) ||
+      static_cast<size_t>(fileStat.st_size) < MinMappedFileSize) {
+    close(fd);
+    return nullptr;
+  }
+  auto length = static_cast<size_t>(fileStat.st_size);
+  auto address = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+  // The mapping keeps its own reference to the file, so the descriptor is no longer needed.
+  close(fd);
+  if (address == MAP_FAILED) {
+    return nullptr;
+  }
+  madvise(address, length, GetAdvice(access));
+  if (access == FileAccess::Sequential) {
+    // The whole file is about to be read, so start paging it in right away.
+    madvise(address, length, MADV_WILLNEED);
+  }
+  return Data::MakeAdopted(address, length, UnmapProc, reinterpret_cast<void*>(length));
+}
+#else
+std::shared_ptr<Data> MapFile(const std::string&, FileAccess) {
+  return nullptr;
+}
+#endif
+}  // namespace tgfx
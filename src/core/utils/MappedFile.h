@@ -0,0 +1,54 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <string>
+#include "tgfx/core/Data.h"
+
+namespace tgfx {
+/**
+ * Describes how the bytes of a mapped file are going to be accessed, which is passed to the kernel
+ * as a hint for read-ahead.
+ */
+enum class FileAccess {
+  /**
+   * No particular access pattern.
+   */
+  Normal,
+  /**
+   * The file is read from start to end, such as when decoding an image. The kernel reads ahead
+   * aggressively and may drop pages soon after they are accessed.
+   */
+  Sequential,
+  /**
+   * The file is accessed in random order, such as the glyph tables of a font. Read-ahead is
+   * disabled.
+   */
+  Random
+};
+
+/**
+ * Maps the file at the specified path into memory and returns a Data object backed by the mapping,
+ * which is unmapped when the Data is released. The pages are loaded lazily and shared with the page
+ * cache, so no copy of the file is made. Returns nullptr if memory mapping is not supported on the
+ * current platform, the path uses a custom protocol, the file is too small to benefit from mapping,
+ * or the mapping fails. Callers should fall back to reading the file through a Stream in that case.
+ */
+std::shared_ptr<Data> MapFile(const std::string& filePath, FileAccess access);
+}  // namespace tgfx
@@ -0,0 +1,77 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "core/utils/ParallelRows.h"
+#include <algorithm>
+#include <atomic>
+#include <vector>
+#include "core/utils/TaskGroup.h"
+
+namespace tgfx {
+// Images below this size decode in a few milliseconds, where the cost of scheduling the bands on
+// other threads outweighs the gain.
+static constexpr int MinParallelPixels = 1024 * 1024;
+static constexpr int MinBandPixels = 256 * 1024;
+static constexpr int MinBandRows = 16;
+static constexpr int MaxBandCount = 16;
+
+int GetParallelBandCount(int width, int height) {
+  if (width <= 0 || height <= 0) {
+    return 1;
+  }
+  auto pixels = static_cast<int64_t>(width) * height;
+  if (pixels < MinParallelPixels) {
+    return 1;
+  }
+  static const int CPUCores = GetCPUCores();
+  auto bandCount = std::min(static_cast<int64_t>(std::min(CPUCores, MaxBandCount)),
+                            pixels / MinBandPixels);
+  bandCount = std::min(bandCount, static_cast<int64_t>(height / MinBandRows));
+  return std::max(static_cast<int>(bandCount), 1);
+}
+
+bool ParallelForRows(int height, int bandCount,
+                     const std::function<bool(int top, int bottom)>& block) {
+  if (height <= 0) {
+    return false;
+  }
+  bandCount = std::clamp(bandCount, 1, height);
+  if (bandCount == 1) {
+    return block(0, height);
+  }
+  auto bandHeight = (height + bandCount - 1) / bandCount;
+  std::atomic_bool success = {true};
+  std::vector<std::shared_ptr<Task>> tasks = {};
+  for (int top = bandHeight; top < height; top += bandHeight) {
+    auto bottom = std::min(top + bandHeight, height);
+    tasks.push_back(Task::Run([&block, &success, top, bottom]() {
+      if (!block(top, bottom)) {
+        success = false;
+      }
+    }));
+  }
+  if (!block(0, std::min(bandHeight, height))) {
+    success = false;
+  }
+  // A band that has not been picked up by a worker yet runs on the calling thread.
+  for (auto& task : tasks) {
+    task->wait();
+  }
+  return success;
+}
+}  // namespace tgfx
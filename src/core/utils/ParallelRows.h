@@ -0,0 +1,37 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <functional>
+
+namespace tgfx {
+/**
+ * Returns the number of row bands an image with the given dimensions should be split into when its
+ * pixels are processed on the task pool. Returns 1 if the image is too small to benefit from it.
+ */
+int GetParallelBandCount(int width, int height);
+
+/**
+ * Splits the rows [0, height) into bandCount contiguous bands and calls the block for each band
+ * concurrently. The first band runs on the calling thread, and the others run on the task pool.
+ * Returns after all bands have finished, and returns true if the block succeeded for every band.
+ */
+bool ParallelForRows(int height, int bandCount,
+                     const std::function<bool(int top, int bottom)>& block);
+}  // namespace tgfx
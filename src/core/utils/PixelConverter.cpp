@@ -0,0 +1,473 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "core/utils/PixelConverter.h"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include "skcms.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TGFX_PIXEL_SSE2
+#include <emmintrin.h>
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define TGFX_PIXEL_AVX2
+#include <immintrin.h>
+#define AVX2_TARGET __attribute__((target("avx2")))
+#endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define TGFX_PIXEL_NEON
+#include <arm_neon.h>
+#endif
+
+namespace tgfx {
+inline void* AddOffset(void* pixels, size_t offset) {
+  return reinterpret_cast<uint8_t*>(pixels) + offset;
+}
+
+inline const void* AddOffset(const void* pixels, size_t offset) {
+  return reinterpret_cast<const uint8_t*>(pixels) + offset;
+}
+
+static void CopyRectMemory(const void* src, size_t srcRB, void* dst, size_t dstRB,
+                           size_t trimRowBytes, size_t rowCount) {
+  if (trimRowBytes == dstRB && trimRowBytes == srcRB) {
+    memcpy(dst, src, trimRowBytes * rowCount);
+    return;
+  }
+  for (size_t i = 0; i < rowCount; i++) {
+    memcpy(dst, src, trimRowBytes);
+    dst = AddOffset(dst, dstRB);
+    src = AddOffset(src, srcRB);
+  }
+}
+
+static gfx::skcms_PixelFormat ToPixelFormat(ColorType colorType) {
+  switch (colorType) {
+    case ColorType::ALPHA_8:
+      return gfx::skcms_PixelFormat::skcms_PixelFormat_A_8;
+    case ColorType::BGRA_8888:
+      return gfx::skcms_PixelFormat::skcms_PixelFormat_BGRA_8888;
+    case ColorType::RGB_565:
+      return gfx::skcms_PixelFormat::skcms_PixelFormat_BGR_565;
+    case ColorType::Gray_8:
+      return gfx::skcms_PixelFormat::skcms_PixelFormat_G_8;
+    case ColorType::RGBA_F16:
+      return gfx::skcms_PixelFormat::skcms_PixelFormat_RGBA_hhhh;
+    case ColorType::RGBA_1010102:
+      return gfx::skcms_PixelFormat::skcms_PixelFormat_RGBA_1010102;
+    default:
+      return gfx::skcms_PixelFormat::skcms_PixelFormat_RGBA_8888;
+  }
+}
+
+static gfx::skcms_AlphaFormat ToAlphaFormat(AlphaType alphaType) {
+  switch (alphaType) {
+    case AlphaType::Premultiplied:
+      return gfx::skcms_AlphaFormat::skcms_AlphaFormat_PremulAsEncoded;
+    case AlphaType::Opaque:
+      return gfx::skcms_AlphaFormat::skcms_AlphaFormat_Opaque;
+    default:
+      return gfx::skcms_AlphaFormat::skcms_AlphaFormat_Unpremul;
+  }
+}
+
+void TransformPixels(const ImageInfo& srcInfo, const void* srcPixels, const ImageInfo& dstInfo,
+                     void* dstPixels) {
+  auto srcFormat = ToPixelFormat(srcInfo.colorType());
+  auto srcAlpha = ToAlphaFormat(srcInfo.alphaType());
+  auto dstFormat = ToPixelFormat(dstInfo.colorType());
+  auto dstAlpha = ToAlphaFormat(dstInfo.alphaType());
+  auto width = dstInfo.width();
+  auto height = dstInfo.height();
+  for (int i = 0; i < height; i++) {
+    gfx::skcms_Transform(srcPixels, srcFormat, srcAlpha, nullptr, dstPixels, dstFormat, dstAlpha,
+                         nullptr, static_cast<size_t>(width));
+    dstPixels = AddOffset(dstPixels, dstInfo.rowBytes());
+    srcPixels = AddOffset(srcPixels, srcInfo.rowBytes());
+  }
+}
+
+/**
+ * The alpha operation applied when converting between two 8888 formats. The kernels produce the
+ * same results as the skcms pipeline: premultiplication rounds to nearest, and unpremultiplication
+ * runs the same sequence of float operations.
+ */
+enum class AlphaOp { None, ForceOpaque, Premultiply, Unpremultiply };
+
+using RowProc = void (*)(const uint8_t* src, uint8_t* dst, int count);
+
+static inline uint8_t MulDiv255(uint32_t color, uint32_t alpha) {
+  auto value = color * alpha + 128;
+  return static_cast<uint8_t>((value + (value >> 8)) >> 8);
+}
+
+static inline float UnpremultiplyScale(uint8_t alpha) {
+  auto scale = 1.0f / (static_cast<float>(alpha) * (1 / 255.0f));
+  return scale < std::numeric_limits<float>::infinity() ? scale : 0.0f;
+}
+
+static inline uint8_t Unpremultiply(uint8_t color, float scale) {
+  auto value = static_cast<float>(color) * (1 / 255.0f) * scale;
+  value = std::min(std::max(value, 0.0f), 1.0f);
+  return static_cast<uint8_t>(value * 255.0f + 0.5f);
+}
+
+#ifdef TGFX_PIXEL_SSE2
+static inline __m128i SwapRB_SSE2(__m128i pixels) {
+  auto rbMask = _mm_set1_epi32(0x00FF00FF);
+  auto rb = _mm_and_si128(pixels, rbMask);
+  auto ga = _mm_andnot_si128(rbMask, pixels);
+  return _mm_or_si128(ga, _mm_or_si128(_mm_slli_epi32(rb, 16), _mm_srli_epi32(rb, 16)));
+}
+
+static inline __m128i MulDiv255_SSE2(__m128i colors, __m128i alphas) {
+  auto value = _mm_add_epi16(_mm_mullo_epi16(colors, alphas), _mm_set1_epi16(128));
+  return _mm_srli_epi16(_mm_add_epi16(value, _mm_srli_epi16(value, 8)), 8);
+}
+
+static inline __m128i PremultiplyHalf_SSE2(__m128i colors) {
+  // Broadcasts the alpha of each pixel to its color lanes, and multiplies the alpha lane by 255.
+  auto alphas = _mm_shufflehi_epi16(_mm_shufflelo_epi16(colors, 0xFF), 0xFF);
+  auto colorMask = _mm_set_epi16(0, -1, -1, -1, 0, -1, -1, -1);
+  alphas = _mm_or_si128(_mm_and_si128(alphas, colorMask),
+                        _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0));
+  return MulDiv255_SSE2(colors, alphas);
+}
+
+static inline __m128i Premultiply_SSE2(__m128i pixels) {
+  auto zero = _mm_setzero_si128();
+  auto lo = PremultiplyHalf_SSE2(_mm_unpacklo_epi8(pixels, zero));
+  auto hi = PremultiplyHalf_SSE2(_mm_unpackhi_epi8(pixels, zero));
+  return _mm_packus_epi16(lo, hi);
+}
+
+static inline __m128i UnpremultiplyPixel_SSE2(__m128i pixel) {
+  auto color = _mm_mul_ps(_mm_cvtepi32_ps(pixel), _mm_set1_ps(1 / 255.0f));
+  auto alpha = _mm_shuffle_ps(color, color, 0xFF);
+  auto scale = _mm_div_ps(_mm_set1_ps(1.0f), alpha);
+  auto infinity = _mm_set1_ps(std::numeric_limits<float>::infinity());
+  scale = _mm_and_ps(scale, _mm_cmplt_ps(scale, infinity));
+  // Keeps the alpha lane unchanged.
+  auto alphaLane = _mm_castsi128_ps(_mm_set_epi32(-1, 0, 0, 0));
+  scale = _mm_or_ps(_mm_andnot_ps(alphaLane, scale), _mm_and_ps(alphaLane, _mm_set1_ps(1.0f)));
+  color = _mm_mul_ps(color, scale);
+  color = _mm_min_ps(_mm_max_ps(color, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+  color = _mm_add_ps(_mm_mul_ps(color, _mm_set1_ps(255.0f)), _mm_set1_ps(0.5f));
+  return _mm_cvttps_epi32(color);
+}
+
+static inline __m128i Unpremultiply_SSE2(__m128i pixels) {
+  auto zero = _mm_setzero_si128();
+  auto lo = _mm_unpacklo_epi8(pixels, zero);
+  auto hi = _mm_unpackhi_epi8(pixels, zero);
+  auto p0 = UnpremultiplyPixel_SSE2(_mm_unpacklo_epi16(lo, zero));
+  auto p1 = UnpremultiplyPixel_SSE2(_mm_unpackhi_epi16(lo, zero));
+  auto p2 = UnpremultiplyPixel_SSE2(_mm_unpacklo_epi16(hi, zero));
+  auto p3 = UnpremultiplyPixel_SSE2(_mm_unpackhi_epi16(hi, zero));
+  return _mm_packus_epi16(_mm_packs_epi32(p0, p1), _mm_packs_epi32(p2, p3));
+}
+
+template <bool SwapRB, AlphaOp Op>
+static int Convert8888_SSE2(const uint8_t* src, uint8_t* dst, int count) {
+  int i = 0;
+  for (; i + 4 <= count; i += 4) {
+    auto pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4));
+    if (SwapRB) {
+      pixels = SwapRB_SSE2(pixels);
+    }
+    if (Op == AlphaOp::ForceOpaque) {
+      pixels = _mm_or_si128(pixels, _mm_set1_epi32(static_cast<int>(0xFF000000)));
+    } else if (Op == AlphaOp::Premultiply) {
+      pixels = Premultiply_SSE2(pixels);
+    } else if (Op == AlphaOp::Unpremultiply) {
+      pixels = Unpremultiply_SSE2(pixels);
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), pixels);
+  }
+  return i;
+}
+
+static int ExtractAlpha_SSE2(const uint8_t* src, uint8_t* dst, int count) {
+  int i = 0;
+  for (; i + 16 <= count; i += 16) {
+    auto pixels = reinterpret_cast<const __m128i*>(src + i * 4);
+    auto a0 = _mm_srli_epi32(_mm_loadu_si128(pixels), 24);
+    auto a1 = _mm_srli_epi32(_mm_loadu_si128(pixels + 1), 24);
+    auto a2 = _mm_srli_epi32(_mm_loadu_si128(pixels + 2), 24);
+    auto a3 = _mm_srli_epi32(_mm_loadu_si128(pixels + 3), 24);
+    auto alphas = _mm_packus_epi16(_mm_packs_epi32(a0, a1), _mm_packs_epi32(a2, a3));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), alphas);
+  }
+  return i;
+}
+
+static int ExpandAlpha_SSE2(const uint8_t* src, uint8_t* dst, int count) {
+  auto zero = _mm_setzero_si128();
+  int i = 0;
+  for (; i + 16 <= count; i += 16) {
+    auto alphas = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    auto lo = _mm_unpacklo_epi8(zero, alphas);
+    auto hi = _mm_unpackhi_epi8(zero, alphas);
+    auto pixels = reinterpret_cast<__m128i*>(dst + i * 4);
+    _mm_storeu_si128(pixels, _mm_unpacklo_epi16(zero, lo));
+    _mm_storeu_si128(pixels + 1, _mm_unpackhi_epi16(zero, lo));
+    _mm_storeu_si128(pixels + 2, _mm_unpacklo_epi16(zero, hi));
+    _mm_storeu_si128(pixels + 3, _mm_unpackhi_epi16(zero, hi));
+  }
+  return i;
+}
+#endif
+
+#ifdef TGFX_PIXEL_AVX2
+AVX2_TARGET static inline __m256i MulDiv255_AVX2(__m256i colors, __m256i alphas) {
+  auto value = _mm256_add_epi16(_mm256_mullo_epi16(colors, alphas), _mm256_set1_epi16(128));
+  return _mm256_srli_epi16(_mm256_add_epi16(value, _mm256_srli_epi16(value, 8)), 8);
+}
+
+AVX2_TARGET static inline __m256i PremultiplyHalf_AVX2(__m256i colors) {
+  auto alphas = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(colors, 0xFF), 0xFF);
+  auto colorMask = _mm256_set_epi16(0, -1, -1, -1, 0, -1, -1, -1, 0, -1, -1, -1, 0, -1, -1, -1);
+  auto alphaLane = _mm256_set_epi16(255, 0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0);
+  alphas = _mm256_or_si256(_mm256_and_si256(alphas, colorMask), alphaLane);
+  return MulDiv255_AVX2(colors, alphas);
+}
+
+template <bool SwapRB, AlphaOp Op>
+AVX2_TARGET static int Convert8888_AVX2(const uint8_t* src, uint8_t* dst, int count) {
+  auto swapMask = _mm256_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15, 2, 1, 0,
+                                   3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+  auto zero = _mm256_setzero_si256();
+  int i = 0;
+  for (; i + 8 <= count; i += 8) {
+    auto pixels = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * 4));
+    if (SwapRB) {
+      pixels = _mm256_shuffle_epi8(pixels, swapMask);
+    }
+    if (Op == AlphaOp::ForceOpaque) {
+      pixels = _mm256_or_si256(pixels, _mm256_set1_epi32(static_cast<int>(0xFF000000)));
+    } else if (Op == AlphaOp::Premultiply) {
+      // The unpack and pack instructions both work within 128-bit lanes, so the order of the
+      // pixels is preserved.
+      auto lo = PremultiplyHalf_AVX2(_mm256_unpacklo_epi8(pixels, zero));
+      auto hi = PremultiplyHalf_AVX2(_mm256_unpackhi_epi8(pixels, zero));
+      pixels = _mm256_packus_epi16(lo, hi);
+    }
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 4), pixels);
+  }
+  return i;
+}
+
+static bool HasAVX2() {
+  static const bool hasAVX2 = __builtin_cpu_supports("avx2");
+  return hasAVX2;
+}
+#endif
+
+#ifdef TGFX_PIXEL_NEON
+static inline uint8x16_t MulDiv255_NEON(uint8x16_t colors, uint8x16_t alphas) {
+  auto lo = vmull_u8(vget_low_u8(colors), vget_low_u8(alphas));
+  auto hi = vmull_u8(vget_high_u8(colors), vget_high_u8(alphas));
+  return vcombine_u8(vrshrn_n_u16(vrsraq_n_u16(lo, lo, 8), 8),
+                     vrshrn_n_u16(vrsraq_n_u16(hi, hi, 8), 8));
+}
+
+template <bool SwapRB, AlphaOp Op>
+static int Convert8888_NEON(const uint8_t* src, uint8_t* dst, int count) {
+  if (Op == AlphaOp::Unpremultiply) {
+    return 0;
+  }
+  int i = 0;
+  for (; i + 16 <= count; i += 16) {
+    auto pixels = vld4q_u8(src + i * 4);
+    if (SwapRB) {
+      std::swap(pixels.val[0], pixels.val[2]);
+    }
+    if (Op == AlphaOp::ForceOpaque) {
+      pixels.val[3] = vdupq_n_u8(255);
+    } else if (Op == AlphaOp::Premultiply) {
+      pixels.val[0] = MulDiv255_NEON(pixels.val[0], pixels.val[3]);
+      pixels.val[1] = MulDiv255_NEON(pixels.val[1], pixels.val[3]);
+      pixels.val[2] = MulDiv255_NEON(pixels.val[2], pixels.val[3]);
+    }
+    vst4q_u8(dst + i * 4, pixels);
+  }
+  return i;
+}
+
+static int ExtractAlpha_NEON(const uint8_t* src, uint8_t* dst, int count) {
+  int i = 0;
+  for (; i + 16 <= count; i += 16) {
+    vst1q_u8(dst + i, vld4q_u8(src + i * 4).val[3]);
+  }
+  return i;
+}
+
+static int ExpandAlpha_NEON(const uint8_t* src, uint8_t* dst, int count) {
+  uint8x16x4_t pixels = {};
+  pixels.val[0] = pixels.val[1] = pixels.val[2] = vdupq_n_u8(0);
+  int i = 0;
+  for (; i + 16 <= count; i += 16) {
+    pixels.val[3] = vld1q_u8(src + i);
+    vst4q_u8(dst + i * 4, pixels);
+  }
+  return i;
+}
+#endif
+
+template <bool SwapRB, AlphaOp Op>
+static void Convert8888Row(const uint8_t* src, uint8_t* dst, int count) {
+  int done = 0;
+#ifdef TGFX_PIXEL_AVX2
+  if (Op != AlphaOp::Unpremultiply && HasAVX2()) {
+    done = Convert8888_AVX2<SwapRB, Op>(src, dst, count);
+  }
+#endif
+#ifdef TGFX_PIXEL_SSE2
+  done += Convert8888_SSE2<SwapRB, Op>(src + done * 4, dst + done * 4, count - done);
+#endif
+#ifdef TGFX_PIXEL_NEON
+  done = Convert8888_NEON<SwapRB, Op>(src, dst, count);
+#endif
+  for (int i = done; i < count; i++) {
+    auto pixel = src + i * 4;
+    uint8_t r = SwapRB ? pixel[2] : pixel[0];
+    uint8_t g = pixel[1];
+    uint8_t b = SwapRB ? pixel[0] : pixel[2];
+    uint8_t a = pixel[3];
+    if (Op == AlphaOp::ForceOpaque) {
+      a = 255;
+    } else if (Op == AlphaOp::Premultiply) {
+      r = MulDiv255(r, a);
+      g = MulDiv255(g, a);
+      b = MulDiv255(b, a);
+    } else if (Op == AlphaOp::Unpremultiply) {
+      auto scale = UnpremultiplyScale(a);
+      r = Unpremultiply(r, scale);
+      g = Unpremultiply(g, scale);
+      b = Unpremultiply(b, scale);
+    }
+    auto result = dst + i * 4;
+    result[0] = r;
+    result[1] = g;
+    result[2] = b;
+    result[3] = a;
+  }
+}
+
+static void ExtractAlphaRow(const uint8_t* src, uint8_t* dst, int count) {
+  int done = 0;
+#ifdef TGFX_PIXEL_SSE2
+  done = ExtractAlpha_SSE2(src, dst, count);
+#endif
+#ifdef TGFX_PIXEL_NEON
+  done = ExtractAlpha_NEON(src, dst, count);
+#endif
+  for (int i = done; i < count; i++) {
+    dst[i] = src[i * 4 + 3];
+  }
+}
+
+static void ExpandAlphaRow(const uint8_t* src, uint8_t* dst, int count) {
+  int done = 0;
+#ifdef TGFX_PIXEL_SSE2
+  done = ExpandAlpha_SSE2(src, dst, count);
+#endif
+#ifdef TGFX_PIXEL_NEON
+  done = ExpandAlpha_NEON(src, dst, count);
+#endif
+  memset(dst + done * 4, 0, static_cast<size_t>(count - done) * 4);
+  for (int i = done; i < count; i++) {
+    dst[i * 4 + 3] = src[i];
+  }
+}
+
+static void OpaqueAlphaRow(const uint8_t*, uint8_t* dst, int count) {
+  static constexpr uint8_t OpaqueBlack[4] = {0, 0, 0, 255};
+  for (int i = 0; i < count; i++) {
+    memcpy(dst + i * 4, OpaqueBlack, 4);
+  }
+}
+
+template <bool SwapRB>
+static RowProc Get8888RowProc(AlphaOp op) {
+  switch (op) {
+    case AlphaOp::ForceOpaque:
+      return Convert8888Row<SwapRB, AlphaOp::ForceOpaque>;
+    case AlphaOp::Premultiply:
+      return Convert8888Row<SwapRB, AlphaOp::Premultiply>;
+    case AlphaOp::Unpremultiply:
+      return Convert8888Row<SwapRB, AlphaOp::Unpremultiply>;
+    default:
+      return Convert8888Row<SwapRB, AlphaOp::None>;
+  }
+}
+
+static bool Is8888(ColorType colorType) {
+  return colorType == ColorType::RGBA_8888 || colorType == ColorType::BGRA_8888;
+}
+
+static RowProc GetRowProc(const ImageInfo& srcInfo, const ImageInfo& dstInfo) {
+  auto srcAlpha = srcInfo.alphaType();
+  auto dstAlpha = dstInfo.alphaType();
+  if (Is8888(srcInfo.colorType()) && Is8888(dstInfo.colorType())) {
+    auto op = AlphaOp::None;
+    if (srcAlpha == AlphaType::Opaque || dstAlpha == AlphaType::Opaque) {
+      if (srcAlpha == AlphaType::Premultiplied) {
+        // Unpremultiplying before dropping the alpha is rare enough to leave it to skcms.
+        return nullptr;
+      }
+      op = AlphaOp::ForceOpaque;
+    } else if (srcAlpha != dstAlpha) {
+      op = dstAlpha == AlphaType::Premultiplied ? AlphaOp::Premultiply : AlphaOp::Unpremultiply;
+    }
+    if (srcInfo.colorType() != dstInfo.colorType()) {
+      return Get8888RowProc<true>(op);
+    }
+    return Get8888RowProc<false>(op);
+  }
+  if (Is8888(srcInfo.colorType()) && dstInfo.colorType() == ColorType::ALPHA_8) {
+    return srcAlpha == AlphaType::Opaque ? nullptr : ExtractAlphaRow;
+  }
+  if (srcInfo.colorType() == ColorType::ALPHA_8 && Is8888(dstInfo.colorType())) {
+    return dstAlpha == AlphaType::Opaque ? OpaqueAlphaRow : ExpandAlphaRow;
+  }
+  return nullptr;
+}
+
+void ConvertPixels(const ImageInfo& srcInfo, const void* srcPixels, const ImageInfo& dstInfo,
+                   void* dstPixels) {
+  if (srcInfo.colorType() == dstInfo.colorType() && srcInfo.alphaType() == dstInfo.alphaType()) {
+    CopyRectMemory(srcPixels, srcInfo.rowBytes(), dstPixels, dstInfo.rowBytes(),
+                   dstInfo.minRowBytes(), static_cast<size_t>(dstInfo.height()));
+    return;
+  }
+  auto rowProc = GetRowProc(srcInfo, dstInfo);
+  if (rowProc == nullptr) {
+    TransformPixels(srcInfo, srcPixels, dstInfo, dstPixels);
+    return;
+  }
+  auto width = dstInfo.width();
+  auto height = dstInfo.height();
+  for (int i = 0; i < height; i++) {
+    rowProc(static_cast<const uint8_t*>(srcPixels), static_cast<uint8_t*>(dstPixels), width);
+    dstPixels = AddOffset(dstPixels, dstInfo.rowBytes());
+    srcPixels = AddOffset(srcPixels, srcInfo.rowBytes());
+  }
+}
+}  // namespace tgfx
@@ -0,0 +1,39 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "tgfx/core/ImageInfo.h"
+
+namespace tgfx {
+/**
+ * Converts the pixels from the source format to the destination format. Both ImageInfos must have
+ * the same dimensions. Copies between 8888 formats with swizzling, premultiplication,
+ * unpremultiplication, and alpha extraction use dedicated SIMD kernels (SSE2/AVX2 on x86, NEON on
+ * ARM), while other conversions fall back to TransformPixels().
+ */
+void ConvertPixels(const ImageInfo& srcInfo, const void* srcPixels, const ImageInfo& dstInfo,
+                   void* dstPixels);
+
+/**
+ * Converts the pixels from the source format to the destination format using the generic skcms
+ * pipeline, which supports all color types and alpha types.
+ */
+void TransformPixels(const ImageInfo& srcInfo, const void* srcPixels, const ImageInfo& dstInfo,
+                     void* dstPixels);
+}  // namespace tgfx
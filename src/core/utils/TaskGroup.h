@@ -26,6 +26,11 @@
 #include "tgfx/core/Task.h"
 
 namespace tgfx {
+/**
+ * Returns the number of CPU cores available to the task pool.
+ */
+int GetCPUCores();
+
 class TaskGroup {
  private:
   std::mutex locker = {};
@@ -110,7 +110,7 @@ FontMetrics CGScalerContext::getFontMetrics() const {
   return metrics;
 }
 
-Rect CGScalerContext::getBounds(GlyphID glyphID, bool fauxBold, bool fauxItalic) const {
+Rect CGScalerContext::onGetBounds(GlyphID glyphID, bool fauxBold, bool fauxItalic) const {
   const auto cgGlyph = static_cast<CGGlyph>(glyphID);
   // Glyphs are always drawn from the horizontal origin. The caller must manually use the result
   // of CTFontGetVerticalTranslationsForGlyphs to calculate where to draw the glyph for vertical
@@ -140,7 +140,7 @@ Rect CGScalerContext::getBounds(GlyphID glyphID, bool fauxBold, bool fauxItalic)
   return bounds;
 }
 
-float CGScalerContext::getAdvance(GlyphID glyphID, bool verticalText) const {
+float CGScalerContext::onGetAdvance(GlyphID glyphID, bool verticalText) const {
   CGSize cgAdvance;
   if (verticalText) {
     CTFontGetAdvancesForGlyphs(ctFont, kCTFontOrientationVertical, &glyphID, &cgAdvance, 1);
@@ -228,8 +228,8 @@ class CTPathGeometrySink {
   CGPoint current = {0, 0};
 };
 
-bool CGScalerContext::generatePath(GlyphID glyphID, bool fauxBold, bool fauxItalic,
-                                   Path* path) const {
+bool CGScalerContext::onGeneratePath(GlyphID glyphID, bool fauxBold, bool fauxItalic,
+                                     Path* path) const {
   auto fontFormat = CTFontCopyAttribute(ctFont, kCTFontFormatAttribute);
   if (!fontFormat) {
     return false;
@@ -32,18 +32,19 @@ class CGScalerContext : public ScalerContext {
 
   FontMetrics getFontMetrics() const override;
 
-  Rect getBounds(GlyphID glyphID, bool fauxBold, bool fauxItalic) const override;
-
-  float getAdvance(GlyphID glyphID, bool verticalText) const override;
-
   Point getVerticalOffset(GlyphID glyphID) const override;
 
-  bool generatePath(GlyphID glyphID, bool fauxBold, bool fauxItalic, Path* path) const override;
-
   Rect getImageTransform(GlyphID glyphID, Matrix* matrix) const override;
 
   std::shared_ptr<ImageBuffer> generateImage(GlyphID glyphID, bool tryHardware) const override;
 
+ protected:
+  Rect onGetBounds(GlyphID glyphID, bool fauxBold, bool fauxItalic) const override;
+
+  float onGetAdvance(GlyphID glyphID, bool verticalText) const override;
+
+  bool onGeneratePath(GlyphID glyphID, bool fauxBold, bool fauxItalic, Path* path) const override;
+
  private:
   float fauxBoldScale = 1.0f;
   CTFontRef ctFont = nullptr;
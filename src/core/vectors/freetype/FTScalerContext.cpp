@@ -102,6 +102,22 @@ static FT_Int ChooseBitmapStrike(FT_Face face, FT_F26Dot6 scaleY) {
   return chosenStrikeIndex;
 }
 
+class FTScalerContext::AutoFace {
+ public:
+  explicit AutoFace(const FTScalerContext* context)
+      : context(context), face(context->acquireFace()) {
+  }
+
+  ~AutoFace() {
+    if (face != nullptr) {
+      context->releaseFace(face);
+    }
+  }
+
+  const FTScalerContext* context = nullptr;
+  FT_Face face = nullptr;
+};
+
 FTScalerContext::FTScalerContext(std::shared_ptr<Typeface> tf, float size)
     : ScalerContext(std::move(tf), size), textScale(size) {
   loadGlyphFlags |= FT_LOAD_NO_BITMAP;
@@ -109,32 +125,33 @@ FTScalerContext::FTScalerContext(std::shared_ptr<Typeface> tf, float size)
   // advances, as fontconfig and cairo do.
   loadGlyphFlags |= FT_LOAD_IGNORE_GLOBAL_ADVANCE_WIDTH;
   loadGlyphFlags |= FT_LOAD_TARGET_NORMAL;
-  auto face = ftTypeface()->face;
-  if (FT_HAS_COLOR(face)) {
-    loadGlyphFlags |= FT_LOAD_COLOR;
-  }
-
-  auto err = FT_New_Size(face, &ftSize);
-  if (err != FT_Err_Ok) {
-    LOGE("FT_New_Size(%s) failed.", face->family_name);
+  auto face = ftTypeface()->acquireFace();
+  if (face == nullptr) {
+    LOGE("FTScalerContext: failed to open the font face.");
     return;
   }
-  err = FT_Activate_Size(ftSize);
-  if (err != FT_Err_Ok) {
-    LOGE("FT_Activate_Size(%s) failed.", face->family_name);
-    return;
+  faceReady = initFace(face);
+  ftTypeface()->releaseFace(face);
+}
+
+bool FTScalerContext::initFace(FT_Face face) {
+  if (FT_HAS_COLOR(face)) {
+    loadGlyphFlags |= FT_LOAD_COLOR;
   }
   if (FloatNearlyZero(textScale) || !FloatsAreFinite(&textScale, 1)) {
     textScale = 1.0f;
     extraScale.set(0.0f, 0.0f);
   }
-  auto textScaleDot6 = FloatToFDot6(textScale);
-  if (FT_IS_SCALABLE(face)) {
-    err = FT_Set_Char_Size(face, textScaleDot6, textScaleDot6, 72, 72);
-    if (err != FT_Err_Ok) {
-      LOGE("FT_Set_CharSize(%s, %f, %f) failed.", face->family_name, textScaleDot6, textScaleDot6);
-      return;
+  if (!FT_IS_SCALABLE(face) && FT_HAS_FIXED_SIZES(face)) {
+    strikeIndex = ChooseBitmapStrike(face, FloatToFDot6(textScale));
+    if (strikeIndex == -1) {
+      LOGE("No glyphs for font \"%s\" size %f.\n", face->family_name, textScale);
     }
+  }
+  if (!activateSize(face)) {
+    return false;
+  }
+  if (FT_IS_SCALABLE(face)) {
     // Adjust the matrix to reflect the actually chosen scale.
     // FreeType currently does not allow requesting sizes less than 1, this allows for scaling.
     // Don't do this at all sizes as that will interfere with hinting.
@@ -146,20 +163,7 @@ FTScalerContext::FTScalerContext(std::shared_ptr<Typeface> tf, float size)
       extraScale.x *= textScale / xPpem;
       extraScale.y *= textScale / yPpem;
     }
-  } else if (FT_HAS_FIXED_SIZES(face)) {
-    strikeIndex = ChooseBitmapStrike(face, textScaleDot6);
-    if (strikeIndex == -1) {
-      LOGE("No glyphs for font \"%s\" size %f.\n", face->family_name, textScaleDot6);
-      return;
-    }
-
-    err = FT_Select_Size(face, strikeIndex);
-    if (err != 0) {
-      LOGE("FT_Select_Size(%s, %d) failed.", face->family_name, strikeIndex);
-      strikeIndex = -1;
-      return;
-    }
-
+  } else if (strikeIndex != -1) {
     // Adjust the matrix to reflect the actually chosen scale.
     // It is likely that the ppem chosen was not the one requested; this allows for scaling.
     extraScale.x *= textScale / static_cast<float>(face->size->metrics.x_ppem);
@@ -173,20 +177,75 @@ FTScalerContext::FTScalerContext(std::shared_ptr<Typeface> tf, float size)
     // Force this flag off for bitmap-only fonts.
     loadGlyphFlags &= ~FT_LOAD_NO_BITMAP;
   }
+  return true;
 }
 
 FTScalerContext::~FTScalerContext() {
-  if (ftSize) {
-    std::lock_guard<std::mutex> autoLock(ftTypeface()->locker);
-    FT_Done_Size(ftSize);
+  ftTypeface()->releaseSizes(faceSizes);
+}
+
+bool FTScalerContext::setupFace(FT_Face face) const {
+  auto textScaleDot6 = FloatToFDot6(textScale);
+  if (FT_IS_SCALABLE(face)) {
+    auto err = FT_Set_Char_Size(face, textScaleDot6, textScaleDot6, 72, 72);
+    if (err != FT_Err_Ok) {
+      LOGE("FT_Set_CharSize(%s, %f, %f) failed.", face->family_name, textScaleDot6, textScaleDot6);
+      return false;
+    }
+  } else if (FT_HAS_FIXED_SIZES(face)) {
+    if (strikeIndex == -1) {
+      return false;
+    }
+    auto err = FT_Select_Size(face, strikeIndex);
+    if (err != FT_Err_Ok) {
+      LOGE("FT_Select_Size(%s, %d) failed.", face->family_name, strikeIndex);
+      return false;
+    }
   }
+  return true;
 }
 
-int FTScalerContext::setupSize(bool fauxItalic) const {
-  FT_Error err = FT_Activate_Size(ftSize);
-  if (err != 0) {
-    return err;
+bool FTScalerContext::activateSize(FT_Face face) const {
+  FT_Size size = nullptr;
+  {
+    std::lock_guard<std::mutex> autoLock(sizeLocker);
+    auto result = faceSizes.find(face);
+    if (result != faceSizes.end()) {
+      size = result->second;
+    }
   }
+  if (size != nullptr) {
+    return FT_Activate_Size(size) == FT_Err_Ok;
+  }
+  if (FT_New_Size(face, &size) != FT_Err_Ok) {
+    return false;
+  }
+  if (FT_Activate_Size(size) != FT_Err_Ok || !setupFace(face)) {
+    FT_Done_Size(size);
+    return false;
+  }
+  std::lock_guard<std::mutex> autoLock(sizeLocker);
+  faceSizes[face] = size;
+  return true;
+}
+
+FT_Face FTScalerContext::acquireFace() const {
+  if (!faceReady) {
+    return nullptr;
+  }
+  auto face = ftTypeface()->acquireFace();
+  if (face != nullptr && !activateSize(face)) {
+    ftTypeface()->releaseFace(face);
+    return nullptr;
+  }
+  return face;
+}
+
+void FTScalerContext::releaseFace(FT_Face face) const {
+  ftTypeface()->releaseFace(face);
+}
+
+void FTScalerContext::setTransform(FT_Face face, bool fauxItalic) const {
   auto matrix = getExtraMatrix(fauxItalic);
   FT_Matrix matrix22 = {
       FloatToFTFixed(matrix.getScaleX()),
@@ -194,23 +253,22 @@ int FTScalerContext::setupSize(bool fauxItalic) const {
       FloatToFTFixed(-matrix.getSkewY()),
       FloatToFTFixed(matrix.getScaleY()),
   };
-  FT_Set_Transform(ftTypeface()->face, &matrix22, nullptr);
-  return 0;
+  FT_Set_Transform(face, &matrix22, nullptr);
 }
 
 FontMetrics FTScalerContext::getFontMetrics() const {
-  std::lock_guard<std::mutex> autoLock(ftTypeface()->locker);
+  AutoFace autoFace(this);
   FontMetrics metrics = {};
-  if (setupSize(false)) {
+  if (autoFace.face == nullptr) {
     return metrics;
   }
-  getFontMetricsInternal(&metrics);
+  setTransform(autoFace.face, false);
+  getFontMetricsInternal(autoFace.face, &metrics);
   return metrics;
 }
 
-void FTScalerContext::getFontMetricsInternal(FontMetrics* metrics) const {
-  auto face = ftTypeface()->face;
-  auto upem = static_cast<float>(ftTypeface()->unitsPerEmInternal());
+void FTScalerContext::getFontMetricsInternal(FT_Face face, FontMetrics* metrics) const {
+  auto upem = static_cast<float>(FTTypeface::GetUnitsPerEm(face));
 
   // use the os/2 table as a source of reasonable defaults.
   auto xHeight = 0.0f;
@@ -260,13 +318,13 @@ void FTScalerContext::getFontMetricsInternal(FontMetrics* metrics) const {
     // we may be able to synthesize x_height and cap_height from outline
     if (xHeight == 0.f) {
       FT_BBox bbox;
-      if (getCBoxForLetter('x', &bbox)) {
+      if (getCBoxForLetter(face, 'x', &bbox)) {
         xHeight = static_cast<float>(bbox.yMax) / 64.0f;
       }
     }
     if (capHeight == 0.f) {
       FT_BBox bbox;
-      if (getCBoxForLetter('H', &bbox)) {
+      if (getCBoxForLetter(face, 'H', &bbox)) {
         capHeight = static_cast<float>(bbox.yMax) / 64.0f;
       }
     }
@@ -319,8 +377,7 @@ void FTScalerContext::getFontMetricsInternal(FontMetrics* metrics) const {
   metrics->underlinePosition = underlinePosition * textScale;
 }
 
-bool FTScalerContext::getCBoxForLetter(char letter, FT_BBox* bbox) const {
-  auto face = ftTypeface()->face;
+bool FTScalerContext::getCBoxForLetter(FT_Face face, char letter, FT_BBox* bbox) const {
   const auto glyph_id = FT_Get_Char_Index(face, static_cast<FT_ULong>(letter));
   if (glyph_id == 0) {
     return false;
@@ -413,15 +470,16 @@ static bool GenerateGlyphPath(FT_Face face, Path* path) {
   return true;
 }
 
-bool FTScalerContext::generatePath(GlyphID glyphID, bool fauxBold, bool fauxItalic,
-                                   Path* path) const {
-  std::lock_guard<std::mutex> autoLock(ftTypeface()->locker);
-  auto face = ftTypeface()->face;
+bool FTScalerContext::onGeneratePath(GlyphID glyphID, bool fauxBold, bool fauxItalic,
+                                     Path* path) const {
+  AutoFace autoFace(this);
+  auto face = autoFace.face;
   // FT_IS_SCALABLE is documented to mean the face contains outline glyphs.
-  if (!FT_IS_SCALABLE(face) || setupSize(fauxItalic)) {
+  if (face == nullptr || !FT_IS_SCALABLE(face)) {
     path->reset();
     return false;
   }
+  setTransform(face, fauxItalic);
   auto flags = loadGlyphFlags;
   flags |= FT_LOAD_NO_BITMAP;  // ignore embedded bitmaps so we're sure to get the outline
   flags &= ~FT_LOAD_RENDER;    // don't scan convert (we just want the outline)
@@ -441,8 +499,7 @@ bool FTScalerContext::generatePath(GlyphID glyphID, bool fauxBold, bool fauxItal
   return true;
 }
 
-void FTScalerContext::getBBoxForCurrentGlyph(FT_BBox* bbox) const {
-  auto face = ftTypeface()->face;
+void FTScalerContext::getBBoxForCurrentGlyph(FT_Face face, FT_BBox* bbox) const {
   FT_Outline_Get_CBox(&face->glyph->outline, bbox);
 
   // outset the box to integral boundaries
@@ -452,14 +509,15 @@ void FTScalerContext::getBBoxForCurrentGlyph(FT_BBox* bbox) const {
   bbox->yMax = (bbox->yMax + 63) & ~63;
 }
 
-Rect FTScalerContext::getBounds(tgfx::GlyphID glyphID, bool fauxBold, bool fauxItalic) const {
-  std::lock_guard<std::mutex> autoLock(ftTypeface()->locker);
+Rect FTScalerContext::onGetBounds(tgfx::GlyphID glyphID, bool fauxBold, bool fauxItalic) const {
+  AutoFace autoFace(this);
+  auto face = autoFace.face;
   auto bounds = Rect::MakeEmpty();
-  if (setupSize(fauxItalic)) {
+  if (face == nullptr) {
     return bounds;
   }
+  setTransform(face, fauxItalic);
   auto glyphFlags = loadGlyphFlags | static_cast<FT_Int32>(FT_LOAD_BITMAP_METRICS_ONLY);
-  auto face = ftTypeface()->face;
   auto err = FT_Load_Glyph(face, glyphID, glyphFlags);
   if (err != FT_Err_Ok) {
     return bounds;
@@ -472,7 +530,7 @@ Rect FTScalerContext::getBounds(tgfx::GlyphID glyphID, bool fauxBold, bool fauxI
     FT_BBox rect = {FT_PosLimits::max(), FT_PosLimits::max(), FT_PosLimits::min(),
                     FT_PosLimits::min()};
     if (0 < face->glyph->outline.n_contours) {
-      getBBoxForCurrentGlyph(&rect);
+      getBBoxForCurrentGlyph(face, &rect);
     } else {
       rect = {0, 0, 0, 0};
     }
@@ -498,21 +556,21 @@ Rect FTScalerContext::getBounds(tgfx::GlyphID glyphID, bool fauxBold, bool fauxI
     matrix.mapRect(&bounds);
     bounds.roundOut();
   } else {
-    LOGE("FTScalerContext::getBounds() unknown glyph format!");
+    LOGE("FTScalerContext::onGetBounds() unknown glyph format!");
   }
   return bounds;
 }
 
-float FTScalerContext::getAdvance(GlyphID glyphID, bool verticalText) const {
-  std::lock_guard<std::mutex> autoLock(ftTypeface()->locker);
-  if (setupSize(false)) {
+float FTScalerContext::onGetAdvance(GlyphID glyphID, bool verticalText) const {
+  AutoFace autoFace(this);
+  if (autoFace.face == nullptr) {
     return 0;
   }
-  return getAdvanceInternal(glyphID, verticalText);
+  setTransform(autoFace.face, false);
+  return getAdvanceInternal(autoFace.face, glyphID, verticalText);
 }
 
-float FTScalerContext::getAdvanceInternal(GlyphID glyphID, bool verticalText) const {
-  auto face = ftTypeface()->face;
+float FTScalerContext::getAdvanceInternal(FT_Face face, GlyphID glyphID, bool verticalText) const {
   auto glyphFlags = loadGlyphFlags | static_cast<FT_Int32>(FT_LOAD_BITMAP_METRICS_ONLY);
   if (verticalText) {
     glyphFlags |= FT_LOAD_VERTICAL_LAYOUT;
@@ -525,13 +583,18 @@ float FTScalerContext::getAdvanceInternal(GlyphID glyphID, bool verticalText) co
 }
 
 Point FTScalerContext::getVerticalOffset(GlyphID glyphID) const {
-  std::lock_guard<std::mutex> autoLock(ftTypeface()->locker);
-  if (glyphID == 0 || setupSize(false)) {
+  if (glyphID == 0) {
+    return Point::Zero();
+  }
+  AutoFace autoFace(this);
+  auto face = autoFace.face;
+  if (face == nullptr) {
     return Point::Zero();
   }
+  setTransform(face, false);
   FontMetrics metrics = {};
-  getFontMetricsInternal(&metrics);
-  auto advanceX = getAdvanceInternal(glyphID);
+  getFontMetricsInternal(face, &metrics);
+  auto advanceX = getAdvanceInternal(face, glyphID);
   return {-advanceX * 0.5f, metrics.capHeight};
 }
 
@@ -547,13 +610,13 @@ static gfx::skcms_PixelFormat ToPixelFormat(ColorType colorType) {
 }
 
 Rect FTScalerContext::getImageTransform(GlyphID glyphID, Matrix* matrix) const {
-  std::lock_guard<std::mutex> autoLock(ftTypeface()->locker);
+  AutoFace autoFace(this);
+  auto face = autoFace.face;
   auto glyphFlags = loadGlyphFlags | static_cast<FT_Int32>(FT_LOAD_BITMAP_METRICS_ONLY);
   glyphFlags &= ~FT_LOAD_NO_BITMAP;
-  if (!loadBitmapGlyph(glyphID, glyphFlags)) {
+  if (!loadBitmapGlyph(face, glyphID, glyphFlags)) {
     return Rect::MakeEmpty();
   }
-  auto face = ftTypeface()->face;
   if (matrix) {
     matrix->setTranslate(static_cast<float>(face->glyph->bitmap_left),
                          -static_cast<float>(face->glyph->bitmap_top));
@@ -566,14 +629,15 @@ Rect FTScalerContext::getImageTransform(GlyphID glyphID, Matrix* matrix) const {
 
 std::shared_ptr<ImageBuffer> FTScalerContext::generateImage(GlyphID glyphID,
                                                             bool tryHardware) const {
-  std::lock_guard<std::mutex> autoLock(ftTypeface()->locker);
+  AutoFace autoFace(this);
+  auto face = autoFace.face;
   auto glyphFlags = loadGlyphFlags;
   glyphFlags |= FT_LOAD_RENDER;
   glyphFlags &= ~FT_LOAD_NO_BITMAP;
-  if (!loadBitmapGlyph(glyphID, glyphFlags)) {
+  if (!loadBitmapGlyph(face, glyphID, glyphFlags)) {
     return nullptr;
   }
-  auto ftBitmap = ftTypeface()->face->glyph->bitmap;
+  auto ftBitmap = face->glyph->bitmap;
   auto alphaOnly = ftBitmap.pixel_mode == FT_PIXEL_MODE_GRAY;
   Bitmap bitmap(static_cast<int>(ftBitmap.width), static_cast<int>(ftBitmap.rows), alphaOnly,
                 tryHardware);
@@ -600,11 +664,11 @@ std::shared_ptr<ImageBuffer> FTScalerContext::generateImage(GlyphID glyphID,
   return bitmap.makeBuffer();
 }
 
-bool FTScalerContext::loadBitmapGlyph(GlyphID glyphID, FT_Int32 glyphFlags) const {
-  if (setupSize(false)) {
+bool FTScalerContext::loadBitmapGlyph(FT_Face face, GlyphID glyphID, FT_Int32 glyphFlags) const {
+  if (face == nullptr) {
     return false;
   }
-  auto face = ftTypeface()->face;
+  setTransform(face, false);
   auto err = FT_Load_Glyph(face, glyphID, glyphFlags);
   if (err != FT_Err_Ok || face->glyph->format != FT_GLYPH_FORMAT_BITMAP) {
     return false;
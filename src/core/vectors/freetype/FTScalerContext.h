@@ -19,6 +19,8 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
+#include <unordered_map>
 #include "ft2build.h"
 #include FT_FREETYPE_H
 #include "FTTypeface.h"
@@ -34,39 +36,59 @@ class FTScalerContext : public ScalerContext {
 
   FontMetrics getFontMetrics() const override;
 
-  Rect getBounds(GlyphID glyphID, bool fauxBold, bool fauxItalic) const override;
-
-  float getAdvance(GlyphID glyphID, bool verticalText) const override;
-
   Point getVerticalOffset(GlyphID glyphID) const override;
 
-  bool generatePath(GlyphID glyphID, bool fauxBold, bool fauxItalic, Path* path) const override;
-
   Rect getImageTransform(GlyphID glyphID, Matrix* matrix) const override;
 
   std::shared_ptr<ImageBuffer> generateImage(GlyphID glyphID, bool tryHardware) const override;
 
+ protected:
+  Rect onGetBounds(GlyphID glyphID, bool fauxBold, bool fauxItalic) const override;
+
+  float onGetAdvance(GlyphID glyphID, bool verticalText) const override;
+
+  bool onGeneratePath(GlyphID glyphID, bool fauxBold, bool fauxItalic, Path* path) const override;
+
  private:
-  int setupSize(bool fauxItalic) const;
+  /**
+   * Borrows an FT_Face from the face pool of the typeface for the lifetime of the object, with the
+   * FT_Size of this context activated.
+   */
+  class AutoFace;
 
-  void getFontMetricsInternal(FontMetrics* metrics) const;
+  void setTransform(FT_Face face, bool fauxItalic) const;
 
-  float getAdvanceInternal(GlyphID glyphID, bool verticalText = false) const;
+  void getFontMetricsInternal(FT_Face face, FontMetrics* metrics) const;
 
-  bool getCBoxForLetter(char letter, FT_BBox* bbox) const;
+  float getAdvanceInternal(FT_Face face, GlyphID glyphID, bool verticalText = false) const;
 
-  void getBBoxForCurrentGlyph(FT_BBox* bbox) const;
+  bool getCBoxForLetter(FT_Face face, char letter, FT_BBox* bbox) const;
 
-  bool loadBitmapGlyph(GlyphID glyphID, FT_Int32 glyphFlags) const;
+  void getBBoxForCurrentGlyph(FT_Face face, FT_BBox* bbox) const;
+
+  bool loadBitmapGlyph(FT_Face face, GlyphID glyphID, FT_Int32 glyphFlags) const;
 
   Matrix getExtraMatrix(bool fauxItalic) const;
 
   FTTypeface* ftTypeface() const;
 
+  bool initFace(FT_Face face);
+
+  bool setupFace(FT_Face face) const;
+
+  bool activateSize(FT_Face face) const;
+
+  FT_Face acquireFace() const;
+
+  void releaseFace(FT_Face face) const;
+
   float textScale = 1.0f;
   Point extraScale = Point::Make(1.f, 1.f);
-  FT_Size ftSize = nullptr;
   FT_Int strikeIndex = -1;  // The bitmap strike for the face (or -1 if none).
   FT_Int32 loadGlyphFlags = 0;
+  bool faceReady = false;
+  // The FT_Size of this context on each face it has borrowed from the typeface.
+  mutable std::mutex sizeLocker = {};
+  mutable std::unordered_map<FT_Face, FT_Size> faceSizes = {};
 };
 }  // namespace tgfx
@@ -17,11 +17,15 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "FTTypeface.h"
+#include <algorithm>
 #include <cstddef>
 #include "FTLibrary.h"
+#include FT_SIZES_H
 #include FT_TRUETYPE_TABLES_H
 #include "FTScalerContext.h"
 #include "SystemFont.h"
+#include "core/utils/MappedFile.h"
+#include "core/utils/TaskGroup.h"
 #include "core/utils/UniqueID.h"
 #include "tgfx/core/UTF.h"
 
@@ -32,6 +36,12 @@ std::shared_ptr<Typeface> Typeface::MakeFromName(const std::string& fontFamily,
 }
 
 std::shared_ptr<Typeface> Typeface::MakeFromPath(const std::string& fontPath, int ttcIndex) {
+  // FreeType jumps between the font tables while loading glyphs, so read-ahead is disabled. The
+  // mapped pages are shared with the page cache instead of being buffered again by FreeType.
+  auto fontData = MapFile(fontPath, FileAccess::Random);
+  if (fontData != nullptr) {
+    return FTTypeface::Make(FTFontData(std::move(fontData), ttcIndex));
+  }
   return FTTypeface::Make(FTFontData(fontPath, ttcIndex));
 }
 
@@ -89,10 +99,73 @@ std::shared_ptr<FTTypeface> FTTypeface::Make(FTFontData data) {
 }
 
 FTTypeface::FTTypeface(FTFontData data, FT_Face face)
-    : _uniqueID(UniqueID::Next()), data(std::move(data)), face(std::move(face)) {
+    : _uniqueID(UniqueID::Next()), data(std::move(data)), face(std::move(face)),
+      maxFaceCount(static_cast<size_t>(std::max(GetCPUCores(), 1))) {
 }
 
 FTTypeface::~FTTypeface() {
+  // The scaler contexts hold the typeface, so all pooled faces are idle here. Closing a face also
+  // frees its remaining sizes.
+  for (auto& idleFace : idleFaces) {
+    CloseFace(idleFace);
+  }
+  CloseFace(face);
+}
+
+FT_Face FTTypeface::acquireFace() const {
+  std::unique_lock<std::mutex> autoLock(poolLocker);
+  while (idleFaces.empty()) {
+    if (faceCount < maxFaceCount) {
+      // Opening a face is slow, so do it outside the lock.
+      faceCount++;
+      autoLock.unlock();
+      auto newFace = CreateFTFace(data);
+      if (newFace != nullptr) {
+        return newFace;
+      }
+      autoLock.lock();
+      faceCount--;
+      // Stop growing the pool if the font can not be opened again.
+      maxFaceCount = faceCount;
+      if (faceCount == 0) {
+        return nullptr;
+      }
+      continue;
+    }
+    poolCondition.wait(autoLock);
+  }
+  auto idleFace = idleFaces.back();
+  idleFaces.pop_back();
+  return idleFace;
+}
+
+void FTTypeface::releaseFace(FT_Face ftFace) const {
+  {
+    std::lock_guard<std::mutex> autoLock(poolLocker);
+    auto result = retiredSizes.find(ftFace);
+    if (result != retiredSizes.end()) {
+      for (auto& size : result->second) {
+        FT_Done_Size(size);
+      }
+      retiredSizes.erase(result);
+    }
+    idleFaces.push_back(ftFace);
+  }
+  poolCondition.notify_one();
+}
+
+void FTTypeface::releaseSizes(const std::unordered_map<FT_Face, FT_Size>& sizes) const {
+  std::lock_guard<std::mutex> autoLock(poolLocker);
+  for (auto& item : sizes) {
+    if (std::find(idleFaces.begin(), idleFaces.end(), item.first) != idleFaces.end()) {
+      FT_Done_Size(item.second);
+    } else {
+      retiredSizes[item.first].push_back(item.second);
+    }
+  }
+}
+
+void FTTypeface::CloseFace(FT_Face face) {
   std::lock_guard<std::mutex> autoLock(FTMutex());
   FT_Done_Face(face);
 }
@@ -114,10 +187,10 @@ size_t FTTypeface::glyphsCount() const {
 
 int FTTypeface::unitsPerEm() const {
   std::lock_guard<std::mutex> autoLock(locker);
-  return unitsPerEmInternal();
+  return GetUnitsPerEm(face);
 }
 
-int FTTypeface::unitsPerEmInternal() const {
+int FTTypeface::GetUnitsPerEm(FT_Face face) {
   auto upem = face->units_per_EM;
   // At least some versions of FreeType set face->units_per_EM to 0 for bitmap only fonts.
   if (upem == 0) {
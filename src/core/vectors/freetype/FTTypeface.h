@@ -18,7 +18,10 @@
 
 #pragma once
 
+#include <condition_variable>
 #include <mutex>
+#include <unordered_map>
+#include <vector>
 #include "ft2build.h"
 #include FT_FREETYPE_H
 #include "FTFontData.h"
@@ -67,7 +70,37 @@ class FTTypeface : public Typeface {
 
   FTTypeface(FTFontData data, FT_Face face);
 
-  int unitsPerEmInternal() const;
+  static int GetUnitsPerEm(FT_Face face);
+
+  // The faces sharing the font data of this typeface, which the scaler contexts borrow to load
+  // glyphs from different threads concurrently. Each context keeps its own FT_Size on them.
+  mutable std::mutex poolLocker = {};
+  mutable std::condition_variable poolCondition = {};
+  mutable std::vector<FT_Face> idleFaces = {};
+  mutable size_t faceCount = 0;
+  mutable size_t maxFaceCount = 1;
+  // The sizes released by the scaler contexts while their faces were borrowed.
+  mutable std::unordered_map<FT_Face, std::vector<FT_Size>> retiredSizes = {};
+
+  /**
+   * Borrows a face from the pool, opening a new one if all faces are in use and the pool is not
+   * full yet, or waiting for one to be released otherwise. Returns nullptr if the font can not be
+   * opened.
+   */
+  FT_Face acquireFace() const;
+
+  /**
+   * Returns a face borrowed by acquireFace() to the pool.
+   */
+  void releaseFace(FT_Face face) const;
+
+  /**
+   * Frees the FT_Sizes created by a scaler context on the faces of the pool. The sizes of a face
+   * that is borrowed are freed when it is released.
+   */
+  void releaseSizes(const std::unordered_map<FT_Face, FT_Size>& sizes) const;
+
+  static void CloseFace(FT_Face face);
 
   friend class FTScalerContext;
 };
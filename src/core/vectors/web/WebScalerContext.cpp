@@ -48,11 +48,11 @@ FontMetrics WebScalerContext::getFontMetrics() const {
   return scalerContext.call<FontMetrics>("getFontMetrics");
 }
 
-Rect WebScalerContext::getBounds(GlyphID glyphID, bool fauxBold, bool fauxItalic) const {
+Rect WebScalerContext::onGetBounds(GlyphID glyphID, bool fauxBold, bool fauxItalic) const {
   return scalerContext.call<Rect>("getBounds", getText(glyphID), fauxBold, fauxItalic);
 }
 
-float WebScalerContext::getAdvance(GlyphID glyphID, bool) const {
+float WebScalerContext::onGetAdvance(GlyphID glyphID, bool) const {
   return scalerContext.call<float>("getAdvance", getText(glyphID));
 }
 
@@ -62,7 +62,7 @@ Point WebScalerContext::getVerticalOffset(GlyphID glyphID) const {
   return {-advanceX * 0.5f, metrics.capHeight};
 }
 
-bool WebScalerContext::generatePath(GlyphID, bool, bool, Path*) const {
+bool WebScalerContext::onGeneratePath(GlyphID, bool, bool, Path*) const {
   return false;
 }
 
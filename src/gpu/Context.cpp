@@ -67,6 +67,7 @@ bool Context::flush(BackendSemaphore* signalSemaphore) {
   if (flushed) {
     // Clean up all unreferenced resources after flushing to reduce memory usage.
     _proxyProvider->purgeExpiredProxies();
+    _proxyProvider->advanceDrawScales();
     _resourceCache->purgeToCacheLimit(timePoint);
   }
   return semaphoreInserted;
@@ -17,6 +17,8 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "DrawingManager.h"
+#include <algorithm>
+#include <list>
 #include "gpu/Gpu.h"
 #include "gpu/proxies/RenderTargetProxy.h"
 #include "gpu/proxies/TextureProxy.h"
@@ -99,10 +101,7 @@ bool DrawingManager::flush() {
   for (auto& task : renderTasks) {
     task->prepare(context);
   }
-  for (auto& task : resourceTasks) {
-    task->execute(context);
-  }
-  resourceTasks = {};
+  executeResourceTasks();
 #ifdef DEBUG
   resourceTaskMap = {};
 #endif
@@ -131,6 +130,32 @@ bool DrawingManager::flush() {
   return true;
 }
 
+void DrawingManager::executeResourceTasks() {
+  // Upload the resources in the order their asynchronous work finishes, so that a single slow
+  // shape does not keep the GPU idle while the others are already done.
+  std::list<std::shared_ptr<ResourceTask>> pendingTasks = {};
+  for (auto& task : resourceTasks) {
+    if (task->isReady()) {
+      task->execute(context);
+    } else {
+      pendingTasks.push_back(std::move(task));
+    }
+  }
+  resourceTasks = {};
+  while (!pendingTasks.empty()) {
+    auto readyTask = std::find_if(pendingTasks.begin(), pendingTasks.end(),
+                                  [](const std::shared_ptr<ResourceTask>& task) {
+                                    return task->isReady();
+                                  });
+    if (readyTask == pendingTasks.end()) {
+      // Nothing has finished yet, block on the oldest task, which may also run it on this thread.
+      readyTask = pendingTasks.begin();
+    }
+    (*readyTask)->execute(context);
+    pendingTasks.erase(readyTask);
+  }
+}
+
 void DrawingManager::addRenderTask(std::shared_ptr<RenderTask> renderTask) {
   if (activeOpsTask) {
     activeOpsTask->makeClosed();
@@ -65,6 +65,7 @@ class DrawingManager {
   ResourceKeyMap<ResourceTask*> resourceTaskMap = {};
 #endif
 
+  void executeResourceTasks();
   void addRenderTask(std::shared_ptr<RenderTask> renderTask);
   void checkIfResolveNeeded(std::shared_ptr<RenderTargetProxy> renderTargetProxy);
 };
@@ -74,6 +74,17 @@ class Pipeline : public ProgramInfo {
     return dstTextureInfo.offset;
   }
 
+  const StencilSettings* stencilSettings() const override {
+    return _stencilSettings;
+  }
+
+  /**
+   * Sets the stencil settings for the draw. The settings must outlive the pipeline.
+   */
+  void setStencilSettings(const StencilSettings* settings) {
+    _stencilSettings = settings;
+  }
+
   bool requiresBarrier() const override {
     return dstTextureInfo.requiresBarrier;
   }
@@ -106,6 +117,7 @@ class Pipeline : public ProgramInfo {
   size_t numColorProcessors = 0;
   std::unique_ptr<XferProcessor> xferProcessor = nullptr;
   BlendInfo _blendInfo = {};
+  const StencilSettings* _stencilSettings = nullptr;
   DstTextureInfo dstTextureInfo = {};
   const Swizzle* _outputSwizzle = nullptr;
 
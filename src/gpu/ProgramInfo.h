@@ -21,6 +21,7 @@
 #include "gpu/Blend.h"
 #include "gpu/Program.h"
 #include "gpu/SamplerState.h"
+#include "gpu/StencilSettings.h"
 #include "gpu/TextureSampler.h"
 #include "gpu/UniformBuffer.h"
 
@@ -43,6 +44,12 @@ class ProgramInfo {
    */
   virtual const BlendInfo* blendInfo() const = 0;
 
+  /**
+   * Returns the stencil settings for the draw. A nullptr is returned if the draw does not use the
+   * stencil buffer.
+   */
+  virtual const StencilSettings* stencilSettings() const = 0;
+
   /**
    * Returns true if the draw requires a texture barrier.
    */
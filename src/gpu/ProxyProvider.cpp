@@ -17,6 +17,7 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "ProxyProvider.h"
+#include <algorithm>
 #include "core/ShapeRasterizer.h"
 #include "core/shapes/MatrixShape.h"
 #include "core/utils/DataTask.h"
@@ -112,6 +113,10 @@ class AsyncShapeBufferProvider : public ShapeBufferProvider {
     return task->wait();
   }
 
+  bool isReady() const override {
+    return task->finished();
+  }
+
  private:
   std::shared_ptr<DataTask<ShapeBuffer>> task = nullptr;
 };
@@ -127,6 +132,23 @@ static UniqueKey AppendClipBoundsKey(const UniqueKey& uniqueKey, const Rect& cli
   return UniqueKey::Append(uniqueKey, bytesKey.data(), bytesKey.size());
 }
 
+// The scales at which zoomed shapes are cached while their scale keeps changing, spaced by a factor
+// of sqrt(2). A cached scale is reused as long as the requested scale is within three quarters of
+// a step from it, so that zooming back and forth around the middle of two steps does not switch
+// between them on every frame.
+static constexpr float ScaleStepsPerOctave = 2.0f;
+static constexpr float MaxScaleStepDistance = 0.75f;
+// Scale changes larger than this between two flushes are treated as jumps rather than zooming.
+static constexpr float MaxZoomingScaleRatio = 2.0f;
+
+static float GetScaleStep(float scale) {
+  return log2f(scale) * ScaleStepsPerOctave;
+}
+
+static float GetStepScale(float step) {
+  return exp2f(step / ScaleStepsPerOctave);
+}
+
 std::shared_ptr<GpuShapeProxy> ProxyProvider::createGpuShapeProxy(std::shared_ptr<Shape> shape,
                                                                   bool antiAlias,
                                                                   const Rect& clipBounds,
@@ -134,18 +156,98 @@ std::shared_ptr<GpuShapeProxy> ProxyProvider::createGpuShapeProxy(std::shared_pt
   if (shape == nullptr) {
     return nullptr;
   }
-  auto drawingMatrix = Matrix::I();
-  auto isInverseFillType = shape->isInverseFillType();
-  if (shape->type() == Shape::Type::Matrix && !isInverseFillType) {
+  if (shape->type() == Shape::Type::Matrix && !shape->isInverseFillType()) {
     auto matrixShape = std::static_pointer_cast<MatrixShape>(shape);
     auto scales = matrixShape->matrix.getAxisScales();
     if (scales.x == scales.y) {
       DEBUG_ASSERT(scales.x != 0);
-      drawingMatrix = matrixShape->matrix;
-      drawingMatrix.preScale(1.0f / scales.x, 1.0f / scales.x);
-      shape = Shape::ApplyMatrix(matrixShape->shape, Matrix::MakeScale(scales.x));
+      return createScaledShapeProxy(matrixShape, scales.x, antiAlias, clipBounds, renderFlags);
+    }
+  }
+  return findOrCreateShapeProxy(std::move(shape), Matrix::I(), antiAlias, clipBounds, renderFlags,
+                                true);
+}
+
+std::shared_ptr<GpuShapeProxy> ProxyProvider::createScaledShapeProxy(
+    std::shared_ptr<MatrixShape> matrixShape, float scale, bool antiAlias, const Rect& clipBounds,
+    uint32_t renderFlags) {
+  auto makeProxy = [&](float rasterScale, bool createIfMissing) {
+    auto drawingMatrix = matrixShape->matrix;
+    drawingMatrix.preScale(1.0f / rasterScale, 1.0f / rasterScale);
+    auto shape = Shape::ApplyMatrix(matrixShape->shape, Matrix::MakeScale(rasterScale));
+    return findOrCreateShapeProxy(std::move(shape), drawingMatrix, antiAlias, clipBounds,
+                                  renderFlags, createIfMissing);
+  };
+  if (!isZooming(matrixShape->shape->getUniqueKey(), scale)) {
+    // The scale has settled, rasterize the shape at its exact scale.
+    return makeProxy(scale, true);
+  }
+  if (auto proxy = makeProxy(scale, false)) {
+    return proxy;
+  }
+  // Reuse the nearest cached scale step while zooming, to avoid rasterizing the shape again on
+  // every frame and filling the resource cache with near-duplicates.
+  auto step = GetScaleStep(scale);
+  auto nearestStep = roundf(step);
+  auto neighborStep = step > nearestStep ? nearestStep + 1.0f : nearestStep - 1.0f;
+  if (auto proxy = makeProxy(GetStepScale(nearestStep), false)) {
+    return proxy;
+  }
+  if (fabsf(step - neighborStep) <= MaxScaleStepDistance) {
+    if (auto proxy = makeProxy(GetStepScale(neighborStep), false)) {
+      return proxy;
     }
   }
+  return makeProxy(GetStepScale(nearestStep), true);
+}
+
+bool ProxyProvider::isZooming(const UniqueKey& uniqueKey, float scale) {
+  BytesKey scaleKey = {};
+  uniqueKey.writeTo(&scaleKey);
+  auto& scales = drawScales[scaleKey];
+  if (std::find(scales.begin(), scales.end(), scale) == scales.end()) {
+    scales.push_back(scale);
+  }
+  auto lastScales = lastDrawScales.find(scaleKey);
+  if (lastScales == lastDrawScales.end()) {
+    return false;
+  }
+  // Content drawn at several scales in one frame, such as a reused icon, is only zooming if none of
+  // the scales from the previous frame matches.
+  auto& previousScales = lastScales->second;
+  if (std::find(previousScales.begin(), previousScales.end(), scale) != previousScales.end()) {
+    return false;
+  }
+  return std::any_of(previousScales.begin(), previousScales.end(), [scale](float lastScale) {
+    return scale < lastScale * MaxZoomingScaleRatio && scale * MaxZoomingScaleRatio > lastScale;
+  });
+}
+
+UniqueKey ProxyProvider::findOrCreateContentKey(const BytesKey& contentKey) {
+  auto result = contentKeys.find(contentKey);
+  if (result != contentKeys.end()) {
+    return result->second;
+  }
+  auto lastResult = lastContentKeys.find(contentKey);
+  auto uniqueKey = lastResult != lastContentKeys.end() ? lastResult->second : UniqueKey::Make();
+  contentKeys[contentKey] = uniqueKey;
+  return uniqueKey;
+}
+
+void ProxyProvider::advanceDrawScales() {
+  lastDrawScales = std::move(drawScales);
+  drawScales = {};
+  lastContentKeys = std::move(contentKeys);
+  contentKeys = {};
+}
+
+std::shared_ptr<GpuShapeProxy> ProxyProvider::findOrCreateShapeProxy(std::shared_ptr<Shape> shape,
+                                                                     Matrix drawingMatrix,
+                                                                     bool antiAlias,
+                                                                     const Rect& clipBounds,
+                                                                     uint32_t renderFlags,
+                                                                     bool createIfMissing) {
+  auto isInverseFillType = shape->isInverseFillType();
   auto shapeBounds = shape->getBounds();
   auto uniqueKey = shape->getUniqueKey();
   if (isInverseFillType) {
@@ -171,6 +273,9 @@ std::shared_ptr<GpuShapeProxy> ProxyProvider::createGpuShapeProxy(std::shared_pt
     return std::make_shared<GpuShapeProxy>(drawingMatrix, std::move(triangleProxy),
                                            std::move(textureProxy));
   }
+  if (!createIfMissing) {
+    return nullptr;
+  }
   auto width = static_cast<int>(ceilf(bounds.width()));
   auto height = static_cast<int>(ceilf(bounds.height()));
   shape = Shape::ApplyMatrix(std::move(shape), Matrix::MakeTrans(-bounds.x(), -bounds.y()));
@@ -213,7 +318,8 @@ std::shared_ptr<TextureProxy> ProxyProvider::createTextureProxy(
     return proxy;
   }
   auto asyncDecoding = !(renderFlags & RenderFlags::DisableAsyncTask);
-  auto decoder = ImageDecoder::MakeFrom(std::move(generator), !mipmapped, asyncDecoding);
+  auto decoder =
+      ImageDecoder::MakeFrom(std::move(generator), !mipmapped, asyncDecoding, uniqueKey);
   return doCreateTextureProxy(uniqueKey, std::move(decoder), mipmapped, renderFlags);
 }
 
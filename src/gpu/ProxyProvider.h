@@ -20,6 +20,7 @@
 
 #include "core/DataProvider.h"
 #include "core/ImageDecoder.h"
+#include "core/shapes/MatrixShape.h"
 #include "gpu/proxies/GpuBufferProxy.h"
 #include "gpu/proxies/GpuShapeProxy.h"
 #include "gpu/proxies/RenderTargetProxy.h"
@@ -138,12 +139,47 @@ class ProxyProvider {
    */
   void purgeExpiredProxies();
 
+  /**
+   * Records the scale at which the content identified by the uniqueKey is drawn in the current
+   * frame, and returns true if the content is being zoomed, i.e., none of the scales it was drawn
+   * at in the previous frame matches, but one of them is close to the scale.
+   */
+  bool isZooming(const UniqueKey& uniqueKey, float scale);
+
+  /**
+   * Returns the UniqueKey assigned to the given content key, creating a new one if the content was
+   * not drawn in the current or the previous frame. This lets content that is recreated on every
+   * draw, such as text, find its cached GPU resources across frames.
+   */
+  UniqueKey findOrCreateContentKey(const BytesKey& contentKey);
+
+  /**
+   * Marks the end of a frame. The scales recorded since the last call are used to tell whether the
+   * content is being zoomed in the next frame, and the content keys not used in the last two
+   * frames are released.
+   */
+  void advanceDrawScales();
+
  private:
   Context* context = nullptr;
   ResourceKeyMap<std::weak_ptr<ResourceProxy>> proxyMap = {};
+  BytesKeyMap<std::vector<float>> drawScales = {};
+  BytesKeyMap<std::vector<float>> lastDrawScales = {};
+  BytesKeyMap<UniqueKey> contentKeys = {};
+  BytesKeyMap<UniqueKey> lastContentKeys = {};
 
   static UniqueKey GetProxyKey(const UniqueKey& uniqueKey, uint32_t renderFlags);
 
+  std::shared_ptr<GpuShapeProxy> createScaledShapeProxy(std::shared_ptr<MatrixShape> matrixShape,
+                                                        float scale, bool antiAlias,
+                                                        const Rect& clipBounds,
+                                                        uint32_t renderFlags);
+
+  std::shared_ptr<GpuShapeProxy> findOrCreateShapeProxy(std::shared_ptr<Shape> shape,
+                                                        Matrix drawingMatrix, bool antiAlias,
+                                                        const Rect& clipBounds,
+                                                        uint32_t renderFlags, bool createIfMissing);
+
   std::shared_ptr<GpuBufferProxy> findOrWrapGpuBufferProxy(const UniqueKey& uniqueKey);
 
   std::shared_ptr<TextureProxy> doCreateTextureProxy(const UniqueKey& uniqueKey,
@@ -17,18 +17,24 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "RenderContext.h"
+#include "core/DistanceFieldRasterizer.h"
 #include "core/PathRef.h"
 #include "core/PathTriangulator.h"
 #include "core/Rasterizer.h"
 #include "core/utils/Caster.h"
+#include "core/utils/MathExtra.h"
 #include "gpu/DrawingManager.h"
 #include "gpu/OpContext.h"
 #include "gpu/ProxyProvider.h"
 #include "gpu/ops/ClearOp.h"
+#include "gpu/ops/ConvexPathDrawOp.h"
 #include "gpu/ops/RRectDrawOp.h"
 #include "gpu/ops/RectDrawOp.h"
 #include "gpu/ops/ShapeDrawOp.h"
+#include "gpu/ops/StrokeDrawOp.h"
+#include "gpu/ops/TessellatedPathDrawOp.h"
 #include "gpu/processors/AARectEffect.h"
+#include "gpu/processors/DistanceFieldEffect.h"
 #include "gpu/processors/TextureEffect.h"
 
 namespace tgfx {
@@ -40,6 +46,24 @@ namespace tgfx {
  */
 static constexpr float BOUNDS_TOLERANCE = 1e-3f;
 
+/**
+ * Text at or above this size in device pixels is drawn from a distance field instead of a coverage
+ * mask. Coverage masks of large glyphs are expensive to generate and upload, while the distance
+ * field can be generated at a smaller scale and magnified without blurring the edges.
+ */
+static constexpr float MIN_DISTANCE_FIELD_TEXT_SIZE = 256.0f;
+
+/**
+ * The maximum width or height of a distance field texture in pixels.
+ */
+static constexpr float MAX_DISTANCE_FIELD_SIZE = 2048.0f;
+
+/**
+ * The minimum text size in pixels at which a distance field is generated. Smaller fields lose the
+ * corners and thin strokes of the glyphs, so they are generated at this size and minified instead.
+ */
+static constexpr float MIN_DISTANCE_FIELD_GLYPH_SIZE = 64.0f;
+
 RenderContext::RenderContext(std::shared_ptr<RenderTargetProxy> renderTargetProxy,
                              uint32_t renderFlags)
     : renderFlags(renderFlags) {
@@ -137,6 +161,13 @@ void RenderContext::drawRRect(const RRect& rRect, const MCState& state, const Fi
     return;
   }
   auto drawOp = RRectDrawOp::Make(style.color.premultiply(), rRect, state.matrix);
+  if (drawOp == nullptr) {
+    // Corners smaller than half a pixel, such as tiny dots, are drawn as paths instead.
+    Path path = {};
+    path.addRRect(rRect);
+    drawShape(Shape::MakeFrom(std::move(path)), state, style);
+    return;
+  }
   addDrawOp(std::move(drawOp), localBounds, state, style);
 }
 
@@ -152,12 +183,84 @@ void RenderContext::drawShape(std::shared_ptr<Shape> shape, const MCState& state
   if (localBounds.isEmpty()) {
     return;
   }
+  // Parts of a stroke that cross each other are blended more than once by StrokeDrawOp, which is
+  // only invisible for opaque fills.
+  auto allowOverlaps = style.isOpaque() &&
+                       (style.blendMode == BlendMode::SrcOver || style.blendMode == BlendMode::Src);
+  if (auto strokeOp =
+          StrokeDrawOp::Make(style.color.premultiply(), shape, state.matrix, allowOverlaps)) {
+    addDrawOp(std::move(strokeOp), localBounds, state, style);
+    return;
+  }
+  if (auto convexOp = ConvexPathDrawOp::Make(style.color.premultiply(), shape, state.matrix)) {
+    addDrawOp(std::move(convexOp), localBounds, state, style);
+    return;
+  }
+  if (drawTessellatedPath(shape, localBounds, state, style)) {
+    return;
+  }
   auto clipBounds = getClipBounds(state.clip);
   auto drawOp =
       ShapeDrawOp::Make(style.color.premultiply(), std::move(shape), state.matrix, clipBounds);
   addDrawOp(std::move(drawOp), localBounds, state, style);
 }
 
+bool RenderContext::drawTessellatedPath(const std::shared_ptr<Shape>& shape,
+                                        const Rect& localBounds, const MCState& state,
+                                        const FillStyle& style) {
+  auto color = style.color.premultiply();
+  if (getAAType(style) != AAType::Coverage) {
+    // The stencil buffer can't be attached to the frame buffer of an external render target.
+    if (!opContext->renderTarget()->isTextureBacked()) {
+      return false;
+    }
+    auto drawOp = TessellatedPathDrawOp::Make(color, shape, state.matrix);
+    if (drawOp == nullptr) {
+      return false;
+    }
+    addDrawOp(std::move(drawOp), localBounds, state, style);
+    return true;
+  }
+  // Shapes drawn by ShapeDrawOp are cached across frames with analytic antialiasing, which beats
+  // rendering a new mask on every frame. The mask is only used when caching is disabled.
+  if (!(renderFlags & RenderFlags::DisableCache)) {
+    return false;
+  }
+  // Without multisampling, complex paths are tessellated into a multisampled mask first, which
+  // is then drawn as the coverage of a rect.
+  auto maskBounds = state.matrix.mapRect(localBounds);
+  maskBounds.roundOut();
+  auto width = static_cast<int>(maskBounds.width());
+  auto height = static_cast<int>(maskBounds.height());
+  auto maxTextureSize = getContext()->caps()->maxTextureSize;
+  if (width <= 0 || height <= 0 || width > maxTextureSize || height > maxTextureSize) {
+    return false;
+  }
+  auto maskMatrix = state.matrix;
+  maskMatrix.postTranslate(-maskBounds.left, -maskBounds.top);
+  auto maskOp = TessellatedPathDrawOp::Make(Color::White(), shape, maskMatrix, true);
+  if (maskOp == nullptr) {
+    return false;
+  }
+  auto maskTarget = RenderTargetProxy::MakeFallback(getContext(), width, height, true, 4, false,
+                                                    ImageOrigin::TopLeft, true);
+  if (maskTarget == nullptr || maskTarget->sampleCount() <= 1) {
+    return false;
+  }
+  maskOp->setAA(AAType::MSAA);
+  OpContext maskContext(maskTarget, renderFlags);
+  maskContext.addOp(std::move(maskOp));
+  getContext()->drawingManager()->addTextureResolveTask(maskTarget);
+  auto processor = TextureEffect::Make(maskTarget->getTextureProxy(), {}, &maskMatrix, true);
+  if (processor == nullptr) {
+    return true;
+  }
+  auto drawOp = RectDrawOp::Make(color, localBounds, state.matrix);
+  drawOp->addCoverageFP(std::move(processor));
+  addDrawOp(std::move(drawOp), localBounds, state, style);
+  return true;
+}
+
 void RenderContext::drawImage(std::shared_ptr<Image> image, const SamplingOptions& sampling,
                               const MCState& state, const FillStyle& style) {
   DEBUG_ASSERT(image != nullptr);
@@ -180,6 +283,11 @@ void RenderContext::drawImageRect(std::shared_ptr<Image> image, const Rect& rect
   if (localBounds.isEmpty()) {
     return;
   }
+  auto tiledImage = Caster::AsTiledImage(image.get());
+  if (tiledImage != nullptr) {
+    drawTiledImage(tiledImage, localBounds, uvMatrix, sampling, state, style);
+    return;
+  }
   FPArgs args = {getContext(), renderFlags, localBounds, state.matrix};
   auto processor = FragmentProcessor::Make(std::move(image), args, sampling);
   if (processor == nullptr) {
@@ -190,6 +298,70 @@ void RenderContext::drawImageRect(std::shared_ptr<Image> image, const Rect& rect
   addDrawOp(std::move(drawOp), localBounds, state, style);
 }
 
+static uint32_t GetOuterEdges(const Rect& rect, const Rect& bounds) {
+  uint32_t edges = 0;
+  if (FloatNearlyEqual(rect.left, bounds.left)) {
+    edges |= RectDrawOp::LeftEdge;
+  }
+  if (FloatNearlyEqual(rect.top, bounds.top)) {
+    edges |= RectDrawOp::TopEdge;
+  }
+  if (FloatNearlyEqual(rect.right, bounds.right)) {
+    edges |= RectDrawOp::RightEdge;
+  }
+  if (FloatNearlyEqual(rect.bottom, bounds.bottom)) {
+    edges |= RectDrawOp::BottomEdge;
+  }
+  return edges;
+}
+
+void RenderContext::drawTiledImage(const TiledImage* image, const Rect& localBounds,
+                                   const Matrix& uvMatrix, const SamplingOptions& sampling,
+                                   const MCState& state, const FillStyle& style) {
+  Matrix invertMatrix = {};
+  if (!uvMatrix.invert(&invertMatrix)) {
+    return;
+  }
+  auto imageMatrix = state.matrix;
+  imageMatrix.preConcat(invertMatrix);
+  auto level = image->getLevel(imageMatrix.getMaxScale());
+  auto imageBounds = uvMatrix.mapRect(localBounds);
+  auto tiles = image->getTiles(imageBounds, level);
+  auto drawBounds = invertMatrix.mapRect(imageBounds);
+  for (auto& tile : tiles) {
+    auto tileBounds = tile.bounds;
+    if (!tileBounds.intersect(imageBounds)) {
+      continue;
+    }
+    auto tileLocalBounds = invertMatrix.mapRect(tileBounds);
+    FPArgs args = {getContext(), renderFlags, tileLocalBounds, state.matrix};
+    auto processor = FragmentProcessor::Make(tile.image, args, sampling);
+    if (processor == nullptr) {
+      continue;
+    }
+    auto tileUVMatrix = uvMatrix;
+    tileUVMatrix.postConcat(tile.matrix);
+    // Antialiasing the edges shared by adjacent tiles would leave visible seams between them, so
+    // only the edges on the outline of the drawn image are antialiased.
+    auto aaEdges = GetOuterEdges(tileLocalBounds, drawBounds);
+    auto drawOp = RectDrawOp::Make(style.color.premultiply(), tileLocalBounds, state.matrix,
+                                   tileUVMatrix, aaEdges);
+    drawOp->addColorFP(std::move(processor));
+    addDrawOp(std::move(drawOp), tileLocalBounds, state, style);
+  }
+}
+
+static float GetMaxTextSize(const GlyphRunList* glyphRunList) {
+  float textSize = 0.0f;
+  for (auto& glyphRun : glyphRunList->glyphRuns()) {
+    Font font = {};
+    if (glyphRun.glyphFace->asFont(&font)) {
+      textSize = std::max(textSize, font.getSize());
+    }
+  }
+  return textSize;
+}
+
 void RenderContext::drawGlyphRunList(std::shared_ptr<GlyphRunList> glyphRunList,
                                      const Stroke* stroke, const MCState& state,
                                      const FillStyle& style) {
@@ -202,6 +374,19 @@ void RenderContext::drawGlyphRunList(std::shared_ptr<GlyphRunList> glyphRunList,
   if (maxScale <= 0.0f) {
     return;
   }
+  BytesKey contentKey = {};
+  // Text recreated on every draw is matched by its glyphs, so the distance field and the zoom
+  // detection carry over between frames. Text that can't be identified keeps using masks.
+  if (stroke == nullptr && glyphRunList->hasOutlines() &&
+      glyphRunList->computeContentKey(&contentKey)) {
+    auto proxyProvider = getContext()->proxyProvider();
+    auto textKey = proxyProvider->findOrCreateContentKey(contentKey);
+    auto zooming = proxyProvider->isZooming(textKey, maxScale);
+    if (zooming || GetMaxTextSize(glyphRunList.get()) * maxScale >= MIN_DISTANCE_FIELD_TEXT_SIZE) {
+      drawDistanceFieldGlyphs(std::move(glyphRunList), textKey, maxScale, state, style);
+      return;
+    }
+  }
   auto bounds = glyphRunList->getBounds(maxScale);
   if (stroke) {
     stroke->applyToBounds(&bounds);
@@ -230,6 +415,56 @@ void RenderContext::drawGlyphRunList(std::shared_ptr<GlyphRunList> glyphRunList,
   addDrawOp(std::move(drawOp), localBounds, state, style);
 }
 
+void RenderContext::drawDistanceFieldGlyphs(std::shared_ptr<GlyphRunList> glyphRunList,
+                                            const UniqueKey& textKey, float maxScale,
+                                            const MCState& state, const FillStyle& style) {
+  // Generate the distance field at a power-of-two scale, so it can be reused while the text is
+  // zoomed within an octave. The field is magnified by less than 2x in that range.
+  auto fieldScale = exp2f(floorf(log2f(maxScale)));
+  // Small text is zoomed into the distance field path too, and its field is kept large enough to
+  // resolve the glyph shapes, then minified.
+  auto textSize = GetMaxTextSize(glyphRunList.get());
+  if (textSize > 0.0f && textSize * fieldScale < MIN_DISTANCE_FIELD_GLYPH_SIZE) {
+    fieldScale = exp2f(ceilf(log2f(MIN_DISTANCE_FIELD_GLYPH_SIZE / textSize)));
+  }
+  auto bounds = glyphRunList->getBounds(fieldScale);
+  auto localBounds = clipLocalBounds(state, bounds);
+  if (localBounds.isEmpty()) {
+    return;
+  }
+  auto maxSide = std::max(bounds.width(), bounds.height()) * fieldScale;
+  if (maxSide > MAX_DISTANCE_FIELD_SIZE) {
+    fieldScale *= MAX_DISTANCE_FIELD_SIZE / maxSide;
+  }
+  auto fieldBounds = bounds;
+  fieldBounds.scale(fieldScale, fieldScale);
+  fieldBounds.outset(DistanceFieldRasterizer::Radius, DistanceFieldRasterizer::Radius);
+  fieldBounds.roundOut();
+  auto rasterizeMatrix = Matrix::MakeScale(fieldScale);
+  rasterizeMatrix.postTranslate(-fieldBounds.x(), -fieldBounds.y());
+  auto width = static_cast<int>(fieldBounds.width());
+  auto height = static_cast<int>(fieldBounds.height());
+  static const auto DistanceFieldType = UniqueID::Next();
+  BytesKey bytesKey(2);
+  bytesKey.write(DistanceFieldType);
+  bytesKey.write(fieldScale);
+  auto uniqueKey = UniqueKey::Append(textKey, bytesKey.data(), bytesKey.size());
+  auto rasterizer =
+      Rasterizer::MakeDistanceField(width, height, std::move(glyphRunList), rasterizeMatrix);
+  auto proxyProvider = getContext()->proxyProvider();
+  auto textureProxy = proxyProvider->createTextureProxy(uniqueKey, rasterizer, false, renderFlags);
+  auto textureEffect = TextureEffect::Make(std::move(textureProxy), {}, &rasterizeMatrix, true);
+  // Maps the sampled value to the distance from the edge in device pixels.
+  auto distanceScale = 2.0f * DistanceFieldRasterizer::Radius * maxScale / fieldScale;
+  auto processor = DistanceFieldEffect::Make(std::move(textureEffect), distanceScale);
+  if (processor == nullptr) {
+    return;
+  }
+  auto drawOp = RectDrawOp::Make(style.color.premultiply(), localBounds, state.matrix);
+  drawOp->addCoverageFP(std::move(processor));
+  addDrawOp(std::move(drawOp), localBounds, state, style);
+}
+
 void RenderContext::drawPicture(std::shared_ptr<Picture> picture, const MCState& state) {
   DEBUG_ASSERT(picture != nullptr);
   picture->playback(this, state);
@@ -24,6 +24,8 @@
 #include "gpu/ops/DrawOp.h"
 
 namespace tgfx {
+class TiledImage;
+
 class RenderContext : public DrawContext {
  public:
   RenderContext(std::shared_ptr<RenderTargetProxy> renderTargetProxy, uint32_t renderFlags);
@@ -76,8 +78,16 @@ class RenderContext : public DrawContext {
   Rect getClipBounds(const Path& clip);
   Rect clipLocalBounds(const MCState& state, const Rect& localBounds, bool unbounded = false);
   bool drawAsClear(const Rect& rect, const MCState& state, const FillStyle& style);
+  bool drawTessellatedPath(const std::shared_ptr<Shape>& shape, const Rect& localBounds,
+                           const MCState& state, const FillStyle& style);
+  void drawTiledImage(const TiledImage* image, const Rect& localBounds, const Matrix& uvMatrix,
+                      const SamplingOptions& sampling, const MCState& state,
+                      const FillStyle& style);
   void drawColorGlyphs(std::shared_ptr<GlyphRunList> glyphRunList, const MCState& state,
                        const FillStyle& style);
+  void drawDistanceFieldGlyphs(std::shared_ptr<GlyphRunList> glyphRunList,
+                               const UniqueKey& textKey, float maxScale, const MCState& state,
+                               const FillStyle& style);
   void addDrawOp(std::unique_ptr<DrawOp> op, const Rect& localBounds, const MCState& state,
                  const FillStyle& style);
   void addOp(std::unique_ptr<Op> op, const std::function<bool()>& willDiscardContent);
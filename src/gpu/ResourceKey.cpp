@@ -159,6 +159,13 @@ uint32_t UniqueKey::domainID() const {
   return uniqueDomain != nullptr ? uniqueDomain->uniqueID() : 0;
 }
 
+void UniqueKey::writeTo(BytesKey* bytesKey) const {
+  // Keys with appended data store their hash in front of the domain ID.
+  for (size_t i = count > 1 ? 1 : 0; i < count; i++) {
+    bytesKey->write(data[i]);
+  }
+}
+
 long UniqueKey::useCount() const {
   return uniqueDomain != nullptr ? uniqueDomain->useCount() : 0;
 }
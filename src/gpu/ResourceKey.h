@@ -174,6 +174,12 @@ class UniqueKey : public ResourceKey {
    */
   uint32_t domainID() const;
 
+  /**
+   * Writes the domain ID and the appended data of the key into the given BytesKey. Unlike copying
+   * the UniqueKey, this identifies the key without holding a reference to its domain.
+   */
+  void writeTo(BytesKey* bytesKey) const;
+
   /**
    * Returns the total number of times the domain has been referenced.
    */
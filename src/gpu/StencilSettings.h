@@ -0,0 +1,65 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cinttypes>
+
+namespace tgfx {
+/**
+ * The comparison a sample must pass against its stencil value, after both the reference value and
+ * the stencil value are masked by the test mask.
+ */
+enum class StencilTest {
+  Always,
+  Never,
+  Equal,
+  NotEqual,
+};
+
+/**
+ * The operation applied to the stencil value of a sample.
+ */
+enum class StencilOp {
+  Keep,
+  Zero,
+  Replace,
+  IncWrap,
+  DecWrap,
+  Invert,
+};
+
+struct StencilFace {
+  StencilTest test = StencilTest::Always;
+  StencilOp passOp = StencilOp::Keep;
+  StencilOp failOp = StencilOp::Keep;
+  uint32_t reference = 0;
+  uint32_t testMask = 0xFF;
+  uint32_t writeMask = 0xFF;
+};
+
+/**
+ * StencilSettings describes how a draw tests and updates the stencil buffer. Triangles facing
+ * front and back are configured separately, which lets a single draw accumulate the winding number
+ * of a path.
+ */
+struct StencilSettings {
+  StencilFace front = {};
+  StencilFace back = {};
+};
+}  // namespace tgfx
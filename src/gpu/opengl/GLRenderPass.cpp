@@ -95,6 +95,35 @@ static void UpdateBlend(Context* context, const BlendInfo* blendFactors) {
   }
 }
 
+static const unsigned gStencilTest[] = {GL_ALWAYS, GL_NEVER, GL_EQUAL, GL_NOTEQUAL};
+
+static const unsigned gStencilOp[] = {GL_KEEP,      GL_ZERO,      GL_REPLACE,
+                                      GL_INCR_WRAP, GL_DECR_WRAP, GL_INVERT};
+
+static void UpdateStencilFace(const GLFunctions* gl, unsigned face, const StencilFace& settings) {
+  gl->stencilFuncSeparate(face, gStencilTest[static_cast<int>(settings.test)],
+                          static_cast<int>(settings.reference), settings.testMask);
+  gl->stencilMaskSeparate(face, settings.writeMask);
+  auto failOp = gStencilOp[static_cast<int>(settings.failOp)];
+  gl->stencilOpSeparate(face, failOp, failOp, gStencilOp[static_cast<int>(settings.passOp)]);
+}
+
+static bool UpdateStencil(Context* context, GLRenderTarget* renderTarget,
+                          const StencilSettings* settings) {
+  auto gl = GLFunctions::Get(context);
+  if (settings == nullptr) {
+    gl->disable(GL_STENCIL_TEST);
+    return true;
+  }
+  if (!renderTarget->ensureStencilBuffer()) {
+    return false;
+  }
+  gl->enable(GL_STENCIL_TEST);
+  UpdateStencilFace(gl, GL_FRONT, settings->front);
+  UpdateStencilFace(gl, GL_BACK, settings->back);
+  return true;
+}
+
 bool GLRenderPass::onBindProgramAndScissorClip(const ProgramInfo* programInfo,
                                                const Rect& scissorRect) {
   _program = static_cast<GLProgram*>(context->programCache()->getProgram(programInfo));
@@ -105,6 +134,9 @@ bool GLRenderPass::onBindProgramAndScissorClip(const ProgramInfo* programInfo,
   CheckGLError(context);
   auto glRT = static_cast<GLRenderTarget*>(_renderTarget.get());
   auto* program = static_cast<GLProgram*>(_program);
+  if (!UpdateStencil(context, glRT, programInfo->stencilSettings())) {
+    return false;
+  }
   gl->useProgram(program->programID());
   gl->bindFramebuffer(GL_FRAMEBUFFER, glRT->getFrameBufferID());
   gl->viewport(0, 0, glRT->width(), glRT->height());
@@ -50,12 +50,11 @@ std::shared_ptr<RenderTarget> RenderTarget::MakeFrom(Context* context,
   return Resource::AddToCache(context, target);
 }
 
-static bool RenderbufferStorageMSAA(Context* context, int sampleCount, PixelFormat pixelFormat,
-                                    int width, int height) {
+static bool RenderbufferStorageMSAA(Context* context, int sampleCount, unsigned format, int width,
+                                    int height) {
   CheckGLError(context);
   auto gl = GLFunctions::Get(context);
   auto caps = GLCaps::Get(context);
-  auto format = caps->getTextureFormat(pixelFormat).sizedFormat;
   switch (caps->msFBOType) {
     case MSFBOType::Standard:
       gl->renderbufferStorageMultisample(GL_RENDERBUFFER, sampleCount, format, width, height);
@@ -123,8 +122,10 @@ static bool CreateRenderBuffer(const Texture* texture, GLFrameBuffer* renderTarg
     return false;
   }
   gl->bindRenderbuffer(GL_RENDERBUFFER, *msRenderBufferID);
-  if (!RenderbufferStorageMSAA(texture->getContext(), sampleCount, renderTargetFBInfo->format,
-                               texture->width(), texture->height())) {
+  auto caps = GLCaps::Get(texture->getContext());
+  auto format = caps->getTextureFormat(renderTargetFBInfo->format).sizedFormat;
+  if (!RenderbufferStorageMSAA(texture->getContext(), sampleCount, format, texture->width(),
+                               texture->height())) {
     return false;
   }
   gl->bindFramebuffer(GL_FRAMEBUFFER, renderTargetFBInfo->id);
@@ -282,6 +283,51 @@ bool GLRenderTarget::readPixels(const ImageInfo& dstInfo, void* dstPixels, int s
   return true;
 }
 
+bool GLRenderTarget::ensureStencilBuffer() {
+  if (stencilRenderBufferID > 0) {
+    return true;
+  }
+  if (externalResource) {
+    return false;
+  }
+  auto gl = GLFunctions::Get(context);
+  gl->genRenderbuffers(1, &stencilRenderBufferID);
+  if (stencilRenderBufferID == 0) {
+    return false;
+  }
+  gl->bindRenderbuffer(GL_RENDERBUFFER, stencilRenderBufferID);
+  auto success = true;
+  if (sampleCount() > 1) {
+    success = RenderbufferStorageMSAA(context, sampleCount(), GL_STENCIL_INDEX8, width(), height());
+  } else {
+    CheckGLError(context);
+    gl->renderbufferStorage(GL_RENDERBUFFER, GL_STENCIL_INDEX8, width(), height());
+    success = CheckGLError(context);
+  }
+  gl->bindRenderbuffer(GL_RENDERBUFFER, 0);
+  gl->bindFramebuffer(GL_FRAMEBUFFER, frameBufferForDraw.id);
+  if (success) {
+    gl->framebufferRenderbuffer(GL_FRAMEBUFFER, GL_STENCIL_ATTACHMENT, GL_RENDERBUFFER,
+                                stencilRenderBufferID);
+#ifndef TGFX_BUILD_FOR_WEB
+    success = gl->checkFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+#endif
+  }
+  if (!success) {
+    gl->framebufferRenderbuffer(GL_FRAMEBUFFER, GL_STENCIL_ATTACHMENT, GL_RENDERBUFFER, 0);
+    gl->deleteRenderbuffers(1, &stencilRenderBufferID);
+    stencilRenderBufferID = 0;
+    return false;
+  }
+  // Draws using the stencil buffer always reset the values they touch, so it only needs to be
+  // cleared once.
+  gl->disable(GL_SCISSOR_TEST);
+  gl->stencilMask(0xFF);
+  gl->clearStencil(0);
+  gl->clear(GL_STENCIL_BUFFER_BIT);
+  return true;
+}
+
 unsigned GLRenderTarget::getFrameBufferID(bool forDraw) const {
   return forDraw ? frameBufferForDraw.id : frameBufferForRead.id;
 }
@@ -290,6 +336,14 @@ void GLRenderTarget::onReleaseGPU() {
   if (externalResource) {
     return;
   }
+  if (stencilRenderBufferID > 0) {
+    auto gl = GLFunctions::Get(context);
+    gl->bindFramebuffer(GL_FRAMEBUFFER, frameBufferForDraw.id);
+    gl->framebufferRenderbuffer(GL_FRAMEBUFFER, GL_STENCIL_ATTACHMENT, GL_RENDERBUFFER, 0);
+    gl->bindFramebuffer(GL_FRAMEBUFFER, 0);
+    gl->deleteRenderbuffers(1, &stencilRenderBufferID);
+    stencilRenderBufferID = 0;
+  }
   if (textureTarget != 0) {
     auto gl = GLFunctions::Get(context);
     gl->bindFramebuffer(GL_FRAMEBUFFER, frameBufferForRead.id);
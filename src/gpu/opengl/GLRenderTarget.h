@@ -40,6 +40,13 @@ class GLRenderTarget : public RenderTarget {
 
   BackendRenderTarget getBackendRenderTarget() const override;
 
+  /**
+   * Attaches a cleared stencil buffer to the frame buffer for drawing if it doesn't have one yet.
+   * Returns false if the render target wraps an external frame buffer or the stencil buffer can't
+   * be created.
+   */
+  bool ensureStencilBuffer();
+
   bool readPixels(const ImageInfo& dstInfo, void* dstPixels, int srcX = 0,
                   int srcY = 0) const override;
 
@@ -50,6 +57,7 @@ class GLRenderTarget : public RenderTarget {
   GLFrameBuffer frameBufferForRead = {};
   GLFrameBuffer frameBufferForDraw = {};
   unsigned msRenderBufferID = 0;
+  unsigned stencilRenderBufferID = 0;
   unsigned textureTarget = 0;
   bool externalResource = false;
 
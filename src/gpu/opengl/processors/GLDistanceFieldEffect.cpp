@@ -0,0 +1,52 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "GLDistanceFieldEffect.h"
+
+namespace tgfx {
+std::unique_ptr<FragmentProcessor> DistanceFieldEffect::Make(
+    std::unique_ptr<FragmentProcessor> textureEffect, float distanceScale) {
+  if (textureEffect == nullptr || distanceScale <= 0.0f) {
+    return nullptr;
+  }
+  return std::unique_ptr<FragmentProcessor>(
+      new GLDistanceFieldEffect(std::move(textureEffect), distanceScale));
+}
+
+GLDistanceFieldEffect::GLDistanceFieldEffect(std::unique_ptr<FragmentProcessor> textureEffect,
+                                             float distanceScale)
+    : DistanceFieldEffect(std::move(textureEffect), distanceScale) {
+}
+
+void GLDistanceFieldEffect::emitCode(EmitArgs& args) const {
+  auto* fragBuilder = args.fragBuilder;
+  auto distanceScaleName =
+      args.uniformHandler->addUniform(ShaderFlags::Fragment, SLType::Float, "DistanceScale");
+  std::string distanceColor = "distanceColor";
+  emitChild(0, &distanceColor, args);
+  fragBuilder->codeAppendf("float signedDistance = (%s.a - 0.5) * %s;", distanceColor.c_str(),
+                           distanceScaleName.c_str());
+  fragBuilder->codeAppend("float coverage = clamp(signedDistance + 0.5, 0.0, 1.0);");
+  fragBuilder->codeAppendf("%s = %s * coverage;", args.outputColor.c_str(),
+                           args.inputColor.c_str());
+}
+
+void GLDistanceFieldEffect::onSetData(UniformBuffer* uniformBuffer) const {
+  uniformBuffer->setData("DistanceScale", distanceScale);
+}
+}  // namespace tgfx
@@ -0,0 +1,75 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "GLStrokeGeometryProcessor.h"
+
+namespace tgfx {
+std::unique_ptr<StrokeGeometryProcessor> StrokeGeometryProcessor::Make(int width, int height,
+                                                                       AAType aa,
+                                                                       const Matrix& uvMatrix) {
+  return std::unique_ptr<StrokeGeometryProcessor>(
+      new GLStrokeGeometryProcessor(width, height, aa, uvMatrix));
+}
+
+GLStrokeGeometryProcessor::GLStrokeGeometryProcessor(int width, int height, AAType aa,
+                                                     const Matrix& uvMatrix)
+    : StrokeGeometryProcessor(width, height, aa, uvMatrix) {
+}
+
+void GLStrokeGeometryProcessor::emitCode(EmitArgs& args) const {
+  auto* vertBuilder = args.vertBuilder;
+  auto* fragBuilder = args.fragBuilder;
+  auto* varyingHandler = args.varyingHandler;
+  auto* uniformHandler = args.uniformHandler;
+
+  varyingHandler->emitAttributes(*this);
+
+  auto edges = varyingHandler->addVarying("Edges", SLType::Float4);
+  vertBuilder->codeAppendf("%s = %s;", edges.vsOut().c_str(), inEdges.name().c_str());
+  auto circle = varyingHandler->addVarying("Circle", SLType::Float4);
+  vertBuilder->codeAppendf("%s = %s;", circle.vsOut().c_str(), inCircle.name().c_str());
+
+  auto color = varyingHandler->addVarying("Color", SLType::Float4);
+  vertBuilder->codeAppendf("%s = %s;", color.vsOut().c_str(), inColor.name().c_str());
+  fragBuilder->codeAppendf("%s = %s;", args.outputColor.c_str(), color.fsIn().c_str());
+
+  // The vertices are already in device space, and the uvMatrix maps them back to local space.
+  args.vertBuilder->emitNormalizedPosition(inPosition.name());
+  emitTransforms(vertBuilder, varyingHandler, uniformHandler, inPosition.asShaderVar(),
+                 args.fpCoordTransformHandler);
+
+  // The edge distances are linear, so they interpolate exactly across the primitives. Unused
+  // edges and circles carry a large distance that never wins the min().
+  fragBuilder->codeAppendf("vec4 edges = %s;", edges.fsIn().c_str());
+  fragBuilder->codeAppendf("vec4 circle = %s;", circle.fsIn().c_str());
+  fragBuilder->codeAppend("float distance = min(min(edges.x, edges.y), min(edges.z, edges.w));");
+  fragBuilder->codeAppend("distance = min(distance, circle.z - length(circle.xy));");
+  if (aa == AAType::None) {
+    fragBuilder->codeAppend("float edgeAlpha = step(0.0, distance);");
+  } else {
+    fragBuilder->codeAppend("float edgeAlpha = clamp(distance + 0.5, 0.0, 1.0);");
+  }
+  // The w component scales the coverage of strokes thinner than one pixel.
+  fragBuilder->codeAppendf("%s = vec4(edgeAlpha * circle.w);", args.outputCoverage.c_str());
+}
+
+void GLStrokeGeometryProcessor::setData(UniformBuffer* uniformBuffer,
+                                        FPCoordTransformIter* transformIter) const {
+  setTransformDataHelper(uvMatrix, uniformBuffer, transformIter);
+}
+}  // namespace tgfx
@@ -0,0 +1,73 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "GLTessellatedPathGeometryProcessor.h"
+
+namespace tgfx {
+std::unique_ptr<TessellatedPathGeometryProcessor> TessellatedPathGeometryProcessor::Make(
+    Color color, int width, int height, const Matrix& viewMatrix, const Matrix& uvMatrix) {
+  return std::unique_ptr<TessellatedPathGeometryProcessor>(
+      new GLTessellatedPathGeometryProcessor(color, width, height, viewMatrix, uvMatrix));
+}
+
+GLTessellatedPathGeometryProcessor::GLTessellatedPathGeometryProcessor(Color color, int width,
+                                                                       int height,
+                                                                       const Matrix& viewMatrix,
+                                                                       const Matrix& uvMatrix)
+    : TessellatedPathGeometryProcessor(color, width, height, viewMatrix, uvMatrix) {
+}
+
+void GLTessellatedPathGeometryProcessor::emitCode(EmitArgs& args) const {
+  auto* vertBuilder = args.vertBuilder;
+  auto* fragBuilder = args.fragBuilder;
+  auto* varyingHandler = args.varyingHandler;
+  auto* uniformHandler = args.uniformHandler;
+
+  varyingHandler->emitAttributes(*this);
+
+  // Evaluates the cubic curve in Bernstein form. The end points are reproduced exactly at t = 0
+  // and t = 1, which keeps the curve fans and the inner polygon of the path watertight.
+  vertBuilder->codeAppendf("float t = %s;", inParameter.name().c_str());
+  vertBuilder->codeAppend("float s = 1.0 - t;");
+  vertBuilder->codeAppendf("vec2 localPosition = (s * s * s) * %s.xy + (3.0 * s * s * t) * %s.zw"
+                           " + (3.0 * s * t * t) * %s.xy + (t * t * t) * %s.zw;",
+                           inCurveStart.name().c_str(), inCurveStart.name().c_str(),
+                           inCurveEnd.name().c_str(), inCurveEnd.name().c_str());
+  auto matrixName = uniformHandler->addUniform(ShaderFlags::Vertex, SLType::Float3x3, "Matrix");
+  std::string positionName = "position";
+  vertBuilder->codeAppendf("vec2 %s = (%s * vec3(localPosition, 1.0)).xy;", positionName.c_str(),
+                           matrixName.c_str());
+
+  emitTransforms(vertBuilder, varyingHandler, uniformHandler,
+                 ShaderVar("localPosition", SLType::Float2), args.fpCoordTransformHandler);
+
+  // The edges are antialiased by multisampling, if at all.
+  fragBuilder->codeAppendf("%s = vec4(1.0);", args.outputCoverage.c_str());
+  auto colorName = uniformHandler->addUniform(ShaderFlags::Fragment, SLType::Float4, "Color");
+  fragBuilder->codeAppendf("%s = %s;", args.outputColor.c_str(), colorName.c_str());
+
+  args.vertBuilder->emitNormalizedPosition(positionName);
+}
+
+void GLTessellatedPathGeometryProcessor::setData(UniformBuffer* uniformBuffer,
+                                                 FPCoordTransformIter* transformIter) const {
+  setTransformDataHelper(uvMatrix, uniformBuffer, transformIter);
+  uniformBuffer->setData("Color", color);
+  uniformBuffer->setData("Matrix", viewMatrix);
+}
+}  // namespace tgfx
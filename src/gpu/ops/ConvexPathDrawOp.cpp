@@ -0,0 +1,340 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "ConvexPathDrawOp.h"
+#include <algorithm>
+#include <cmath>
+#include "core/shapes/MatrixShape.h"
+#include "core/utils/MathExtra.h"
+#include "gpu/Gpu.h"
+#include "gpu/processors/StrokeGeometryProcessor.h"
+
+namespace tgfx {
+// The distance carried by the edge and circle slots that don't clip a triangle.
+static constexpr float NoEdge = 1.0e4f;
+// The maximum distance in device pixels between a curve and the line segments approximating it.
+static constexpr float FlattenTolerance = 0.25f;
+static constexpr int MaxFlattenSegments = 1024;
+// Paths with more verbs than this are left to the general path renderers.
+static constexpr int MaxConvexVerbCount = 256;
+// Points closer than this in device pixels are merged when building the polygon.
+static constexpr float PointTolerance = 1.0e-3f;
+// Limits how far the antialiasing fringe extends at sharp corners, in multiples of its width.
+static constexpr float MaxMiterLength = 4.0f;
+// Position, color, edges and circle, matching the layout of StrokeGeometryProcessor.
+static constexpr size_t FloatsPerVertex = 14;
+
+class ConvexPaint {
+ public:
+  ConvexPaint(Color color, std::vector<Point> polygon)
+      : color(color), polygon(std::move(polygon)) {
+  }
+
+  Color color;
+  // The convex polygon in device space, wound clockwise on the screen.
+  std::vector<Point> polygon;
+};
+
+static float Cross(const Point& a, const Point& b) {
+  return a.x * b.y - a.y * b.x;
+}
+
+static float Dot(const Point& a, const Point& b) {
+  return a.x * b.x + a.y * b.y;
+}
+
+static int SegmentCount(float deviation) {
+  auto count = static_cast<int>(ceilf(sqrtf(deviation / FlattenTolerance)));
+  return std::clamp(count, 1, MaxFlattenSegments);
+}
+
+class PolygonBuilder {
+ public:
+  explicit PolygonBuilder(std::vector<Point>* points) : points(points) {
+  }
+
+  bool failed = false;
+
+  void moveTo(const Point& point) {
+    if (!points->empty()) {
+      // A second contour is only allowed if it is a lone moveTo() at the end.
+      pendingMove = true;
+      return;
+    }
+    addPoint(point);
+  }
+
+  void lineTo(const Point& point) {
+    addSegmentPoint(point);
+  }
+
+  void quadTo(const Point points[3]) {
+    auto count = SegmentCount((points[0] - points[1] * 2.0f + points[2]).length() * 0.25f);
+    for (int i = 1; i <= count; i++) {
+      auto t = static_cast<float>(i) / static_cast<float>(count);
+      auto mt = 1.0f - t;
+      addSegmentPoint(points[0] * (mt * mt) + points[1] * (2.0f * t * mt) + points[2] * (t * t));
+    }
+  }
+
+  void cubicTo(const Point points[4]) {
+    auto deviation = std::max((points[0] - points[1] * 2.0f + points[2]).length(),
+                              (points[1] - points[2] * 2.0f + points[3]).length());
+    auto count = SegmentCount(deviation * 0.75f);
+    for (int i = 1; i <= count; i++) {
+      auto t = static_cast<float>(i) / static_cast<float>(count);
+      auto mt = 1.0f - t;
+      addSegmentPoint(points[0] * (mt * mt * mt) + points[1] * (3.0f * t * mt * mt) +
+                      points[2] * (3.0f * t * t * mt) + points[3] * (t * t * t));
+    }
+  }
+
+ private:
+  std::vector<Point>* points = nullptr;
+  bool pendingMove = false;
+
+  void addSegmentPoint(const Point& point) {
+    if (pendingMove) {
+      failed = true;
+      return;
+    }
+    addPoint(point);
+  }
+
+  void addPoint(const Point& point) {
+    if (!points->empty() && (point - points->back()).length() < PointTolerance) {
+      return;
+    }
+    points->push_back(point);
+  }
+};
+
+/**
+ * Removes the collinear points of the polygon and checks that it turns in one direction exactly
+ * once. Reverses the polygon if needed so that it winds clockwise on the screen. Returns false if
+ * the polygon is not convex or has no area.
+ */
+static bool MakeConvexPolygon(std::vector<Point>* polygon) {
+  auto& points = *polygon;
+  if (points.size() > 1 && (points.back() - points.front()).length() < PointTolerance) {
+    points.pop_back();
+  }
+  std::vector<Point> corners = {};
+  auto count = points.size();
+  for (size_t i = 0; i < count; i++) {
+    auto& prev = points[(i + count - 1) % count];
+    auto& next = points[(i + 1) % count];
+    if (!FloatNearlyZero(Cross(points[i] - prev, next - points[i]))) {
+      corners.push_back(points[i]);
+    }
+  }
+  count = corners.size();
+  if (count < 3) {
+    return false;
+  }
+  float direction = 0.0f;
+  float totalTurn = 0.0f;
+  for (size_t i = 0; i < count; i++) {
+    auto edge = corners[(i + 1) % count] - corners[i];
+    auto nextEdge = corners[(i + 2) % count] - corners[(i + 1) % count];
+    auto cross = Cross(edge, nextEdge);
+    if (direction == 0.0f) {
+      direction = cross > 0 ? 1.0f : -1.0f;
+    } else if (cross * direction < 0) {
+      return false;
+    }
+    totalTurn += atan2f(cross, Dot(edge, nextEdge));
+  }
+  // A star turns in one direction too, but more than once.
+  if (fabsf(totalTurn) > static_cast<float>(M_PI) * 3.0f) {
+    return false;
+  }
+  if (direction < 0) {
+    std::reverse(corners.begin(), corners.end());
+  }
+  points = std::move(corners);
+  return true;
+}
+
+class ConvexVerticesProvider : public DataProvider {
+ public:
+  ConvexVerticesProvider(std::vector<std::shared_ptr<ConvexPaint>> convexPaints, AAType aaType)
+      : convexPaints(std::move(convexPaints)), aaType(aaType) {
+  }
+
+  std::shared_ptr<Data> getData() const override {
+    float bloat = 0.0f;
+    if (aaType == AAType::Coverage) {
+      bloat = 0.5f;
+    } else if (aaType == AAType::MSAA) {
+      bloat = FLOAT_SQRT2;
+    }
+    std::vector<float> vertices = {};
+    for (auto& convexPaint : convexPaints) {
+      writePolygon(&vertices, *convexPaint, bloat);
+    }
+    if (vertices.empty()) {
+      return nullptr;
+    }
+    return Data::MakeWithCopy(vertices.data(), vertices.size() * sizeof(float));
+  }
+
+ private:
+  std::vector<std::shared_ptr<ConvexPaint>> convexPaints = {};
+  AAType aaType = AAType::None;
+
+  static void writePolygon(std::vector<float>* vertices, const ConvexPaint& convexPaint,
+                           float bloat) {
+    auto& points = convexPaint.polygon;
+    auto count = points.size();
+    // The polygon winds clockwise on the screen, where the y-axis points down, so the outward
+    // normal of each edge points to its left.
+    std::vector<Point> normals(count);
+    auto centroid = Point::Zero();
+    for (size_t i = 0; i < count; i++) {
+      auto edge = points[(i + 1) % count] - points[i];
+      auto length = edge.length();
+      normals[i] = Point::Make(edge.y / length, -edge.x / length);
+      centroid += points[i];
+    }
+    centroid *= 1.0f / static_cast<float>(count);
+    std::vector<Point> outsetPoints(count);
+    for (size_t i = 0; i < count; i++) {
+      auto& prevNormal = normals[(i + count - 1) % count];
+      auto miter = (prevNormal + normals[i]) * (1.0f / (1.0f + Dot(prevNormal, normals[i])));
+      auto length = miter.length();
+      if (length > MaxMiterLength) {
+        miter *= MaxMiterLength / length;
+      }
+      outsetPoints[i] = points[i] + miter * bloat;
+    }
+    auto& color = convexPaint.color;
+    for (size_t i = 0; i < count; i++) {
+      // The edge of the triangle and the edges around it, which are the only ones that can be
+      // within a pixel of it, unless the polygon is tiny.
+      size_t edges[4] = {i, (i + count - 1) % count, (i + 1) % count, (i + 2) % count};
+      for (auto& point : {centroid, outsetPoints[i], outsetPoints[(i + 1) % count]}) {
+        vertices->insert(vertices->end(), {point.x, point.y, color.red, color.green, color.blue,
+                                           color.alpha});
+        for (auto edge : edges) {
+          vertices->push_back(Dot(points[edge] - point, normals[edge]));
+        }
+        vertices->insert(vertices->end(), {0.0f, 0.0f, NoEdge, 1.0f});
+      }
+    }
+  }
+};
+
+std::unique_ptr<ConvexPathDrawOp> ConvexPathDrawOp::Make(Color color,
+                                                         const std::shared_ptr<Shape>& shape,
+                                                         const Matrix& viewMatrix) {
+  if (shape == nullptr || shape->isInverseFillType()) {
+    return nullptr;
+  }
+  auto matrix = viewMatrix;
+  auto target = shape;
+  if (target->type() == Shape::Type::Matrix) {
+    auto matrixShape = std::static_pointer_cast<MatrixShape>(target);
+    matrix.preConcat(matrixShape->matrix);
+    target = matrixShape->shape;
+  }
+  Path path = {};
+  if (!target->isSimplePath(&path) || path.countVerbs() > MaxConvexVerbCount) {
+    return nullptr;
+  }
+  Matrix uvMatrix = Matrix::I();
+  if (!viewMatrix.invert(&uvMatrix)) {
+    return nullptr;
+  }
+  path.transform(matrix);
+  std::vector<Point> polygon = {};
+  PolygonBuilder builder(&polygon);
+  auto iterator = [&](PathVerb verb, const Point points[4], void*) {
+    switch (verb) {
+      case PathVerb::Move:
+        builder.moveTo(points[0]);
+        break;
+      case PathVerb::Line:
+        builder.lineTo(points[1]);
+        break;
+      case PathVerb::Quad:
+        builder.quadTo(points);
+        break;
+      case PathVerb::Cubic:
+        builder.cubicTo(points);
+        break;
+      case PathVerb::Close:
+        break;
+    }
+  };
+  path.decompose(iterator);
+  if (builder.failed || !MakeConvexPolygon(&polygon)) {
+    return nullptr;
+  }
+  auto bounds = Rect::MakeEmpty();
+  bounds.setBounds(polygon.data(), static_cast<int>(polygon.size()));
+  // Leaves room for the antialiasing fringe.
+  bounds.outset(FLOAT_SQRT2 * MaxMiterLength, FLOAT_SQRT2 * MaxMiterLength);
+  auto convexPaint = std::make_shared<ConvexPaint>(color, std::move(polygon));
+  return std::unique_ptr<ConvexPathDrawOp>(
+      new ConvexPathDrawOp(std::move(convexPaint), uvMatrix, bounds));
+}
+
+ConvexPathDrawOp::ConvexPathDrawOp(std::shared_ptr<ConvexPaint> convexPaint,
+                                   const Matrix& uvMatrix, const Rect& bounds)
+    : DrawOp(ClassID()), uvMatrix(uvMatrix) {
+  convexPaints.push_back(std::move(convexPaint));
+  setBounds(bounds);
+}
+
+bool ConvexPathDrawOp::onCombineIfPossible(Op* op) {
+  if (!DrawOp::onCombineIfPossible(op)) {
+    return false;
+  }
+  auto* that = static_cast<ConvexPathDrawOp*>(op);
+  if (uvMatrix != that->uvMatrix) {
+    return false;
+  }
+  convexPaints.insert(convexPaints.end(), that->convexPaints.begin(), that->convexPaints.end());
+  return true;
+}
+
+void ConvexPathDrawOp::prepare(Context* context, uint32_t renderFlags) {
+  auto vertexProvider = std::make_shared<ConvexVerticesProvider>(convexPaints, aa);
+  vertexBufferProxy = GpuBufferProxy::MakeFrom(context, std::move(vertexProvider),
+                                               BufferType::Vertex, renderFlags);
+}
+
+void ConvexPathDrawOp::execute(RenderPass* renderPass) {
+  if (vertexBufferProxy == nullptr) {
+    return;
+  }
+  auto vertexBuffer = vertexBufferProxy->getBuffer();
+  if (vertexBuffer == nullptr) {
+    return;
+  }
+  auto pipeline = createPipeline(
+      renderPass, StrokeGeometryProcessor::Make(renderPass->renderTarget()->width(),
+                                                renderPass->renderTarget()->height(), aa,
+                                                uvMatrix));
+  renderPass->bindProgramAndScissorClip(pipeline.get(), scissorRect());
+  renderPass->bindBuffers(nullptr, vertexBuffer);
+  auto vertexCount = vertexBuffer->size() / (FloatsPerVertex * sizeof(float));
+  renderPass->draw(PrimitiveType::Triangles, 0, vertexCount);
+}
+}  // namespace tgfx
@@ -0,0 +1,58 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "DrawOp.h"
+#include "tgfx/core/Shape.h"
+
+namespace tgfx {
+class ConvexPaint;
+
+/**
+ * ConvexPathDrawOp fills convex paths, such as polygons and pie slices, with a fan of triangles
+ * around their centroid. The fan is outset by the antialiasing fringe, and the fragment shader
+ * computes the coverage from the distances to the nearby edges. Curves are flattened on the CPU
+ * first. Unlike ShapeDrawOp, consecutive convex paths are batched into a single draw.
+ */
+class ConvexPathDrawOp : public DrawOp {
+ public:
+  DEFINE_OP_CLASS_ID
+
+  /**
+   * Creates a ConvexPathDrawOp if the shape is a filled path with a single convex contour. Returns
+   * nullptr otherwise.
+   */
+  static std::unique_ptr<ConvexPathDrawOp> Make(Color color, const std::shared_ptr<Shape>& shape,
+                                                const Matrix& viewMatrix);
+
+  void prepare(Context* context, uint32_t renderFlags) override;
+
+  void execute(RenderPass* renderPass) override;
+
+ private:
+  ConvexPathDrawOp(std::shared_ptr<ConvexPaint> convexPaint, const Matrix& uvMatrix,
+                   const Rect& bounds);
+
+  bool onCombineIfPossible(Op* op) override;
+
+  std::vector<std::shared_ptr<ConvexPaint>> convexPaints = {};
+  Matrix uvMatrix = Matrix::I();
+  std::shared_ptr<GpuBufferProxy> vertexBufferProxy = nullptr;
+};
+}  // namespace tgfx
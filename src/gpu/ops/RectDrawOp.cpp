@@ -28,17 +28,35 @@ namespace tgfx {
 class RectPaint {
  public:
   RectPaint(std::optional<Color> color, const Rect& rect, const Matrix& viewMatrix,
-            const Matrix& uvMatrix)
+            const Matrix& uvMatrix, uint32_t aaEdges)
       : color(color.value_or(Color::White())), rect(rect), viewMatrix(viewMatrix),
-        uvMatrix(uvMatrix) {
+        uvMatrix(uvMatrix), aaEdges(aaEdges) {
   }
 
   Color color;
   Rect rect;
   Matrix viewMatrix;
   Matrix uvMatrix;
+  uint32_t aaEdges;
 };
 
+static Rect OutsetEdges(const Rect& rect, float padding, uint32_t edges) {
+  auto result = rect;
+  if (edges & RectDrawOp::LeftEdge) {
+    result.left -= padding;
+  }
+  if (edges & RectDrawOp::TopEdge) {
+    result.top -= padding;
+  }
+  if (edges & RectDrawOp::RightEdge) {
+    result.right += padding;
+  }
+  if (edges & RectDrawOp::BottomEdge) {
+    result.bottom += padding;
+  }
+  return result;
+}
+
 class RectCoverageVerticesProvider : public DataProvider {
  public:
   RectCoverageVerticesProvider(std::vector<std::shared_ptr<RectPaint>> rectPaints, bool hasColor)
@@ -56,11 +74,12 @@ class RectCoverageVerticesProvider : public DataProvider {
       auto& uvMatrix = rectPaint->uvMatrix;
       auto scale = sqrtf(viewMatrix.getScaleX() * viewMatrix.getScaleX() +
                          viewMatrix.getSkewY() * viewMatrix.getSkewY());
-      // we want the new edge to be .5px away from the old line.
+      // we want the new edge to be .5px away from the old line. Edges without antialiasing keep
+      // both quads on the old line, so they have full coverage up to it.
       auto padding = 0.5f / scale;
-      auto insetBounds = rect.makeInset(padding, padding);
+      auto insetBounds = OutsetEdges(rect, -padding, rectPaint->aaEdges);
       auto insetQuad = Quad::MakeFrom(insetBounds, &viewMatrix);
-      auto outsetBounds = rect.makeOutset(padding, padding);
+      auto outsetBounds = OutsetEdges(rect, padding, rectPaint->aaEdges);
       auto outsetQuad = Quad::MakeFrom(outsetBounds, &viewMatrix);
 
       auto normalInsetQuad = Quad::MakeFrom(insetBounds, &uvMatrix);
@@ -134,14 +153,15 @@ class RectNonCoverageVerticesProvider : public DataProvider {
 };
 
 std::unique_ptr<RectDrawOp> RectDrawOp::Make(std::optional<Color> color, const Rect& rect,
-                                             const Matrix& viewMatrix, const Matrix& uvMatrix) {
-  return std::unique_ptr<RectDrawOp>(new RectDrawOp(color, rect, viewMatrix, uvMatrix));
+                                             const Matrix& viewMatrix, const Matrix& uvMatrix,
+                                             uint32_t aaEdges) {
+  return std::unique_ptr<RectDrawOp>(new RectDrawOp(color, rect, viewMatrix, uvMatrix, aaEdges));
 }
 
 RectDrawOp::RectDrawOp(std::optional<Color> color, const Rect& rect, const Matrix& viewMatrix,
-                       const Matrix& uvMatrix)
+                       const Matrix& uvMatrix, uint32_t aaEdges)
     : DrawOp(ClassID()), hasColor(color) {
-  auto rectPaint = std::make_shared<RectPaint>(color, rect, viewMatrix, uvMatrix);
+  auto rectPaint = std::make_shared<RectPaint>(color, rect, viewMatrix, uvMatrix, aaEdges);
   rectPaints.push_back(std::move(rectPaint));
   auto bounds = viewMatrix.mapRect(rect);
   setBounds(bounds);
@@ -28,9 +28,20 @@ class RectDrawOp : public DrawOp {
  public:
   DEFINE_OP_CLASS_ID
 
+  /**
+   * Flags of the rect edges that get antialiased under coverage antialiasing. The other edges are
+   * drawn hard, which keeps rects that share those edges seamless.
+   */
+  static constexpr uint32_t LeftEdge = 1 << 0;
+  static constexpr uint32_t TopEdge = 1 << 1;
+  static constexpr uint32_t RightEdge = 1 << 2;
+  static constexpr uint32_t BottomEdge = 1 << 3;
+  static constexpr uint32_t AllEdges = LeftEdge | TopEdge | RightEdge | BottomEdge;
+
   static std::unique_ptr<RectDrawOp> Make(std::optional<Color> color, const Rect& rect,
                                           const Matrix& viewMatrix,
-                                          const Matrix& uvMatrix = Matrix::I());
+                                          const Matrix& uvMatrix = Matrix::I(),
+                                          uint32_t aaEdges = AllEdges);
 
   void prepare(Context* context, uint32_t renderFlags) override;
 
@@ -38,7 +49,7 @@ class RectDrawOp : public DrawOp {
 
  private:
   RectDrawOp(std::optional<Color> color, const Rect& rect, const Matrix& viewMatrix,
-             const Matrix& uvMatrix);
+             const Matrix& uvMatrix, uint32_t aaEdges);
 
   bool onCombineIfPossible(Op* op) override;
 
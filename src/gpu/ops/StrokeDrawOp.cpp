@@ -0,0 +1,592 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "StrokeDrawOp.h"
+#include <algorithm>
+#include <cmath>
+#include "core/shapes/MatrixShape.h"
+#include "core/shapes/StrokeShape.h"
+#include "core/utils/MathExtra.h"
+#include "gpu/Gpu.h"
+#include "gpu/processors/StrokeGeometryProcessor.h"
+
+namespace tgfx {
+// The distance carried by the edges and circles that don't clip a primitive. It is large enough to
+// never win the min() in the shader, and small enough to interpolate without losing precision.
+static constexpr float NoEdge = 1.0e4f;
+// The maximum distance in device pixels between a curve and the line segments approximating it.
+static constexpr float FlattenTolerance = 0.25f;
+static constexpr int MaxFlattenSegments = 1024;
+// Points closer than this in device pixels are merged when building the polylines.
+static constexpr float PointTolerance = 1.0e-3f;
+// Position, color, edges and circle.
+static constexpr size_t FloatsPerVertex = 14;
+
+class StrokePaint {
+ public:
+  StrokePaint(Color color, std::shared_ptr<Shape> shape, const Stroke& stroke,
+              const Matrix& viewMatrix)
+      : color(color), shape(std::move(shape)), stroke(stroke), viewMatrix(viewMatrix) {
+  }
+
+  Color color;
+  std::shared_ptr<Shape> shape;
+  Stroke stroke;
+  Matrix viewMatrix;
+};
+
+/**
+ * A polyline in device space. The smooth flags mark the points inside flattened curves, where the
+ * joins only need to hide the tiny gaps between the segments.
+ */
+struct StrokeContour {
+  std::vector<Point> points = {};
+  std::vector<bool> smooth = {};
+  bool closed = false;
+  bool hasSegments = false;
+};
+
+static Point Normalize(const Point& vector) {
+  auto length = vector.length();
+  return length > 0 ? vector * (1.0f / length) : Point::Zero();
+}
+
+static float Dot(const Point& a, const Point& b) {
+  return a.x * b.x + a.y * b.y;
+}
+
+static float Cross(const Point& a, const Point& b) {
+  return a.x * b.y - a.y * b.x;
+}
+
+static int QuadSegmentCount(const Point points[3]) {
+  auto deviation = (points[0] - points[1] * 2.0f + points[2]).length();
+  auto count = static_cast<int>(ceilf(sqrtf(deviation / (4.0f * FlattenTolerance))));
+  return std::clamp(count, 1, MaxFlattenSegments);
+}
+
+static int CubicSegmentCount(const Point points[4]) {
+  auto deviation = std::max((points[0] - points[1] * 2.0f + points[2]).length(),
+                            (points[1] - points[2] * 2.0f + points[3]).length());
+  auto count = static_cast<int>(ceilf(sqrtf(3.0f * deviation / (4.0f * FlattenTolerance))));
+  return std::clamp(count, 1, MaxFlattenSegments);
+}
+
+class ContourBuilder {
+ public:
+  explicit ContourBuilder(std::vector<StrokeContour>* contours) : contours(contours) {
+  }
+
+  void moveTo(const Point& point) {
+    finishContour();
+    startPoint = point;
+    addPoint(point, false);
+  }
+
+  void lineTo(const Point& point) {
+    ensureContour();
+    current.hasSegments = true;
+    addPoint(point, false);
+  }
+
+  void quadTo(const Point points[3]) {
+    ensureContour();
+    current.hasSegments = true;
+    auto count = QuadSegmentCount(points);
+    for (int i = 1; i <= count; i++) {
+      auto t = static_cast<float>(i) / static_cast<float>(count);
+      auto mt = 1.0f - t;
+      auto point = points[0] * (mt * mt) + points[1] * (2.0f * t * mt) + points[2] * (t * t);
+      addPoint(point, i < count);
+    }
+  }
+
+  void cubicTo(const Point points[4]) {
+    ensureContour();
+    current.hasSegments = true;
+    auto count = CubicSegmentCount(points);
+    for (int i = 1; i <= count; i++) {
+      auto t = static_cast<float>(i) / static_cast<float>(count);
+      auto mt = 1.0f - t;
+      auto point = points[0] * (mt * mt * mt) + points[1] * (3.0f * t * mt * mt) +
+                   points[2] * (3.0f * t * t * mt) + points[3] * (t * t * t);
+      addPoint(point, i < count);
+    }
+  }
+
+  void close() {
+    current.closed = true;
+    finishContour();
+  }
+
+  void finishContour() {
+    if (current.closed && current.points.size() > 1 &&
+        (current.points.back() - current.points.front()).length() < PointTolerance) {
+      current.points.pop_back();
+      current.smooth.pop_back();
+    }
+    if (current.hasSegments && !current.points.empty()) {
+      contours->push_back(std::move(current));
+    }
+    current = {};
+  }
+
+ private:
+  std::vector<StrokeContour>* contours = nullptr;
+  StrokeContour current = {};
+  Point startPoint = Point::Zero();
+
+  void ensureContour() {
+    // A contour that follows close() without a moveTo() starts from the last moveTo() point.
+    if (current.points.empty()) {
+      addPoint(startPoint, false);
+    }
+  }
+
+  void addPoint(const Point& point, bool smooth) {
+    if (!current.points.empty() && (point - current.points.back()).length() < PointTolerance) {
+      return;
+    }
+    current.points.push_back(point);
+    current.smooth.push_back(smooth);
+  }
+};
+
+static std::vector<StrokeContour> FlattenPath(const Path& path) {
+  std::vector<StrokeContour> contours = {};
+  ContourBuilder builder(&contours);
+  auto iterator = [&](PathVerb verb, const Point points[4], void*) {
+    switch (verb) {
+      case PathVerb::Move:
+        builder.moveTo(points[0]);
+        break;
+      case PathVerb::Line:
+        builder.lineTo(points[1]);
+        break;
+      case PathVerb::Quad:
+        builder.quadTo(points);
+        break;
+      case PathVerb::Cubic:
+        builder.cubicTo(points);
+        break;
+      case PathVerb::Close:
+        builder.close();
+        break;
+    }
+  };
+  path.decompose(iterator);
+  builder.finishContour();
+  return contours;
+}
+
+/**
+ * A half-plane in device space that keeps the points where dot(point - origin, normal) <= offset.
+ */
+struct HalfPlane {
+  Point origin = Point::Zero();
+  Point normal = Point::Zero();
+  float offset = 0.0f;
+};
+
+/**
+ * Clips a convex polygon by a half-plane.
+ */
+static std::vector<Point> ClipPolygon(const std::vector<Point>& polygon, const HalfPlane& plane) {
+  std::vector<Point> result = {};
+  auto count = polygon.size();
+  for (size_t i = 0; i < count; i++) {
+    auto& current = polygon[i];
+    auto& next = polygon[(i + 1) % count];
+    auto currentDistance = Dot(current - plane.origin, plane.normal) - plane.offset;
+    auto nextDistance = Dot(next - plane.origin, plane.normal) - plane.offset;
+    if (currentDistance <= 0) {
+      result.push_back(current);
+    }
+    if ((currentDistance < 0 && nextDistance > 0) || (currentDistance > 0 && nextDistance < 0)) {
+      auto t = currentDistance / (currentDistance - nextDistance);
+      result.push_back(current + (next - current) * t);
+    }
+  }
+  return result;
+}
+
+/**
+ * Describes how one end of a segment is finished, either with a cap or with its half of the join
+ * shared with the adjacent segment. Adjacent segments are split along the bisector of their join,
+ * so every pixel of the stroke, including its antialiased fringe, is covered by exactly one piece.
+ */
+struct SegmentEnd {
+  Point point = Point::Zero();
+  // The unit direction pointing away from the segment at this end.
+  Point outward = Point::Zero();
+  bool isJoin = false;
+  LineCap cap = LineCap::Butt;
+  LineJoin join = LineJoin::Miter;
+  // The segment keeps the side of the bisector where dot(p - point, cutNormal) <= 0.
+  Point cutNormal = Point::Zero();
+  // The bisector direction on the outer side of the corner.
+  Point middle = Point::Zero();
+  float cosHalfAngle = 1.0f;
+
+  bool isRound() const {
+    return isJoin ? join == LineJoin::Round : cap == LineCap::Round;
+  }
+};
+
+/**
+ * Expands the polylines of a stroke into triangles. All primitives are generated in device space
+ * and outset by the bloat distance, so that the antialiased edges are covered.
+ */
+class StrokeVertexWriter {
+ public:
+  StrokeVertexWriter(std::vector<float>* vertices, Color color, float halfWidth, float bloat,
+                     float coverageScale)
+      : vertices(vertices), color(color), halfWidth(halfWidth), bloat(bloat),
+        coverageScale(coverageScale) {
+  }
+
+  void writeContour(const StrokeContour& contour, const Stroke& stroke,
+                    const Point& dotDirection) {
+    auto& points = contour.points;
+    auto count = points.size();
+    if (count == 1) {
+      // A zero-length contour only draws its caps.
+      if (stroke.cap != LineCap::Butt) {
+        auto start = makeCap(points[0], dotDirection * -1.0f, stroke.cap);
+        auto end = makeCap(points[0], dotDirection, stroke.cap);
+        writeSegment(points[0], dotDirection, 0.0f, start, end);
+      }
+      return;
+    }
+    auto closed = contour.closed;
+    auto segmentCount = closed ? count : count - 1;
+    for (size_t i = 0; i < segmentCount; i++) {
+      auto& start = points[i];
+      auto& end = points[(i + 1) % count];
+      auto vector = end - start;
+      auto length = vector.length();
+      auto direction = vector * (1.0f / length);
+      SegmentEnd startEnd = {};
+      if (!closed && i == 0) {
+        startEnd = makeCap(start, direction * -1.0f, stroke.cap);
+      } else {
+        auto& previous = points[(i + count - 1) % count];
+        startEnd = makeJoin(Normalize(start - previous), direction, start, false, contour.smooth[i],
+                            stroke);
+      }
+      SegmentEnd endEnd = {};
+      auto endIndex = (i + 1) % count;
+      if (!closed && i == segmentCount - 1) {
+        endEnd = makeCap(end, direction, stroke.cap);
+      } else {
+        auto& next = points[(endIndex + 1) % count];
+        endEnd = makeJoin(direction, Normalize(next - end), end, true, contour.smooth[endIndex],
+                          stroke);
+      }
+      writeSegment(start, direction, length, startEnd, endEnd);
+    }
+  }
+
+ private:
+  std::vector<float>* vertices = nullptr;
+  Color color = Color::Transparent();
+  float halfWidth = 0.5f;
+  float bloat = 0.5f;
+  float coverageScale = 1.0f;
+
+  SegmentEnd makeCap(const Point& point, const Point& outward, LineCap cap) const {
+    SegmentEnd end = {};
+    end.point = point;
+    end.outward = outward;
+    end.cap = cap;
+    return end;
+  }
+
+  /**
+   * Returns the end of a segment at the join between the incoming and outgoing directions. If
+   * atEnd is true, the segment is the incoming one, otherwise it is the outgoing one.
+   */
+  SegmentEnd makeJoin(const Point& incoming, const Point& outgoing, const Point& point,
+                      bool atEnd, bool smooth, const Stroke& stroke) const {
+    auto direction = atEnd ? incoming : outgoing;
+    auto outward = atEnd ? direction : direction * -1.0f;
+    auto join = smooth ? LineJoin::Round : stroke.join;
+    auto bisector = Normalize(incoming + outgoing);
+    if (bisector == Point::Zero()) {
+      // The path turns back on itself, so the segments can't be split along a bisector. The round
+      // join becomes a round cap, and miter and bevel joins have nothing to fill.
+      return makeCap(point, outward, join == LineJoin::Round ? LineCap::Round : LineCap::Butt);
+    }
+    SegmentEnd end = {};
+    end.point = point;
+    end.outward = outward;
+    end.isJoin = true;
+    end.join = join;
+    end.cutNormal = atEnd ? bisector : bisector * -1.0f;
+    // The outer side of the corner is the one the path turns away from.
+    auto sign = Cross(incoming, outgoing) > 0 ? -1.0f : 1.0f;
+    auto outerA = Point::Make(-incoming.y, incoming.x) * sign;
+    auto outerB = Point::Make(-outgoing.y, outgoing.x) * sign;
+    end.middle = Normalize(outerA + outerB);
+    end.cosHalfAngle = Dot(outerA, end.middle);
+    if (end.join == LineJoin::Miter && end.cosHalfAngle * stroke.miterLimit < 1.0f) {
+      end.join = LineJoin::Bevel;
+    }
+    return end;
+  }
+
+  /**
+   * Returns how far the piece of a segment may extend beyond the given end.
+   */
+  float getReach(const SegmentEnd& end) const {
+    auto outer = halfWidth + bloat;
+    if (!end.isJoin) {
+      return end.cap == LineCap::Butt ? bloat : outer;
+    }
+    if (end.join == LineJoin::Miter) {
+      return outer / end.cosHalfAngle;
+    }
+    // Bevel and round joins are clipped by a line across the bisector, which keeps the corners of
+    // the piece within one outer width of the end.
+    return outer;
+  }
+
+  /**
+   * Returns the linear edge distance of a butt or square cap, or of a bevel join, at the point.
+   */
+  float getEndEdge(const SegmentEnd& end, const Point& point) const {
+    auto offset = point - end.point;
+    if (!end.isJoin) {
+      switch (end.cap) {
+        case LineCap::Butt:
+          return -Dot(offset, end.outward);
+        case LineCap::Square:
+          return halfWidth - Dot(offset, end.outward);
+        default:
+          return NoEdge;
+      }
+    }
+    if (end.join == LineJoin::Bevel) {
+      return halfWidth * end.cosHalfAngle - Dot(offset, end.middle);
+    }
+    return NoEdge;
+  }
+
+  /**
+   * Writes the piece of the stroke that belongs to a segment: the band along the segment, clipped
+   * by the bisectors of its joins, plus its caps. Round caps and joins are split off into their own
+   * parts, since their circles only apply beyond the ends of the segment.
+   */
+  void writeSegment(const Point& start, const Point& direction, float length,
+                    const SegmentEnd& startEnd, const SegmentEnd& endEnd) {
+    auto normal = Point::Make(-direction.y, direction.x);
+    auto outer = halfWidth + bloat;
+    auto first = start - direction * getReach(startEnd);
+    auto last = start + direction * (length + getReach(endEnd));
+    std::vector<Point> polygon = {first - normal * outer, last - normal * outer,
+                                  last + normal * outer, first + normal * outer};
+    for (auto end : {&startEnd, &endEnd}) {
+      if (!end->isJoin) {
+        continue;
+      }
+      polygon = ClipPolygon(polygon, {end->point, end->cutNormal, 0.0f});
+      if (end->join == LineJoin::Bevel) {
+        auto offset = halfWidth * end->cosHalfAngle + bloat;
+        polygon = ClipPolygon(polygon, {end->point, end->middle, offset});
+      } else if (end->join == LineJoin::Round) {
+        polygon = ClipPolygon(polygon, {end->point, end->middle, outer});
+      }
+    }
+    auto writePart = [&](const std::vector<Point>& part, const SegmentEnd* circleEnd) {
+      for (size_t i = 2; i < part.size(); i++) {
+        writeVertex(part[0], start, normal, startEnd, endEnd, circleEnd);
+        writeVertex(part[i - 1], start, normal, startEnd, endEnd, circleEnd);
+        writeVertex(part[i], start, normal, startEnd, endEnd, circleEnd);
+      }
+    };
+    for (auto end : {&startEnd, &endEnd}) {
+      if (end->isRound() && polygon.size() > 2) {
+        writePart(ClipPolygon(polygon, {end->point, end->outward * -1.0f, 0.0f}), end);
+        polygon = ClipPolygon(polygon, {end->point, end->outward, 0.0f});
+      }
+    }
+    writePart(polygon, nullptr);
+  }
+
+  void writeVertex(const Point& position, const Point& start, const Point& normal,
+                   const SegmentEnd& startEnd, const SegmentEnd& endEnd,
+                   const SegmentEnd* circleEnd) {
+    auto v = Dot(position - start, normal);
+    Point offset = Point::Zero();
+    auto radius = NoEdge;
+    if (circleEnd != nullptr) {
+      offset = position - circleEnd->point;
+      radius = halfWidth;
+    }
+    vertices->insert(vertices->end(),
+                     {position.x, position.y, color.red, color.green, color.blue, color.alpha,
+                      halfWidth - v, halfWidth + v, getEndEdge(startEnd, position),
+                      getEndEdge(endEnd, position), offset.x, offset.y, radius, coverageScale});
+  }
+};
+
+class StrokeVerticesProvider : public DataProvider {
+ public:
+  StrokeVerticesProvider(std::vector<std::shared_ptr<StrokePaint>> strokePaints, AAType aaType)
+      : strokePaints(std::move(strokePaints)), aaType(aaType) {
+  }
+
+  std::shared_ptr<Data> getData() const override {
+    std::vector<float> vertices = {};
+    float bloat = 0.0f;
+    if (aaType == AAType::Coverage) {
+      bloat = 0.5f;
+    } else if (aaType == AAType::MSAA) {
+      bloat = FLOAT_SQRT2;
+    }
+    for (auto& strokePaint : strokePaints) {
+      auto& viewMatrix = strokePaint->viewMatrix;
+      auto scale = viewMatrix.getMaxScale();
+      auto path = strokePaint->shape->getPath(scale);
+      path.transform(viewMatrix);
+      auto contours = FlattenPath(path);
+      auto halfWidth = strokePaint->stroke.width * 0.5f * scale;
+      auto coverageScale = 1.0f;
+      if (halfWidth < 0.5f) {
+        // Strokes thinner than a pixel are drawn as one pixel wide hairlines with their coverage
+        // scaled down by the width.
+        if (aaType != AAType::None) {
+          coverageScale = halfWidth * 2.0f;
+        }
+        halfWidth = 0.5f;
+      }
+      auto dotDirection = Normalize(viewMatrix.mapXY(1.0f, 0.0f) - viewMatrix.mapXY(0.0f, 0.0f));
+      StrokeVertexWriter writer(&vertices, strokePaint->color, halfWidth, bloat, coverageScale);
+      for (auto& contour : contours) {
+        writer.writeContour(contour, strokePaint->stroke, dotDirection);
+      }
+    }
+    if (vertices.empty()) {
+      return nullptr;
+    }
+    return Data::MakeWithCopy(vertices.data(), vertices.size() * sizeof(float));
+  }
+
+ private:
+  std::vector<std::shared_ptr<StrokePaint>> strokePaints = {};
+  AAType aaType = AAType::None;
+};
+
+/**
+ * Returns true if the matrix only rotates, uniformly scales, flips and translates, so that the
+ * stroke keeps a constant width in device space.
+ */
+static bool IsSimilarity(const Matrix& matrix) {
+  auto scaleX = matrix.getScaleX();
+  auto scaleY = matrix.getScaleY();
+  auto skewX = matrix.getSkewX();
+  auto skewY = matrix.getSkewY();
+  return (FloatNearlyEqual(scaleX, scaleY) && FloatNearlyEqual(skewX, -skewY)) ||
+         (FloatNearlyEqual(scaleX, -scaleY) && FloatNearlyEqual(skewX, skewY));
+}
+
+std::unique_ptr<StrokeDrawOp> StrokeDrawOp::Make(Color color, const std::shared_ptr<Shape>& shape,
+                                                 const Matrix& viewMatrix, bool allowOverlaps) {
+  if (shape == nullptr || shape->isInverseFillType()) {
+    return nullptr;
+  }
+  auto matrix = viewMatrix;
+  auto target = shape;
+  if (target->type() == Shape::Type::Matrix) {
+    auto matrixShape = std::static_pointer_cast<MatrixShape>(target);
+    matrix.preConcat(matrixShape->matrix);
+    target = matrixShape->shape;
+  }
+  if (target->type() != Shape::Type::Stroke) {
+    return nullptr;
+  }
+  auto strokeShape = std::static_pointer_cast<StrokeShape>(target);
+  auto& source = strokeShape->shape;
+  if (strokeShape->stroke.width <= 0 || !IsSimilarity(matrix)) {
+    return nullptr;
+  }
+  // Other shapes, such as text, are expensive to flatten and better served by the path renderer.
+  if (source->type() != Shape::Type::Path && source->type() != Shape::Type::Effect) {
+    return nullptr;
+  }
+  if (!allowOverlaps && !source->isLine()) {
+    return nullptr;
+  }
+  Matrix uvMatrix = Matrix::I();
+  if (!viewMatrix.invert(&uvMatrix)) {
+    return nullptr;
+  }
+  auto scale = matrix.getMaxScale();
+  auto bounds = strokeShape->getBounds(scale);
+  matrix.mapRect(&bounds);
+  // Leaves room for the antialiased edges and the hairline footprint of thin strokes.
+  bounds.outset(1.0f, 1.0f);
+  auto strokePaint =
+      std::make_shared<StrokePaint>(color, source, strokeShape->stroke, matrix);
+  return std::unique_ptr<StrokeDrawOp>(
+      new StrokeDrawOp(std::move(strokePaint), uvMatrix, bounds));
+}
+
+StrokeDrawOp::StrokeDrawOp(std::shared_ptr<StrokePaint> strokePaint, const Matrix& uvMatrix,
+                           const Rect& bounds)
+    : DrawOp(ClassID()), uvMatrix(uvMatrix) {
+  strokePaints.push_back(std::move(strokePaint));
+  setBounds(bounds);
+}
+
+bool StrokeDrawOp::onCombineIfPossible(Op* op) {
+  if (!DrawOp::onCombineIfPossible(op)) {
+    return false;
+  }
+  auto* that = static_cast<StrokeDrawOp*>(op);
+  if (uvMatrix != that->uvMatrix) {
+    return false;
+  }
+  strokePaints.insert(strokePaints.end(), that->strokePaints.begin(), that->strokePaints.end());
+  return true;
+}
+
+void StrokeDrawOp::prepare(Context* context, uint32_t renderFlags) {
+  auto vertexProvider = std::make_shared<StrokeVerticesProvider>(strokePaints, aa);
+  vertexBufferProxy = GpuBufferProxy::MakeFrom(context, std::move(vertexProvider),
+                                               BufferType::Vertex, renderFlags);
+}
+
+void StrokeDrawOp::execute(RenderPass* renderPass) {
+  if (vertexBufferProxy == nullptr) {
+    return;
+  }
+  auto vertexBuffer = vertexBufferProxy->getBuffer();
+  if (vertexBuffer == nullptr) {
+    return;
+  }
+  auto pipeline = createPipeline(
+      renderPass, StrokeGeometryProcessor::Make(renderPass->renderTarget()->width(),
+                                                renderPass->renderTarget()->height(), aa,
+                                                uvMatrix));
+  renderPass->bindProgramAndScissorClip(pipeline.get(), scissorRect());
+  renderPass->bindBuffers(nullptr, vertexBuffer);
+  auto vertexCount = vertexBuffer->size() / (FloatsPerVertex * sizeof(float));
+  renderPass->draw(PrimitiveType::Triangles, 0, vertexCount);
+}
+}  // namespace tgfx
@@ -0,0 +1,62 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "DrawOp.h"
+#include "tgfx/core/Shape.h"
+#include "tgfx/core/Stroke.h"
+
+namespace tgfx {
+class StrokePaint;
+
+/**
+ * StrokeDrawOp draws stroked paths by expanding their line segments, caps and joins into convex
+ * antialiased pieces, which the GPU shades with analytic edge and circle distances. This skips
+ * stroking the path into an outline and triangulating or rasterizing it. The expansion runs on the
+ * CPU, since RenderPass has no instanced draws to replicate a per-segment template in the vertex
+ * shader. Curves are flattened into line segments first. Adjacent segments are split along the
+ * bisectors of their joins, so joins are blended only once.
+ */
+class StrokeDrawOp : public DrawOp {
+ public:
+  DEFINE_OP_CLASS_ID
+
+  /**
+   * Creates a StrokeDrawOp if the shape is a stroke that can be expanded into pieces. Returns
+   * nullptr otherwise. Parts of a stroke that cross each other are drawn more than once, so unless
+   * allowOverlaps is true, only single line segments are accepted.
+   */
+  static std::unique_ptr<StrokeDrawOp> Make(Color color, const std::shared_ptr<Shape>& shape,
+                                            const Matrix& viewMatrix, bool allowOverlaps);
+
+  void prepare(Context* context, uint32_t renderFlags) override;
+
+  void execute(RenderPass* renderPass) override;
+
+ private:
+  StrokeDrawOp(std::shared_ptr<StrokePaint> strokePaint, const Matrix& uvMatrix,
+               const Rect& bounds);
+
+  bool onCombineIfPossible(Op* op) override;
+
+  std::vector<std::shared_ptr<StrokePaint>> strokePaints = {};
+  Matrix uvMatrix = Matrix::I();
+  std::shared_ptr<GpuBufferProxy> vertexBufferProxy = nullptr;
+};
+}  // namespace tgfx
@@ -0,0 +1,267 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "TessellatedPathDrawOp.h"
+#include <algorithm>
+#include <cmath>
+#include "core/shapes/MatrixShape.h"
+#include "gpu/Gpu.h"
+#include "gpu/processors/TessellatedPathGeometryProcessor.h"
+
+namespace tgfx {
+// The maximum distance in device pixels between a curve and the line segments approximating it.
+static constexpr float CurveTolerance = 0.25f;
+static constexpr int MaxCurveSegments = 1024;
+// Paths with no more verbs than this are cheap to triangulate on the CPU, which keeps their
+// antialiasing analytic.
+static constexpr int MinComplexVerbCount = 100;
+// The four control points of a cubic curve and the parameter to evaluate it at.
+static constexpr size_t FloatsPerVertex = 9;
+// The cover pass draws two triangles at the end of the vertex buffer.
+static constexpr size_t CoverVertexCount = 6;
+
+// Accumulates the winding number of the path. The wrapping operations keep the parity of the
+// winding number intact, so the same pass serves both fill rules.
+static constexpr StencilSettings StencilPass = {
+    {StencilTest::Always, StencilOp::IncWrap, StencilOp::Keep, 0, 0xFF, 0xFF},
+    {StencilTest::Always, StencilOp::DecWrap, StencilOp::Keep, 0, 0xFF, 0xFF}};
+
+static constexpr StencilFace NonZeroCoverFace = {StencilTest::NotEqual, StencilOp::Zero,
+                                                 StencilOp::Zero, 0, 0xFF, 0xFF};
+static constexpr StencilSettings NonZeroCoverPass = {NonZeroCoverFace, NonZeroCoverFace};
+
+static constexpr StencilFace EvenOddCoverFace = {StencilTest::NotEqual, StencilOp::Zero,
+                                                 StencilOp::Zero, 0, 0x01, 0xFF};
+static constexpr StencilSettings EvenOddCoverPass = {EvenOddCoverFace, EvenOddCoverFace};
+
+/**
+ * Returns the number of line segments needed to keep the curve within the tolerance in device
+ * space, using Wang's formula.
+ */
+static int CubicSegmentCount(const Point points[4], float scale) {
+  auto deviation = std::max((points[0] - points[1] * 2.0f + points[2]).length(),
+                            (points[1] - points[2] * 2.0f + points[3]).length());
+  auto count = ceilf(sqrtf(0.75f * deviation * scale / CurveTolerance));
+  return static_cast<int>(std::clamp(count, 1.0f, static_cast<float>(MaxCurveSegments)));
+}
+
+class PathTessellationWriter {
+ public:
+  PathTessellationWriter(std::vector<float>* vertices, float scale)
+      : vertices(vertices), scale(scale) {
+  }
+
+  void moveTo(const Point& point) {
+    finishContour();
+    contour.push_back(point);
+  }
+
+  void lineTo(const Point& point) {
+    contour.push_back(point);
+  }
+
+  void quadTo(const Point points[3]) {
+    // Raising the degree of a quadratic curve is exact, so all curves go through the same cubic
+    // evaluation in the vertex shader.
+    Point cubic[4] = {points[0], points[0] + (points[1] - points[0]) * (2.0f / 3.0f),
+                      points[2] + (points[1] - points[2]) * (2.0f / 3.0f), points[2]};
+    cubicTo(cubic);
+  }
+
+  void cubicTo(const Point points[4]) {
+    auto segmentCount = CubicSegmentCount(points, scale);
+    // Fans out from the start point of the curve to the points along it. Together with the chord
+    // in the inner polygon, this covers the area between the curve and the chord.
+    for (int i = 1; i < segmentCount; i++) {
+      writeCurveVertex(points, 0.0f);
+      writeCurveVertex(points, static_cast<float>(i) / static_cast<float>(segmentCount));
+      writeCurveVertex(points, static_cast<float>(i + 1) / static_cast<float>(segmentCount));
+    }
+    contour.push_back(points[3]);
+  }
+
+  /**
+   * Triangulates the polygon of the on-curve points of the current contour in middle-out order,
+   * which produces fewer slivers than a plain fan. Each level removes every other point of the
+   * polygon left by the previous level.
+   */
+  void finishContour() {
+    auto count = contour.size();
+    for (size_t step = 1; step < count; step *= 2) {
+      for (size_t i = 0; i + step < count; i += step * 2) {
+        auto last = i + step * 2 < count ? i + step * 2 : 0;
+        if (last == i) {
+          continue;
+        }
+        writePoint(contour[i]);
+        writePoint(contour[i + step]);
+        writePoint(contour[last]);
+      }
+    }
+    contour.clear();
+  }
+
+  void writeCover(const Rect& rect) {
+    writePoint({rect.left, rect.top});
+    writePoint({rect.right, rect.top});
+    writePoint({rect.left, rect.bottom});
+    writePoint({rect.right, rect.top});
+    writePoint({rect.right, rect.bottom});
+    writePoint({rect.left, rect.bottom});
+  }
+
+ private:
+  std::vector<float>* vertices = nullptr;
+  float scale = 1.0f;
+  std::vector<Point> contour = {};
+
+  void writePoint(const Point& point) {
+    vertices->insert(vertices->end(), {point.x, point.y, point.x, point.y, point.x, point.y,
+                                       point.x, point.y, 0.0f});
+  }
+
+  void writeCurveVertex(const Point points[4], float t) {
+    vertices->insert(vertices->end(),
+                     {points[0].x, points[0].y, points[1].x, points[1].y, points[2].x, points[2].y,
+                      points[3].x, points[3].y, t});
+  }
+};
+
+class TessellatedPathVerticesProvider : public DataProvider {
+ public:
+  TessellatedPathVerticesProvider(Path path, float scale) : path(std::move(path)), scale(scale) {
+  }
+
+  std::shared_ptr<Data> getData() const override {
+    std::vector<float> vertices = {};
+    PathTessellationWriter writer(&vertices, scale);
+    auto iterator = [&](PathVerb verb, const Point points[4], void*) {
+      switch (verb) {
+        case PathVerb::Move:
+          writer.moveTo(points[0]);
+          break;
+        case PathVerb::Line:
+          writer.lineTo(points[1]);
+          break;
+        case PathVerb::Quad:
+          writer.quadTo(points);
+          break;
+        case PathVerb::Cubic:
+          writer.cubicTo(points);
+          break;
+        case PathVerb::Close:
+          break;
+      }
+    };
+    path.decompose(iterator);
+    writer.finishContour();
+    if (vertices.empty()) {
+      return nullptr;
+    }
+    // The control points of a path are within its bounds, and so is every triangle above.
+    writer.writeCover(path.getBounds());
+    return Data::MakeWithCopy(vertices.data(), vertices.size() * sizeof(float));
+  }
+
+ private:
+  Path path = {};
+  float scale = 1.0f;
+};
+
+std::unique_ptr<TessellatedPathDrawOp> TessellatedPathDrawOp::Make(
+    Color color, const std::shared_ptr<Shape>& shape, const Matrix& viewMatrix, bool complexOnly) {
+  if (shape == nullptr || shape->isInverseFillType()) {
+    return nullptr;
+  }
+  auto uvMatrix = Matrix::I();
+  auto target = shape;
+  if (target->type() == Shape::Type::Matrix) {
+    auto matrixShape = std::static_pointer_cast<MatrixShape>(target);
+    uvMatrix = matrixShape->matrix;
+    target = matrixShape->shape;
+  }
+  Path path = {};
+  if (!target->isSimplePath(&path) || path.isEmpty()) {
+    return nullptr;
+  }
+  if (complexOnly && path.countVerbs() <= MinComplexVerbCount) {
+    return nullptr;
+  }
+  auto drawMatrix = viewMatrix;
+  drawMatrix.preConcat(uvMatrix);
+  auto bounds = drawMatrix.mapRect(path.getBounds());
+  return std::unique_ptr<TessellatedPathDrawOp>(
+      new TessellatedPathDrawOp(color, std::move(path), drawMatrix, uvMatrix, bounds));
+}
+
+TessellatedPathDrawOp::TessellatedPathDrawOp(Color color, Path path, const Matrix& viewMatrix,
+                                             const Matrix& uvMatrix, const Rect& bounds)
+    : DrawOp(ClassID()), color(color), path(std::move(path)), viewMatrix(viewMatrix),
+      uvMatrix(uvMatrix) {
+  setBounds(bounds);
+}
+
+bool TessellatedPathDrawOp::onCombineIfPossible(Op*) {
+  // The winding numbers of overlapping paths would add up in the stencil buffer.
+  return false;
+}
+
+void TessellatedPathDrawOp::prepare(Context* context, uint32_t renderFlags) {
+  auto vertexProvider =
+      std::make_shared<TessellatedPathVerticesProvider>(path, viewMatrix.getMaxScale());
+  vertexBufferProxy = GpuBufferProxy::MakeFrom(context, std::move(vertexProvider),
+                                               BufferType::Vertex, renderFlags);
+}
+
+void TessellatedPathDrawOp::execute(RenderPass* renderPass) {
+  if (vertexBufferProxy == nullptr) {
+    return;
+  }
+  auto vertexBuffer = vertexBufferProxy->getBuffer();
+  if (vertexBuffer == nullptr) {
+    return;
+  }
+  auto vertexCount = vertexBuffer->size() / (FloatsPerVertex * sizeof(float));
+  if (vertexCount <= CoverVertexCount) {
+    return;
+  }
+  auto renderTarget = renderPass->renderTarget();
+  auto width = renderTarget->width();
+  auto height = renderTarget->height();
+  auto context = renderPass->getContext();
+  const auto& swizzle = context->caps()->getWriteSwizzle(renderTarget->format());
+  // The stencil pass leaves the color untouched by blending with the destination only.
+  auto stencilPipeline = std::make_unique<Pipeline>(
+      TessellatedPathGeometryProcessor::Make(color, width, height, viewMatrix, uvMatrix),
+      std::vector<std::unique_ptr<FragmentProcessor>>{}, 0, BlendMode::Dst, DstTextureInfo{},
+      &swizzle);
+  stencilPipeline->setStencilSettings(&StencilPass);
+  renderPass->bindProgramAndScissorClip(stencilPipeline.get(), scissorRect());
+  renderPass->bindBuffers(nullptr, vertexBuffer);
+  renderPass->draw(PrimitiveType::Triangles, 0, vertexCount - CoverVertexCount);
+
+  auto coverPipeline = createPipeline(
+      renderPass,
+      TessellatedPathGeometryProcessor::Make(color, width, height, viewMatrix, uvMatrix));
+  auto evenOdd = path.getFillType() == PathFillType::EvenOdd;
+  coverPipeline->setStencilSettings(evenOdd ? &EvenOddCoverPass : &NonZeroCoverPass);
+  renderPass->bindProgramAndScissorClip(coverPipeline.get(), scissorRect());
+  renderPass->bindBuffers(nullptr, vertexBuffer);
+  renderPass->draw(PrimitiveType::Triangles, vertexCount - CoverVertexCount, CoverVertexCount);
+}
+}  // namespace tgfx
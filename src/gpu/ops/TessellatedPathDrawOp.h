@@ -0,0 +1,65 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "DrawOp.h"
+#include "tgfx/core/Shape.h"
+
+namespace tgfx {
+/**
+ * TessellatedPathDrawOp fills paths with the stencil-then-cover technique. The first pass
+ * accumulates the winding number of the path into the stencil buffer by drawing a middle-out fan
+ * of its on-curve points together with a fan for each curve, which the vertex shader flattens from
+ * the control points. The second pass covers the bounds of the path and keeps the samples that
+ * pass the fill rule, resetting the stencil buffer along the way. Nothing is triangulated or
+ * rasterized on the CPU, so paths that change every frame stay cheap to draw. The edges are
+ * aliased unless the render target is multisampled.
+ */
+class TessellatedPathDrawOp : public DrawOp {
+ public:
+  DEFINE_OP_CLASS_ID
+
+  /**
+   * Creates a TessellatedPathDrawOp if the shape is a filled path with a non-inverse fill type.
+   * Returns nullptr otherwise. If complexOnly is true, paths with few verbs, which are cheap to
+   * triangulate on the CPU, are rejected as well.
+   */
+  static std::unique_ptr<TessellatedPathDrawOp> Make(Color color,
+                                                     const std::shared_ptr<Shape>& shape,
+                                                     const Matrix& viewMatrix,
+                                                     bool complexOnly = false);
+
+  void prepare(Context* context, uint32_t renderFlags) override;
+
+  void execute(RenderPass* renderPass) override;
+
+ protected:
+  bool onCombineIfPossible(Op* op) override;
+
+ private:
+  Color color = Color::Transparent();
+  Path path = {};
+  Matrix viewMatrix = Matrix::I();
+  Matrix uvMatrix = Matrix::I();
+  std::shared_ptr<GpuBufferProxy> vertexBufferProxy = nullptr;
+
+  TessellatedPathDrawOp(Color color, Path path, const Matrix& viewMatrix, const Matrix& uvMatrix,
+                        const Rect& bounds);
+};
+}  // namespace tgfx
@@ -0,0 +1,47 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "gpu/processors/FragmentProcessor.h"
+
+namespace tgfx {
+/**
+ * DistanceFieldEffect converts the signed distance sampled from a distance field texture into
+ * coverage. The distanceScale maps the sampled value, which is 0.5 on the edges, into the distance
+ * from the edge in device pixels.
+ */
+class DistanceFieldEffect : public FragmentProcessor {
+ public:
+  static std::unique_ptr<FragmentProcessor> Make(std::unique_ptr<FragmentProcessor> textureEffect,
+                                                 float distanceScale);
+
+  std::string name() const override {
+    return "DistanceFieldEffect";
+  }
+
+ protected:
+  DEFINE_PROCESSOR_CLASS_ID
+
+  DistanceFieldEffect(std::unique_ptr<FragmentProcessor> textureEffect, float distanceScale);
+
+  bool onIsEqual(const FragmentProcessor& processor) const override;
+
+  float distanceScale = 1.0f;
+};
+}  // namespace tgfx
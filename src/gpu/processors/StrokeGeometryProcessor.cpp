@@ -0,0 +1,36 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "StrokeGeometryProcessor.h"
+
+namespace tgfx {
+StrokeGeometryProcessor::StrokeGeometryProcessor(int width, int height, AAType aa,
+                                                 const Matrix& uvMatrix)
+    : GeometryProcessor(ClassID()), width(width), height(height), aa(aa), uvMatrix(uvMatrix) {
+  inPosition = {"inPosition", SLType::Float2};
+  inColor = {"inColor", SLType::Float4};
+  inEdges = {"inEdges", SLType::Float4};
+  inCircle = {"inCircle", SLType::Float4};
+  setVertexAttributes(&inPosition, 4);
+}
+
+void StrokeGeometryProcessor::onComputeProcessorKey(BytesKey* bytesKey) const {
+  uint32_t flags = aa == AAType::None ? 0 : 1;
+  bytesKey->write(flags);
+}
+}  // namespace tgfx
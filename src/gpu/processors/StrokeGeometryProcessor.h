@@ -0,0 +1,56 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "GeometryProcessor.h"
+#include "gpu/AAType.h"
+
+namespace tgfx {
+/**
+ * StrokeGeometryProcessor draws the quads and triangles that StrokeDrawOp expands from line
+ * segments, caps and joins. Each vertex carries up to four linear edge distances and one circle
+ * offset, all in device pixels, and the coverage is the minimum of their signed distances.
+ */
+class StrokeGeometryProcessor : public GeometryProcessor {
+ public:
+  static std::unique_ptr<StrokeGeometryProcessor> Make(int width, int height, AAType aa,
+                                                       const Matrix& uvMatrix);
+
+  std::string name() const override {
+    return "StrokeGeometryProcessor";
+  }
+
+ protected:
+  DEFINE_PROCESSOR_CLASS_ID
+
+  StrokeGeometryProcessor(int width, int height, AAType aa, const Matrix& uvMatrix);
+
+  void onComputeProcessorKey(BytesKey* bytesKey) const override;
+
+  Attribute inPosition;
+  Attribute inColor;
+  Attribute inEdges;
+  Attribute inCircle;
+
+  int width = 1;
+  int height = 1;
+  AAType aa = AAType::None;
+  Matrix uvMatrix = Matrix::I();
+};
+}  // namespace tgfx
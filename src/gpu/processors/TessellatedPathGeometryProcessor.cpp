@@ -0,0 +1,33 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "TessellatedPathGeometryProcessor.h"
+
+namespace tgfx {
+TessellatedPathGeometryProcessor::TessellatedPathGeometryProcessor(Color color, int width,
+                                                                   int height,
+                                                                   const Matrix& viewMatrix,
+                                                                   const Matrix& uvMatrix)
+    : GeometryProcessor(ClassID()), color(color), width(width), height(height),
+      viewMatrix(viewMatrix), uvMatrix(uvMatrix) {
+  inCurveStart = {"inCurveStart", SLType::Float4};
+  inCurveEnd = {"inCurveEnd", SLType::Float4};
+  inParameter = {"inParameter", SLType::Float};
+  setVertexAttributes(&inCurveStart, 3);
+}
+}  // namespace tgfx
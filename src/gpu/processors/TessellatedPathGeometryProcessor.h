@@ -0,0 +1,57 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "GeometryProcessor.h"
+
+namespace tgfx {
+/**
+ * TessellatedPathGeometryProcessor evaluates the triangles that TessellatedPathDrawOp generates
+ * from the control points of a path. Each vertex carries the four control points of a cubic curve
+ * in the local space of the path and the parameter to evaluate it at, so curves are flattened in
+ * the vertex shader instead of on the CPU. Straight edges and single points repeat the same point
+ * in all four slots.
+ */
+class TessellatedPathGeometryProcessor : public GeometryProcessor {
+ public:
+  static std::unique_ptr<TessellatedPathGeometryProcessor> Make(Color color, int width, int height,
+                                                                const Matrix& viewMatrix,
+                                                                const Matrix& uvMatrix);
+
+  std::string name() const override {
+    return "TessellatedPathGeometryProcessor";
+  }
+
+ protected:
+  DEFINE_PROCESSOR_CLASS_ID
+
+  TessellatedPathGeometryProcessor(Color color, int width, int height, const Matrix& viewMatrix,
+                                   const Matrix& uvMatrix);
+
+  Attribute inCurveStart;
+  Attribute inCurveEnd;
+  Attribute inParameter;
+
+  Color color;
+  int width = 1;
+  int height = 1;
+  Matrix viewMatrix = Matrix::I();
+  Matrix uvMatrix = Matrix::I();
+};
+}  // namespace tgfx
@@ -36,6 +36,13 @@ class ResourceTask {
    */
   virtual bool execute(Context* context);
 
+  /**
+   * Returns true if the task can execute without waiting for any asynchronous work to finish.
+   */
+  virtual bool isReady() const {
+    return true;
+  }
+
  protected:
   UniqueKey uniqueKey = {};
 
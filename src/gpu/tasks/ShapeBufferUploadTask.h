@@ -27,6 +27,13 @@ class ShapeBufferProvider {
   virtual ~ShapeBufferProvider() = default;
 
   virtual std::shared_ptr<ShapeBuffer> getBuffer() const = 0;
+
+  /**
+   * Returns true if getBuffer() returns without blocking.
+   */
+  virtual bool isReady() const {
+    return true;
+  }
 };
 
 class ShapeBufferUploadTask : public ResourceTask {
@@ -36,6 +43,10 @@ class ShapeBufferUploadTask : public ResourceTask {
 
   bool execute(Context* context) override;
 
+  bool isReady() const override {
+    return provider == nullptr || provider->isReady();
+  }
+
  protected:
   std::shared_ptr<Resource> onMakeResource(Context*) override {
     // The execute() method is already overridden, so this method should never be called.
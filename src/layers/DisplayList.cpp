@@ -17,33 +17,216 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "tgfx/layers/DisplayList.h"
+#include <algorithm>
+#include <cmath>
 #include "layers/DrawArgs.h"
+#include "layers/TileCache.h"
 
 namespace tgfx {
 
+static constexpr int MinTileSize = 16;
+
 DisplayList::DisplayList() : _root(Layer::Make()) {
   _root->_root = _root.get();
 }
 
+DisplayList::~DisplayList() = default;
+
 Layer* DisplayList::root() const {
   return _root.get();
 }
 
 bool DisplayList::render(Surface* surface, bool replaceAll) {
-  if (!surface ||
-      (replaceAll && surface->_uniqueID == surfaceID &&
-       surface->contentVersion() == surfaceContentVersion && !_root->bitFields.childrenDirty)) {
+  if (!surface) {
+    return false;
+  }
+  auto animationChanged = _root->updateAnimations(_animationTime >= 0 ? _animationTime
+                                                                      : clock.elapsedTime());
+  auto contentChanged = _root->bitFields.childrenDirty || animationChanged;
+  if (replaceAll && surface->_uniqueID == surfaceID &&
+      surface->contentVersion() == surfaceContentVersion && !contentChanged && !viewportChanged) {
     return false;
   }
   auto canvas = surface->getCanvas();
   if (replaceAll) {
     canvas->clear();
   }
-  DrawArgs args(surface->getContext(), surface->renderFlags(), true);
-  _root->drawLayer(args, canvas, 1.0f, BlendMode::SrcOver);
+  if (_renderMode == RenderMode::Tiled && surface->getContext() != nullptr) {
+    renderTiles(surface);
+  } else {
+    // Drawing the layer tree directly consumes the dirty flags that the tiles rely on.
+    tileCache = nullptr;
+    AutoCanvasRestore autoRestore(canvas);
+    canvas->translate(_contentOffset.x, _contentOffset.y);
+    canvas->scale(_zoomScale, _zoomScale);
+    DrawArgs args(surface->getContext(), surface->renderFlags(), true);
+    _root->drawLayer(args, canvas, 1.0f, BlendMode::SrcOver);
+  }
+  viewportChanged = false;
   surfaceContentVersion = surface->contentVersion();
   surfaceID = surface->_uniqueID;
   return true;
 }
 
+bool DisplayList::hasAnimations() const {
+  return _root->bitFields.hasAnimations;
+}
+
+void DisplayList::setAnimationTime(int64_t time) {
+  _animationTime = time;
+}
+
+void DisplayList::setRenderMode(RenderMode value) {
+  if (_renderMode == value) {
+    return;
+  }
+  _renderMode = value;
+  tileCache = nullptr;
+  viewportChanged = true;
+}
+
+void DisplayList::setTileSize(int value) {
+  value = std::max(value, MinTileSize);
+  if (_tileSize == value) {
+    return;
+  }
+  _tileSize = value;
+  if (tileCache) {
+    tileCache->clear();
+  }
+  viewportChanged = true;
+}
+
+void DisplayList::setZoomScale(float value) {
+  if (_zoomScale == value) {
+    return;
+  }
+  _zoomScale = value;
+  if (tileCache) {
+    tileCache->clear();
+  }
+  viewportChanged = true;
+}
+
+void DisplayList::setContentOffset(const Point& value) {
+  if (_contentOffset == value) {
+    return;
+  }
+  _contentOffset = value;
+  viewportChanged = true;
+}
+
+void DisplayList::renderTiles(Surface* surface) {
+  auto context = surface->getContext();
+  auto cacheReset = tileCache == nullptr || tileContextID != context->uniqueID();
+  if (cacheReset) {
+    tileCache = std::make_unique<TileCache>();
+    tileContextID = context->uniqueID();
+  }
+  std::vector<Rect> dirtyRects = {};
+  // An empty cache has no tiles to invalidate, but the render bounds of all layers still need to
+  // be refreshed for the next frames.
+  collectDirtyRects(_root.get(), Matrix::I(), cacheReset, &dirtyRects);
+  for (auto& rect : dirtyRects) {
+    rect.scale(_zoomScale, _zoomScale);
+    // Antialiased edges may touch the pixels just outside the bounds.
+    rect.outset(1.0f, 1.0f);
+    tileCache->removeTiles(rect, static_cast<float>(_tileSize));
+  }
+  frameIndex++;
+  auto offsetX = roundf(_contentOffset.x);
+  auto offsetY = roundf(_contentOffset.y);
+  auto tileSize = static_cast<float>(_tileSize);
+  // The range of tiles covering the surface, in the tile grid of the zoomed layer tree.
+  auto left = static_cast<int>(floorf(-offsetX / tileSize));
+  auto top = static_cast<int>(floorf(-offsetY / tileSize));
+  auto right = static_cast<int>(ceilf((static_cast<float>(surface->width()) - offsetX) / tileSize));
+  auto bottom =
+      static_cast<int>(ceilf((static_cast<float>(surface->height()) - offsetY) / tileSize));
+  auto canvas = surface->getCanvas();
+  size_t visibleCount = 0;
+  for (int tileY = top; tileY < bottom; tileY++) {
+    for (int tileX = left; tileX < right; tileX++) {
+      auto image = tileCache->getTile(tileX, tileY, frameIndex);
+      if (image == nullptr) {
+        image = renderTile(context, surface->renderFlags(), tileX, tileY);
+        if (image == nullptr) {
+          continue;
+        }
+        tileCache->addTile(tileX, tileY, image, frameIndex);
+      }
+      visibleCount++;
+      canvas->drawImage(std::move(image), static_cast<float>(tileX) * tileSize + offsetX,
+                        static_cast<float>(tileY) * tileSize + offsetY);
+    }
+  }
+  // Keeps some invisible tiles around, so scrolling back and forth does not redraw them.
+  tileCache->purgeToCount(visibleCount * 2);
+}
+
+void DisplayList::collectDirtyRects(Layer* layer, const Matrix& matrix, bool parentDirty,
+                                    std::vector<Rect>* dirtyRects) {
+  auto selfDirty = layer->bitFields.selfDirty || layer->bitFields.contentDirty;
+  if (!parentDirty && !selfDirty && !layer->bitFields.childrenDirty &&
+      !layer->bitFields.hasAnimations) {
+    return;
+  }
+  // Once a layer is dirty, its whole area is redrawn, so the descendants only refresh their bounds.
+  auto reportsBounds = selfDirty && !parentDirty;
+  if (reportsBounds) {
+    dirtyRects->push_back(layer->renderBounds);
+    if (layer->maskOwner) {
+      dirtyRects->push_back(layer->maskOwner->renderBounds);
+    }
+  }
+  if (!layer->removedChildBounds.isEmpty()) {
+    dirtyRects->push_back(layer->removedChildBounds);
+    layer->removedChildBounds.setEmpty();
+  }
+  layer->bitFields.selfDirty = false;
+  layer->bitFields.childrenDirty = false;
+  for (const auto& child : layer->_children) {
+    auto childMatrix = matrix;
+    childMatrix.preConcat(child->getPresentationMatrix());
+    collectDirtyRects(child.get(), childMatrix, parentDirty || selfDirty, dirtyRects);
+  }
+  auto bounds = Rect::MakeEmpty();
+  if (layer->visible() && layer->getPresentationAlpha() > 0) {
+    if (layer->_filters.empty() && layer->_layerStyles.empty()) {
+      // Joins the bounds of the children that are already up to date instead of measuring the
+      // whole subtree again. Scroll rects and masks are ignored, which only enlarges the bounds.
+      if (auto content = layer->getContent()) {
+        bounds = matrix.mapRect(content->getBounds());
+      }
+      for (const auto& child : layer->_children) {
+        if (!child->maskOwner) {
+          bounds.join(child->renderBounds);
+        }
+      }
+    } else {
+      bounds = matrix.mapRect(layer->getBounds());
+    }
+  }
+  layer->renderBounds = bounds;
+  if (reportsBounds) {
+    dirtyRects->push_back(bounds);
+  }
+}
+
+std::shared_ptr<Image> DisplayList::renderTile(Context* context, uint32_t renderFlags, int tileX,
+                                               int tileY) {
+  auto tileSurface = Surface::Make(context, _tileSize, _tileSize, false, 1, false, renderFlags);
+  if (tileSurface == nullptr) {
+    return nullptr;
+  }
+  auto canvas = tileSurface->getCanvas();
+  canvas->clear();
+  canvas->translate(static_cast<float>(-tileX * _tileSize),
+                    static_cast<float>(-tileY * _tileSize));
+  canvas->scale(_zoomScale, _zoomScale);
+  DrawArgs args(context, renderFlags, true);
+  _root->drawLayer(args, canvas, 1.0f, BlendMode::SrcOver);
+  return tileSurface->makeImageSnapshot();
+}
+
 }  // namespace tgfx
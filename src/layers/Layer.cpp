@@ -22,6 +22,7 @@
 #include "core/utils/Log.h"
 #include "core/utils/MathExtra.h"
 #include "layers/DrawArgs.h"
+#include "layers/animations/LayerAnimator.h"
 #include "layers/contents/RasterizedContent.h"
 #include "tgfx/core/Recorder.h"
 #include "tgfx/core/Surface.h"
@@ -40,6 +41,21 @@ struct LayerStyleSource {
   Point contourOffset = Point::Zero();
 };
 
+static bool HasOverlap(std::vector<Rect>* rects) {
+  std::sort(rects->begin(), rects->end(),
+            [](const Rect& a, const Rect& b) { return a.left < b.left; });
+  auto count = rects->size();
+  for (size_t i = 0; i < count; i++) {
+    auto& rect = (*rects)[i];
+    for (size_t j = i + 1; j < count && (*rects)[j].left < rect.right; j++) {
+      if (Rect::Intersects(rect, (*rects)[j])) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
 static std::shared_ptr<Picture> CreatePicture(
     const DrawArgs& args, float contentScale,
     const std::function<void(const DrawArgs&, Canvas*)>& drawFunction) {
@@ -105,6 +121,7 @@ Layer::Layer() {
   bitFields.visible = true;
   bitFields.allowsEdgeAntialiasing = AllowsEdgeAntialiasing;
   bitFields.allowsGroupOpacity = AllowsGroupOpacity;
+  bitFields.selfDirty = true;
 }
 
 void Layer::setAlpha(float value) {
@@ -256,6 +273,39 @@ void Layer::setExcludeChildEffectsInLayerStyle(bool value) {
   invalidate();
 }
 
+std::vector<std::shared_ptr<Animation>> Layer::animations() const {
+  if (animator == nullptr) {
+    return {};
+  }
+  return animator->animations();
+}
+
+void Layer::addAnimation(std::shared_ptr<Animation> animation) {
+  if (animation == nullptr) {
+    return;
+  }
+  if (animator == nullptr) {
+    animator = std::make_shared<LayerAnimator>();
+  }
+  animator->addAnimation(std::move(animation));
+  invalidateAnimations();
+}
+
+void Layer::removeAnimation(std::shared_ptr<Animation> animation) {
+  if (animator == nullptr || !animator->removeAnimation(animation.get())) {
+    return;
+  }
+  invalidate();
+}
+
+void Layer::removeAllAnimations() {
+  if (animator == nullptr) {
+    return;
+  }
+  animator = nullptr;
+  invalidate();
+}
+
 bool Layer::addChild(std::shared_ptr<Layer> child) {
   if (!child) {
     return false;
@@ -287,7 +337,11 @@ bool Layer::addChildAt(std::shared_ptr<Layer> child, int index) {
   child->removeFromParent();
   _children.insert(_children.begin() + index, child);
   child->_parent = this;
+  child->bitFields.selfDirty = true;
   child->onAttachToRoot(_root);
+  if (child->bitFields.hasAnimations) {
+    invalidateAnimations();
+  }
   invalidateChildren();
   return true;
 }
@@ -329,6 +383,7 @@ std::shared_ptr<Layer> Layer::removeChildAt(int index) {
   }
   auto child = _children[static_cast<size_t>(index)];
   child->_parent = nullptr;
+  removedChildBounds.join(child->renderBounds);
   child->onDetachFromRoot();
   _children.erase(_children.begin() + index);
   invalidateChildren();
@@ -365,6 +420,7 @@ bool Layer::setChildIndex(std::shared_ptr<Layer> child, int index) {
   }
   _children.erase(_children.begin() + oldIndex);
   _children.insert(_children.begin() + index, child);
+  child->bitFields.selfDirty = true;
   invalidateChildren();
   return true;
 }
@@ -496,12 +552,15 @@ void Layer::draw(Canvas* canvas, float alpha, BlendMode blendMode) {
 }
 
 void Layer::invalidate() {
+  bitFields.overlapAnalyzed = false;
+  bitFields.selfDirty = true;
   if (_parent) {
     _parent->invalidateChildren();
   }
 }
 
 void Layer::invalidateContent() {
+  bitFields.overlapAnalyzed = false;
   if (bitFields.contentDirty) {
     return;
   }
@@ -511,12 +570,15 @@ void Layer::invalidateContent() {
 }
 
 void Layer::invalidateChildren() {
+  bitFields.overlapAnalyzed = false;
   if (bitFields.childrenDirty) {
     return;
   }
   bitFields.childrenDirty = true;
   rasterizedContent = nullptr;
-  invalidate();
+  if (_parent) {
+    _parent->invalidateChildren();
+  }
 }
 
 std::unique_ptr<LayerContent> Layer::onUpdateContent() {
@@ -592,6 +654,56 @@ Matrix Layer::getMatrixWithScrollRect() const {
   return matrix;
 }
 
+float Layer::getPresentationAlpha() const {
+  return animator ? animator->getAlpha(_alpha) : _alpha;
+}
+
+Matrix Layer::getPresentationMatrix() const {
+  if (animator == nullptr) {
+    return getMatrixWithScrollRect();
+  }
+  auto matrix = _matrix;
+  animator->applyToMatrix(&matrix);
+  if (_scrollRect) {
+    matrix.preTranslate(-_scrollRect->left, -_scrollRect->top);
+  }
+  return matrix;
+}
+
+void Layer::invalidateAnimations() {
+  auto layer = this;
+  while (layer && !layer->bitFields.hasAnimations) {
+    layer->bitFields.hasAnimations = true;
+    layer = layer->_parent;
+  }
+}
+
+bool Layer::updateAnimations(int64_t time) {
+  if (!bitFields.hasAnimations) {
+    return false;
+  }
+  bool changed = false;
+  bool hasAnimations = false;
+  if (animator) {
+    changed = animator->update(time, this);
+    hasAnimations = !animator->empty();
+    if (changed) {
+      // The presentation matrix and alpha don't change the content of the layer, but they change
+      // how it is drawn into its ancestors, which may have cached a rasterized image of it.
+      invalidateOverlapAnalysis();
+      invalidate();
+    }
+  }
+  for (const auto& child : _children) {
+    if (child->updateAnimations(time)) {
+      changed = true;
+    }
+    hasAnimations = hasAnimations || child->bitFields.hasAnimations;
+  }
+  bitFields.hasAnimations = hasAnimations;
+  return changed;
+}
+
 LayerContent* Layer::getContent() {
   if (bitFields.contentDirty) {
     layerContent = onUpdateContent();
@@ -679,15 +791,108 @@ void Layer::drawLayer(const DrawArgs& args, Canvas* canvas, float alpha, BlendMo
   DEBUG_ASSERT(canvas != nullptr);
   if (auto rasterizedCache = getRasterizedCache(args)) {
     rasterizedCache->draw(canvas, getLayerPaint(alpha, blendMode));
-  } else if (blendMode != BlendMode::SrcOver || (alpha < 1.0f && allowsGroupOpacity()) ||
-             (!_filters.empty() && !args.excludeEffects) || hasValidMask()) {
+  } else if (requiresOffscreen(args, alpha, blendMode)) {
     drawOffscreen(args, canvas, alpha, blendMode);
+  } else if (blendMode != BlendMode::SrcOver) {
+    // The layer is drawn by a single draw call, so the blend mode can be applied to it directly.
+    getContent()->draw(canvas, getLayerPaint(alpha, blendMode));
+    // None of the children are visible, but they still need to report their later changes.
+    if (args.cleanDirtyFlags) {
+      bitFields.childrenDirty = false;
+    }
   } else {
     // draw directly
     drawDirectly(args, canvas, alpha);
   }
 }
 
+bool Layer::requiresOffscreen(const DrawArgs& args, float alpha, BlendMode blendMode) {
+  if ((!_filters.empty() && !args.excludeEffects) || hasValidMask()) {
+    return true;
+  }
+  if (blendMode != BlendMode::SrcOver) {
+    if (args.forContour || hasChildrenToDraw() || (!_layerStyles.empty() && !args.excludeEffects)) {
+      return true;
+    }
+    auto content = getContent();
+    return content == nullptr || !content->isSingleDraw();
+  }
+  if (alpha < 1.0f && allowsGroupOpacity()) {
+    // Folding the alpha into each draw call gives the same result as compositing the layer as a
+    // group only if none of the draw calls overlap each other.
+    return !canDrawWithoutOverlap(args);
+  }
+  return false;
+}
+
+bool Layer::drawsAsSingleImage(const DrawArgs& args) const {
+  return (bitFields.shouldRasterize && args.context != nullptr &&
+          !(args.renderFlags & RenderFlags::DisableCache)) ||
+         (!_filters.empty() && !args.excludeEffects) || hasValidMask();
+}
+
+bool Layer::hasChildrenToDraw() const {
+  return std::any_of(_children.begin(), _children.end(), [](const auto& child) {
+    return child->visible() && child->getPresentationAlpha() > 0 && !child->maskOwner;
+  });
+}
+
+bool Layer::canDrawWithoutOverlap(const DrawArgs& args) {
+  // The result only depends on the layer tree when drawing with the default arguments, which is
+  // also the only case where the dirty flags get cleaned and keep the cache up to date.
+  auto cacheable = args.cleanDirtyFlags && !args.excludeEffects && !args.forContour;
+  if (cacheable && bitFields.overlapAnalyzed) {
+    return bitFields.drawsWithoutOverlap;
+  }
+  auto result = [&]() {
+    if (!_layerStyles.empty() && !args.excludeEffects) {
+      return false;
+    }
+    std::vector<Rect> rects = {};
+    if (auto content = getContent()) {
+      if (!content->isSingleDraw()) {
+        return false;
+      }
+      rects.push_back(content->getBounds());
+    }
+    for (const auto& child : _children) {
+      if (!child->visible() || child->getPresentationAlpha() <= 0 || child->maskOwner) {
+        continue;
+      }
+      if (child->_blendMode != BlendMode::SrcOver) {
+        return false;
+      }
+      // A child that allows group opacity always receives an alpha below 1 here, so it is either
+      // composited as a single image or folds the alpha itself.
+      if (!child->allowsGroupOpacity() && !child->drawsAsSingleImage(args) &&
+          !child->canDrawWithoutOverlap(args)) {
+        return false;
+      }
+      // The unmasked bounds are larger than the masked ones, which is fine for the overlap test.
+      auto childBounds = child->getBounds();
+      if (child->_scrollRect && !childBounds.intersect(*child->_scrollRect)) {
+        continue;
+      }
+      child->getPresentationMatrix().mapRect(&childBounds);
+      rects.push_back(childBounds);
+    }
+    return !HasOverlap(&rects);
+  }();
+  if (cacheable) {
+    bitFields.overlapAnalyzed = true;
+    bitFields.drawsWithoutOverlap = result;
+  }
+  return result;
+}
+
+void Layer::invalidateOverlapAnalysis() {
+  auto layer = this;
+  while (layer) {
+    layer->bitFields.overlapAnalyzed = false;
+    layer = layer->_parent;
+  }
+}
+
 Matrix Layer::getRelativeMatrix(const Layer* targetCoordinateSpace) const {
   if (targetCoordinateSpace == nullptr || targetCoordinateSpace == this) {
     return Matrix::I();
@@ -773,15 +978,16 @@ void Layer::drawContents(LayerContent* content, Canvas* canvas, float alpha, boo
 
 void Layer::drawChildren(const DrawArgs& args, Canvas* canvas, float alpha) {
   for (const auto& child : _children) {
-    if (!child->visible() || child->_alpha <= 0 || child->maskOwner) {
+    auto childAlpha = child->getPresentationAlpha();
+    if (!child->visible() || childAlpha <= 0 || child->maskOwner) {
       continue;
     }
     AutoCanvasRestore autoRestore(canvas);
-    canvas->concat(child->getMatrixWithScrollRect());
+    canvas->concat(child->getPresentationMatrix());
     if (child->_scrollRect) {
       canvas->clipRect(*child->_scrollRect);
     }
-    child->drawLayer(args, canvas, child->_alpha * alpha, child->_blendMode);
+    child->drawLayer(args, canvas, childAlpha * alpha, child->_blendMode);
   }
   if (args.cleanDirtyFlags) {
     bitFields.childrenDirty = false;
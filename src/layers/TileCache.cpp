@@ -0,0 +1,78 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "TileCache.h"
+#include <algorithm>
+#include <vector>
+
+namespace tgfx {
+static int64_t TileKey(int tileX, int tileY) {
+  return static_cast<int64_t>(static_cast<uint64_t>(static_cast<uint32_t>(tileX)) << 32 |
+                              static_cast<uint32_t>(tileY));
+}
+
+std::shared_ptr<Image> TileCache::getTile(int tileX, int tileY, uint64_t frame) {
+  auto result = tiles.find(TileKey(tileX, tileY));
+  if (result == tiles.end()) {
+    return nullptr;
+  }
+  result->second.lastUsedFrame = frame;
+  return result->second.image;
+}
+
+void TileCache::addTile(int tileX, int tileY, std::shared_ptr<Image> image, uint64_t frame) {
+  tiles[TileKey(tileX, tileY)] = {std::move(image), frame, tileX, tileY};
+}
+
+void TileCache::removeTiles(const Rect& rect, float tileSize) {
+  if (rect.isEmpty()) {
+    return;
+  }
+  for (auto item = tiles.begin(); item != tiles.end();) {
+    auto& tile = item->second;
+    auto tileRect = Rect::MakeXYWH(static_cast<float>(tile.tileX) * tileSize,
+                                   static_cast<float>(tile.tileY) * tileSize, tileSize, tileSize);
+    if (Rect::Intersects(tileRect, rect)) {
+      item = tiles.erase(item);
+    } else {
+      ++item;
+    }
+  }
+}
+
+void TileCache::clear() {
+  tiles.clear();
+}
+
+void TileCache::purgeToCount(size_t maxCount) {
+  if (tiles.size() <= maxCount) {
+    return;
+  }
+  std::vector<std::pair<uint64_t, int64_t>> usages = {};
+  usages.reserve(tiles.size());
+  for (auto& item : tiles) {
+    usages.emplace_back(item.second.lastUsedFrame, item.first);
+  }
+  auto purgeCount = tiles.size() - maxCount;
+  std::partial_sort(usages.begin(), usages.begin() + static_cast<std::ptrdiff_t>(purgeCount),
+                    usages.end());
+  for (size_t i = 0; i < purgeCount; i++) {
+    tiles.erase(usages[i].second);
+  }
+}
+}  // namespace tgfx
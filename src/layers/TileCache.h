@@ -0,0 +1,76 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <unordered_map>
+#include "tgfx/core/Image.h"
+
+namespace tgfx {
+/**
+ * TileCache holds the rendered tiles of a DisplayList in tiled render mode, indexed by their
+ * coordinates in the tile grid. The textures of the tiles are returned to the ResourceCache as
+ * scratch resources once the tiles are evicted, so they can be reused by the next tiles.
+ */
+class TileCache {
+ public:
+  /**
+   * Returns the number of tiles in the cache.
+   */
+  size_t size() const {
+    return tiles.size();
+  }
+
+  /**
+   * Returns the image of the tile at the given grid coordinates and marks it as used in the given
+   * frame. Returns nullptr if the tile is not cached.
+   */
+  std::shared_ptr<Image> getTile(int tileX, int tileY, uint64_t frame);
+
+  /**
+   * Adds the image of the tile at the given grid coordinates to the cache.
+   */
+  void addTile(int tileX, int tileY, std::shared_ptr<Image> image, uint64_t frame);
+
+  /**
+   * Removes the tiles intersecting the given rect, which is in the coordinates of the tile grid
+   * scaled by the tile size.
+   */
+  void removeTiles(const Rect& rect, float tileSize);
+
+  /**
+   * Removes all tiles from the cache.
+   */
+  void clear();
+
+  /**
+   * Evicts the least recently used tiles until the cache holds no more than maxCount tiles.
+   */
+  void purgeToCount(size_t maxCount);
+
+ private:
+  struct Tile {
+    std::shared_ptr<Image> image = nullptr;
+    uint64_t lastUsedFrame = 0;
+    int tileX = 0;
+    int tileY = 0;
+  };
+
+  std::unordered_map<int64_t, Tile> tiles = {};
+};
+}  // namespace tgfx
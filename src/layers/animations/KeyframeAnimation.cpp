@@ -0,0 +1,82 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "tgfx/layers/animations/KeyframeAnimation.h"
+#include <algorithm>
+
+namespace tgfx {
+std::shared_ptr<KeyframeAnimation> KeyframeAnimation::Make(AnimationProperty property,
+                                                           float fromValue, float toValue) {
+  return Make(property, {fromValue, toValue});
+}
+
+std::shared_ptr<KeyframeAnimation> KeyframeAnimation::Make(AnimationProperty property,
+                                                           std::vector<float> values,
+                                                           std::vector<float> keyTimes) {
+  if (values.empty()) {
+    return nullptr;
+  }
+  return std::shared_ptr<KeyframeAnimation>(
+      new KeyframeAnimation(property, std::move(values), std::move(keyTimes)));
+}
+
+KeyframeAnimation::KeyframeAnimation(AnimationProperty property, std::vector<float> values,
+                                     std::vector<float> keyTimes)
+    : Animation(property), _values(std::move(values)), _keyTimes(std::move(keyTimes)) {
+  auto count = _values.size();
+  if (_keyTimes.size() != count || !std::is_sorted(_keyTimes.begin(), _keyTimes.end())) {
+    _keyTimes.resize(count);
+    for (size_t i = 0; i < count; i++) {
+      _keyTimes[i] = count > 1 ? static_cast<float>(i) / static_cast<float>(count - 1) : 0.0f;
+    }
+  }
+}
+
+void KeyframeAnimation::setTimingFunctions(std::vector<std::shared_ptr<TimingFunction>> value) {
+  _timingFunctions = std::move(value);
+}
+
+void KeyframeAnimation::setTimingFunction(std::shared_ptr<TimingFunction> value) {
+  _timingFunctions.clear();
+  if (value != nullptr) {
+    _timingFunctions.push_back(std::move(value));
+  }
+}
+
+float KeyframeAnimation::getValue(float fraction) const {
+  if (_values.size() == 1 || fraction <= _keyTimes.front()) {
+    return _values.front();
+  }
+  if (fraction >= _keyTimes.back()) {
+    return _values.back();
+  }
+  auto next = std::upper_bound(_keyTimes.begin(), _keyTimes.end(), fraction) - _keyTimes.begin();
+  auto index = static_cast<size_t>(next - 1);
+  auto startTime = _keyTimes[index];
+  auto segmentLength = _keyTimes[index + 1] - startTime;
+  auto progress = segmentLength > 0 ? (fraction - startTime) / segmentLength : 1.0f;
+  if (!_timingFunctions.empty()) {
+    auto& timingFunction = _timingFunctions[std::min(index, _timingFunctions.size() - 1)];
+    if (timingFunction != nullptr) {
+      progress = timingFunction->getValue(progress);
+    }
+  }
+  auto startValue = _values[index];
+  return startValue + (_values[index + 1] - startValue) * progress;
+}
+}  // namespace tgfx
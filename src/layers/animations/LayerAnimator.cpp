@@ -0,0 +1,214 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "layers/animations/LayerAnimator.h"
+#include <cmath>
+#include "tgfx/layers/ShapeLayer.h"
+
+namespace tgfx {
+static constexpr size_t PresentationPropertyCount = 6;
+
+static bool IsPresentationProperty(AnimationProperty property) {
+  return static_cast<size_t>(property) < PresentationPropertyCount;
+}
+
+/**
+ * Computes the fraction of the current iteration at the given time relative to the beginning of
+ * the animation. Returns true if the animation has finished, in which case the fraction is set to
+ * the final position of the animation.
+ */
+static bool GetIterationFraction(const Animation* animation, int64_t localTime, float* fraction) {
+  auto duration = animation->duration();
+  auto repeatCount = static_cast<double>(animation->repeatCount());
+  if (duration <= 0 || repeatCount <= 0) {
+    *fraction = animation->autoreverses() ? 0.0f : 1.0f;
+    return true;
+  }
+  auto iterations = static_cast<double>(localTime) / static_cast<double>(duration);
+  auto finished = !std::isinf(repeatCount) && iterations >= repeatCount;
+  double index = 0;
+  double progress = 0;
+  if (finished) {
+    index = ceil(repeatCount) - 1.0;
+    progress = repeatCount - index;
+  } else {
+    index = floor(iterations);
+    progress = iterations - index;
+  }
+  if (animation->autoreverses() && fmod(index, 2.0) != 0.0) {
+    progress = 1.0 - progress;
+  }
+  *fraction = static_cast<float>(progress);
+  return finished;
+}
+
+static void CommitValue(Layer* layer, AnimationProperty property, float value) {
+  switch (property) {
+    case AnimationProperty::Alpha:
+      layer->setAlpha(value);
+      break;
+    case AnimationProperty::PositionX:
+      layer->setPosition({value, layer->position().y});
+      break;
+    case AnimationProperty::PositionY:
+      layer->setPosition({layer->position().x, value});
+      break;
+    case AnimationProperty::ScaleX: {
+      auto matrix = layer->matrix();
+      matrix.preScale(value, 1.0f);
+      layer->setMatrix(matrix);
+    } break;
+    case AnimationProperty::ScaleY: {
+      auto matrix = layer->matrix();
+      matrix.preScale(1.0f, value);
+      layer->setMatrix(matrix);
+    } break;
+    case AnimationProperty::Rotation: {
+      auto matrix = layer->matrix();
+      matrix.preRotate(value);
+      layer->setMatrix(matrix);
+    } break;
+    case AnimationProperty::StrokeStart:
+      if (layer->type() == LayerType::Shape) {
+        static_cast<ShapeLayer*>(layer)->setStrokeStart(value);
+      }
+      break;
+    case AnimationProperty::StrokeEnd:
+      if (layer->type() == LayerType::Shape) {
+        static_cast<ShapeLayer*>(layer)->setStrokeEnd(value);
+      }
+      break;
+  }
+}
+
+std::vector<std::shared_ptr<Animation>> LayerAnimator::animations() const {
+  std::vector<std::shared_ptr<Animation>> result = {};
+  result.reserve(tracks.size());
+  for (auto& track : tracks) {
+    result.push_back(track.animation);
+  }
+  return result;
+}
+
+void LayerAnimator::addAnimation(std::shared_ptr<Animation> animation) {
+  for (auto& track : tracks) {
+    if (track.animation->property() == animation->property()) {
+      track.animation = std::move(animation);
+      track.beginTime = -1;
+      return;
+    }
+  }
+  tracks.push_back({std::move(animation), -1});
+}
+
+bool LayerAnimator::removeAnimation(const Animation* animation) {
+  for (auto track = tracks.begin(); track != tracks.end(); ++track) {
+    if (track->animation.get() == animation) {
+      // The layer invalidates itself after the removal, so the change needs no reporting.
+      animatedFlags &= ~(1u << static_cast<size_t>(animation->property()));
+      tracks.erase(track);
+      return true;
+    }
+  }
+  return false;
+}
+
+bool LayerAnimator::update(int64_t time, Layer* layer) {
+  bool changed = false;
+  // Committing values may call back into the layer, so finished tracks are collected first.
+  std::vector<std::pair<AnimationProperty, float>> finishedValues = {};
+  for (auto track = tracks.begin(); track != tracks.end();) {
+    auto animation = track->animation.get();
+    auto property = animation->property();
+    if (track->beginTime < 0) {
+      track->beginTime = time + animation->delay();
+    }
+    if (time < track->beginTime) {
+      clearPresentationValue(property, &changed);
+      ++track;
+      continue;
+    }
+    float fraction = 0.0f;
+    auto finished = GetIterationFraction(animation, time - track->beginTime, &fraction);
+    auto value = animation->getValue(fraction);
+    if (finished) {
+      clearPresentationValue(property, &changed);
+      finishedValues.emplace_back(property, value);
+      track = tracks.erase(track);
+      continue;
+    }
+    if (IsPresentationProperty(property)) {
+      setPresentationValue(property, value, &changed);
+    } else {
+      CommitValue(layer, property, value);
+    }
+    ++track;
+  }
+  for (auto& item : finishedValues) {
+    CommitValue(layer, item.first, item.second);
+  }
+  return changed || !finishedValues.empty();
+}
+
+float LayerAnimator::getAlpha(float alpha) const {
+  return getValue(AnimationProperty::Alpha, alpha);
+}
+
+void LayerAnimator::applyToMatrix(Matrix* matrix) const {
+  if (hasValue(AnimationProperty::PositionX)) {
+    matrix->setTranslateX(getValue(AnimationProperty::PositionX, 0.0f));
+  }
+  if (hasValue(AnimationProperty::PositionY)) {
+    matrix->setTranslateY(getValue(AnimationProperty::PositionY, 0.0f));
+  }
+  if (hasValue(AnimationProperty::Rotation)) {
+    matrix->preRotate(getValue(AnimationProperty::Rotation, 0.0f));
+  }
+  if (hasValue(AnimationProperty::ScaleX) || hasValue(AnimationProperty::ScaleY)) {
+    matrix->preScale(getValue(AnimationProperty::ScaleX, 1.0f),
+                     getValue(AnimationProperty::ScaleY, 1.0f));
+  }
+}
+
+void LayerAnimator::setPresentationValue(AnimationProperty property, float value, bool* changed) {
+  auto index = static_cast<size_t>(property);
+  if (hasValue(property) && values[index] == value) {
+    return;
+  }
+  values[index] = value;
+  animatedFlags |= 1u << index;
+  *changed = true;
+}
+
+void LayerAnimator::clearPresentationValue(AnimationProperty property, bool* changed) {
+  if (!hasValue(property)) {
+    return;
+  }
+  animatedFlags &= ~(1u << static_cast<size_t>(property));
+  *changed = true;
+}
+
+bool LayerAnimator::hasValue(AnimationProperty property) const {
+  return IsPresentationProperty(property) &&
+         (animatedFlags & (1u << static_cast<size_t>(property))) != 0;
+}
+
+float LayerAnimator::getValue(AnimationProperty property, float defaultValue) const {
+  return hasValue(property) ? values[static_cast<size_t>(property)] : defaultValue;
+}
+}  // namespace tgfx
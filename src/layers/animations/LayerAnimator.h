@@ -0,0 +1,85 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <vector>
+#include "tgfx/core/Matrix.h"
+#include "tgfx/layers/animations/Animation.h"
+
+namespace tgfx {
+class Layer;
+
+/**
+ * LayerAnimator keeps track of the animations attached to a layer, evaluates them at a given time,
+ * and holds the resulting presentation values used when compositing the layer.
+ */
+class LayerAnimator {
+ public:
+  bool empty() const {
+    return tracks.empty();
+  }
+
+  std::vector<std::shared_ptr<Animation>> animations() const;
+
+  /**
+   * Adds the animation to the animator. Any existing animation of the same property is replaced.
+   */
+  void addAnimation(std::shared_ptr<Animation> animation);
+
+  /**
+   * Removes the animation from the animator. Returns true if the animation was found.
+   */
+  bool removeAnimation(const Animation* animation);
+
+  /**
+   * Evaluates all animations at the given time and applies their values to the layer. Finished
+   * animations commit their final values to the layer and are removed. Returns true if any
+   * presentation value has changed.
+   */
+  bool update(int64_t time, Layer* layer);
+
+  /**
+   * Returns the presentation alpha of the layer, given its model alpha.
+   */
+  float getAlpha(float alpha) const;
+
+  /**
+   * Applies the animated transform properties to the given model matrix of the layer.
+   */
+  void applyToMatrix(Matrix* matrix) const;
+
+ private:
+  struct Track {
+    std::shared_ptr<Animation> animation = nullptr;
+    int64_t beginTime = -1;
+  };
+
+  std::vector<Track> tracks = {};
+  float values[6] = {};
+  uint32_t animatedFlags = 0;
+
+  void setPresentationValue(AnimationProperty property, float value, bool* changed);
+
+  void clearPresentationValue(AnimationProperty property, bool* changed);
+
+  bool hasValue(AnimationProperty property) const;
+
+  float getValue(AnimationProperty property, float defaultValue) const;
+};
+}  // namespace tgfx
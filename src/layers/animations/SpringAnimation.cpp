@@ -0,0 +1,112 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "tgfx/layers/animations/SpringAnimation.h"
+#include <algorithm>
+#include <cmath>
+
+namespace tgfx {
+// The spring is considered settled once its oscillation envelope decays below this ratio of the
+// initial displacement.
+static constexpr double SettleThreshold = 0.001;
+static constexpr double MaxSettleSeconds = 10.0;
+
+std::shared_ptr<SpringAnimation> SpringAnimation::Make(AnimationProperty property,
+                                                       float fromValue, float toValue) {
+  return std::shared_ptr<SpringAnimation>(new SpringAnimation(property, fromValue, toValue));
+}
+
+SpringAnimation::SpringAnimation(AnimationProperty property, float fromValue, float toValue)
+    : Animation(property), _fromValue(fromValue), _toValue(toValue) {
+}
+
+void SpringAnimation::setMass(float value) {
+  if (value > 0) {
+    _mass = value;
+  }
+}
+
+void SpringAnimation::setStiffness(float value) {
+  if (value > 0) {
+    _stiffness = value;
+  }
+}
+
+void SpringAnimation::setDamping(float value) {
+  if (value >= 0) {
+    _damping = value;
+  }
+}
+
+void SpringAnimation::setInitialVelocity(float value) {
+  _initialVelocity = value;
+}
+
+int64_t SpringAnimation::duration() const {
+  auto omega = sqrt(static_cast<double>(_stiffness) / _mass);
+  auto zeta = _damping / (2.0 * sqrt(static_cast<double>(_stiffness) * _mass));
+  // The slowest decay rate of the envelope, which determines the settling time.
+  double decayRate = 0.0;
+  if (zeta < 1.0) {
+    decayRate = zeta * omega;
+  } else {
+    decayRate = omega * (zeta - sqrt(zeta * zeta - 1.0));
+  }
+  auto seconds = MaxSettleSeconds;
+  if (decayRate > 0.0) {
+    seconds = std::min(-log(SettleThreshold) / decayRate, MaxSettleSeconds);
+  }
+  return static_cast<int64_t>(seconds * 1000000.0);
+}
+
+float SpringAnimation::getValue(float fraction) const {
+  if (fraction >= 1.0f) {
+    return _toValue;
+  }
+  auto seconds = fraction * static_cast<float>(duration()) / 1000000.0f;
+  return _toValue + getDisplacement(seconds);
+}
+
+float SpringAnimation::getDisplacement(float seconds) const {
+  auto t = static_cast<double>(seconds);
+  double x0 = _fromValue - _toValue;
+  double v0 = _initialVelocity;
+  auto omega = sqrt(static_cast<double>(_stiffness) / _mass);
+  auto zeta = _damping / (2.0 * sqrt(static_cast<double>(_stiffness) * _mass));
+  double displacement = 0.0;
+  if (zeta < 1.0) {
+    // Under-damped: oscillates around the target with a decaying envelope.
+    auto dampedOmega = omega * sqrt(1.0 - zeta * zeta);
+    auto envelope = exp(-zeta * omega * t);
+    displacement = envelope * (x0 * cos(dampedOmega * t) +
+                               (v0 + zeta * omega * x0) / dampedOmega * sin(dampedOmega * t));
+  } else if (zeta == 1.0) {
+    // Critically damped: returns to the target as fast as possible without oscillating.
+    displacement = exp(-omega * t) * (x0 + (v0 + omega * x0) * t);
+  } else {
+    // Over-damped: returns to the target slowly without oscillating.
+    auto root = sqrt(zeta * zeta - 1.0);
+    auto r1 = -omega * (zeta - root);
+    auto r2 = -omega * (zeta + root);
+    auto c1 = (v0 - r2 * x0) / (r1 - r2);
+    auto c2 = x0 - c1;
+    displacement = c1 * exp(r1 * t) + c2 * exp(r2 * t);
+  }
+  return static_cast<float>(displacement);
+}
+}  // namespace tgfx
@@ -0,0 +1,141 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "tgfx/layers/animations/TimingFunction.h"
+#include <algorithm>
+#include <cmath>
+
+namespace tgfx {
+class LinearTimingFunction : public TimingFunction {
+ public:
+  float getValue(float progress) const override {
+    return progress;
+  }
+};
+
+class CubicBezierTimingFunction : public TimingFunction {
+ public:
+  CubicBezierTimingFunction(float x1, float y1, float x2, float y2) {
+    // The polynomial coefficients of the curve, with the end points fixed at (0, 0) and (1, 1).
+    cx = 3.0f * x1;
+    bx = 3.0f * (x2 - x1) - cx;
+    ax = 1.0f - cx - bx;
+    cy = 3.0f * y1;
+    by = 3.0f * (y2 - y1) - cy;
+    ay = 1.0f - cy - by;
+  }
+
+  float getValue(float progress) const override {
+    if (progress <= 0.0f) {
+      return 0.0f;
+    }
+    if (progress >= 1.0f) {
+      return 1.0f;
+    }
+    return sampleY(solveT(progress));
+  }
+
+ private:
+  float ax = 0.0f;
+  float bx = 0.0f;
+  float cx = 0.0f;
+  float ay = 0.0f;
+  float by = 0.0f;
+  float cy = 0.0f;
+
+  float sampleX(float t) const {
+    return ((ax * t + bx) * t + cx) * t;
+  }
+
+  float sampleY(float t) const {
+    return ((ay * t + by) * t + cy) * t;
+  }
+
+  float sampleDerivativeX(float t) const {
+    return (3.0f * ax * t + 2.0f * bx) * t + cx;
+  }
+
+  float solveT(float x) const {
+    static constexpr float Epsilon = 1e-6f;
+    // Newton's method converges quickly for most curves.
+    auto t = x;
+    for (int i = 0; i < 8; i++) {
+      auto error = sampleX(t) - x;
+      if (fabsf(error) < Epsilon) {
+        return t;
+      }
+      auto derivative = sampleDerivativeX(t);
+      if (fabsf(derivative) < Epsilon) {
+        break;
+      }
+      t -= error / derivative;
+    }
+    // Falls back to bisection, which always converges since x(t) is monotonic in [0, 1].
+    float low = 0.0f;
+    float high = 1.0f;
+    t = x;
+    while (low < high) {
+      auto value = sampleX(t);
+      if (fabsf(value - x) < Epsilon) {
+        break;
+      }
+      if (x > value) {
+        low = t;
+      } else {
+        high = t;
+      }
+      auto middle = (high - low) * 0.5f + low;
+      if (middle == t) {
+        break;
+      }
+      t = middle;
+    }
+    return t;
+  }
+};
+
+std::shared_ptr<TimingFunction> TimingFunction::Linear() {
+  static auto linear = std::make_shared<LinearTimingFunction>();
+  return linear;
+}
+
+std::shared_ptr<TimingFunction> TimingFunction::EaseIn() {
+  static auto easeIn = MakeCubicBezier(0.42f, 0.0f, 1.0f, 1.0f);
+  return easeIn;
+}
+
+std::shared_ptr<TimingFunction> TimingFunction::EaseOut() {
+  static auto easeOut = MakeCubicBezier(0.0f, 0.0f, 0.58f, 1.0f);
+  return easeOut;
+}
+
+std::shared_ptr<TimingFunction> TimingFunction::EaseInOut() {
+  static auto easeInOut = MakeCubicBezier(0.42f, 0.0f, 0.58f, 1.0f);
+  return easeInOut;
+}
+
+std::shared_ptr<TimingFunction> TimingFunction::MakeCubicBezier(float x1, float y1, float x2,
+                                                                float y2) {
+  x1 = std::clamp(x1, 0.0f, 1.0f);
+  x2 = std::clamp(x2, 0.0f, 1.0f);
+  if (x1 == y1 && x2 == y2) {
+    return Linear();
+  }
+  return std::make_shared<CubicBezierTimingFunction>(x1, y1, x2, y2);
+}
+}  // namespace tgfx
@@ -32,6 +32,10 @@ class ImageContent : public LayerContent {
 
   void draw(Canvas* canvas, const Paint& paint) const override;
 
+  bool isSingleDraw() const override {
+    return true;
+  }
+
   bool hitTestPoint(float localX, float localY, bool pixelHitTest) override;
 
  private:
@@ -38,6 +38,10 @@ class RasterizedContent : public LayerContent {
 
   void draw(Canvas* canvas, const Paint& paint) const override;
 
+  bool isSingleDraw() const override {
+    return true;
+  }
+
   bool hitTestPoint(float localX, float localY, bool pixelHitTest) override;
 
   std::shared_ptr<Image> getImage() const {
@@ -35,6 +35,10 @@ void ShapeContent::draw(Canvas* canvas, const Paint& paint) const {
   drawStrokes(canvas, paint, false);
 }
 
+bool ShapeContent::isSingleDraw() const {
+  return paintList.size() == 1 && paintList.front().blendMode == BlendMode::SrcOver;
+}
+
 static void DrawShape(Canvas* canvas, const Paint& paint, std::shared_ptr<Shape> shape,
                       bool forContour, const std::vector<ShapePaint>::const_iterator& begin,
                       const std::vector<ShapePaint>::const_iterator& end) {
@@ -49,8 +53,11 @@ static void DrawShape(Canvas* canvas, const Paint& paint, std::shared_ptr<Shape>
   for (auto iter = begin; iter != end; iter++) {
     auto drawPaint = paint;
     drawPaint.setAlpha(paint.getAlpha() * iter->alpha);
-    // The blend mode in the paint is always SrcOver, use our own blend mode instead.
-    drawPaint.setBlendMode(iter->blendMode);
+    // The blend mode in the paint comes from the layer, which is only allowed to be something
+    // other than SrcOver when the content is a single draw with the SrcOver blend mode.
+    if (iter->blendMode != BlendMode::SrcOver) {
+      drawPaint.setBlendMode(iter->blendMode);
+    }
     drawPaint.setShader(iter->shader);
     canvas->drawShape(shape, drawPaint);
   }
@@ -43,6 +43,8 @@ class ShapeContent : public LayerContent {
 
   void draw(Canvas* canvas, const Paint& paint) const override;
 
+  bool isSingleDraw() const override;
+
   bool drawFills(Canvas* canvas, const Paint& paint, bool forContour) const;
 
   bool drawStrokes(Canvas* canvas, const Paint& paint, bool forContour) const;
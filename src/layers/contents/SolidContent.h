@@ -31,6 +31,10 @@ class SolidContent : public LayerContent {
 
   void draw(Canvas* canvas, const Paint& paint) const override;
 
+  bool isSingleDraw() const override {
+    return true;
+  }
+
   bool hitTestPoint(float localX, float localY, bool pixelHitTest) override;
 
  private:
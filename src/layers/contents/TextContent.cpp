@@ -32,6 +32,14 @@ void TextContent::draw(Canvas* canvas, const Paint& paint) const {
   canvas->drawTextBlob(textBlob, 0, 0, textPaint);
 }
 
+bool TextContent::isSingleDraw() const {
+  // Each GlyphRunList is drawn separately, and color glyphs are drawn one by one, so overlapping
+  // glyphs would be blended multiple times if the layer alpha were folded into them.
+  auto glyphRunLists = GlyphRunList::Unwrap(textBlob.get());
+  return glyphRunLists != nullptr && glyphRunLists->size() == 1 &&
+         !glyphRunLists->front()->hasColor();
+}
+
 bool TextContent::hitTestPoint(float localX, float localY, bool pixelHitTest) {
   if (pixelHitTest) {
     const auto glyphRunLists = GlyphRunList::Unwrap(textBlob.get());
@@ -31,6 +31,8 @@ class TextContent : public LayerContent {
 
   void draw(Canvas* canvas, const Paint& paint) const override;
 
+  bool isSingleDraw() const override;
+
   bool hitTestPoint(float localX, float localY, bool pixelHitTest) override;
 
  private:
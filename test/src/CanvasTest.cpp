@@ -16,20 +16,28 @@
 //
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
+#include "core/ContourMeasures.h"
 #include "core/FillStyle.h"
 #include "core/PathRef.h"
+#include "core/PathTriangulator.h"
 #include "core/Records.h"
+#include "core/ShapeRasterizer.h"
 #include "core/images/ResourceImage.h"
 #include "core/images/SubsetImage.h"
 #include "core/images/TransformImage.h"
 #include "core/shapes/AppendShape.h"
 #include "core/shapes/ProviderShape.h"
 #include "gpu/DrawingManager.h"
+#include "gpu/ProxyProvider.h"
 #include "gpu/Texture.h"
 #include "gpu/opengl/GLCaps.h"
 #include "gpu/opengl/GLSampler.h"
+#include "gpu/ops/ConvexPathDrawOp.h"
 #include "gpu/ops/RRectDrawOp.h"
 #include "gpu/ops/RectDrawOp.h"
+#include "gpu/ops/ShapeDrawOp.h"
+#include "gpu/ops/StrokeDrawOp.h"
+#include "gpu/ops/TessellatedPathDrawOp.h"
 #include "tgfx/core/Buffer.h"
 #include "tgfx/core/Canvas.h"
 #include "tgfx/core/ImageCodec.h"
@@ -183,6 +191,296 @@ TGFX_TEST(CanvasTest, merge_draw_call_rrect) {
   EXPECT_TRUE(Baseline::Compare(surface, "CanvasTest/merge_draw_call_rrect"));
 }
 
+TGFX_TEST(CanvasTest, merge_draw_call_stroke) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  int width = 64;
+  int height = 64;
+  auto surface = Surface::Make(context, width, height);
+  auto canvas = surface->getCanvas();
+  canvas->clear(Color::White());
+  Paint paint;
+  paint.setStyle(PaintStyle::Stroke);
+  paint.setStrokeWidth(4.0f);
+  paint.setColor(Color::Red());
+  size_t drawCallCount = 0;
+  for (int y = 8; y < height; y += 16) {
+    canvas->drawLine(4.0f, static_cast<float>(y), 60.0f, static_cast<float>(y), paint);
+    drawCallCount++;
+  }
+  Path path = {};
+  path.moveTo(4.0f, 60.0f);
+  path.lineTo(32.0f, 44.0f);
+  path.quadTo(48.0f, 60.0f, 60.0f, 44.0f);
+  canvas->drawPath(path, paint);
+  drawCallCount++;
+  auto* drawingManager = context->drawingManager();
+  EXPECT_TRUE(drawingManager->renderTasks.size() == 1);
+  auto task = std::static_pointer_cast<OpsRenderTask>(drawingManager->renderTasks[0]);
+  ASSERT_TRUE(task->ops.size() == 2);
+  ASSERT_EQ(task->ops[1]->classID(), StrokeDrawOp::ClassID());
+  EXPECT_EQ(static_cast<StrokeDrawOp*>(task->ops[1].get())->strokePaints.size(), drawCallCount);
+  context->flush();
+  auto info = ImageInfo::Make(width, height, ColorType::RGBA_8888, AlphaType::Premultiplied);
+  Buffer pixels(info.byteSize());
+  ASSERT_TRUE(pixels.data() != nullptr);
+  ASSERT_TRUE(surface->readPixels(info, pixels.data()));
+  auto pixelAt = [&](int x, int y) {
+    return pixels.bytes() + static_cast<size_t>(y) * info.rowBytes() + static_cast<size_t>(x) * 4;
+  };
+  // Inside the first line.
+  EXPECT_EQ(pixelAt(32, 8)[0], 255);
+  EXPECT_EQ(pixelAt(32, 8)[1], 0);
+  // Outside of the lines.
+  EXPECT_EQ(pixelAt(32, 14)[1], 255);
+  EXPECT_EQ(pixelAt(1, 8)[1], 255);
+
+  // Translucent polylines may cross themselves and fall back to the path renderer.
+  paint.setAlpha(0.5f);
+  canvas->drawPath(path, paint);
+  ASSERT_TRUE(drawingManager->renderTasks.size() == 1);
+  task = std::static_pointer_cast<OpsRenderTask>(drawingManager->renderTasks[0]);
+  ASSERT_TRUE(task->ops.size() == 1);
+  EXPECT_EQ(task->ops[0]->classID(), ShapeDrawOp::ClassID());
+  canvas->drawLine(4.0f, 8.0f, 60.0f, 8.0f, paint);
+  ASSERT_TRUE(task->ops.size() == 2);
+  EXPECT_EQ(task->ops[1]->classID(), StrokeDrawOp::ClassID());
+  context->flush();
+
+  // The antialiased fringe around a join is blended only once, like the fringe along a segment.
+  canvas->clear(Color::White());
+  paint.setAlpha(1.0f);
+  Path corner = {};
+  corner.moveTo(10.0f, 10.25f);
+  corner.lineTo(40.0f, 10.25f);
+  corner.lineTo(40.0f, 40.0f);
+  canvas->drawPath(corner, paint);
+  context->flush();
+  ASSERT_TRUE(surface->readPixels(info, pixels.data()));
+  auto edgeGreen = static_cast<int>(pixelAt(25, 8)[1]);
+  EXPECT_GT(edgeGreen, 32);
+  EXPECT_LT(edgeGreen, 224);
+  EXPECT_NEAR(pixelAt(40, 8)[1], edgeGreen, 2);
+  EXPECT_NEAR(pixelAt(41, 8)[1], edgeGreen, 2);
+}
+
+TGFX_TEST(CanvasTest, merge_draw_call_convex_path) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  int width = 64;
+  int height = 64;
+  auto surface = Surface::Make(context, width, height);
+  auto canvas = surface->getCanvas();
+  canvas->clear(Color::White());
+  Paint paint;
+  paint.setColor(Color::Red());
+  Path triangle = {};
+  triangle.moveTo(4.0f, 4.0f);
+  triangle.lineTo(28.0f, 4.0f);
+  triangle.lineTo(4.0f, 28.0f);
+  triangle.close();
+  canvas->drawPath(triangle, paint);
+  Path pie = {};
+  pie.moveTo(36.0f, 4.0f);
+  pie.lineTo(60.0f, 4.0f);
+  pie.arcTo(24.0f, 24.0f, 0.0f, PathArcSize::Small, false, Point::Make(36.0f, 28.0f));
+  pie.close();
+  paint.setColor(Color::Blue());
+  canvas->drawPath(pie, paint);
+  auto* drawingManager = context->drawingManager();
+  EXPECT_TRUE(drawingManager->renderTasks.size() == 1);
+  auto task = std::static_pointer_cast<OpsRenderTask>(drawingManager->renderTasks[0]);
+  ASSERT_TRUE(task->ops.size() == 2);
+  ASSERT_EQ(task->ops[1]->classID(), ConvexPathDrawOp::ClassID());
+  EXPECT_EQ(static_cast<ConvexPathDrawOp*>(task->ops[1].get())->convexPaints.size(), 2u);
+  // A star turns in one direction, but it is not convex.
+  Path star = {};
+  star.moveTo(32.0f, 36.0f);
+  star.lineTo(38.0f, 60.0f);
+  star.lineTo(20.0f, 44.0f);
+  star.lineTo(44.0f, 44.0f);
+  star.lineTo(26.0f, 60.0f);
+  star.close();
+  EXPECT_TRUE(ConvexPathDrawOp::Make(Color::Red(), Shape::MakeFrom(star), Matrix::I()) == nullptr);
+
+  auto info = ImageInfo::Make(width, height, ColorType::RGBA_8888, AlphaType::Premultiplied);
+  Buffer pixels(info.byteSize());
+  ASSERT_TRUE(pixels.data() != nullptr);
+  ASSERT_TRUE(surface->readPixels(info, pixels.data()));
+  auto pixelAt = [&](int x, int y) {
+    return pixels.bytes() + static_cast<size_t>(y) * info.rowBytes() + static_cast<size_t>(x) * 4;
+  };
+  EXPECT_EQ(pixelAt(8, 8)[0], 255);
+  EXPECT_EQ(pixelAt(8, 8)[1], 0);
+  EXPECT_EQ(pixelAt(24, 24)[1], 255);
+  EXPECT_EQ(pixelAt(40, 8)[2], 255);
+  EXPECT_EQ(pixelAt(40, 8)[1], 0);
+  EXPECT_EQ(pixelAt(62, 30)[1], 255);
+}
+
+TGFX_TEST(CanvasTest, tessellatedPath) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  int width = 64;
+  int height = 64;
+  auto info = ImageInfo::Make(width, height, ColorType::RGBA_8888, AlphaType::Premultiplied);
+  Buffer pixels(info.byteSize());
+  ASSERT_TRUE(pixels.data() != nullptr);
+  auto pixelAt = [&](int x, int y) {
+    return pixels.bytes() + static_cast<size_t>(y) * info.rowBytes() + static_cast<size_t>(x) * 4;
+  };
+  auto surface = Surface::Make(context, width, height);
+  auto canvas = surface->getCanvas();
+  canvas->clear(Color::White());
+  Paint paint;
+  paint.setColor(Color::Red());
+  paint.setAntiAlias(false);
+  Path path = {};
+  path.addRect(Rect::MakeXYWH(8, 8, 48, 48));
+  path.addOval(Rect::MakeXYWH(20, 20, 24, 24));
+  path.setFillType(PathFillType::EvenOdd);
+  canvas->drawPath(path, paint);
+  auto* drawingManager = context->drawingManager();
+  ASSERT_TRUE(drawingManager->renderTasks.size() == 1);
+  auto task = std::static_pointer_cast<OpsRenderTask>(drawingManager->renderTasks[0]);
+  ASSERT_TRUE(task->ops.size() == 2);
+  EXPECT_EQ(task->ops[1]->classID(), TessellatedPathDrawOp::ClassID());
+  ASSERT_TRUE(surface->readPixels(info, pixels.data()));
+  EXPECT_EQ(pixelAt(12, 12)[1], 0);
+  // The oval is a hole in the even-odd fill.
+  EXPECT_EQ(pixelAt(32, 32)[1], 255);
+  EXPECT_EQ(pixelAt(4, 4)[1], 255);
+
+  paint.setAntiAlias(true);
+  path.reset();
+  for (int i = 0; i < 180; i++) {
+    auto angle = static_cast<float>(i) * 2.0f * static_cast<float>(M_PI) / 180.0f;
+    auto radius = i % 2 == 0 ? 24.0f : 20.0f;
+    auto point = Point::Make(32.0f + radius * cosf(angle), 32.0f + radius * sinf(angle));
+    if (i == 0) {
+      path.moveTo(point);
+    } else {
+      path.lineTo(point);
+    }
+  }
+  path.close();
+  // Complex paths with antialiasing keep using the cached shape geometry.
+  canvas->clear(Color::White());
+  canvas->drawPath(path, paint);
+  task = std::static_pointer_cast<OpsRenderTask>(drawingManager->renderTasks.back());
+  ASSERT_FALSE(task->ops.empty());
+  EXPECT_EQ(task->ops.back()->classID(), ShapeDrawOp::ClassID());
+  context->flush();
+
+  // Without caching, they are tessellated into a multisampled mask when available.
+  auto uncachedSurface =
+      Surface::Make(context, width, height, false, 1, false, RenderFlags::DisableCache);
+  canvas = uncachedSurface->getCanvas();
+  canvas->clear(Color::White());
+  canvas->drawPath(path, paint);
+  ASSERT_TRUE(uncachedSurface->readPixels(info, pixels.data()));
+  EXPECT_EQ(pixelAt(32, 32)[1], 0);
+  EXPECT_EQ(pixelAt(4, 4)[1], 255);
+}
+
+TGFX_TEST(CanvasTest, parallelTessellation) {
+  Path path = {};
+  for (int y = 0; y < 30; y++) {
+    for (int x = 0; x < 30; x++) {
+      path.addRect(Rect::MakeXYWH(static_cast<float>(x) * 40.0f, static_cast<float>(y) * 40.0f,
+                                  10.0f, 10.0f));
+    }
+  }
+  // A large contour overlapping its neighbors keeps them in the same group.
+  path.addOval(Rect::MakeXYWH(5, 5, 100, 100));
+  auto bounds = path.getBounds();
+  auto width = static_cast<int>(ceilf(bounds.right));
+  auto height = static_cast<int>(ceilf(bounds.bottom));
+  // The thread count is fixed, so the path is split even on machines with a single core.
+  static constexpr int ThreadCount = 4;
+  auto groups = ShapeRasterizer::SplitIntoGroups(path, ThreadCount);
+  EXPECT_GT(groups.size(), 1u);
+  EXPECT_LE(groups.size(), static_cast<size_t>(ThreadCount));
+  EXPECT_TRUE(ShapeRasterizer::SplitIntoGroups(path, 1).empty());
+  for (auto antiAlias : {true, false}) {
+    ShapeRasterizer rasterizer(width, height, Shape::MakeFrom(path), antiAlias);
+    auto triangles = rasterizer.makeTriangles(path, ThreadCount);
+    ASSERT_TRUE(triangles != nullptr);
+    std::vector<float> vertices = {};
+    auto clipBounds = Rect::MakeWH(width, height);
+    if (antiAlias) {
+      PathTriangulator::ToAATriangles(path, clipBounds, &vertices);
+    } else {
+      PathTriangulator::ToTriangles(path, clipBounds, &vertices);
+    }
+    // The groups do not overlap, so splitting them must not add or drop any triangles.
+    EXPECT_EQ(triangles->size(), vertices.size() * sizeof(float));
+  }
+}
+
+TGFX_TEST(CanvasTest, zoomedShapeCache) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  auto surface = Surface::Make(context, 100, 100);
+  auto canvas = surface->getCanvas();
+  Path path = {};
+  for (int i = 0; i < 10; i++) {
+    auto angle = static_cast<float>(i) * static_cast<float>(M_PI) / 5.0f;
+    auto radius = i % 2 == 0 ? 30.0f : 12.0f;
+    auto point = Point::Make(40.0f + radius * cosf(angle), 40.0f + radius * sinf(angle));
+    if (i == 0) {
+      path.moveTo(point);
+    } else {
+      path.lineTo(point);
+    }
+  }
+  path.close();
+  auto shape = Shape::MakeFrom(path);
+  auto proxyProvider = context->proxyProvider();
+  auto drawScaled = [&](float scale) {
+    auto scaledShape = Shape::ApplyMatrix(shape, Matrix::MakeScale(scale));
+    auto proxy = proxyProvider->createGpuShapeProxy(scaledShape, true, Rect::MakeWH(100, 100));
+    // Each flush with drawings marks the end of a frame.
+    canvas->clear(Color::White());
+    context->flush();
+    return proxy;
+  };
+  auto proxy = drawScaled(2.0f);
+  ASSERT_TRUE(proxy != nullptr && proxy->getTriangles() != nullptr);
+  // While zooming, the nearest cached scale is reused and stretched to the requested scale.
+  auto zoomingProxy = drawScaled(2.2f);
+  ASSERT_TRUE(zoomingProxy != nullptr);
+  EXPECT_EQ(zoomingProxy->getTriangles(), proxy->getTriangles());
+  EXPECT_FLOAT_EQ(zoomingProxy->getDrawingMatrix().getScaleX(), 1.1f);
+  // Once the scale settles, the shape is rasterized again at its exact scale.
+  auto settledProxy = drawScaled(2.2f);
+  ASSERT_TRUE(settledProxy != nullptr && settledProxy->getTriangles() != nullptr);
+  EXPECT_NE(settledProxy->getTriangles(), proxy->getTriangles());
+  EXPECT_FLOAT_EQ(settledProxy->getDrawingMatrix().getScaleX(), 1.0f);
+
+  // A shape drawn at two scales in every frame is not zooming, and both get their exact scale.
+  auto drawTwice = [&](float firstScale, float secondScale) {
+    std::vector<std::shared_ptr<GpuShapeProxy>> proxies = {};
+    for (auto scale : {firstScale, secondScale}) {
+      auto scaledShape = Shape::ApplyMatrix(shape, Matrix::MakeScale(scale));
+      proxies.push_back(
+          proxyProvider->createGpuShapeProxy(scaledShape, true, Rect::MakeWH(100, 100)));
+    }
+    canvas->clear(Color::White());
+    context->flush();
+    return proxies;
+  };
+  drawTwice(1.0f, 1.5f);
+  for (auto& twiceProxy : drawTwice(1.0f, 1.5f)) {
+    ASSERT_TRUE(twiceProxy != nullptr);
+    EXPECT_FLOAT_EQ(twiceProxy->getDrawingMatrix().getScaleX(), 1.0f);
+  }
+}
+
 TGFX_TEST(CanvasTest, merge_draw_clear_op) {
   ContextScope scope;
   auto context = scope.getContext();
@@ -865,6 +1163,43 @@ TGFX_TEST(CanvasTest, drawShape) {
   EXPECT_TRUE(Baseline::Compare(surface, "CanvasTest/drawShape"));
 }
 
+class CountingPathEffect : public PathEffect {
+ public:
+  bool filterPath(Path* path) const override {
+    filterCount++;
+    path->transform(Matrix::MakeScale(2.0f));
+    return true;
+  }
+
+  mutable int filterCount = 0;
+};
+
+TGFX_TEST(CanvasTest, shapePathCache) {
+  Path path = {};
+  path.addRect(Rect::MakeWH(50, 50));
+  auto effect = std::make_shared<CountingPathEffect>();
+  auto shape = Shape::ApplyEffect(Shape::MakeFrom(path), effect);
+  Stroke stroke(4.0f);
+  auto strokeShape = Shape::ApplyStroke(shape, &stroke);
+  auto effectPath = shape->getPath();
+  EXPECT_EQ(effectPath.getBounds(), Rect::MakeWH(100, 100));
+  EXPECT_EQ(effect->filterCount, 1);
+  auto strokePath = strokeShape->getPath();
+  EXPECT_EQ(effect->filterCount, 1);
+  EXPECT_EQ(strokeShape->getPath(), strokePath);
+  // Scales in the same bucket share the cached path.
+  shape->getPath(1.05f);
+  shape->getPath(1.1f);
+  EXPECT_EQ(effect->filterCount, 2);
+  shape->getPath(2.0f);
+  EXPECT_EQ(effect->filterCount, 3);
+  shape->getPath(1.1f);
+  EXPECT_EQ(effect->filterCount, 3);
+  // Non-positive scales are computed directly.
+  shape->getPath(0.0f);
+  EXPECT_EQ(effect->filterCount, 4);
+}
+
 TGFX_TEST(CanvasTest, inverseFillType) {
   Path firstPath = {};
   firstPath.addRect(Rect::MakeXYWH(50, 50, 170, 100));
@@ -1411,6 +1746,96 @@ TGFX_TEST(CanvasTest, Path_addArc) {
   }
 }
 
+TGFX_TEST(CanvasTest, Path_merge) {
+  Path rectPath = {};
+  rectPath.addRect(Rect::MakeLTRB(0, 0, 100, 100));
+  Path otherRect = {};
+  otherRect.addRect(Rect::MakeLTRB(50, 20, 150, 80));
+  auto path = rectPath;
+  path.addPath(otherRect, PathOp::Intersect);
+  Rect rect = {};
+  EXPECT_TRUE(path.isRect(&rect));
+  EXPECT_EQ(rect, Rect::MakeLTRB(50, 20, 100, 80));
+
+  Path oval = {};
+  oval.addOval(Rect::MakeLTRB(10, 10, 90, 90));
+  path = rectPath;
+  path.addPath(oval, PathOp::Intersect);
+  EXPECT_TRUE(path == oval);
+
+  Path rRectPath = {};
+  RRect rRect = {};
+  rRect.setRectXY(Rect::MakeLTRB(0, 0, 100, 100), 20, 20);
+  rRectPath.addRRect(rRect);
+  Path innerRect = {};
+  innerRect.addRect(Rect::MakeLTRB(10, 10, 90, 90));
+  path = rRectPath;
+  path.addPath(innerRect, PathOp::Intersect);
+  EXPECT_TRUE(path == innerRect);
+
+  Path farOval = {};
+  farOval.addOval(Rect::MakeLTRB(200, 200, 300, 300));
+  path = oval;
+  path.addPath(farOval, PathOp::Intersect);
+  EXPECT_TRUE(path.isEmpty());
+  path = oval;
+  path.addPath(farOval, PathOp::Difference);
+  EXPECT_TRUE(path == oval);
+  path = oval;
+  path.addPath(farOval, PathOp::Union);
+  EXPECT_EQ(path.countVerbs(), oval.countVerbs() + farOval.countVerbs());
+
+  // Recurring operands reuse the cached result.
+  Path overlapOval = {};
+  overlapOval.addOval(Rect::MakeLTRB(50, 50, 130, 130));
+  auto first = oval;
+  first.addPath(overlapOval, PathOp::Union);
+  auto second = oval;
+  second.addPath(overlapOval, PathOp::Union);
+  EXPECT_FALSE(first.isEmpty());
+  EXPECT_TRUE(PathRef::GetUniqueKey(first) == PathRef::GetUniqueKey(second));
+}
+
+TGFX_TEST(CanvasTest, Path_trimAndDash) {
+  Path source = {};
+  source.moveTo(0, 0);
+  source.lineTo(100, 0);
+  source.moveTo(0, 50);
+  source.lineTo(40, 50);
+  auto measures = PathRef::GetContourMeasures(source);
+  ASSERT_TRUE(measures != nullptr);
+  EXPECT_EQ(measures->contourCount(), 2u);
+  EXPECT_FLOAT_EQ(measures->getLength(0), 100.0f);
+
+  // Trimming only measures the first contour, and reuses the measures cached on the source path.
+  auto trim = PathEffect::MakeTrim(0.25f, 0.75f);
+  auto path = source;
+  ASSERT_TRUE(trim->filterPath(&path));
+  EXPECT_EQ(path.getBounds(), Rect::MakeLTRB(25, 0, 75, 0));
+  EXPECT_EQ(PathRef::GetContourMeasures(source), measures);
+
+  float intervals[] = {10, 10};
+  auto dash = PathEffect::MakeDash(intervals, 2, 0);
+  ASSERT_TRUE(dash != nullptr);
+  path = source;
+  ASSERT_TRUE(dash->filterPath(&path));
+  // Five dashes on the first contour and two on the second, each with a move and a line.
+  EXPECT_EQ(path.countVerbs(), 14);
+  EXPECT_EQ(PathRef::GetContourMeasures(source), measures);
+
+  // The first dash of a closed contour joins the last one across the starting point.
+  Path rectPath = {};
+  rectPath.addRect(Rect::MakeWH(40, 40));
+  float rectIntervals[] = {30, 10};
+  dash = PathEffect::MakeDash(rectIntervals, 2, 20);
+  path = rectPath;
+  ASSERT_TRUE(dash->filterPath(&path));
+  auto dashMeasures = PathRef::GetContourMeasures(path);
+  EXPECT_EQ(dashMeasures->contourCount(), 4u);
+  float invalidIntervals[] = {10, -1};
+  EXPECT_TRUE(PathEffect::MakeDash(invalidIntervals, 2, 0) == nullptr);
+}
+
 TGFX_TEST(CanvasTest, Path_complex) {
   ContextScope scope;
   auto context = scope.getContext();
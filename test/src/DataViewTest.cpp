@@ -135,4 +135,28 @@ TGFX_TEST(DataViewTest, FileWriteStream) {
   std::filesystem::remove(path);
 }
 
+TGFX_TEST(DataViewTest, MappedFileData) {
+  auto path = ProjectPath::Absolute("test/out/MappedFile.bin");
+  std::filesystem::path filePath = path;
+  std::filesystem::create_directories(filePath.parent_path());
+  // Large enough to be memory-mapped rather than read into a heap buffer.
+  Buffer content(64 * 1024);
+  for (size_t i = 0; i < content.size(); i++) {
+    content[i] = static_cast<uint8_t>(i * 31 + 7);
+  }
+  auto writeStream = WriteStream::MakeFromFile(path);
+  ASSERT_TRUE(writeStream != nullptr);
+  writeStream->write(content.data(), content.size());
+  writeStream->flush();
+  writeStream = nullptr;
+
+  auto data = Data::MakeFromFile(path);
+  ASSERT_TRUE(data != nullptr);
+  ASSERT_EQ(data->size(), content.size());
+  EXPECT_EQ(memcmp(data->data(), content.data(), content.size()), 0);
+  data = nullptr;
+
+  std::filesystem::remove(path);
+}
+
 }  // namespace tgfx
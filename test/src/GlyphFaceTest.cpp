@@ -16,8 +16,14 @@
 //
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
+#include "core/DistanceFieldRasterizer.h"
+#include "core/GlyphRunList.h"
+#include "core/PixelBuffer.h"
+#include "core/ScalerContext.h"
 #include "core/utils/MathExtra.h"
+#include "tgfx/core/Buffer.h"
 #include "tgfx/core/Canvas.h"
+#include "tgfx/core/Task.h"
 #include "utils/TestUtils.h"
 
 namespace tgfx {
@@ -336,4 +342,217 @@ TGFX_TEST(GlyphFaceTest, GlyphFaceWithStyle) {
 
   EXPECT_TRUE(Baseline::Compare(surface, "GlyphFaceTest/GlyphFaceWithStyle"));
 }
+
+TGFX_TEST(GlyphFaceTest, GlyphCache) {
+  auto typeface = MakeTypeface("resources/font/NotoSansSC-Regular.otf");
+  ASSERT_TRUE(typeface != nullptr);
+  Font font(typeface, 30);
+  GlyphID glyphID = 41;
+  auto& glyphCache = font.scalerContext->glyphCache;
+  EXPECT_TRUE(glyphCache.findRecord(glyphID) == nullptr);
+  auto bounds = font.getBounds(glyphID);
+  auto advance = font.getAdvance(glyphID);
+  EXPECT_FALSE(bounds.isEmpty());
+  EXPECT_GT(advance, 0.0f);
+  auto record = glyphCache.findRecord(glyphID);
+  ASSERT_TRUE(record != nullptr);
+  EXPECT_EQ(font.getBounds(glyphID), bounds);
+  EXPECT_EQ(font.getAdvance(glyphID), advance);
+  EXPECT_EQ(glyphCache.findRecord(glyphID), record);
+
+  Path path = {};
+  ASSERT_TRUE(font.getPath(glyphID, &path));
+  Path cachedPath = {};
+  ASSERT_TRUE(font.getPath(glyphID, &cachedPath));
+  EXPECT_EQ(path, cachedPath);
+  // Modifying the returned path must not change the cached one.
+  path.transform(Matrix::MakeScale(2.0f));
+  Path pathAgain = {};
+  ASSERT_TRUE(font.getPath(glyphID, &pathAgain));
+  EXPECT_EQ(pathAgain, cachedPath);
+
+  // Faux styles are cached separately.
+  font.setFauxBold(true);
+  auto boldBounds = font.getBounds(glyphID);
+  EXPECT_NE(boldBounds, bounds);
+  Path boldPath = {};
+  ASSERT_TRUE(font.getPath(glyphID, &boldPath));
+  EXPECT_NE(boldPath.getBounds(), cachedPath.getBounds());
+  EXPECT_EQ(glyphCache.findRecord(glyphID), record);
+
+  // Fonts with the same typeface and size share the cache.
+  Font otherFont(typeface, 30);
+  EXPECT_EQ(otherFont.scalerContext.get(), font.scalerContext.get());
+}
+
+TGFX_TEST(GlyphFaceTest, ConcurrentGlyphPaths) {
+  auto typeface = MakeTypeface("resources/font/NotoSansSC-Regular.otf");
+  ASSERT_TRUE(typeface != nullptr);
+  Font font(typeface, 40);
+  auto scalerContext = font.scalerContext;
+  std::vector<GlyphID> glyphIDs = {25483, 14857, 8699, 16266, 16671, 24458, 14689, 15107};
+  std::vector<Path> expectedPaths(glyphIDs.size());
+  for (size_t i = 0; i < glyphIDs.size(); i++) {
+    ASSERT_TRUE(scalerContext->onGeneratePath(glyphIDs[i], false, false, &expectedPaths[i]));
+  }
+  // The expected paths bypass the glyph cache, so the tasks all miss it and load glyphs from
+  // FreeType at the same time, each starting at a different glyph.
+  static constexpr size_t TaskCount = 8;
+  std::vector<std::vector<Path>> results(TaskCount, std::vector<Path>(glyphIDs.size()));
+  std::vector<std::shared_ptr<Task>> tasks = {};
+  for (size_t index = 0; index < TaskCount; index++) {
+    auto& paths = results[index];
+    tasks.push_back(Task::Run([&paths, &glyphIDs, font, index] {
+      for (size_t i = 0; i < glyphIDs.size(); i++) {
+        auto glyphIndex = (i + index) % glyphIDs.size();
+        font.getPath(glyphIDs[glyphIndex], &paths[glyphIndex]);
+      }
+    }));
+  }
+  for (auto& task : tasks) {
+    task->wait();
+  }
+  for (auto& paths : results) {
+    for (size_t i = 0; i < glyphIDs.size(); i++) {
+      EXPECT_EQ(paths[i], expectedPaths[i]);
+    }
+  }
+}
+
+TGFX_TEST(GlyphFaceTest, DistanceFieldRasterizer) {
+  auto typeface = MakeTypeface("resources/font/NotoSansSC-Regular.otf");
+  ASSERT_TRUE(typeface != nullptr);
+  Font font(typeface, 100);
+  auto glyphID = font.getGlyphID("I");
+  ASSERT_TRUE(glyphID != 0);
+  auto glyphRunList = std::make_shared<GlyphRunList>(GlyphRun(font, {glyphID}, {Point::Zero()}));
+  auto bounds = glyphRunList->getBounds();
+  ASSERT_FALSE(bounds.isEmpty());
+  auto radius = DistanceFieldRasterizer::Radius;
+  auto matrix = Matrix::MakeTrans(radius - bounds.left, radius - bounds.top);
+  auto width = static_cast<int>(ceilf(bounds.width() + radius * 2.0f));
+  auto height = static_cast<int>(ceilf(bounds.height() + radius * 2.0f));
+  auto rasterizer = Rasterizer::MakeDistanceField(width, height, glyphRunList, matrix);
+  ASSERT_TRUE(rasterizer != nullptr);
+  auto buffer = std::static_pointer_cast<PixelBuffer>(rasterizer->makeBuffer(false));
+  ASSERT_TRUE(buffer != nullptr);
+  EXPECT_TRUE(buffer->isAlphaOnly());
+  EXPECT_EQ(buffer->width(), width);
+  EXPECT_EQ(buffer->height(), height);
+  auto pixels = static_cast<const uint8_t*>(buffer->lockPixels());
+  ASSERT_TRUE(pixels != nullptr);
+  auto rowBytes = buffer->info().rowBytes();
+  // Pixels outside the glyph by more than the radius are zero, and the stem center is inside.
+  EXPECT_EQ(pixels[0], 0);
+  auto offset = static_cast<size_t>(height / 2) * rowBytes + static_cast<size_t>(width / 2);
+  EXPECT_GT(pixels[offset], 128);
+  buffer->unlockPixels();
+  EXPECT_TRUE(Rasterizer::MakeDistanceField(0, height, glyphRunList, matrix) == nullptr);
+}
+
+TGFX_TEST(GlyphFaceTest, DistanceFieldText) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  auto typeface = MakeTypeface("resources/font/NotoSansSC-Regular.otf");
+  ASSERT_TRUE(typeface != nullptr);
+  // Text at 256 pixels or larger is drawn from a distance field.
+  Font font(typeface, 300);
+  auto glyphID = font.getGlyphID("I");
+  ASSERT_TRUE(glyphID != 0);
+  auto glyphBounds = font.getBounds(glyphID);
+  ASSERT_FALSE(glyphBounds.isEmpty());
+  auto width = static_cast<int>(ceilf(glyphBounds.right)) + 40;
+  auto height = static_cast<int>(ceilf(glyphBounds.height())) + 40;
+  auto surface = Surface::Make(context, width, height);
+  auto canvas = surface->getCanvas();
+  canvas->clear(Color::White());
+  Paint paint;
+  paint.setColor(Color::Black());
+  auto origin = Point::Make(20.0f, 20.0f - glyphBounds.top);
+  canvas->drawGlyphs(&glyphID, &origin, 1, font, paint);
+  auto info = ImageInfo::Make(width, height, ColorType::RGBA_8888, AlphaType::Premultiplied);
+  Buffer pixels(info.byteSize());
+  ASSERT_TRUE(pixels.data() != nullptr);
+  ASSERT_TRUE(surface->readPixels(info, pixels.data()));
+  auto pixelAt = [&](float x, float y) {
+    return pixels.bytes() + static_cast<size_t>(y) * info.rowBytes() + static_cast<size_t>(x) * 4;
+  };
+  auto stemCenter = glyphBounds.makeOffset(origin.x, origin.y);
+  // The stem is filled, and the pixels far from it are untouched.
+  EXPECT_EQ(pixelAt(stemCenter.centerX(), stemCenter.centerY())[0], 0);
+  EXPECT_EQ(pixelAt(5, 5)[0], 255);
+  EXPECT_EQ(pixelAt(stemCenter.right + 10, stemCenter.centerY())[0], 255);
+  EXPECT_EQ(pixelAt(stemCenter.left - 10, stemCenter.centerY())[0], 255);
+  // The edges are antialiased from the distance field.
+  bool hasPartialCoverage = false;
+  auto y = static_cast<int>(stemCenter.centerY());
+  for (int x = 0; x < width; x++) {
+    auto value = pixelAt(static_cast<float>(x), static_cast<float>(y))[0];
+    hasPartialCoverage = hasPartialCoverage || (value > 0 && value < 255);
+  }
+  EXPECT_TRUE(hasPartialCoverage);
+  EXPECT_TRUE(Baseline::Compare(surface, "GlyphFaceTest/DistanceFieldText"));
+}
+
+TGFX_TEST(GlyphFaceTest, GlyphRunListContentKey) {
+  auto typeface = MakeTypeface("resources/font/NotoSansSC-Regular.otf");
+  ASSERT_TRUE(typeface != nullptr);
+  Font font(typeface, 30);
+  auto glyphID = font.getGlyphID("I");
+  ASSERT_TRUE(glyphID != 0);
+  // GlyphRunLists created separately for the same glyphs share the content key.
+  GlyphRunList first(GlyphRun(font, {glyphID}, {Point::Make(10, 20)}));
+  GlyphRunList second(GlyphRun(font, {glyphID}, {Point::Make(10, 20)}));
+  BytesKey firstKey = {};
+  BytesKey secondKey = {};
+  ASSERT_TRUE(first.computeContentKey(&firstKey));
+  ASSERT_TRUE(second.computeContentKey(&secondKey));
+  EXPECT_TRUE(firstKey == secondKey);
+  GlyphRunList moved(GlyphRun(font, {glyphID}, {Point::Make(10, 21)}));
+  BytesKey movedKey = {};
+  ASSERT_TRUE(moved.computeContentKey(&movedKey));
+  EXPECT_FALSE(firstKey == movedKey);
+  GlyphRunList resized(GlyphRun(font.makeWithSize(40), {glyphID}, {Point::Make(10, 20)}));
+  BytesKey resizedKey = {};
+  ASSERT_TRUE(resized.computeContentKey(&resizedKey));
+  EXPECT_FALSE(firstKey == resizedKey);
+}
+
+TGFX_TEST(GlyphFaceTest, ConcurrentGlyphPathsAcrossSizes) {
+  auto typeface = MakeTypeface("resources/font/NotoSansSC-Regular.otf");
+  ASSERT_TRUE(typeface != nullptr);
+  // Scaler contexts of the same typeface borrow faces from one pool, each with its own size.
+  std::vector<Font> fonts = {Font(typeface, 20), Font(typeface, 60)};
+  std::vector<GlyphID> glyphIDs = {25483, 14857, 8699, 16266};
+  std::vector<std::vector<Path>> expectedPaths(fonts.size(), std::vector<Path>(glyphIDs.size()));
+  for (size_t i = 0; i < fonts.size(); i++) {
+    for (size_t j = 0; j < glyphIDs.size(); j++) {
+      ASSERT_TRUE(
+          fonts[i].scalerContext->onGeneratePath(glyphIDs[j], false, false, &expectedPaths[i][j]));
+    }
+  }
+  EXPECT_NE(expectedPaths[0][0], expectedPaths[1][0]);
+  static constexpr size_t TaskCount = 8;
+  std::vector<std::vector<Path>> results(TaskCount, std::vector<Path>(glyphIDs.size()));
+  std::vector<std::shared_ptr<Task>> tasks = {};
+  for (size_t index = 0; index < TaskCount; index++) {
+    auto& paths = results[index];
+    auto font = fonts[index % fonts.size()];
+    tasks.push_back(Task::Run([&paths, &glyphIDs, font, index] {
+      for (size_t i = 0; i < glyphIDs.size(); i++) {
+        auto glyphIndex = (i + index / 2) % glyphIDs.size();
+        font.getPath(glyphIDs[glyphIndex], &paths[glyphIndex]);
+      }
+    }));
+  }
+  for (auto& task : tasks) {
+    task->wait();
+  }
+  for (size_t index = 0; index < TaskCount; index++) {
+    for (size_t i = 0; i < glyphIDs.size(); i++) {
+      EXPECT_EQ(results[index][i], expectedPaths[index % fonts.size()][i]);
+    }
+  }
+}
 }  // namespace tgfx
@@ -20,6 +20,11 @@
 #include <tgfx/layers/ImagePattern.h>
 #include <vector>
 #include "core/filters/BlurImageFilter.h"
+#include "layers/DrawArgs.h"
+#include "layers/TileCache.h"
+#include "layers/animations/LayerAnimator.h"
+#include "layers/contents/TextContent.h"
+#include "tgfx/core/Buffer.h"
 #include "tgfx/core/PathEffect.h"
 #include "tgfx/layers/DisplayList.h"
 #include "tgfx/layers/Gradient.h"
@@ -28,6 +33,8 @@
 #include "tgfx/layers/ShapeLayer.h"
 #include "tgfx/layers/SolidLayer.h"
 #include "tgfx/layers/TextLayer.h"
+#include "tgfx/layers/animations/KeyframeAnimation.h"
+#include "tgfx/layers/animations/SpringAnimation.h"
 #include "tgfx/layers/filters/BlendFilter.h"
 #include "tgfx/layers/filters/BlurFilter.h"
 #include "tgfx/layers/filters/ColorMatrixFilter.h"
@@ -1921,4 +1928,314 @@ TGFX_TEST(LayerTest, MaskOnwer) {
   EXPECT_EQ(layer->mask(), nullptr);
   EXPECT_EQ(mask->maskOwner, nullptr);
 }
+
+TGFX_TEST(LayerTest, Animations) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  auto surface = Surface::Make(context, 100, 100);
+  DisplayList displayList;
+  auto layer = ShapeLayer::Make();
+  Path path;
+  path.addRect(Rect::MakeWH(50, 50));
+  layer->setPath(path);
+  layer->setFillStyle(SolidColor::Make(Color::Red()));
+  layer->setShouldRasterize(true);
+  displayList.root()->addChild(layer);
+  displayList.setAnimationTime(0);
+  EXPECT_TRUE(displayList.render(surface.get()));
+  EXPECT_FALSE(displayList.render(surface.get()));
+  auto rasterizedContent = layer->rasterizedContent.get();
+  EXPECT_TRUE(rasterizedContent != nullptr);
+
+  auto alphaAnimation = KeyframeAnimation::Make(AnimationProperty::Alpha, 1.0f, 0.0f);
+  alphaAnimation->setDuration(1000);
+  layer->addAnimation(alphaAnimation);
+  auto positionAnimation = KeyframeAnimation::Make(AnimationProperty::PositionX, {0, 20, 40});
+  positionAnimation->setDuration(1000);
+  positionAnimation->setTimingFunction(TimingFunction::EaseInOut());
+  layer->addAnimation(positionAnimation);
+  EXPECT_EQ(layer->animations().size(), 2u);
+  EXPECT_TRUE(displayList.hasAnimations());
+
+  displayList.setAnimationTime(100);
+  EXPECT_TRUE(displayList.render(surface.get()));
+  displayList.setAnimationTime(600);
+  EXPECT_TRUE(displayList.render(surface.get()));
+  EXPECT_FLOAT_EQ(layer->animator->getAlpha(layer->alpha()), 0.5f);
+  // Animated values never touch the model values or the layer content.
+  EXPECT_FLOAT_EQ(layer->alpha(), 1.0f);
+  EXPECT_EQ(layer->position(), Point::Zero());
+  EXPECT_FALSE(displayList.root()->bitFields.childrenDirty);
+  EXPECT_EQ(layer->rasterizedContent.get(), rasterizedContent);
+
+  displayList.setAnimationTime(1100);
+  EXPECT_TRUE(displayList.render(surface.get()));
+  EXPECT_TRUE(layer->animations().empty());
+  EXPECT_FALSE(displayList.hasAnimations());
+  EXPECT_FLOAT_EQ(layer->alpha(), 0.0f);
+  EXPECT_EQ(layer->position(), Point::Make(40, 0));
+
+  auto strokeAnimation = KeyframeAnimation::Make(AnimationProperty::StrokeEnd, 0.0f, 1.0f);
+  strokeAnimation->setDuration(1000);
+  strokeAnimation->setRepeatCount(2);
+  strokeAnimation->setAutoreverses(true);
+  layer->addAnimation(strokeAnimation);
+  displayList.render(surface.get());
+  EXPECT_FLOAT_EQ(layer->strokeEnd(), 0.0f);
+  displayList.setAnimationTime(1600);
+  displayList.render(surface.get());
+  EXPECT_FLOAT_EQ(layer->strokeEnd(), 0.5f);
+  displayList.setAnimationTime(2600);
+  displayList.render(surface.get());
+  EXPECT_FLOAT_EQ(layer->strokeEnd(), 0.5f);
+  displayList.setAnimationTime(3100);
+  displayList.render(surface.get());
+  EXPECT_FLOAT_EQ(layer->strokeEnd(), 0.0f);
+  EXPECT_TRUE(layer->animations().empty());
+
+  auto spring = SpringAnimation::Make(AnimationProperty::ScaleX, 0.0f, 1.0f);
+  EXPECT_GT(spring->duration(), 0);
+  layer->addAnimation(spring);
+  layer->removeAnimation(spring);
+  EXPECT_TRUE(layer->animations().empty());
+
+  // Animating a child invalidates the rasterized image of its ancestors.
+  auto group = Layer::Make();
+  group->setShouldRasterize(true);
+  displayList.root()->addChild(group);
+  auto child = ShapeLayer::Make();
+  child->setPath(path);
+  child->setFillStyle(SolidColor::Make(Color::Blue()));
+  group->addChild(child);
+  displayList.setAnimationTime(4000);
+  EXPECT_TRUE(displayList.render(surface.get()));
+  EXPECT_TRUE(group->rasterizedContent != nullptr);
+  auto moveAnimation = KeyframeAnimation::Make(AnimationProperty::PositionX, 0.0f, 40.0f);
+  moveAnimation->setDuration(1000);
+  child->addAnimation(moveAnimation);
+  EXPECT_TRUE(displayList.render(surface.get()));
+  EXPECT_TRUE(group->rasterizedContent != nullptr);
+  EXPECT_TRUE(displayList.root()->updateAnimations(4500));
+  EXPECT_TRUE(group->rasterizedContent == nullptr);
+  EXPECT_TRUE(displayList.root()->bitFields.childrenDirty);
+
+  auto easeInOut = TimingFunction::EaseInOut();
+  EXPECT_FLOAT_EQ(easeInOut->getValue(0.0f), 0.0f);
+  EXPECT_NEAR(easeInOut->getValue(0.5f), 0.5f, 1e-4f);
+  EXPECT_FLOAT_EQ(easeInOut->getValue(1.0f), 1.0f);
+  EXPECT_LT(TimingFunction::EaseIn()->getValue(0.25f), 0.25f);
+}
+
+TGFX_TEST(LayerTest, OffscreenAvoidance) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  auto surface = Surface::Make(context, 100, 100);
+  DisplayList displayList;
+  auto group = Layer::Make();
+  group->setAlpha(0.5f);
+  group->setAllowsGroupOpacity(true);
+  displayList.root()->addChild(group);
+  auto left = SolidLayer::Make();
+  left->setWidth(40);
+  left->setHeight(40);
+  left->setColor(Color::Red());
+  group->addChild(left);
+  auto right = SolidLayer::Make();
+  right->setWidth(40);
+  right->setHeight(40);
+  right->setColor(Color::Blue());
+  right->setMatrix(Matrix::MakeTrans(50, 0));
+  group->addChild(right);
+
+  DrawArgs args(context, surface->renderFlags(), true);
+  EXPECT_FALSE(group->requiresOffscreen(args, group->alpha(), BlendMode::SrcOver));
+  EXPECT_TRUE(group->bitFields.overlapAnalyzed);
+  displayList.render(surface.get());
+
+  right->setMatrix(Matrix::MakeTrans(20, 20));
+  EXPECT_FALSE(group->bitFields.overlapAnalyzed);
+  EXPECT_TRUE(group->requiresOffscreen(args, group->alpha(), BlendMode::SrcOver));
+  displayList.render(surface.get());
+
+  right->setBlendMode(BlendMode::Multiply);
+  EXPECT_FALSE(right->requiresOffscreen(args, right->alpha(), right->blendMode()));
+  right->addChild(SolidLayer::Make());
+  EXPECT_TRUE(right->requiresOffscreen(args, right->alpha(), right->blendMode()));
+}
+
+class TextBlobLayer : public Layer {
+ public:
+  explicit TextBlobLayer(std::shared_ptr<TextBlob> textBlob) : textBlob(std::move(textBlob)) {
+  }
+
+ protected:
+  std::unique_ptr<LayerContent> onUpdateContent() override {
+    return std::make_unique<TextContent>(textBlob, Color::White());
+  }
+
+ private:
+  std::shared_ptr<TextBlob> textBlob = nullptr;
+};
+
+TGFX_TEST(LayerTest, OverlappingGlyphsWithGroupOpacity) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  auto width = 150;
+  auto height = 100;
+  auto surface = Surface::Make(context, width, height);
+  auto emojiTypeface = MakeTypeface("resources/font/NotoColorEmoji.ttf");
+  ASSERT_TRUE(emojiTypeface != nullptr);
+  Font emojiFont(emojiTypeface, 50);
+  auto emojiID = emojiFont.getGlyphID("👻");
+  ASSERT_TRUE(emojiID != 0);
+  auto emojiBlob = TextBlob::MakeFrom(GlyphRun(emojiFont, {emojiID, emojiID}, {{0, 0}, {25, 0}}));
+  auto typeface = MakeTypeface("resources/font/NotoSansSC-Regular.otf");
+  ASSERT_TRUE(typeface != nullptr);
+  Font font(typeface, 50);
+  auto glyphID = font.getGlyphID("O");
+  auto textBlob = TextBlob::MakeFrom(GlyphRun(font, {glyphID, glyphID}, {{0, 0}, {20, 0}}));
+  auto mixedBlob = TextBlob::MakeFrom(
+      {GlyphRun(font, {glyphID}, {{0, 0}}), GlyphRun(emojiFont, {emojiID}, {{20, 0}})});
+  EXPECT_TRUE(TextContent(textBlob, Color::White()).isSingleDraw());
+  EXPECT_FALSE(TextContent(emojiBlob, Color::White()).isSingleDraw());
+  EXPECT_FALSE(TextContent(mixedBlob, Color::White()).isSingleDraw());
+
+  DisplayList displayList;
+  auto layer = std::make_shared<TextBlobLayer>(emojiBlob);
+  layer->setAlpha(0.5f);
+  layer->setAllowsGroupOpacity(true);
+  layer->setMatrix(Matrix::MakeTrans(10, 70));
+  displayList.root()->addChild(layer);
+  DrawArgs args(context, surface->renderFlags(), true);
+  EXPECT_TRUE(layer->requiresOffscreen(args, layer->alpha(), BlendMode::SrcOver));
+  displayList.render(surface.get());
+  auto info = ImageInfo::Make(width, height, ColorType::RGBA_8888, AlphaType::Premultiplied);
+  Buffer pixels(info.byteSize());
+  ASSERT_TRUE(pixels.data() != nullptr);
+  ASSERT_TRUE(surface->readPixels(info, pixels.data()));
+  // The group is composited with half alpha, so the overlapping glyphs never exceed it.
+  uint8_t maxAlpha = 0;
+  for (size_t i = 3; i < pixels.size(); i += 4) {
+    maxAlpha = std::max(maxAlpha, pixels.bytes()[i]);
+  }
+  EXPECT_GT(maxAlpha, 0);
+  EXPECT_LE(maxAlpha, 128);
+}
+
+TGFX_TEST(LayerTest, ShowChildOfBlendedLayer) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  auto surface = Surface::Make(context, 100, 100);
+  DisplayList displayList;
+  auto parent = SolidLayer::Make();
+  parent->setWidth(100);
+  parent->setHeight(100);
+  parent->setColor(Color::Red());
+  parent->setBlendMode(BlendMode::Screen);
+  displayList.root()->addChild(parent);
+  auto child = SolidLayer::Make();
+  child->setWidth(50);
+  child->setHeight(50);
+  child->setColor(Color::Blue());
+  child->setVisible(false);
+  parent->addChild(child);
+  // With every child hidden, the parent is drawn by a single draw call with its blend mode.
+  EXPECT_TRUE(displayList.render(surface.get()));
+  EXPECT_FALSE(parent->bitFields.childrenDirty);
+  auto info = ImageInfo::Make(100, 100, ColorType::RGBA_8888, AlphaType::Premultiplied);
+  Buffer pixels(info.byteSize());
+  ASSERT_TRUE(pixels.data() != nullptr);
+  ASSERT_TRUE(surface->readPixels(info, pixels.data()));
+  EXPECT_EQ(pixels.bytes()[2], 0);
+
+  child->setVisible(true);
+  EXPECT_TRUE(displayList.render(surface.get()));
+  ASSERT_TRUE(surface->readPixels(info, pixels.data()));
+  EXPECT_GT(pixels.bytes()[2], 0);
+}
+
+TGFX_TEST(LayerTest, TiledRender) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  auto surface = Surface::Make(context, 200, 100);
+  DisplayList displayList;
+  displayList.setRenderMode(RenderMode::Tiled);
+  displayList.setTileSize(64);
+  auto layer = SolidLayer::Make();
+  layer->setWidth(10000);
+  layer->setHeight(10000);
+  layer->setColor(Color::Red());
+  displayList.root()->addChild(layer);
+  EXPECT_TRUE(displayList.render(surface.get()));
+  // 4 x 2 tiles cover the 200 x 100 surface.
+  EXPECT_EQ(displayList.tileCache->size(), 8u);
+  EXPECT_FALSE(displayList.render(surface.get()));
+
+  displayList.setContentOffset(Point::Make(-64, 0));
+  EXPECT_TRUE(displayList.render(surface.get()));
+  // Only the tiles of the new column are rendered, the others are reused.
+  EXPECT_EQ(displayList.tileCache->size(), 10u);
+
+  layer->setColor(Color::Blue());
+  EXPECT_TRUE(displayList.render(surface.get()));
+  EXPECT_EQ(displayList.tileCache->size(), 8u);
+
+  displayList.setZoomScale(0.5f);
+  EXPECT_TRUE(displayList.render(surface.get()));
+  EXPECT_EQ(displayList.tileCache->size(), 8u);
+}
+
+TGFX_TEST(LayerTest, TiledRenderDirtyTiles) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  auto surface = Surface::Make(context, 256, 128);
+  DisplayList displayList;
+  displayList.setRenderMode(RenderMode::Tiled);
+  displayList.setTileSize(64);
+  auto background = SolidLayer::Make();
+  background->setWidth(256);
+  background->setHeight(128);
+  background->setColor(Color::White());
+  displayList.root()->addChild(background);
+  auto layer = SolidLayer::Make();
+  layer->setWidth(20);
+  layer->setHeight(20);
+  layer->setColor(Color::Red());
+  layer->setMatrix(Matrix::MakeTrans(10, 10));
+  displayList.root()->addChild(layer);
+  EXPECT_TRUE(displayList.render(surface.get()));
+  auto& tileCache = displayList.tileCache;
+  EXPECT_EQ(tileCache->size(), 8u);
+  auto firstTile = tileCache->getTile(0, 0, 0);
+  auto lastTile = tileCache->getTile(3, 1, 0);
+  ASSERT_TRUE(firstTile != nullptr);
+  ASSERT_TRUE(lastTile != nullptr);
+
+  // Only the tile under the changed layer is redrawn.
+  layer->setColor(Color::Blue());
+  EXPECT_TRUE(displayList.render(surface.get()));
+  EXPECT_EQ(tileCache->size(), 8u);
+  EXPECT_NE(tileCache->getTile(0, 0, 0), firstTile);
+  EXPECT_EQ(tileCache->getTile(3, 1, 0), lastTile);
+  firstTile = tileCache->getTile(0, 0, 0);
+
+  // Moving the layer redraws the tiles of both its old and new positions.
+  layer->setMatrix(Matrix::MakeTrans(200, 80));
+  EXPECT_TRUE(displayList.render(surface.get()));
+  EXPECT_NE(tileCache->getTile(0, 0, 0), firstTile);
+  EXPECT_NE(tileCache->getTile(3, 1, 0), lastTile);
+  auto middleTile = tileCache->getTile(1, 0, 0);
+  lastTile = tileCache->getTile(3, 1, 0);
+
+  layer->removeFromParent();
+  EXPECT_TRUE(displayList.render(surface.get()));
+  EXPECT_NE(tileCache->getTile(3, 1, 0), lastTile);
+  EXPECT_EQ(tileCache->getTile(1, 0, 0), middleTile);
+}
 }  // namespace tgfx
@@ -0,0 +1,83 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include "tgfx/core/Matrix.h"
+#include "utils/TestUtils.h"
+
+namespace tgfx {
+static Rect MapRectCorners(const Matrix& matrix, const Rect& rect) {
+  Point quad[4] = {{rect.left, rect.top},
+                   {rect.right, rect.top},
+                   {rect.right, rect.bottom},
+                   {rect.left, rect.bottom}};
+  matrix.mapPoints(quad, 4);
+  Rect bounds = {};
+  bounds.setBounds(quad, 4);
+  return bounds;
+}
+
+TGFX_TEST(MatrixTest, mapPoints) {
+  auto scaleTranslate = Matrix::MakeScale(-2.0f, 3.0f);
+  scaleTranslate.postTranslate(5.0f, -1.0f);
+  auto rotate = Matrix::MakeRotate(30.0f);
+  rotate.postTranslate(2.0f, 3.0f);
+  Matrix matrices[] = {Matrix::I(), Matrix::MakeTrans(3.0f, 4.0f), scaleTranslate, rotate,
+                       Matrix::MakeAll(1.5f, 0.2f, 3.0f, 0.1f, -2.0f, 4.0f)};
+  // An odd count covers both the vectorized pairs and the remaining point.
+  Point src[7] = {};
+  for (int i = 0; i < 7; i++) {
+    src[i] = Point::Make(static_cast<float>(i * 13 % 7) - 3.5f, static_cast<float>(i) * 2.5f);
+  }
+  for (auto& matrix : matrices) {
+    Point dst[7] = {};
+    matrix.mapPoints(dst, src, 7);
+    for (int i = 0; i < 7; i++) {
+      auto expected = matrix.mapXY(src[i].x, src[i].y);
+      EXPECT_FLOAT_EQ(dst[i].x, expected.x);
+      EXPECT_FLOAT_EQ(dst[i].y, expected.y);
+    }
+    Point points[7] = {};
+    std::copy(src, src + 7, points);
+    matrix.mapPoints(points, 7);
+    for (int i = 0; i < 7; i++) {
+      EXPECT_EQ(points[i], dst[i]);
+    }
+  }
+}
+
+TGFX_TEST(MatrixTest, mapRects) {
+  auto scaleTranslate = Matrix::MakeScale(-2.0f, 3.0f);
+  scaleTranslate.postTranslate(5.0f, -1.0f);
+  Matrix matrices[] = {Matrix::MakeTrans(3.0f, 4.0f), scaleTranslate, Matrix::MakeRotate(45.0f)};
+  Rect src[3] = {Rect::MakeLTRB(1, 2, 10, 20), Rect::MakeLTRB(-5, -5, 3, 4),
+                 Rect::MakeLTRB(0, 0, 1, 1)};
+  for (auto& matrix : matrices) {
+    Rect dst[3] = {};
+    matrix.mapRects(dst, src, 3);
+    for (int i = 0; i < 3; i++) {
+      auto expected = MapRectCorners(matrix, src[i]);
+      EXPECT_FLOAT_EQ(dst[i].left, expected.left);
+      EXPECT_FLOAT_EQ(dst[i].top, expected.top);
+      EXPECT_FLOAT_EQ(dst[i].right, expected.right);
+      EXPECT_FLOAT_EQ(dst[i].bottom, expected.bottom);
+      EXPECT_EQ(matrix.mapRect(src[i]), dst[i]);
+    }
+  }
+}
+}  // namespace tgfx
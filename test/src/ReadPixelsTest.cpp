@@ -16,10 +16,16 @@
 //
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
+#include <chrono>
 #include <vector>
+#include "core/utils/PixelConverter.h"
 #include "gpu/opengl/GLUtil.h"
+#include "tgfx/core/AnimatedCodec.h"
+#include "tgfx/core/AnimatedImageReader.h"
 #include "tgfx/core/Buffer.h"
+#include "tgfx/core/Image.h"
 #include "tgfx/core/ImageCodec.h"
+#include "tgfx/core/IncrementalDecoder.h"
 #include "tgfx/core/Pixmap.h"
 #include "tgfx/core/Surface.h"
 #include "tgfx/gpu/opengl/GLDevice.h"
@@ -473,4 +479,480 @@ TGFX_TEST(ReadPixelsTest, NativeCodec) {
   EXPECT_TRUE(codec->readPixels(A8Info, pixels));
   CHECK_PIXELS(A8Info, pixels, "NativeCodec_Encode_Alpha8");
 }
+
+TGFX_TEST(ReadPixelsTest, ScaledDecode) {
+  auto jpegCodec = MakeImageCodec("resources/apitest/imageReplacement.jpg");
+  ASSERT_TRUE(jpegCodec != nullptr);
+  auto size = jpegCodec->getScaledDimensions(1.0f);
+  EXPECT_EQ(size.width, 110);
+  EXPECT_EQ(size.height, 110);
+  size = jpegCodec->getScaledDimensions(0.2f);
+  EXPECT_EQ(size.width, 28);
+  EXPECT_EQ(size.height, 28);
+  size = jpegCodec->getScaledDimensions(0.01f);
+  EXPECT_EQ(size.width, 14);
+  EXPECT_EQ(size.height, 14);
+  auto info = ImageInfo::Make(28, 28, ColorType::RGBA_8888, AlphaType::Premultiplied);
+  Buffer buffer(info.byteSize());
+  ASSERT_TRUE(buffer.data() != nullptr);
+  EXPECT_TRUE(jpegCodec->readScaledPixels(info, buffer.data()));
+  info = ImageInfo::Make(30, 30, ColorType::RGBA_8888, AlphaType::Premultiplied);
+  EXPECT_FALSE(jpegCodec->readScaledPixels(info, buffer.data()));
+
+  auto webpCodec = MakeImageCodec("resources/apitest/imageReplacement.webp");
+  ASSERT_TRUE(webpCodec != nullptr);
+  size = webpCodec->getScaledDimensions(0.5f);
+  EXPECT_EQ(size.width, 55);
+  EXPECT_EQ(size.height, 55);
+  info = ImageInfo::Make(55, 55, ColorType::RGBA_8888, AlphaType::Premultiplied);
+  EXPECT_TRUE(webpCodec->readScaledPixels(info, buffer.data()));
+
+  auto pngCodec = MakeImageCodec("resources/apitest/imageReplacement.png");
+  ASSERT_TRUE(pngCodec != nullptr);
+  size = pngCodec->getScaledDimensions(0.5f);
+  EXPECT_EQ(size.width, 110);
+  EXPECT_EQ(size.height, 110);
+  EXPECT_FALSE(pngCodec->readScaledPixels(info, buffer.data()));
+}
+
+TGFX_TEST(ReadPixelsTest, JpegYUVDecode) {
+  auto pngCodec = MakeImageCodec("resources/apitest/imageReplacement.png");
+  ASSERT_TRUE(pngCodec != nullptr);
+  EXPECT_TRUE(pngCodec->readYUVData() == nullptr);
+  auto info = ImageInfo::Make(pngCodec->width(), pngCodec->height(), ColorType::RGBA_8888,
+                              AlphaType::Premultiplied);
+  Buffer buffer(info.byteSize());
+  ASSERT_TRUE(buffer.data() != nullptr);
+  EXPECT_TRUE(pngCodec->readPixels(info, buffer.data()));
+  // The default settings of the JPEG encoder use 4:2:0 chroma subsampling.
+  auto bytes = ImageCodec::Encode(Pixmap(info, buffer.data()), EncodedFormat::JPEG, 80);
+  auto jpegCodec = ImageCodec::MakeFrom(bytes);
+  ASSERT_TRUE(jpegCodec != nullptr);
+  auto colorSpace = YUVColorSpace::BT601_LIMITED;
+  auto yuvData = jpegCodec->readYUVData(&colorSpace);
+  ASSERT_TRUE(yuvData != nullptr);
+  EXPECT_EQ(yuvData->planeCount(), YUVData::I420_PLANE_COUNT);
+  EXPECT_EQ(yuvData->width(), 110);
+  EXPECT_EQ(yuvData->height(), 110);
+  EXPECT_EQ(colorSpace, YUVColorSpace::JPEG_FULL);
+  auto image = Image::MakeYUVFromEncoded(bytes);
+  ASSERT_TRUE(image != nullptr);
+  EXPECT_EQ(image->width(), 110);
+  EXPECT_EQ(image->height(), 110);
+}
+
+static int MaxChannelDifference(const uint8_t* pixels, const uint8_t* expected, size_t size) {
+  int difference = 0;
+  for (size_t i = 0; i < size; i++) {
+    difference = std::max(difference, std::abs(pixels[i] - expected[i]));
+  }
+  return difference;
+}
+
+TGFX_TEST(ReadPixelsTest, RegionDecode) {
+  auto pngCodec = MakeImageCodec("resources/apitest/imageReplacement.png");
+  ASSERT_TRUE(pngCodec != nullptr);
+  auto fullInfo = ImageInfo::Make(pngCodec->width(), pngCodec->height(), ColorType::RGBA_8888,
+                                  AlphaType::Premultiplied);
+  Buffer fullBuffer(fullInfo.byteSize());
+  ASSERT_TRUE(fullBuffer.data() != nullptr);
+  EXPECT_TRUE(pngCodec->readPixels(fullInfo, fullBuffer.data()));
+  auto info = ImageInfo::Make(40, 30, ColorType::RGBA_8888, AlphaType::Premultiplied);
+  Buffer buffer(info.byteSize());
+  ASSERT_TRUE(buffer.data() != nullptr);
+  auto region = Rect::MakeXYWH(20, 50, 40, 30);
+  EXPECT_TRUE(pngCodec->readRegion(region, info, buffer.data()));
+  Buffer expected(info.byteSize());
+  ASSERT_TRUE(expected.data() != nullptr);
+  Pixmap(fullInfo, fullBuffer.data()).readPixels(info, expected.data(), 20, 50);
+  EXPECT_EQ(memcmp(buffer.data(), expected.data(), info.byteSize()), 0);
+  EXPECT_FALSE(pngCodec->readRegion(Rect::MakeXYWH(100, 100, 40, 30), info, buffer.data()));
+
+  // Lossy codecs upsample the chroma of the region from its own samples, so the pixels at its
+  // edges may differ slightly from the full decode.
+  static constexpr int LossyTolerance = 4;
+  auto scaledInfo = ImageInfo::Make(10, 8, ColorType::RGBA_8888, AlphaType::Premultiplied);
+  std::vector<std::string> lossyPaths = {"resources/apitest/imageReplacement.jpg",
+                                         "resources/apitest/imageReplacement.webp"};
+  for (auto& path : lossyPaths) {
+    auto codec = MakeImageCodec(path);
+    ASSERT_TRUE(codec != nullptr);
+    EXPECT_TRUE(codec->readPixels(fullInfo, fullBuffer.data()));
+    Pixmap(fullInfo, fullBuffer.data()).readPixels(info, expected.data(), 20, 50);
+    EXPECT_TRUE(codec->readRegion(region, info, buffer.data()));
+    EXPECT_LE(MaxChannelDifference(buffer.bytes(), expected.bytes(), info.byteSize()),
+              LossyTolerance);
+    EXPECT_TRUE(codec->readRegion(region, scaledInfo, buffer.data()));
+  }
+  auto jpegCodec = MakeImageCodec("resources/apitest/imageReplacement.jpg");
+  ASSERT_TRUE(jpegCodec != nullptr);
+
+  auto image = Image::MakeTiled(jpegCodec, 64);
+  ASSERT_TRUE(image != nullptr);
+  EXPECT_EQ(image->width(), 110);
+  EXPECT_EQ(image->height(), 110);
+  EXPECT_FALSE(image->hasMipmaps());
+}
+
+TGFX_TEST(ReadPixelsTest, TiledImage) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  auto codec = MakeImageCodec("resources/apitest/imageReplacement.png");
+  ASSERT_TRUE(codec != nullptr);
+  auto tiledImage = Image::MakeTiled(codec, 32);
+  ASSERT_TRUE(tiledImage != nullptr);
+  auto image = Image::MakeFrom(codec);
+  ASSERT_TRUE(image != nullptr);
+  auto info = ImageInfo::Make(codec->width() + 2, codec->height() + 2, ColorType::RGBA_8888,
+                              AlphaType::Premultiplied);
+  Buffer expected(info.byteSize());
+  Buffer actual(info.byteSize());
+  ASSERT_TRUE(expected.data() != nullptr && actual.data() != nullptr);
+  auto surface = Surface::Make(context, info.width(), info.height());
+  ASSERT_TRUE(surface != nullptr);
+  auto canvas = surface->getCanvas();
+  // The half-pixel offset puts every edge of the tiles between pixels. The outer edges of the
+  // image are antialiased like the untiled image, while the edges shared by the tiles are not.
+  std::vector<float> offsets = {1.0f, 1.5f};
+  for (auto offset : offsets) {
+    canvas->clear();
+    canvas->drawImage(image, offset, offset);
+    EXPECT_TRUE(surface->readPixels(info, expected.data()));
+    canvas->clear();
+    canvas->drawImage(tiledImage, offset, offset);
+    EXPECT_TRUE(surface->readPixels(info, actual.data()));
+    EXPECT_LE(MaxChannelDifference(actual.bytes(), expected.bytes(), info.byteSize()), 1);
+  }
+}
+
+TGFX_TEST(ReadPixelsTest, ParallelDecode) {
+  // Large enough to be decoded in row bands on the task pool.
+  auto info = ImageInfo::Make(1600, 1200, ColorType::RGBA_8888, AlphaType::Unpremultiplied);
+  Buffer source(info.byteSize());
+  ASSERT_TRUE(source.data() != nullptr);
+  for (int y = 0; y < info.height(); y++) {
+    auto row = source.bytes() + info.rowBytes() * static_cast<size_t>(y);
+    for (int x = 0; x < info.width(); x++) {
+      row[x * 4] = static_cast<uint8_t>(x * 255 / info.width());
+      row[x * 4 + 1] = static_cast<uint8_t>(y * 255 / info.height());
+      row[x * 4 + 2] = static_cast<uint8_t>((x + y) & 0xFF);
+      row[x * 4 + 3] = static_cast<uint8_t>(128 + (x & 0x7F));
+    }
+  }
+  auto dstInfo = info.makeColorType(ColorType::BGRA_8888).makeAlphaType(AlphaType::Premultiplied);
+  Buffer expected(dstInfo.byteSize());
+  Buffer decoded(dstInfo.byteSize());
+  ASSERT_TRUE(expected.data() != nullptr && decoded.data() != nullptr);
+  EXPECT_TRUE(Pixmap(info, source.data()).readPixels(dstInfo, expected.data()));
+  auto bytes = ImageCodec::Encode(Pixmap(info, source.data()), EncodedFormat::PNG, 100);
+  auto pngCodec = ImageCodec::MakeFrom(bytes);
+  ASSERT_TRUE(pngCodec != nullptr);
+  EXPECT_TRUE(pngCodec->readPixels(dstInfo, decoded.data()));
+  EXPECT_EQ(memcmp(expected.data(), decoded.data(), dstInfo.byteSize()), 0);
+
+  bytes = ImageCodec::Encode(Pixmap(info, source.data()), EncodedFormat::JPEG, 90);
+  auto jpegCodec = ImageCodec::MakeFrom(bytes);
+  ASSERT_TRUE(jpegCodec != nullptr);
+  auto rgbaInfo = info.makeAlphaType(AlphaType::Opaque);
+  EXPECT_TRUE(jpegCodec->readPixels(rgbaInfo, decoded.data()));
+  // Decoding the whole image as a single region goes through one decompressor, which the bands
+  // must match.
+  auto region = Rect::MakeWH(info.width(), info.height());
+  EXPECT_TRUE(jpegCodec->readRegion(region, rgbaInfo, expected.data()));
+  EXPECT_EQ(memcmp(expected.data(), decoded.data(), rgbaInfo.byteSize()), 0);
+}
+
+TGFX_TEST(ReadPixelsTest, IncrementalDecode) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  std::vector<std::string> paths = {"resources/apitest/imageReplacement.jpg",
+                                    "resources/apitest/imageReplacement.png",
+                                    "resources/apitest/imageReplacement.webp"};
+  for (auto& path : paths) {
+    auto data = Data::MakeFromFile(ProjectPath::Absolute(path));
+    ASSERT_TRUE(data != nullptr);
+    EXPECT_TRUE(IncrementalDecoder::MakeFrom(Data::MakeWithCopy(data->data(), 8)) == nullptr);
+    static constexpr size_t ChunkSize = 512;
+    auto decoder = IncrementalDecoder::MakeFrom(Data::MakeWithCopy(data->data(), ChunkSize));
+    ASSERT_TRUE(decoder != nullptr);
+    EXPECT_FALSE(decoder->isComplete());
+    auto surface = Surface::Make(context, 110, 110);
+    ASSERT_TRUE(surface != nullptr);
+    auto canvas = surface->getCanvas();
+    for (size_t offset = ChunkSize; offset < data->size(); offset += ChunkSize) {
+      auto length = std::min(ChunkSize, data->size() - offset);
+      EXPECT_TRUE(decoder->append(Data::MakeWithCopy(data->bytes() + offset, length)));
+      auto buffer = decoder->acquireNextBuffer();
+      if (buffer != nullptr) {
+        canvas->clear();
+        canvas->drawImage(Image::MakeFrom(buffer));
+        context->flush();
+      }
+    }
+    EXPECT_TRUE(decoder->isComplete());
+    EXPECT_EQ(decoder->width(), 110);
+    EXPECT_EQ(decoder->height(), 110);
+    EXPECT_TRUE(decoder->acquireNextBuffer() == nullptr);
+    auto codec = ImageCodec::MakeFrom(data);
+    ASSERT_TRUE(codec != nullptr);
+    auto info = ImageInfo::Make(110, 110, ColorType::RGBA_8888, AlphaType::Premultiplied);
+    Buffer expected(info.byteSize());
+    Buffer actual(info.byteSize());
+    ASSERT_TRUE(expected.data() != nullptr && actual.data() != nullptr);
+    EXPECT_TRUE(codec->readPixels(info, expected.data()));
+    EXPECT_TRUE(surface->readPixels(info, actual.data()));
+    EXPECT_EQ(memcmp(expected.data(), actual.data(), info.byteSize()), 0);
+  }
+}
+
+TGFX_TEST(ReadPixelsTest, IncrementalDecodeOrientation) {
+  auto info = ImageInfo::Make(16, 8, ColorType::RGBA_8888, AlphaType::Premultiplied);
+  std::vector<uint32_t> pixels(16 * 8, 0xFF0000FF);
+  auto jpeg = ImageCodec::Encode(Pixmap(info, pixels.data()), EncodedFormat::JPEG, 90);
+  ASSERT_TRUE(jpeg != nullptr);
+  // An APP1 segment with a big-endian EXIF header and one IFD entry that sets the orientation
+  // (0x0112) to RightTop (6).
+  std::vector<uint8_t> exif = {0xFF, 0xE1, 0x00, 0x22, 'E',  'x',  'i',  'f',  0x00,
+                               0x00, 'M',  'M',  0x00, 0x2A, 0x00, 0x00, 0x00, 0x08,
+                               0x00, 0x01, 0x01, 0x12, 0x00, 0x03, 0x00, 0x00, 0x00,
+                               0x01, 0x00, 0x06, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+  std::vector<uint8_t> bytes(jpeg->bytes(), jpeg->bytes() + 2);
+  bytes.insert(bytes.end(), exif.begin(), exif.end());
+  bytes.insert(bytes.end(), jpeg->bytes() + 2, jpeg->bytes() + jpeg->size());
+  auto data = Data::MakeWithCopy(bytes.data(), bytes.size());
+  auto codec = ImageCodec::MakeFrom(data);
+  ASSERT_TRUE(codec != nullptr);
+  EXPECT_EQ(codec->orientation(), Orientation::RightTop);
+  auto decoder = IncrementalDecoder::MakeFrom(Data::MakeWithCopy(bytes.data(), 14));
+  ASSERT_TRUE(decoder != nullptr);
+  EXPECT_EQ(decoder->orientation(), Orientation::TopLeft);
+  EXPECT_TRUE(decoder->append(Data::MakeWithCopy(bytes.data() + 14, bytes.size() - 14)));
+  EXPECT_TRUE(decoder->isComplete());
+  EXPECT_EQ(decoder->orientation(), Orientation::RightTop);
+  // The dimensions are those of the encoded pixels, like the ones of the codec.
+  EXPECT_EQ(decoder->width(), codec->width());
+  EXPECT_EQ(decoder->height(), codec->height());
+}
+
+static void AppendUInt32(std::vector<uint8_t>* bytes, uint32_t value) {
+  bytes->push_back(static_cast<uint8_t>(value >> 24));
+  bytes->push_back(static_cast<uint8_t>(value >> 16));
+  bytes->push_back(static_cast<uint8_t>(value >> 8));
+  bytes->push_back(static_cast<uint8_t>(value));
+}
+
+static void AppendChunk(std::vector<uint8_t>* bytes, const char* type,
+                        const std::vector<uint8_t>& data) {
+  AppendUInt32(bytes, static_cast<uint32_t>(data.size()));
+  bytes->insert(bytes->end(), type, type + 4);
+  bytes->insert(bytes->end(), data.begin(), data.end());
+  // The CRCs of the APNG container are not verified by the decoder.
+  AppendUInt32(bytes, 0);
+}
+
+static std::vector<uint8_t> GetChunkData(const std::shared_ptr<Data>& png, const char* type) {
+  std::vector<uint8_t> result = {};
+  auto bytes = png->bytes();
+  size_t offset = 8;
+  while (offset + 12 <= png->size()) {
+    auto length = static_cast<size_t>(bytes[offset]) << 24 | bytes[offset + 1] << 16 |
+                  bytes[offset + 2] << 8 | bytes[offset + 3];
+    if (memcmp(bytes + offset + 4, type, 4) == 0) {
+      result.insert(result.end(), bytes + offset + 8, bytes + offset + 8 + length);
+    }
+    offset += length + 12;
+  }
+  return result;
+}
+
+static std::vector<uint8_t> MakeFrameControl(uint32_t sequence, int width, int height, int x,
+                                             int y) {
+  std::vector<uint8_t> data = {};
+  AppendUInt32(&data, sequence);
+  AppendUInt32(&data, static_cast<uint32_t>(width));
+  AppendUInt32(&data, static_cast<uint32_t>(height));
+  AppendUInt32(&data, static_cast<uint32_t>(x));
+  AppendUInt32(&data, static_cast<uint32_t>(y));
+  // A delay of 1/10 second, no disposal, and no blending.
+  data.insert(data.end(), {0, 1, 0, 10, 0, 0});
+  return data;
+}
+
+static std::shared_ptr<Data> EncodeSolidPng(int width, int height, uint32_t color) {
+  auto info = ImageInfo::Make(width, height, ColorType::RGBA_8888, AlphaType::Unpremultiplied);
+  std::vector<uint32_t> pixels(static_cast<size_t>(width * height), color);
+  return ImageCodec::Encode(Pixmap(info, pixels.data()), EncodedFormat::PNG, 100);
+}
+
+TGFX_TEST(ReadPixelsTest, AnimatedCodec) {
+  auto firstFrame = EncodeSolidPng(16, 16, 0xFF0000FF);
+  auto secondFrame = EncodeSolidPng(8, 8, 0xFF00FF00);
+  ASSERT_TRUE(firstFrame != nullptr && secondFrame != nullptr);
+  std::vector<uint8_t> bytes(firstFrame->bytes(), firstFrame->bytes() + 8);
+  AppendChunk(&bytes, "IHDR", GetChunkData(firstFrame, "IHDR"));
+  std::vector<uint8_t> animationControl = {};
+  AppendUInt32(&animationControl, 2);
+  AppendUInt32(&animationControl, 0);
+  AppendChunk(&bytes, "acTL", animationControl);
+  AppendChunk(&bytes, "fcTL", MakeFrameControl(0, 16, 16, 0, 0));
+  AppendChunk(&bytes, "IDAT", GetChunkData(firstFrame, "IDAT"));
+  AppendChunk(&bytes, "fcTL", MakeFrameControl(1, 8, 8, 4, 4));
+  std::vector<uint8_t> frameData = {};
+  AppendUInt32(&frameData, 2);
+  auto secondData = GetChunkData(secondFrame, "IDAT");
+  frameData.insert(frameData.end(), secondData.begin(), secondData.end());
+  AppendChunk(&bytes, "fdAT", frameData);
+  AppendChunk(&bytes, "IEND", {});
+
+  EXPECT_TRUE(AnimatedCodec::MakeFrom(firstFrame) == nullptr);
+  auto codec = AnimatedCodec::MakeFrom(Data::MakeWithCopy(bytes.data(), bytes.size()));
+  ASSERT_TRUE(codec != nullptr);
+  EXPECT_EQ(codec->width(), 16);
+  EXPECT_EQ(codec->height(), 16);
+  EXPECT_EQ(codec->frameCount(), 2);
+  EXPECT_EQ(codec->loopCount(), 0);
+  EXPECT_EQ(codec->duration(), 200000);
+  EXPECT_EQ(codec->getFrameInfo(1).bounds, Rect::MakeXYWH(4, 4, 8, 8));
+  auto info = ImageInfo::Make(16, 16, ColorType::RGBA_8888, AlphaType::Premultiplied);
+  std::vector<uint32_t> pixels(16 * 16);
+  EXPECT_TRUE(codec->readFrame(1, info, pixels.data()));
+  EXPECT_EQ(pixels[0], 0xFF0000FF);
+  EXPECT_EQ(pixels[5 * 16 + 5], 0xFF00FF00);
+  EXPECT_TRUE(codec->readFrame(0, info, pixels.data()));
+  EXPECT_EQ(pixels[5 * 16 + 5], 0xFF0000FF);
+
+  auto reader = AnimatedImageReader::MakeFrom(codec, 2);
+  ASSERT_TRUE(reader != nullptr);
+  EXPECT_EQ(reader->getFrameIndex(50000), 0);
+  EXPECT_EQ(reader->getFrameIndex(150000), 1);
+  EXPECT_EQ(reader->getFrameIndex(250000), 0);
+  EXPECT_TRUE(reader->acquireNextBuffer(0) != nullptr);
+  EXPECT_TRUE(reader->acquireNextBuffer(50000) == nullptr);
+  EXPECT_TRUE(reader->acquireNextBuffer(150000) != nullptr);
+  EXPECT_TRUE(reader->acquireNextBuffer(250000) != nullptr);
+}
+
+TGFX_TEST(ReadPixelsTest, ConversionKernels) {
+  // An odd width exercises the scalar tails after the SIMD loops. All pixels are valid
+  // premultiplied colors, so every conversion has a single correct result.
+  int width = 256 * 3 + 13;
+  int height = 256;
+  Buffer srcBuffer(static_cast<size_t>(width * height * 4));
+  auto srcPixels = srcBuffer.bytes();
+  for (int y = 0; y < height; y++) {
+    for (int x = 0; x < width; x++) {
+      auto pixel = srcPixels + (y * width + x) * 4;
+      pixel[0] = static_cast<uint8_t>((x & 255) * y / 255);
+      pixel[1] = static_cast<uint8_t>(((x * 7 + y) & 255) * y / 255);
+      pixel[2] = static_cast<uint8_t>((255 - (x & 255)) * y / 255);
+      pixel[3] = static_cast<uint8_t>(y);
+    }
+  }
+  std::vector<ColorType> colorTypes = {ColorType::RGBA_8888, ColorType::BGRA_8888,
+                                       ColorType::ALPHA_8};
+  std::vector<AlphaType> alphaTypes = {AlphaType::Premultiplied, AlphaType::Unpremultiplied,
+                                       AlphaType::Opaque};
+  for (auto srcColorType : colorTypes) {
+    for (auto srcAlphaType : alphaTypes) {
+      for (auto dstColorType : colorTypes) {
+        for (auto dstAlphaType : alphaTypes) {
+          if (srcColorType == dstColorType && srcAlphaType == dstAlphaType) {
+            continue;
+          }
+          auto srcInfo = ImageInfo::Make(width, height, srcColorType, srcAlphaType);
+          auto dstInfo = ImageInfo::Make(width, height, dstColorType, dstAlphaType);
+          if (srcInfo.isEmpty() || dstInfo.isEmpty()) {
+            continue;
+          }
+          Buffer result(dstInfo.byteSize());
+          Buffer expected(dstInfo.byteSize());
+          ConvertPixels(srcInfo, srcPixels, dstInfo, result.data());
+          TransformPixels(srcInfo, srcPixels, dstInfo, expected.data());
+          EXPECT_EQ(memcmp(result.data(), expected.data(), result.size()), 0);
+        }
+      }
+    }
+  }
+}
+
+// Compares the kernels against the skcms pipeline for the common readback conversions. Disabled
+// by default, run it with --gtest_also_run_disabled_tests --gtest_filter=*ConversionKernelsBench*.
+TGFX_TEST(ReadPixelsTest, DISABLED_ConversionKernelsBenchmark) {
+  static constexpr int RepeatCount = 20;
+  auto srcInfo = ImageInfo::Make(2048, 2048, ColorType::RGBA_8888, AlphaType::Premultiplied);
+  Buffer srcBuffer(srcInfo.byteSize());
+  ASSERT_TRUE(srcBuffer.data() != nullptr);
+  srcBuffer.clear();
+  std::vector<std::pair<ColorType, AlphaType>> dstTypes = {
+      {ColorType::BGRA_8888, AlphaType::Premultiplied},
+      {ColorType::RGBA_8888, AlphaType::Unpremultiplied},
+      {ColorType::ALPHA_8, AlphaType::Premultiplied}};
+  for (auto& dstType : dstTypes) {
+    auto dstInfo = srcInfo.makeColorType(dstType.first).makeAlphaType(dstType.second);
+    Buffer dstBuffer(dstInfo.byteSize());
+    ASSERT_TRUE(dstBuffer.data() != nullptr);
+    auto startTime = std::chrono::steady_clock::now();
+    for (int i = 0; i < RepeatCount; i++) {
+      ConvertPixels(srcInfo, srcBuffer.data(), dstInfo, dstBuffer.data());
+    }
+    auto kernelTime = std::chrono::steady_clock::now() - startTime;
+    startTime = std::chrono::steady_clock::now();
+    for (int i = 0; i < RepeatCount; i++) {
+      TransformPixels(srcInfo, srcBuffer.data(), dstInfo, dstBuffer.data());
+    }
+    auto skcmsTime = std::chrono::steady_clock::now() - startTime;
+    auto kernelMicros = std::chrono::duration_cast<std::chrono::microseconds>(kernelTime).count();
+    auto skcmsMicros = std::chrono::duration_cast<std::chrono::microseconds>(skcmsTime).count();
+    printf("ConvertPixels to (%d, %d): kernels %lld us, skcms %lld us\n",
+           static_cast<int>(dstType.first), static_cast<int>(dstType.second),
+           static_cast<long long>(kernelMicros / RepeatCount),
+           static_cast<long long>(skcmsMicros / RepeatCount));
+  }
+}
+
+TGFX_TEST(ReadPixelsTest, StreamEncode) {
+  // Large enough to be encoded in row bands on the task pool.
+  auto info = ImageInfo::Make(1600, 1200, ColorType::RGBA_8888, AlphaType::Unpremultiplied);
+  Buffer source(info.byteSize());
+  ASSERT_TRUE(source.data() != nullptr);
+  for (int y = 0; y < info.height(); y++) {
+    auto row = source.bytes() + info.rowBytes() * static_cast<size_t>(y);
+    for (int x = 0; x < info.width(); x++) {
+      row[x * 4] = static_cast<uint8_t>(x * 255 / info.width());
+      row[x * 4 + 1] = static_cast<uint8_t>(y * 255 / info.height());
+      row[x * 4 + 2] = static_cast<uint8_t>((x * y) & 0xFF);
+      row[x * 4 + 3] = static_cast<uint8_t>(128 + (y & 0x7F));
+    }
+  }
+  Pixmap pixmap(info, source.data());
+  auto stream = MemoryWriteStream::Make();
+  EXPECT_FALSE(ImageCodec::Encode(pixmap, EncodedFormat::PNG, 100, nullptr));
+  ASSERT_TRUE(ImageCodec::Encode(pixmap, EncodedFormat::PNG, 100, stream.get()));
+  auto bytes = stream->readData();
+  ASSERT_TRUE(bytes != nullptr);
+  EXPECT_EQ(bytes->size(), stream->bytesWritten());
+  auto codec = ImageCodec::MakeFrom(bytes);
+  ASSERT_TRUE(codec != nullptr);
+  Buffer decoded(info.byteSize());
+  ASSERT_TRUE(decoded.data() != nullptr);
+  EXPECT_TRUE(codec->readPixels(info, decoded.data()));
+  EXPECT_EQ(memcmp(source.data(), decoded.data(), info.byteSize()), 0);
+
+  auto smallInfo = ImageInfo::Make(64, 48, ColorType::RGBA_8888, AlphaType::Unpremultiplied);
+  Pixmap smallPixmap(smallInfo, source.data());
+  std::vector<const Pixmap*> pixmaps = {&pixmap, nullptr, &smallPixmap};
+  auto results = ImageCodec::Encode(pixmaps, EncodedFormat::PNG, 100);
+  ASSERT_EQ(results.size(), pixmaps.size());
+  ASSERT_TRUE(results[0] != nullptr);
+  EXPECT_TRUE(results[0]->size() == bytes->size());
+  EXPECT_EQ(memcmp(results[0]->data(), bytes->data(), bytes->size()), 0);
+  EXPECT_TRUE(results[1] == nullptr);
+  ASSERT_TRUE(results[2] != nullptr);
+  codec = ImageCodec::MakeFrom(results[2]);
+  ASSERT_TRUE(codec != nullptr);
+  EXPECT_EQ(codec->width(), 64);
+  EXPECT_EQ(codec->height(), 48);
+}
 }  // namespace tgfx
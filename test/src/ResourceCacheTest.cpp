@@ -16,9 +16,16 @@
 //
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
+#include <atomic>
 #include <vector>
+#include "core/PixelBuffer.h"
 #include "core/utils/UniqueID.h"
 #include "gpu/Resource.h"
+#include "tgfx/core/Canvas.h"
+#include "tgfx/core/DecodedImageCache.h"
+#include "tgfx/core/Image.h"
+#include "tgfx/core/ImageGenerator.h"
+#include "tgfx/core/Surface.h"
 #include "tgfx/core/Task.h"
 #include "utils/TestUtils.h"
 
@@ -42,6 +49,33 @@ class TestResource : public Resource {
   }
 };
 
+class CountingGenerator : public ImageGenerator {
+ public:
+  CountingGenerator(int width, int height, std::shared_ptr<std::atomic_int> decodeCount)
+      : ImageGenerator(width, height), decodeCount(std::move(decodeCount)) {
+  }
+
+  bool isAlphaOnly() const override {
+    return false;
+  }
+
+ protected:
+  std::shared_ptr<ImageBuffer> onMakeBuffer(bool tryHardware) const override {
+    (*decodeCount)++;
+    auto pixelBuffer = PixelBuffer::Make(width(), height(), false, tryHardware);
+    if (pixelBuffer == nullptr) {
+      return nullptr;
+    }
+    auto pixels = pixelBuffer->lockPixels();
+    memset(pixels, 0xFF, pixelBuffer->info().byteSize());
+    pixelBuffer->unlockPixels();
+    return pixelBuffer;
+  }
+
+ private:
+  std::shared_ptr<std::atomic_int> decodeCount = nullptr;
+};
+
 TGFX_TEST(ResourceCacheTest, multiThreadRecycling) {
   auto device = DevicePool::Make();
   ASSERT_TRUE(device != nullptr);
@@ -60,4 +94,43 @@ TGFX_TEST(ResourceCacheTest, multiThreadRecycling) {
     }
   });
 }
+
+TGFX_TEST(ResourceCacheTest, DecodedImageCache) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  EXPECT_EQ(DecodedImageCache::GetCacheLimit(), 0U);
+  DecodedImageCache::SetCacheLimit(16 * 1024 * 1024);
+  auto decodeCount = std::make_shared<std::atomic_int>(0);
+  auto image = Image::MakeFrom(std::make_shared<CountingGenerator>(100, 100, decodeCount));
+  ASSERT_TRUE(image != nullptr);
+  auto surface = Surface::Make(context, 100, 100);
+  ASSERT_TRUE(surface != nullptr);
+  auto canvas = surface->getCanvas();
+  canvas->drawImage(image);
+  context->flush();
+  EXPECT_EQ(decodeCount->load(), 1);
+  auto stats = DecodedImageCache::GetStats();
+  EXPECT_EQ(stats.entryCount, 1U);
+  EXPECT_EQ(stats.memoryUsage, 100U * 100U * 4U);
+
+  // The texture is purged from the GPU cache, so the next draw uploads the cached pixels.
+  context->purgeResourcesNotUsedSince(std::chrono::steady_clock::now());
+  canvas->clear();
+  canvas->drawImage(image);
+  context->flush();
+  EXPECT_EQ(decodeCount->load(), 1);
+  EXPECT_EQ(DecodedImageCache::GetStats().hitCount, stats.hitCount + 1);
+
+  // Images larger than the whole budget are not cached, and shrinking the budget evicts entries.
+  DecodedImageCache::SetCacheLimit(100 * 100 * 4 - 1);
+  EXPECT_EQ(DecodedImageCache::GetStats().entryCount, 0U);
+  context->purgeResourcesNotUsedSince(std::chrono::steady_clock::now());
+  canvas->clear();
+  canvas->drawImage(image);
+  context->flush();
+  EXPECT_EQ(decodeCount->load(), 2);
+  EXPECT_EQ(DecodedImageCache::GetStats().entryCount, 0U);
+  DecodedImageCache::SetCacheLimit(0);
+}
 }  // namespace tgfx